@@ -0,0 +1,14 @@
+/* @copyright Edouard DUPIN */
+// Call overhead: recursive call (run with --stat: the number of stack allocation must not depend on the number of call)
+int fib(int n) {
+	if (n < 2) {
+		return n;
+	}
+	return fib(n-1) + fib(n-2);
+}
+int main() {
+	if (fib(27) != 196418) {
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,15 @@
+/* @copyright Edouard DUPIN */
+// Call overhead: call in a tight loop (visitor like callback)
+int visit(int value, int accumulator) {
+	return accumulator + value;
+}
+int main() {
+	int accumulator = 0;
+	for (int iii=0; iii<1000000; ++iii) {
+		accumulator = visit(iii & 1023, accumulator);
+	}
+	if (accumulator != 511370976) {
+		return 1;
+	}
+	return 0;
+}
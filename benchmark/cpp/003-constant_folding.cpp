@@ -0,0 +1,32 @@
+/* @copyright Edouard DUPIN */
+// Constant folding: generated code with constant expressions and debug branches
+const int SIZE = 64 * 16;
+const bool DEBUG = false;
+const int MASK = SIZE - 1;
+int compute(int value) {
+	const int scale = (2 + 3) * 4 - 19;
+	int out = value * scale + (SIZE / 32 - 32);
+	if (DEBUG == true) {
+		out = out + 1000;
+	}
+	if (!DEBUG && (1 < 2)) {
+		out = out & MASK;
+	} else {
+		out = 0;
+	}
+	while (DEBUG) {
+		out = out * 2;
+	}
+	out = out + (int)(2.5 * 2.0) - 5;
+	return out;
+}
+int main() {
+	int accumulator = 0;
+	for (int iii=0; iii<200000; ++iii) {
+		accumulator = accumulator + compute(iii) + (7 % 4 - 3);
+	}
+	if (accumulator != 102187360) {
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,34 @@
+/* @copyright Edouard DUPIN */
+// Member access and method call in a loop (inline cache)
+class Counter {
+	public:
+		int m_value;
+		int m_step;
+		void add(int _value) {
+			m_value += _value * m_step;
+		}
+};
+class FastCounter : public Counter {
+	public:
+		void add(int _value) {
+			m_value += _value;
+		}
+};
+int run(Counter _counter, int _count) {
+	for (int iii=0; iii<_count; ++iii) {
+		_counter.add(iii & 7);
+		_counter.m_step = _counter.m_step + 1 - 1;
+	}
+	return _counter.m_value;
+}
+int main() {
+	Counter counter;
+	counter.m_step = 2;
+	FastCounter fast;
+	fast.m_step = 2;
+	int out = run(counter, 200000) + run(fast, 200000);
+	if (out != 2100000) {
+		return 1;
+	}
+	return 0;
+}
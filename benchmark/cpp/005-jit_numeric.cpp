@@ -0,0 +1,37 @@
+/* @copyright Edouard DUPIN */
+// Numeric kernel called many times: compare the interpreter with "--jit"
+double kernel(int count, double step) {
+	double sum = 0.0;
+	for (int iii=0; iii<count; ++iii) {
+		sum += iii * step;
+		if (iii % 3 == 0) {
+			sum -= 1.0;
+		}
+	}
+	return sum;
+}
+int64_t mix(int64_t seed, int count) {
+	int64_t value = seed;
+	int iii = 0;
+	while (iii < count) {
+		value = value * 31 + iii;
+		value = value % 1000000007;
+		++iii;
+	}
+	return value;
+}
+int main() {
+	double total = 0.0;
+	int64_t hash = 0;
+	for (int jjj=0; jjj<200; ++jjj) {
+		total += kernel(1000, 0.5);
+		hash = mix(hash + jjj, 100);
+	}
+	if (total != 49883200.0) {
+		return 1;
+	}
+	if (hash != 726002977) {
+		return 1;
+	}
+	return 0;
+}
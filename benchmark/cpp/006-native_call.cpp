@@ -0,0 +1,36 @@
+/* @copyright Edouard DUPIN */
+// Call overhead of a C function of a library compared with the same function in the script ("--time", "--jit")
+#import "libc.so.6"
+long labs(long value);
+long scriptAbs(long value) {
+	if (value < 0) {
+		return -value;
+	}
+	return value;
+}
+long sumNative(int count) {
+	long sum = 0;
+	for (int iii=0; iii<count; ++iii) {
+		sum += labs(iii - 500);
+	}
+	return sum;
+}
+long sumScript(int count) {
+	long sum = 0;
+	for (int iii=0; iii<count; ++iii) {
+		sum += scriptAbs(iii - 500);
+	}
+	return sum;
+}
+int main() {
+	long native = 0;
+	long script = 0;
+	for (int jjj=0; jjj<100; ++jjj) {
+		native += sumNative(1000);
+		script += sumScript(1000);
+	}
+	if (native != script || native != 25000000) {
+		return 1;
+	}
+	return 0;
+}
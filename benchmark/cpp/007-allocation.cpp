@@ -0,0 +1,60 @@
+/* @copyright Edouard DUPIN */
+// Allocation throughput of the script heap: short lived objects of several sizes and a kept list ("--time", "--stat")
+class Small {
+	public:
+		int m_value;
+};
+class Medium {
+	public:
+		double m_a;
+		double m_b;
+		double m_c;
+		double m_d;
+		int m_value;
+};
+class Cell {
+	public:
+		int m_value;
+		Cell* m_next;
+};
+int churn(int count) {
+	int sum = 0;
+	for (int iii=0; iii<count; ++iii) {
+		Small* small = new Small();
+		small->m_value = iii;
+		Medium* medium = new Medium();
+		medium->m_value = small->m_value;
+		sum += medium->m_value % 7;
+		delete small;
+		delete medium;
+	}
+	return sum;
+}
+int keep(int count) {
+	Cell* list = null;
+	for (int iii=0; iii<count; ++iii) {
+		Cell* cell = new Cell();
+		cell->m_value = iii;
+		cell->m_next = list;
+		list = cell;
+	}
+	int sum = 0;
+	for (int iii=0; iii<count; ++iii) {
+		Cell* next = list->m_next;
+		sum += list->m_value;
+		delete list;
+		list = next;
+	}
+	return sum;
+}
+int main() {
+	int sum = 0;
+	for (int jjj=0; jjj<20; ++jjj) {
+		sum += churn(1000);
+		sum += keep(1000);
+	}
+	if (sum != 20*(2997+499500)) {
+		return 1;
+	}
+	return 0;
+}
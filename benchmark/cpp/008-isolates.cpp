@@ -0,0 +1,45 @@
+/* @copyright Edouard DUPIN */
+// Work load of the isolate scaling ("--isolates=8"): each interpreter parse the file, call functions and use its own heap
+class Point {
+	public:
+		int m_x;
+		int m_y;
+		Point* m_next;
+};
+int fib(int value) {
+	if (value < 2) {
+		return value;
+	}
+	return fib(value-1) + fib(value-2);
+}
+int walk(int count) {
+	Point* list = null;
+	for (int iii=0; iii<count; ++iii) {
+		Point* point = new Point();
+		point->m_x = iii;
+		point->m_y = count - iii;
+		point->m_next = list;
+		list = point;
+	}
+	int sum = 0;
+	for (int iii=0; iii<count; ++iii) {
+		Point* next = list->m_next;
+		sum += list->m_x + list->m_y;
+		delete list;
+		list = next;
+	}
+	return sum;
+}
+int main() {
+	int sum = 0;
+	for (int iii=0; iii<20; ++iii) {
+		sum += walk(1000);
+	}
+	if (sum != 20*1000*1000) {
+		return 1;
+	}
+	if (fib(20) != 6765) {
+		return 2;
+	}
+	return 0;
+}
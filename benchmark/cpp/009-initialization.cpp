@@ -0,0 +1,53 @@
+/* @copyright Edouard DUPIN */
+// Start of a program with an expensive initialization: "--time" against "--save-image" then "--image --time" on "009-initialization.cpp.img"
+class Entry {
+	public:
+		int m_key;
+		int m_value;
+		Entry* m_next;
+};
+int countPrimes(int limit) {
+	int count = 0;
+	for (int iii=2; iii<limit; ++iii) {
+		bool prime = true;
+		for (int jjj=2; jjj*jjj<=iii; ++jjj) {
+			if (iii % jjj == 0) {
+				prime = false;
+				break;
+			}
+		}
+		if (prime == true) {
+			count += 1;
+		}
+	}
+	return count;
+}
+Entry* buildTable(int count) {
+	Entry* list = null;
+	for (int iii=0; iii<count; ++iii) {
+		Entry* entry = new Entry();
+		entry->m_key = iii;
+		entry->m_value = (iii * 7919) % 10007;
+		entry->m_next = list;
+		list = entry;
+	}
+	return list;
+}
+int nbPrime = countPrimes(30000);
+Entry* table = buildTable(5000);
+int main() {
+	// the request only read the initialized state
+	if (nbPrime != 3245) {
+		return 1;
+	}
+	int sum = 0;
+	Entry* entry = table;
+	for (int iii=0; iii<100; ++iii) {
+		sum += entry->m_key;
+		entry = entry->m_next;
+	}
+	if (sum != 100*4999-4950) {
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,30 @@
+/* @copyright Edouard DUPIN */
+// Function executed on columns of records: "--batch=score --time" (vectorized expression), "--batch=clamp" (row by row)
+// and "--batch=wrap" (vectorized integer expression that overflow: the result wrap as in the interpreter)
+double score(double price, double quantity, double discount) {
+	return price * quantity - discount * 0.5 + (price - discount) / 4.0;
+}
+int clamp(int value, int limit) {
+	if (value > limit) {
+		return limit;
+	}
+	return value * 2 - limit;
+}
+int wrap(int value, int factor) {
+	return value * 1000000 * factor + 2147483647;
+}
+int main() {
+	if (score(10.0, 2.0, 4.0) != 19.5) {
+		return 1;
+	}
+	if (clamp(9, 4) != 4) {
+		return 2;
+	}
+	if (clamp(3, 4) != 2) {
+		return 3;
+	}
+	if (wrap(1, 1) != -2146483649) {
+		return 4;
+	}
+	return 0;
+}
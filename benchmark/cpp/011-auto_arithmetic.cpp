@@ -0,0 +1,28 @@
+/* @copyright Edouard DUPIN */
+// Arithmetic loops on "auto" variables: the operator sites are quickened with the types seen at the execution
+double integrate(int steps) {
+	auto sum = 0.0;
+	auto step = 1.0 / steps;
+	for (auto iii=0; iii<steps; ++iii) {
+		auto x = (iii + 0.5) * step;
+		sum += 4.0 / (1.0 + x * x);
+	}
+	return sum * step;
+}
+int checksum(int count) {
+	auto hash = 7;
+	for (auto iii=0; iii<count; ++iii) {
+		hash = (hash * 31 + iii) % 1000003;
+	}
+	return hash;
+}
+int main() {
+	auto pi = integrate(200000);
+	if (pi < 3.14159 || pi > 3.1416) {
+		return 1;
+	}
+	if (checksum(200000) != 604574) {
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,66 @@
+/* @copyright Edouard DUPIN */
+// Dispatch loops: a dense switch (table) for the operation codes and a sparse switch (search) for the status codes
+int execute(int code, int value) {
+	switch (code) {
+		case 0: return value + 1;
+		case 1: return value - 3;
+		case 2: return value * 3;
+		case 3: return value / 2;
+		case 4: return value % 1000;
+		case 5: return value + 17;
+		case 6: return value * 7;
+		case 7: return value - 1;
+		case 8: return value + 100;
+		case 9: return value * 2;
+		case 10: return value - 11;
+		case 11: return value / 3;
+		case 12: return value + 5;
+		case 13: return value * 5;
+		case 14: return value - 7;
+		case 15: return value % 997;
+	}
+	return value;
+}
+int weight(int status) {
+	switch (status) {
+		case 100: return 1;
+		case 200: return 2;
+		case 201: return 3;
+		case 204: return 4;
+		case 301: return 5;
+		case 302: return 6;
+		case 304: return 7;
+		case 400: return 8;
+		case 401: return 9;
+		case 403: return 10;
+		case 404: return 11;
+		case 500: return 12;
+		case 502: return 13;
+		case 503: return 14;
+		default: return 0;
+	}
+	return 0;
+}
+int run(int count) {
+	int value = 1;
+	for (int iii=0; iii<count; ++iii) {
+		value = execute(iii % 16, value) % 1000003;
+	}
+	return value;
+}
+int statistic(int count) {
+	int total = 0;
+	for (int iii=0; iii<count; ++iii) {
+		total += weight(100 + (iii * 7) % 410);
+	}
+	return total;
+}
+int main() {
+	if (run(200000) != 512) {
+		return 1;
+	}
+	if (statistic(200000) != 51214) {
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,27 @@
+/* @copyright Edouard DUPIN */
+// Counted loops (native induction variable) and recursive calls in tail position (no new frame)
+int sum(int count, int total) {
+	if (count == 0) {
+		return total;
+	}
+	return sum(count - 1, (total + count) % 100003);
+}
+int main() {
+	int total = 0;
+	for (int iii=0; iii<200; ++iii) {
+		total = (total + sum(5000, iii)) % 100003;
+	}
+	if (total != 44888) {
+		return 1;
+	}
+	long checksum = 0;
+	for (int iii=0; iii<1000; ++iii) {
+		for (int jjj=0; jjj<1000; jjj+=2) {
+			checksum += jjj;
+		}
+	}
+	if (checksum != 249500000) {
+		return 2;
+	}
+	return 0;
+}
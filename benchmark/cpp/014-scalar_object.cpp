@@ -0,0 +1,57 @@
+/* @copyright Edouard DUPIN */
+// Temporary structures in a loop: the local objects are replaced by their fields (compare "objects=" of "--stat" with -O0)
+struct Vector {
+	double x;
+	double y;
+};
+struct Box {
+	int left;
+	int top;
+	int right;
+	int bottom;
+};
+double integrate(int count) {
+	double total = 0.0;
+	for (int iii=0; iii<count; ++iii) {
+		Vector position;
+		position.x = iii * 0.5;
+		position.y = iii * 0.25;
+		Vector* speed = new Vector();
+		speed->x = position.y - position.x;
+		speed->y = position.x + position.y;
+		total += position.x * speed->x + position.y * speed->y;
+		delete speed;
+	}
+	return total;
+}
+int overlap(int count) {
+	int total = 0;
+	for (int iii=0; iii<count; ++iii) {
+		Box first;
+		first.left = iii % 100;
+		first.top = iii % 50;
+		first.right = first.left + 20;
+		first.bottom = first.top + 10;
+		Box second;
+		second.left = (iii * 7) % 100;
+		second.top = (iii * 3) % 50;
+		second.right = second.left + 30;
+		second.bottom = second.top + 15;
+		if (    first.left < second.right
+		     && second.left < first.right
+		     && first.top < second.bottom
+		     && second.top < first.bottom) {
+			total += 1;
+		}
+	}
+	return total;
+}
+int main() {
+	if (integrate(200000) != 166665416668750.0) {
+		return 1;
+	}
+	if (overlap(200000) != 44000) {
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,61 @@
+/* @copyright Edouard DUPIN */
+// Array of records: the structures are stored inline in one block (compare "objects=" of "--stat" with the array of pointers)
+struct Particle {
+	double x;
+	double y;
+	double speed;
+	int hits;
+};
+double flat(int count, int steps) {
+	Particle particles[count];
+	for (int iii=0; iii<count; ++iii) {
+		particles[iii].x = iii * 0.5;
+		particles[iii].speed = (iii % 7) * 0.25;
+	}
+	for (int step=0; step<steps; ++step) {
+		for (int iii=0; iii<count; ++iii) {
+			particles[iii].x += particles[iii].speed;
+			particles[iii].y += 1.0;
+			if (particles[iii].x > 1000.0) {
+				particles[iii].x -= 1000.0;
+				++particles[iii].hits;
+			}
+		}
+	}
+	double total = 0.0;
+	for (int iii=0; iii<count; ++iii) {
+		total += particles[iii].x + particles[iii].y + particles[iii].hits;
+	}
+	return total;
+}
+double pointer(int count, int steps) {
+	Particle* particles[count];
+	for (int iii=0; iii<count; ++iii) {
+		particles[iii] = new Particle();
+		particles[iii]->x = iii * 0.5;
+		particles[iii]->speed = (iii % 7) * 0.25;
+	}
+	for (int step=0; step<steps; ++step) {
+		for (int iii=0; iii<count; ++iii) {
+			particles[iii]->x += particles[iii]->speed;
+			particles[iii]->y += 1.0;
+			if (particles[iii]->x > 1000.0) {
+				particles[iii]->x -= 1000.0;
+				++particles[iii]->hits;
+			}
+		}
+	}
+	double total = 0.0;
+	for (int iii=0; iii<count; ++iii) {
+		total += particles[iii]->x + particles[iii]->y + particles[iii]->hits;
+		delete particles[iii];
+	}
+	return total;
+}
+int main() {
+	double expected = flat(100000, 4);
+	if (pointer(100000, 4) != expected) {
+		return 1;
+	}
+	return 0;
+}
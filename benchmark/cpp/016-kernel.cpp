@@ -0,0 +1,61 @@
+/* @copyright Edouard DUPIN */
+// Reductions and element by element operations on big arrays: loops of the script against the kernels of the builtin library (see "--kernel=")
+#import <eci/kernel>
+double dotDouble(double left[], double right[]);
+double maxDouble(double values[]);
+void scaleDouble(double out[], double values[], double factor);
+void addDouble(double out[], double left[], double right[]);
+int countLessInt(int values[], int limit);
+double script(double left[], double right[], double out[], int values[], int count, int loop) {
+	double total = 0.0;
+	for (int jjj=0; jjj<loop; ++jjj) {
+		double dot = 0.0;
+		double max = left[0];
+		for (int iii=0; iii<count; ++iii) {
+			dot += left[iii] * right[iii];
+			if (left[iii] > max) {
+				max = left[iii];
+			}
+		}
+		for (int iii=0; iii<count; ++iii) {
+			out[iii] = left[iii] * 0.5 + right[iii];
+		}
+		int less = 0;
+		for (int iii=0; iii<count; ++iii) {
+			if (values[iii] < 500) {
+				less += 1;
+			}
+		}
+		total += dot + max + out[count-1] + less;
+	}
+	return total;
+}
+double kernel(double left[], double right[], double out[], int values[], int count, int loop) {
+	double total = 0.0;
+	for (int jjj=0; jjj<loop; ++jjj) {
+		double dot = dotDouble(left, right);
+		double max = maxDouble(left);
+		scaleDouble(out, left, 0.5);
+		addDouble(out, out, right);
+		int less = countLessInt(values, 500);
+		total += dot + max + out[count-1] + less;
+	}
+	return total;
+}
+int main() {
+	int count = 100000;
+	double left[count];
+	double right[count];
+	double out[count];
+	int values[count];
+	for (int iii=0; iii<count; ++iii) {
+		left[iii] = iii % 1000;
+		right[iii] = (iii % 7) * 0.5;
+		values[iii] = (iii * 37) % 1000;
+	}
+	double expected = script(left, right, out, values, count, 2);
+	if (kernel(left, right, out, values, count, 200) != expected * 100) {
+		return 1;
+	}
+	return 0;
+}
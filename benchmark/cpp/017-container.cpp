@@ -0,0 +1,66 @@
+/* @copyright Edouard DUPIN */
+// Text building and counting by key: concatenation in a loop against the builder, linear search in an array against the hash map of the builtin library
+#import <eci/container>
+string stringConcat(string left, string right);
+string stringFromInt(long value);
+bool stringEqual(string left, string right);
+int stringLength(string text);
+void builderAppend(builder out, string text);
+void builderAppendInt(builder out, long value);
+string builderToString(builder out);
+long mapAdd(map table, auto key, long delta);
+long mapGet(map table, auto key);
+int mapSize(map table);
+string concat(int count) {
+	// each concatenation copy all the previous text
+	string out = "";
+	for (int iii=0; iii<count; ++iii) {
+		out = stringConcat(out, stringFromInt(iii));
+		out = stringConcat(out, ";");
+	}
+	return out;
+}
+string build(int count) {
+	builder out;
+	for (int iii=0; iii<count; ++iii) {
+		builderAppendInt(out, iii);
+		builderAppend(out, ";");
+	}
+	return builderToString(out);
+}
+long search(int count, int nbKey) {
+	long keys[nbKey];
+	long counts[nbKey];
+	int size = 0;
+	for (int iii=0; iii<count; ++iii) {
+		long key = (iii * 7919) % nbKey;
+		int position = 0;
+		while (position < size && keys[position] != key) {
+			position += 1;
+		}
+		if (position == size) {
+			keys[size] = key;
+			counts[size] = 0;
+			size += 1;
+		}
+		counts[position] += 1;
+	}
+	return size;
+}
+long hash(int count, int nbKey) {
+	map counts;
+	for (int iii=0; iii<count; ++iii) {
+		mapAdd(counts, (iii * 7919) % nbKey, 1);
+	}
+	return mapSize(counts);
+}
+int main() {
+	int count = 3000;
+	if (stringEqual(concat(count), build(count)) == false) {
+		return 1;
+	}
+	if (search(20000, 1000) != hash(20000, 1000)) {
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,413 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Batch.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/Function.hpp>
+#include <eci/Stack.hpp>
+#include <eci/debug.hpp>
+
+eci::Value eci::Column::get(size_t _index) const {
+	switch (m_type) {
+		case eci::valueTypeBool:   return eci::Value(static_cast<const bool*>(m_data)[_index]);
+		case eci::valueTypeInt8:   return eci::Value(static_cast<const int8_t*>(m_data)[_index]);
+		case eci::valueTypeUInt8:  return eci::Value(static_cast<const uint8_t*>(m_data)[_index]);
+		case eci::valueTypeInt16:  return eci::Value(static_cast<const int16_t*>(m_data)[_index]);
+		case eci::valueTypeUInt16: return eci::Value(static_cast<const uint16_t*>(m_data)[_index]);
+		case eci::valueTypeInt32:  return eci::Value(static_cast<const int32_t*>(m_data)[_index]);
+		case eci::valueTypeUInt32: return eci::Value(static_cast<const uint32_t*>(m_data)[_index]);
+		case eci::valueTypeInt64:  return eci::Value(static_cast<const int64_t*>(m_data)[_index]);
+		case eci::valueTypeUInt64: return eci::Value(static_cast<const uint64_t*>(m_data)[_index]);
+		case eci::valueTypeFloat:  return eci::Value(static_cast<const float*>(m_data)[_index]);
+		case eci::valueTypeDouble: return eci::Value(static_cast<const double*>(m_data)[_index]);
+		default:                   break;
+	}
+	return eci::Value();
+}
+
+void eci::Column::set(size_t _index, const eci::Value& _value) {
+	switch (m_type) {
+		case eci::valueTypeBool:   static_cast<bool*>(m_data)[_index] = _value.isTrue(); break;
+		case eci::valueTypeInt8:   static_cast<int8_t*>(m_data)[_index] = _value.get<int8_t>(); break;
+		case eci::valueTypeUInt8:  static_cast<uint8_t*>(m_data)[_index] = _value.get<uint8_t>(); break;
+		case eci::valueTypeInt16:  static_cast<int16_t*>(m_data)[_index] = _value.get<int16_t>(); break;
+		case eci::valueTypeUInt16: static_cast<uint16_t*>(m_data)[_index] = _value.get<uint16_t>(); break;
+		case eci::valueTypeInt32:  static_cast<int32_t*>(m_data)[_index] = _value.get<int32_t>(); break;
+		case eci::valueTypeUInt32: static_cast<uint32_t*>(m_data)[_index] = _value.get<uint32_t>(); break;
+		case eci::valueTypeInt64:  static_cast<int64_t*>(m_data)[_index] = _value.get<int64_t>(); break;
+		case eci::valueTypeUInt64: static_cast<uint64_t*>(m_data)[_index] = _value.get<uint64_t>(); break;
+		case eci::valueTypeFloat:  static_cast<float*>(m_data)[_index] = _value.get<float>(); break;
+		case eci::valueTypeDouble: static_cast<double*>(m_data)[_index] = _value.get<double>(); break;
+		default:                   break;
+	}
+}
+
+eci::Batch::Batch(eci::Interpreter& _interpreter, const etk::String& _name) :
+  m_interpreter(_interpreter),
+  m_function(null),
+  m_return(eci::valueTypeVoid),
+  m_vectorize(true),
+  m_vectorized(false),
+  m_result(-1) {
+	if (m_interpreter.isFrozen() == true) {
+		ECI_ERROR("Can not execute a module : '" << _name << "'");
+		return;
+	}
+	int32_t id = m_interpreter.findFunction(_name);
+	if (id < 0) {
+		ECI_ERROR("Batch on an unknown function : '" << _name << "'");
+		return;
+	}
+	const eci::Function& function = *m_interpreter.getFunction(id);
+	if (function.getClass() != null) {
+		ECI_ERROR("Batch on a method is not supported : '" << _name << "'");
+		return;
+	}
+	if (    function.getReturn().size() != 1
+	     || function.getReturn()[0].getValueType() == eci::valueTypeVoid
+	     || function.getReturn()[0].getValueType() == eci::valueTypeObject) {
+		ECI_ERROR("Batch on function '" << _name << "' that does not return a native type");
+		return;
+	}
+	for (auto &it : function.getArguments()) {
+		if (    it.getValueType() == eci::valueTypeVoid
+		     || it.getValueType() == eci::valueTypeObject) {
+			ECI_ERROR("Batch on function '" << _name << "' with an argument that is not a native type : '" << it.getName() << "'");
+			return;
+		}
+		m_arguments.pushBack(it.getValueType());
+	}
+	// the lookup, the parsing and the compilation are done once for all the rows
+	if (    function.getLazyBody() != null
+	     && m_interpreter.compileFunction(function) == false) {
+		return;
+	}
+	if (    function.getBody() == null
+	     && function.getNative() == null) {
+		ECI_ERROR("Batch on a function without body : '" << _name << "'");
+		return;
+	}
+	if (    function.getNative() == null
+	     && function.getJitState() == eci::jitStateNone
+	     && m_interpreter.getJit().getEnable() == true
+	     && m_arguments.size() <= size_t(eci::Jit::maxArgument)) {
+		m_interpreter.getJit().compile(m_interpreter, function);
+	}
+	m_return = function.getReturn()[0].getValueType();
+	m_function = &function;
+	vectorize();
+}
+
+eci::Batch::~Batch() {
+	
+}
+
+void eci::Batch::vectorize() {
+	if (    m_function->getBody() == null
+	     || m_function->getBody()->m_actions.size() != 1) {
+		return;
+	}
+	if (    m_return != eci::valueTypeInt32
+	     && m_return != eci::valueTypeInt64
+	     && m_return != eci::valueTypeFloat
+	     && m_return != eci::valueTypeDouble) {
+		return;
+	}
+	for (auto &it : m_arguments) {
+		if (it != m_return) {
+			return;
+		}
+	}
+	ememory::SharedPtr<eci::interpreter::Return> action = ememory::dynamicPointerCast<eci::interpreter::Return>(m_function->getBody()->m_actions[0]);
+	if (    action == null
+	     || action->m_value == null) {
+		return;
+	}
+	// the registers of the constants are set after the compilation (they follow the arguments)
+	m_result = addExpression(action->m_value, m_return);
+	if (m_result == -1) {
+		m_constants.clear();
+		m_operations.clear();
+		return;
+	}
+	m_vectorized = true;
+}
+
+/**
+ * @brief Register of an element of the expression: the arguments are the registers [0, nbArgument[,
+ * the constants and the operations are tagged with their index until the end of the compilation (see @ref getRegister).
+ */
+static const int32_t constantTag = 0x40000000;
+static const int32_t operationTag = 0x20000000;
+
+int32_t eci::Batch::addExpression(const ememory::SharedPtr<eci::interpreter::Element>& _element, enum eci::valueType _type) {
+	if (_element == null) {
+		return -1;
+	}
+	ememory::SharedPtr<eci::interpreter::Variable> variable = ememory::dynamicPointerCast<eci::interpreter::Variable>(_element);
+	if (variable != null) {
+		if (    variable->m_global == true
+		     || variable->m_slot < 0
+		     || variable->m_slot >= int32_t(m_arguments.size())) {
+			return -1;
+		}
+		return variable->m_slot;
+	}
+	ememory::SharedPtr<eci::interpreter::Constant> constant = ememory::dynamicPointerCast<eci::interpreter::Constant>(_element);
+	if (constant != null) {
+		if (    constant->m_value.m_type == eci::valueTypeVoid
+		     || constant->m_value.m_type == eci::valueTypeObject
+		     || eci::getCommonType(_type, constant->m_value.m_type) != _type) {
+			return -1;
+		}
+		m_constants.pushBack(constant->m_value.convert(_type));
+		return constantTag | int32_t(m_constants.size()-1);
+	}
+	ememory::SharedPtr<eci::interpreter::Operator> op = ememory::dynamicPointerCast<eci::interpreter::Operator>(_element);
+	if (op == null) {
+		return -1;
+	}
+	switch (op->m_operatorId) {
+		case eci::operatorAdd:
+		case eci::operatorSub:
+		case eci::operatorMul:
+			break;
+		case eci::operatorDiv:
+			// integer division can fail (division by 0): it stay in the interpreter
+			if (    _type != eci::valueTypeFloat
+			     && _type != eci::valueTypeDouble) {
+				return -1;
+			}
+			break;
+		default:
+			return -1;
+	}
+	int32_t left = addExpression(op->m_left, _type);
+	if (left == -1) {
+		return -1;
+	}
+	int32_t right = addExpression(op->m_right, _type);
+	if (right == -1) {
+		return -1;
+	}
+	m_operations.pushBack(eci::Batch::Operation(op->m_operatorId, left, right));
+	return operationTag | int32_t(m_operations.size()-1);
+}
+
+/**
+ * @brief Get the final register of an element of the expression.
+ * @param[in] _register Register returned by the compilation.
+ * @param[in] _nbArgument Number of argument of the function.
+ * @param[in] _nbConstant Number of constant of the expression.
+ * @return Index of the register (arguments, constants then operations).
+ */
+static int32_t getRegister(int32_t _register, int32_t _nbArgument, int32_t _nbConstant) {
+	if ((_register & constantTag) != 0) {
+		return _nbArgument + (_register & ~constantTag);
+	}
+	if ((_register & operationTag) != 0) {
+		return _nbArgument + _nbConstant + (_register & ~operationTag);
+	}
+	return _register;
+}
+
+/**
+ * @brief Execute an operation on a block of rows (simple loop that the compiler vectorize).
+ */
+template<typename T>
+static void executeOperation(enum eci::operatorId _operator, const T* _left, const T* _right, T* _out, size_t _size) {
+	switch (_operator) {
+		case eci::operatorAdd:
+			for (size_t iii=0; iii<_size; ++iii) {
+				_out[iii] = eci::typeAdd<T>(_left[iii], _right[iii]);
+			}
+			break;
+		case eci::operatorSub:
+			for (size_t iii=0; iii<_size; ++iii) {
+				_out[iii] = eci::typeSub<T>(_left[iii], _right[iii]);
+			}
+			break;
+		case eci::operatorMul:
+			for (size_t iii=0; iii<_size; ++iii) {
+				_out[iii] = eci::typeMul<T>(_left[iii], _right[iii]);
+			}
+			break;
+		case eci::operatorDiv:
+			for (size_t iii=0; iii<_size; ++iii) {
+				_out[iii] = _left[iii] / _right[iii];
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * @brief Execute the vectorized expression on all the rows.
+ * @param[in] _inputs Columns of the arguments.
+ * @param[out] _output Column of the results.
+ * @param[in] _constants Constants of the expression.
+ * @param[in] _operations Operations of the expression.
+ * @param[in] _result Register of the result.
+ */
+template<typename T>
+static void executeExpression(const etk::Vector<eci::Column>& _inputs,
+                              eci::Column& _output,
+                              const etk::Vector<eci::Value>& _constants,
+                              const etk::Vector<eci::Batch::Operation>& _operations,
+                              int32_t _result) {
+	int32_t nbArgument = _inputs.size();
+	int32_t nbConstant = _constants.size();
+	const size_t blockSize = eci::Batch::blockSize;
+	// the constants and the intermediate results are blocks of the working memory (the arguments are read in the columns)
+	etk::Vector<T> memory;
+	memory.resize((_constants.size() + _operations.size()) * blockSize);
+	for (size_t iii=0; iii<_constants.size(); ++iii) {
+		T value = _constants[iii].get<T>();
+		for (size_t jjj=0; jjj<blockSize; ++jjj) {
+			memory[iii*blockSize + jjj] = value;
+		}
+	}
+	etk::Vector<const T*> registers;
+	registers.resize(nbArgument + nbConstant + _operations.size());
+	for (size_t iii=nbArgument; iii<registers.size(); ++iii) {
+		registers[iii] = &memory[(iii-nbArgument) * blockSize];
+	}
+	int32_t result = getRegister(_result, nbArgument, nbConstant);
+	T* out = static_cast<T*>(_output.m_data);
+	for (size_t offset=0; offset<_output.m_size; offset+=blockSize) {
+		size_t size = etk::min(blockSize, _output.m_size-offset);
+		for (int32_t iii=0; iii<nbArgument; ++iii) {
+			registers[iii] = static_cast<const T*>(_inputs[iii].m_data) + offset;
+		}
+		for (size_t iii=0; iii<_operations.size(); ++iii) {
+			int32_t id = nbArgument + nbConstant + iii;
+			// the last operation write directly in the output column
+			T* destination = (id == result) ? out + offset : &memory[(nbConstant+iii) * blockSize];
+			executeOperation<T>(_operations[iii].m_operator,
+			                    registers[getRegister(_operations[iii].m_left, nbArgument, nbConstant)],
+			                    registers[getRegister(_operations[iii].m_right, nbArgument, nbConstant)],
+			                    destination,
+			                    size);
+		}
+		if (result < nbArgument + nbConstant) {
+			// "return a;" or "return 3;"
+			for (size_t iii=0; iii<size; ++iii) {
+				out[offset+iii] = registers[result][iii];
+			}
+		}
+	}
+}
+
+bool eci::Batch::runVectorized(const etk::Vector<eci::Column>& _inputs, eci::Column& _output) {
+	switch (m_return) {
+		case eci::valueTypeInt32:
+			executeExpression<int32_t>(_inputs, _output, m_constants, m_operations, m_result);
+			return true;
+		case eci::valueTypeInt64:
+			executeExpression<int64_t>(_inputs, _output, m_constants, m_operations, m_result);
+			return true;
+		case eci::valueTypeFloat:
+			executeExpression<float>(_inputs, _output, m_constants, m_operations, m_result);
+			return true;
+		case eci::valueTypeDouble:
+			executeExpression<double>(_inputs, _output, m_constants, m_operations, m_result);
+			return true;
+		default:
+			break;
+	}
+	return false;
+}
+
+bool eci::Batch::runRows(const etk::Vector<eci::Column>& _inputs, eci::Column& _output) {
+	const eci::Function& function = *m_function;
+	size_t nbArgument = m_arguments.size();
+	if (function.getJitState() == eci::jitStateCompiled) {
+		int64_t arguments[eci::Jit::maxArgument];
+		eci::jitEntry entry = *function.getJitEntryAddress();
+		for (size_t row=0; row<_output.m_size; ++row) {
+			for (size_t iii=0; iii<nbArgument; ++iii) {
+				arguments[iii] = eci::Jit::toRaw(_inputs[iii].get(row));
+			}
+			_output.set(row, eci::Jit::fromRaw(entry(arguments, &m_interpreter, &function), m_return));
+		}
+		return true;
+	}
+	eci::Stack& stack = m_interpreter.getStack();
+	// one window and one frame for all the rows
+	size_t base = stack.reserve(function.getFrameSize());
+	if (function.getNative() != null) {
+		for (size_t row=0; row<_output.m_size; ++row) {
+			for (size_t iii=0; iii<nbArgument; ++iii) {
+				stack.get(base+iii) = _inputs[iii].get(row);
+			}
+			_output.set(row, function.getNative()->call(m_interpreter, base));
+		}
+		stack.release(base);
+		return true;
+	}
+	eci::Frame* frame = stack.pushFrame();
+	if (frame == null) {
+		ECI_ERROR("Max call depth reached in : '" << function.getName() << "'");
+		stack.release(base);
+		return false;
+	}
+	frame->m_interpreter = &m_interpreter;
+	frame->m_stack = &stack;
+	frame->m_function = &function;
+	frame->m_base = base;
+	for (size_t row=0; row<_output.m_size; ++row) {
+		for (size_t iii=0; iii<nbArgument; ++iii) {
+			stack.get(base+iii) = _inputs[iii].get(row);
+		}
+		// the locals of the previous row can reference a released object (the slots are roots of the collector)
+		for (size_t iii=nbArgument; iii<size_t(function.getFrameSize()); ++iii) {
+			stack.get(base+iii) = eci::Value();
+		}
+		frame->m_return = eci::Value();
+		// safe point of the profiler
+		if (m_interpreter.getProfiler().isPending() == true) {
+			m_interpreter.getProfiler().sample(stack);
+		}
+		function.executeBody(*frame);
+		_output.set(row, frame->m_return);
+	}
+	stack.popFrame();
+	stack.release(base);
+	return true;
+}
+
+bool eci::Batch::run(const etk::Vector<eci::Column>& _inputs, eci::Column& _output) {
+	if (m_function == null) {
+		ECI_ERROR("Batch on a function that is not bound");
+		return false;
+	}
+	if (_inputs.size() != m_arguments.size()) {
+		ECI_ERROR("Batch on function '" << m_function->getName() << "' with " << _inputs.size() << " columns for " << m_arguments.size() << " arguments");
+		return false;
+	}
+	for (size_t iii=0; iii<_inputs.size(); ++iii) {
+		if (_inputs[iii].m_type != m_arguments[iii]) {
+			ECI_ERROR("Batch on function '" << m_function->getName() << "' column " << iii << " is '" << eci::getValueTypeName(_inputs[iii].m_type)
+			          << "' for an argument '" << eci::getValueTypeName(m_arguments[iii]) << "'");
+			return false;
+		}
+		if (_inputs[iii].m_size != _output.m_size) {
+			ECI_ERROR("Batch on function '" << m_function->getName() << "' column " << iii << " has " << _inputs[iii].m_size << " rows for " << _output.m_size);
+			return false;
+		}
+	}
+	if (_output.m_type != m_return) {
+		ECI_ERROR("Batch on function '" << m_function->getName() << "' output column is '" << eci::getValueTypeName(_output.m_type)
+		          << "' for a return '" << eci::getValueTypeName(m_return) << "'");
+		return false;
+	}
+	if (isVectorized() == true) {
+		return runVectorized(_inputs, _output);
+	}
+	return runRows(_inputs, _output);
+}
+
@@ -0,0 +1,147 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/String.hpp>
+#include <etk/Vector.hpp>
+#include <eci/Value.hpp>
+#include <eci/Type.hpp>
+#include <eci/interpreter/Element.hpp>
+#include <ememory/memory.hpp>
+
+namespace eci {
+	class Interpreter;
+	class Function;
+	/**
+	 * @brief Array of native values of one type (a column of records): the data is owned by the caller.
+	 */
+	class Column {
+		public:
+			enum eci::valueType m_type; //!< Type of the values (no object).
+			void* m_data; //!< First value.
+			size_t m_size; //!< Number of values.
+		public:
+			Column(enum eci::valueType _type=eci::valueTypeVoid, void* _data=null, size_t _size=0) :
+			  m_type(_type),
+			  m_data(_data),
+			  m_size(_size) {
+				
+			}
+			/**
+			 * @brief Create a column on a C array.
+			 * @param[in] _data First value (bool, int8_t ... double).
+			 * @param[in] _size Number of values.
+			 * @return The column (the type is the type of the value).
+			 */
+			template<typename T> static Column wrap(T* _data, size_t _size) {
+				return Column(eci::Value(T()).m_type, _data, _size);
+			}
+			template<typename T> static Column wrap(const T* _data, size_t _size) {
+				return Column(eci::Value(T()).m_type, const_cast<T*>(_data), _size);
+			}
+			/**
+			 * @brief Get a value of the column.
+			 * @param[in] _index Index of the value.
+			 * @return The value (in the type of the column).
+			 */
+			eci::Value get(size_t _index) const;
+			/**
+			 * @brief Set a value of the column.
+			 * @param[in] _index Index of the value.
+			 * @param[in] _value Value (converted in the type of the column).
+			 */
+			void set(size_t _index, const eci::Value& _value);
+	};
+	/**
+	 * @brief Execution of a script function on columns of records: the function is bound once (found, compiled and checked)
+	 * and the call is repeated on each row without search, conversion object or frame allocation.
+	 * When the body of the function is an arithmetic expression of its arguments ("return a*b + c;" with the same type
+	 * for all the arguments and the return: int32, int64, float or double), it is executed operation by operation on
+	 * blocks of rows with loops that the C++ compiler vectorize (SIMD). Else the rows are executed by the native code
+	 * of the JIT (when it is enabled and the function can be compiled) or by the interpreter.
+	 */
+	class Batch {
+		public:
+			static const size_t blockSize = 256; //!< Number of rows computed by an operation of the vectorized expression.
+			/**
+			 * @brief Operation of the vectorized expression: register = left operator right.
+			 */
+			class Operation {
+				public:
+					enum eci::operatorId m_operator; //!< Arithmetic operator.
+					int32_t m_left; //!< Register of the left operand.
+					int32_t m_right; //!< Register of the right operand.
+				public:
+					Operation(enum eci::operatorId _operator=eci::operatorNone, int32_t _left=0, int32_t _right=0) :
+					  m_operator(_operator),
+					  m_left(_left),
+					  m_right(_right) {
+						
+					}
+			};
+		private:
+			eci::Interpreter& m_interpreter; //!< Interpreter that own the function.
+			const eci::Function* m_function; //!< Bound function (null on error).
+			etk::Vector<enum eci::valueType> m_arguments; //!< Types of the arguments (type of the input columns).
+			enum eci::valueType m_return; //!< Type of the return (type of the output column).
+			bool m_vectorize; //!< Use the vectorized expression when it exist.
+			// Vectorized expression: the registers are the arguments, then the constants, then the result of each operation.
+			bool m_vectorized; //!< The body is an arithmetic expression of the arguments.
+			etk::Vector<eci::Value> m_constants; //!< Constants of the expression (in the type of the function).
+			etk::Vector<eci::Batch::Operation> m_operations; //!< Operations in the execution order.
+			int32_t m_result; //!< Register of the result.
+		public:
+			/**
+			 * @brief Bind a function.
+			 * @param[in] _interpreter Interpreter that own the function (the global variables must be initialized, see @ref eci::Interpreter::main).
+			 * @param[in] _name Name of the function (native type arguments and return).
+			 */
+			Batch(eci::Interpreter& _interpreter, const etk::String& _name);
+			~Batch();
+			bool isValid() const {
+				return m_function != null;
+			}
+			/**
+			 * @brief Check if the function is executed by the vectorized expression.
+			 * @return true if the body is an arithmetic expression of the arguments.
+			 */
+			bool isVectorized() const {
+				return    m_vectorized == true
+				       && m_vectorize == true;
+			}
+			/**
+			 * @brief Select the execution of the vectorized expression (to compare with the execution row by row).
+			 * @param[in] _value true to use the vectorized expression when it exist (default).
+			 */
+			void setVectorize(bool _value) {
+				m_vectorize = _value;
+			}
+			/**
+			 * @brief Execute the function on each row: _output[i] = function(_inputs[0][i], _inputs[1][i] ...).
+			 * @param[in] _inputs One column per argument (in the type of the argument, same size as the output).
+			 * @param[in,out] _output Column of the results (in the return type of the function).
+			 * @return true if all the rows are executed.
+			 */
+			bool run(const etk::Vector<eci::Column>& _inputs, eci::Column& _output);
+		private:
+			/**
+			 * @brief Create the vectorized expression of the function body (if possible).
+			 */
+			void vectorize();
+			/**
+			 * @brief Add an element of the expression.
+			 * @param[in] _element Element of the body.
+			 * @param[in] _type Type of the expression.
+			 * @return Register of the value of the element (-1 if the element can not be vectorized).
+			 */
+			int32_t addExpression(const ememory::SharedPtr<eci::interpreter::Element>& _element, enum eci::valueType _type);
+			bool runVectorized(const etk::Vector<eci::Column>& _inputs, eci::Column& _output);
+			bool runRows(const etk::Vector<eci::Column>& _inputs, eci::Column& _output);
+	};
+}
+
@@ -5,5 +5,129 @@
  */
 
 #include <eci/Class.hpp>
+#include <eci/Interpreter.hpp>
 #include <eci/debug.hpp>
 
+eci::Class::Class(const etk::String& _name) :
+  m_name(_name),
+  m_parent(null),
+  m_defined(false) {
+	
+}
+
+eci::Class::~Class() {
+	
+}
+
+bool eci::Class::define(const eci::Interpreter& _interpreter) {
+	m_layout.clear();
+	m_methodTable.clear();
+	m_parent = null;
+	if (m_parentName != "") {
+		m_parent = _interpreter.findClass(m_parentName);
+		if (    m_parent == null
+		     || m_parent->isDefined() == false) {
+			ECI_ERROR("Class '" << m_name << "' : parent class '" << m_parentName << "' is not defined");
+			return false;
+		}
+		m_layout = m_parent->m_layout;
+		m_methodTable = m_parent->m_methodTable;
+	}
+	if (isArray() == true) {
+		return defineArray(_interpreter);
+	}
+	for (auto &it : m_fields) {
+		for (size_t iii=(m_parent == null ? 0 : m_parent->m_layout.size()); iii<m_layout.size(); ++iii) {
+			if (m_layout[iii].m_name == it.getName()) {
+				ECI_ERROR("Class '" << m_name << "' : field '" << it.getName() << "' already defined");
+				return false;
+			}
+		}
+		const eci::Class* type = null;
+		if (    it.getValueType() == eci::valueTypeObject
+		     && it.getTypeName().endWith("*") == false) {
+			type = _interpreter.findClass(it.getTypeName());
+			if (    type == null
+			     || type->isDefined() == false) {
+				ECI_ERROR("Class '" << m_name << "' : field '" << it.getName() << "' has an incomplete type '" << it.getTypeName() << "'");
+				return false;
+			}
+		}
+		m_layout.pushBack(eci::Class::Field(it.getName(), it.getValueType(), type));
+	}
+	for (auto &it : m_methods) {
+		int32_t id = _interpreter.findFunction(it->getName());
+		if (id < 0) {
+			ECI_ERROR("Class '" << m_name << "' : method '" << it->getName() << "' is not registered");
+			return false;
+		}
+		// the name of the function is "Class::method"
+		etk::String name(it->getName(), m_name.size()+2, it->getName().size()-(m_name.size()+2));
+		bool find = false;
+		for (auto &itTable : m_methodTable) {
+			if (itTable.first == name) {
+				itTable.second = id;
+				find = true;
+				break;
+			}
+		}
+		if (find == false) {
+			m_methodTable.pushBack(etk::makePair(name, id));
+		}
+	}
+	m_defined = true;
+	ECI_DEBUG("Define class '" << m_name << "' fields=" << m_layout.size() << " methods=" << m_methodTable.size());
+	return true;
+}
+
+bool eci::Class::defineArray(const eci::Interpreter& _interpreter) {
+	enum eci::valueType type = eci::getValueType(m_elementTypeName);
+	if (type == eci::valueTypeVoid) {
+		ECI_ERROR("Array '" << m_name << "' : an element can not be void");
+		return false;
+	}
+	if (    type != eci::valueTypeObject
+	     || m_elementTypeName.endWith("*") == true) {
+		// native value or reference
+		m_layout.pushBack(eci::Class::Field("", type, null));
+		m_defined = true;
+		return true;
+	}
+	const eci::Class* element = _interpreter.findClass(m_elementTypeName);
+	if (    element == null
+	     || element->isDefined() == false
+	     || element->isArray() == true
+	     || element->m_layout.size() == 0) {
+		ECI_ERROR("Array '" << m_name << "' : unknow element type '" << m_elementTypeName << "' (or structure without field)");
+		return false;
+	}
+	for (auto &it : element->m_layout) {
+		if (it.m_class != null) {
+			ECI_ERROR("Array '" << m_name << "' : the field '" << it.m_name << "' of the elements is an object (only the native fields are stored in the array)");
+			return false;
+		}
+	}
+	// the elements are stored with the layout of the structure (the fields are found by name)
+	m_layout = element->m_layout;
+	m_defined = true;
+	return true;
+}
+
+int32_t eci::Class::findField(const etk::String& _name) const {
+	// the last field hide the field of the parent with the same name
+	for (int32_t iii=int32_t(m_layout.size())-1; iii>=0; --iii) {
+		if (m_layout[iii].m_name == _name) {
+			return iii;
+		}
+	}
+	return -1;
+}
+
+int32_t eci::Class::findMethod(const etk::String& _name) const {
+	for (auto &it : m_methodTable) {
+		if (it.first == _name) {
+			return it.second;
+		}
+	}
+	return -1;
+}
@@ -7,11 +7,141 @@
 #pragma once
 
 #include <etk/types.hpp>
+#include <etk/Pair.hpp>
+#include <etk/Vector.hpp>
+#include <ememory/memory.hpp>
+#include <eci/Value.hpp>
+#include <eci/Variable.hpp>
 
 namespace eci {
+	class Interpreter;
+	class Function;
+	/**
+	 * @brief Definition of a class. When the class is defined, the fields get a fixed layout (offset of the field
+	 * in the instance, the fields of the parent first) and the methods a method table (index of the function
+	 * in the interpreter, a method of the parent with the same name is overridden).
+	 * An array "xxx[]" is a class without method: its layout is the layout of one element (a native value or the fields
+	 * of a structure) and an instance store all its elements in its fields, one after the other (the element N start
+	 * at the field N * stride): an array of structures is one block of the heap, without an object per element.
+	 */
 	class Class {
 		public:
-			Class() {};
-			~Class() {};
+			/**
+			 * @brief Field in the layout of an instance.
+			 */
+			class Field {
+				public:
+					etk::String m_name; //!< Name of the field.
+					enum eci::valueType m_valueType; //!< Type of the field.
+					const eci::Class* m_class; //!< Class of the field (null for a native type).
+				public:
+					Field(const etk::String& _name="", enum eci::valueType _valueType=eci::valueTypeVoid, const eci::Class* _class=null) :
+					  m_name(_name),
+					  m_valueType(_valueType),
+					  m_class(_class) {
+						
+					}
+			};
+		public:
+			Class(const etk::String& _name="");
+			~Class();
+		protected:
+			etk::String m_name; //!< Name of the class.
+			etk::String m_parentName; //!< Name of the parent class ("" if none).
+			const eci::Class* m_parent; //!< Parent class (set when the class is defined).
+			etk::Vector<eci::Variable> m_fields; //!< Fields declared in the class.
+			etk::Vector<ememory::SharedPtr<eci::Function>> m_methods; //!< Methods declared in the class.
+			etk::Vector<eci::Class::Field> m_layout; //!< Layout of an instance: index is the offset of the field.
+			etk::Vector<etk::Pair<etk::String, int32_t>> m_methodTable; //!< All the methods of the class (name, index of the function).
+			etk::String m_elementTypeName; //!< Type of the elements of an array ("" if the class is not an array).
+			bool m_defined; //!< The layout and the method table are computed.
+		public:
+			const etk::String& getName() const {
+				return m_name;
+			}
+			void setName(const etk::String& _name) {
+				m_name = _name;
+			}
+			const etk::String& getParentName() const {
+				return m_parentName;
+			}
+			void setParentName(const etk::String& _name) {
+				m_parentName = _name;
+			}
+			const eci::Class* getParent() const {
+				return m_parent;
+			}
+			const etk::String& getElementTypeName() const {
+				return m_elementTypeName;
+			}
+			/**
+			 * @brief Make the class an array (must be set before @ref define).
+			 * @param[in] _typeName Type of the elements: native type, pointer or structure with only native fields.
+			 */
+			void setElementTypeName(const etk::String& _typeName) {
+				m_elementTypeName = _typeName;
+			}
+			bool isArray() const {
+				return m_elementTypeName != "";
+			}
+			/**
+			 * @brief Get the number of fields of an element of an array.
+			 * @return Distance between 2 elements in the fields of an instance.
+			 */
+			size_t getStride() const {
+				return m_layout.size();
+			}
+			/**
+			 * @brief Check if the elements of the array are structures (stored inline) and not values (native or pointer).
+			 * @return true if an element is accessed by its fields.
+			 */
+			bool isStructureArray() const {
+				return    isArray() == true
+				       && m_layout.size() != 0
+				       && m_layout[0].m_name != "";
+			}
+			const etk::Vector<eci::Variable>& getFields() const {
+				return m_fields;
+			}
+			void addField(const eci::Variable& _value) {
+				m_fields.pushBack(_value);
+			}
+			const etk::Vector<ememory::SharedPtr<eci::Function>>& getMethods() const {
+				return m_methods;
+			}
+			void addMethod(const ememory::SharedPtr<eci::Function>& _value) {
+				m_methods.pushBack(_value);
+			}
+			const etk::Vector<eci::Class::Field>& getLayout() const {
+				return m_layout;
+			}
+			bool isDefined() const {
+				return m_defined;
+			}
+			/**
+			 * @brief Compute the layout and the method table (the parent must be defined and the methods registered in the interpreter).
+			 * @param[in] _interpreter Interpreter that own the classes and the functions.
+			 * @return true if the class is valid.
+			 */
+			bool define(const eci::Interpreter& _interpreter);
+			/**
+			 * @brief Get the offset of a field (slow path, by name).
+			 * @param[in] _name Name of the field.
+			 * @return Offset of the field in the instance or -1 if not found.
+			 */
+			int32_t findField(const etk::String& _name) const;
+			/**
+			 * @brief Get the function of a method (slow path, by name).
+			 * @param[in] _name Name of the method (without the class name).
+			 * @return Index of the function in the interpreter or -1 if not found.
+			 */
+			int32_t findMethod(const etk::String& _name) const;
+		private:
+			/**
+			 * @brief Compute the layout of an element of an array.
+			 * @param[in] _interpreter Interpreter that own the classes.
+			 * @return true if the type of the elements is valid.
+			 */
+			bool defineArray(const eci::Interpreter& _interpreter);
 	};
 }
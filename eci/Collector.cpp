@@ -0,0 +1,276 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Collector.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/Stack.hpp>
+#include <eci/Heap.hpp>
+#include <eci/debug.hpp>
+#include <chrono>
+
+/**
+ * @brief Get the duration since a time.
+ * @param[in] _start Start time.
+ * @return Duration in microseconds.
+ */
+static int64_t getDuration(const std::chrono::steady_clock::time_point& _start) {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count();
+}
+
+eci::Collector::Collector() :
+  m_enable(false),
+  m_state(eci::collectorStateIdle),
+  m_epoch(1),
+  m_sweepDeadPos(0),
+  m_sweeper(null),
+  m_sweepDone(false),
+  m_concurrentSweep(true),
+  m_sizeManaged(0),
+  m_minThreshold(256*1024),
+  m_threshold(256*1024),
+  m_stepSize(16*1024),
+  m_sizeSinceStep(0),
+  m_budget(500),
+  m_nbCycle(0),
+  m_nbCollected(0),
+  m_sizeCollected(0),
+  m_nbPause(0),
+  m_pauseMax(0),
+  m_pauseTotal(0) {
+	for (int32_t iii=0; iii<nbHistogram; ++iii) {
+		m_histogram[iii] = 0;
+	}
+}
+
+eci::Collector::~Collector() {
+	// the blocks are released with the heap
+	if (m_sweeper != null) {
+		m_sweeper->join();
+		delete m_sweeper;
+		m_sweeper = null;
+	}
+}
+
+void eci::Collector::add(eci::Object* _object) {
+	size_t size = eci::Object::getSize(_object->m_nbField);
+	_object->m_managed = true;
+	// marked by the current cycle: an object created during the marking is not collected by the cycle
+	_object->m_mark = m_epoch;
+	m_objects.pushBack(_object);
+	m_sizeManaged += size;
+	m_sizeSinceStep += size;
+}
+
+void eci::Collector::shade(eci::Object* _object) {
+	if (    _object == null
+	     || _object->m_mark == m_epoch) {
+		return;
+	}
+	_object->m_mark = m_epoch;
+	// a deleted object is kept while it is referenced (the access report an error), but its fields are not used
+	if (_object->m_fields != null) {
+		m_gray.pushBack(_object);
+	}
+}
+
+void eci::Collector::scanRoots(eci::Interpreter& _interpreter) {
+	// the slots of a window are cleared at the reservation: all the slots under the top are valid
+	eci::Stack& stack = _interpreter.getStack();
+	for (size_t iii=0; iii<stack.getTop(); ++iii) {
+		const eci::Value& value = stack.get(iii);
+		if (value.m_type == eci::valueTypeObject) {
+			shade(value.m_object);
+		}
+	}
+	for (size_t iii=0; iii<stack.getDepth(); ++iii) {
+		const eci::Value& value = stack.getFrame(iii).m_return;
+		if (value.m_type == eci::valueTypeObject) {
+			shade(value.m_object);
+		}
+	}
+	for (size_t iii=0; iii<_interpreter.getNbGlobal(); ++iii) {
+		const eci::Value& value = _interpreter.getGlobal(iii);
+		if (value.m_type == eci::valueTypeObject) {
+			shade(value.m_object);
+		}
+	}
+	for (size_t iii=0; iii<_interpreter.getNbLiteral(); ++iii) {
+		const eci::Value& value = _interpreter.getLiteralValue(iii);
+		if (value.m_type == eci::valueTypeObject) {
+			shade(value.m_object);
+		}
+	}
+	if (_interpreter.getInternTable().m_type == eci::valueTypeObject) {
+		shade(_interpreter.getInternTable().m_object);
+	}
+	if (_interpreter.getReturnValue().m_type == eci::valueTypeObject) {
+		shade(_interpreter.getReturnValue().m_object);
+	}
+}
+
+bool eci::Collector::mark(int64_t _budget) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	size_t count = 0;
+	while (m_gray.size() != 0) {
+		eci::Object* object = m_gray.back();
+		m_gray.popBack();
+		// deleted after its marking: the fields are not used anymore
+		if (object->m_fields == null) {
+			continue;
+		}
+		for (size_t iii=0; iii<object->m_nbField; ++iii) {
+			if (object->m_fields[iii].m_type == eci::valueTypeObject) {
+				shade(object->m_fields[iii].m_object);
+			}
+		}
+		// the clock is read every 64 objects
+		if (    _budget >= 0
+		     && (++count & 63) == 0
+		     && getDuration(start) >= _budget) {
+			return m_gray.size() == 0;
+		}
+	}
+	return true;
+}
+
+void eci::Collector::finishMark(eci::Interpreter& _interpreter) {
+	// the roots are not protected by the write barrier
+	scanRoots(_interpreter);
+	mark(-1);
+	m_sweepList = m_objects;
+	m_objects.clear();
+	m_state = eci::collectorStateSweep;
+	m_sweepDone = false;
+	if (m_concurrentSweep == true) {
+		// the objects of the list are not modified by the interpreter until the end of the cycle (no marking, no release)
+		m_sweeper = new std::thread([this]() {
+			sweep();
+			m_sweepDone = true;
+		});
+	} else {
+		sweep();
+		m_sweepDone = true;
+	}
+}
+
+void eci::Collector::sweep() {
+	for (auto &it : m_sweepList) {
+		if (it->m_mark == m_epoch) {
+			m_sweepLive.pushBack(it);
+		} else {
+			m_sweepDead.pushBack(it);
+		}
+	}
+	m_sweepList.clear();
+}
+
+bool eci::Collector::release(eci::Heap& _heap, int64_t _budget) {
+	if (m_sweeper != null) {
+		m_sweeper->join();
+		delete m_sweeper;
+		m_sweeper = null;
+	}
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	while (m_sweepDeadPos < m_sweepDead.size()) {
+		eci::Object* object = m_sweepDead[m_sweepDeadPos++];
+		size_t size = eci::Object::getSize(object->m_nbField);
+		m_sizeManaged -= size;
+		m_sizeCollected += size;
+		++m_nbCollected;
+		object->m_class = null;
+		object->m_fields = null;
+		_heap.release(object, size);
+		// the clock is read every 256 objects
+		if (    _budget >= 0
+		     && (m_sweepDeadPos & 255) == 0
+		     && getDuration(start) >= _budget) {
+			return false;
+		}
+	}
+	for (auto &it : m_sweepLive) {
+		m_objects.pushBack(it);
+	}
+	m_sweepLive.clear();
+	m_sweepDead.clear();
+	m_sweepDeadPos = 0;
+	m_threshold = etk::max(m_minThreshold, m_sizeManaged*2);
+	m_state = eci::collectorStateIdle;
+	++m_nbCycle;
+	ECI_DEBUG("GC cycle " << m_nbCycle << " : " << m_objects.size() << " objects alive (" << m_sizeManaged << " bytes)");
+	return true;
+}
+
+void eci::Collector::step(eci::Interpreter& _interpreter) {
+	switch (m_state) {
+		case eci::collectorStateIdle: {
+			if (m_sizeManaged < m_threshold) {
+				return;
+			}
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			// all the objects become not marked
+			++m_epoch;
+			m_state = eci::collectorStateMark;
+			m_sizeSinceStep = 0;
+			scanRoots(_interpreter);
+			addPause(getDuration(start));
+			return;
+		}
+		case eci::collectorStateMark: {
+			if (m_sizeSinceStep < m_stepSize) {
+				return;
+			}
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			m_sizeSinceStep = 0;
+			if (mark(m_budget) == true) {
+				finishMark(_interpreter);
+			}
+			addPause(getDuration(start));
+			return;
+		}
+		case eci::collectorStateSweep: {
+			if (m_sweepDone == false) {
+				return;
+			}
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			release(_interpreter.getHeap(), m_budget);
+			addPause(getDuration(start));
+			return;
+		}
+	}
+}
+
+void eci::Collector::collect(eci::Interpreter& _interpreter) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	// finish the current cycle: the objects allocated during its marking are not collected by it
+	if (m_state == eci::collectorStateMark) {
+		mark(-1);
+		finishMark(_interpreter);
+	}
+	if (m_state == eci::collectorStateSweep) {
+		release(_interpreter.getHeap(), -1);
+	}
+	++m_epoch;
+	m_state = eci::collectorStateMark;
+	scanRoots(_interpreter);
+	mark(-1);
+	finishMark(_interpreter);
+	release(_interpreter.getHeap(), -1);
+	addPause(getDuration(start));
+}
+
+void eci::Collector::addPause(int64_t _duration) {
+	++m_nbPause;
+	m_pauseTotal += _duration;
+	m_pauseMax = etk::max(m_pauseMax, _duration);
+	int32_t id = 0;
+	int64_t limit = 10;
+	while (    id < nbHistogram-1
+	        && _duration >= limit) {
+		++id;
+		limit *= 10;
+	}
+	++m_histogram[id];
+}
@@ -0,0 +1,201 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/Vector.hpp>
+#include <eci/Value.hpp>
+#include <eci/Object.hpp>
+#include <thread>
+#include <atomic>
+
+namespace eci {
+	class Interpreter;
+	class Heap;
+	/**
+	 * @brief State of a collection cycle.
+	 */
+	enum collectorState {
+		collectorStateIdle, //!< wait for the heap to reach the threshold
+		collectorStateMark, //!< incremental marking interleaved with the execution
+		collectorStateSweep, //!< the sweeper thread search the dead objects, then they are released by steps
+	};
+	/**
+	 * @brief Tracing garbage collector of the script objects (disable by default, "delete" is the only release).
+	 * The work is done by steps at the allocation of an object (the only point where the C++ code of the interpreter
+	 * does not keep an object out of the roots). The roots are the slots of the value stack, the global variables and
+	 * the return values of the active frames.
+	 * The marking is incremental: the objects allocated during the marking are not collected by the cycle, an object
+	 * stored in a field is marked by the write barrier, and the roots are scanned again at the end of the marking.
+	 * The dead objects are searched by a thread and released by the interpreter thread (the heap has no lock).
+	 * The objects allocated in a region of the heap are collected as the others: the region is reset when all its blocks are released.
+	 */
+	class Collector {
+		public:
+			static const int32_t nbHistogram = 5; //!< Pause histogram: < 10us, < 100us, < 1ms, < 10ms, >= 10ms.
+		private:
+			bool m_enable; //!< The objects are collected.
+			enum collectorState m_state; //!< Current state of the cycle.
+			uint32_t m_epoch; //!< Mark value of the current cycle (an object is marked when its mark is the epoch).
+			etk::Vector<eci::Object*> m_objects; //!< All the objects managed by the collector (except the ones in the sweeper).
+			etk::Vector<eci::Object*> m_gray; //!< Marked objects with fields not scanned yet.
+			etk::Vector<eci::Object*> m_sweepList; //!< Objects of the cycle (owned by the sweeper thread until it is done).
+			etk::Vector<eci::Object*> m_sweepLive; //!< Objects marked by the cycle (set by the sweeper thread).
+			etk::Vector<eci::Object*> m_sweepDead; //!< Objects to release (set by the sweeper thread).
+			size_t m_sweepDeadPos; //!< Number of dead objects already released.
+			std::thread* m_sweeper; //!< Thread that search the dead objects.
+			std::atomic<bool> m_sweepDone; //!< The sweeper thread has finished.
+			bool m_concurrentSweep; //!< The dead objects are searched in a thread.
+			size_t m_sizeManaged; //!< Size of the managed objects (blocks of the heap).
+			size_t m_minThreshold; //!< Min size of the managed objects to start a cycle.
+			size_t m_threshold; //!< Size of the managed objects that start the next cycle.
+			size_t m_stepSize; //!< Size allocated between 2 marking steps.
+			size_t m_sizeSinceStep; //!< Size allocated since the last step.
+			int64_t m_budget; //!< Max duration of a step in microseconds.
+			size_t m_nbCycle; //!< Number of finished cycles.
+			size_t m_nbCollected; //!< Number of released objects.
+			size_t m_sizeCollected; //!< Size of the released objects.
+			size_t m_nbPause; //!< Number of steps.
+			int64_t m_pauseMax; //!< Longest step in microseconds.
+			int64_t m_pauseTotal; //!< Total duration of the steps in microseconds.
+			size_t m_histogram[nbHistogram]; //!< Number of steps by duration.
+		public:
+			Collector();
+			~Collector();
+			/**
+			 * @brief Enable the collector (must be set before the first object is created).
+			 * @param[in] _value New state.
+			 */
+			void setEnable(bool _value) {
+				m_enable = _value;
+			}
+			bool getEnable() const {
+				return m_enable;
+			}
+			/**
+			 * @brief Set the max duration of a step (the final scan of the roots is not limited).
+			 * @param[in] _value Duration in microseconds.
+			 */
+			void setBudget(int64_t _value) {
+				m_budget = etk::max(_value, int64_t(1));
+			}
+			int64_t getBudget() const {
+				return m_budget;
+			}
+			/**
+			 * @brief Set the min size of the managed objects to start a cycle (then a cycle start when the size is twice the living size of the last cycle).
+			 * @param[in] _value Size in byte.
+			 */
+			void setThreshold(size_t _value) {
+				m_minThreshold = _value;
+				m_threshold = etk::max(m_threshold, _value);
+			}
+			/**
+			 * @brief Select where the dead objects are searched.
+			 * @param[in] _value true: in a thread (default), false: in the interpreter thread at the end of the marking.
+			 */
+			void setConcurrentSweep(bool _value) {
+				m_concurrentSweep = _value;
+			}
+			enum collectorState getState() const {
+				return m_state;
+			}
+			/**
+			 * @brief Add a new object (marked when it is created during a marking).
+			 * @param[in] _object Object fully initialized.
+			 */
+			void add(eci::Object* _object);
+			/**
+			 * @brief Write barrier: must be called when an object is stored in a field of an other object.
+			 * @param[in] _value Stored value.
+			 */
+			void barrier(const eci::Value& _value) {
+				if (    m_state == eci::collectorStateMark
+				     && _value.m_type == eci::valueTypeObject) {
+					shade(_value.m_object);
+				}
+			}
+			/**
+			 * @brief Execute a step of the current cycle (called before the allocation of an object).
+			 * @param[in] _interpreter Interpreter that own the roots and the heap.
+			 */
+			void step(eci::Interpreter& _interpreter);
+			/**
+			 * @brief Execute a full cycle without limit of duration (the current cycle is finished first).
+			 * @param[in] _interpreter Interpreter that own the roots and the heap.
+			 */
+			void collect(eci::Interpreter& _interpreter);
+			/**
+			 * @brief Get the size of the managed objects.
+			 * @return Size in byte.
+			 */
+			size_t getSizeManaged() const {
+				return m_sizeManaged;
+			}
+			size_t getNbManaged() const {
+				return m_objects.size() + m_sweepList.size() + m_sweepLive.size() + m_sweepDead.size() - m_sweepDeadPos;
+			}
+			size_t getNbCycle() const {
+				return m_nbCycle;
+			}
+			size_t getNbCollected() const {
+				return m_nbCollected;
+			}
+			size_t getSizeCollected() const {
+				return m_sizeCollected;
+			}
+			size_t getNbPause() const {
+				return m_nbPause;
+			}
+			int64_t getPauseMax() const {
+				return m_pauseMax;
+			}
+			int64_t getPauseTotal() const {
+				return m_pauseTotal;
+			}
+			/**
+			 * @brief Get the number of steps in a duration range.
+			 * @param[in] _id Range (see @ref nbHistogram).
+			 * @return Number of step.
+			 */
+			size_t getHistogram(int32_t _id) const {
+				return m_histogram[_id];
+			}
+		private:
+			/**
+			 * @brief Mark an object (its fields are scanned later).
+			 * @param[in] _object Object to mark (can be null).
+			 */
+			void shade(eci::Object* _object);
+			/**
+			 * @brief Mark the roots of the interpreter.
+			 */
+			void scanRoots(eci::Interpreter& _interpreter);
+			/**
+			 * @brief Scan the fields of the marked objects.
+			 * @param[in] _budget Max duration in microseconds (< 0: no limit).
+			 * @return true when all the reachable objects are marked.
+			 */
+			bool mark(int64_t _budget);
+			/**
+			 * @brief End of the marking: scan the roots again and start the search of the dead objects.
+			 */
+			void finishMark(eci::Interpreter& _interpreter);
+			/**
+			 * @brief Search the dead objects of the cycle (executed by the sweeper thread).
+			 */
+			void sweep();
+			/**
+			 * @brief Release the dead objects found by the sweeper.
+			 * @param[in] _budget Max duration in microseconds (< 0: no limit).
+			 * @return true when the cycle is finished.
+			 */
+			bool release(eci::Heap& _heap, int64_t _budget);
+			void addPause(int64_t _duration);
+	};
+}
+
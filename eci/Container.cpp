@@ -0,0 +1,1051 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Container.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/Object.hpp>
+#include <eci/Class.hpp>
+#include <eci/debug.hpp>
+
+const char* const eci::Container::libraryName = "eci/container";
+
+static const size_t fieldLength = 0; //!< Length of a string or of the text of a builder.
+static const size_t fieldHash = 1; //!< Hash of a string.
+static const size_t fieldBuffer = 1; //!< Buffer of a builder (array of long, bytes packed by 8).
+static const size_t fieldSize = 0; //!< Number of entries of a hash table.
+static const size_t fieldTable = 1; //!< Entries of a hash table (array of long: key, value for a map).
+static const size_t minCapacity = 8; //!< Number of entries of the first table (power of 2).
+
+/**
+ * @brief Get the object of an argument.
+ * @param[in] _value Argument.
+ * @param[in] _class Class expected.
+ * @param[in] _function Name of the function (for the error).
+ * @return The object or null if the argument is not an instance of the class.
+ */
+static eci::Object* getInstance(const eci::Value& _value, const eci::Class* _class, const char* _function) {
+	if (    _value.m_type != eci::valueTypeObject
+	     || _value.m_object == null
+	     || _value.m_object->m_fields == null
+	     || _value.m_object->m_class != _class) {
+		ECI_ERROR("Function '" << _function << "' : an argument is not a '" << _class->getName() << "'");
+		return null;
+	}
+	return _value.m_object;
+}
+
+/**
+ * @brief Store a value in a field of an object (write barrier of the collector).
+ */
+static void store(eci::Interpreter& _interpreter, eci::Value& _field, const eci::Value& _value) {
+	_field = _value;
+	_interpreter.getCollector().barrier(_value);
+}
+
+/**
+ * @brief Release the array referenced by a field (only referenced by the object of the field).
+ */
+static void releaseArray(eci::Interpreter& _interpreter, const eci::Value& _field) {
+	if (    _field.m_type == eci::valueTypeObject
+	     && _field.m_object != null
+	     && _field.m_object->m_fields != null) {
+		_interpreter.destroyObject(_field.m_object);
+	}
+}
+
+/**
+ * @brief Finalizer of the hash (all the bits of the value change the low bits).
+ */
+static uint64_t mix(uint64_t _value) {
+	_value ^= _value >> 33;
+	_value *= 0xFF51AFD7ED558CCDULL;
+	_value ^= _value >> 33;
+	_value *= 0xC4CEB9FE1A85EC53ULL;
+	_value ^= _value >> 33;
+	return _value;
+}
+
+// The bytes of a text are packed by 8 in the fields (the byte N is in the bits 8*(N%8) of the field N/8): the text is
+// read and compared by words, the fields are integers for the collector.
+
+static uint8_t getByte(const eci::Value* _words, size_t _index) {
+	return uint8_t(uint64_t(_words[_index/8].m_int64) >> ((_index%8)*8));
+}
+
+static void setByte(eci::Value* _words, size_t _index, uint8_t _value) {
+	size_t shift = (_index%8)*8;
+	uint64_t word = uint64_t(_words[_index/8].m_int64);
+	word = (word & ~(uint64_t(0xFF) << shift)) | (uint64_t(_value) << shift);
+	_words[_index/8] = eci::Value(int64_t(word));
+}
+
+/**
+ * @brief Read 8 bytes of a text at any position.
+ * @param[in] _words Packed text.
+ * @param[in] _nbWord Number of words of the text.
+ * @param[in] _position Position of the first byte.
+ */
+static uint64_t readWord(const eci::Value* _words, size_t _nbWord, size_t _position) {
+	size_t id = _position/8;
+	size_t shift = (_position%8)*8;
+	uint64_t out = uint64_t(_words[id].m_int64) >> shift;
+	if (    shift != 0
+	     && id+1 < _nbWord) {
+		out |= uint64_t(_words[id+1].m_int64) << (64-shift);
+	}
+	return out;
+}
+
+/**
+ * @brief Copy a part of a text in an other text (by words when 8 bytes remain).
+ * @param[in,out] _destination Packed text to write.
+ * @param[in] _destinationStart Position of the first byte written.
+ * @param[in] _source Packed text to read.
+ * @param[in] _sourceNbWord Number of words of the source.
+ * @param[in] _sourceStart Position of the first byte read.
+ * @param[in] _count Number of bytes.
+ */
+static void copyText(eci::Value* _destination, size_t _destinationStart, const eci::Value* _source, size_t _sourceNbWord, size_t _sourceStart, size_t _count) {
+	size_t pos = 0;
+	while (    pos < _count
+	        && ((_destinationStart+pos) % 8) != 0) {
+		setByte(_destination, _destinationStart+pos, getByte(_source, _sourceStart+pos));
+		++pos;
+	}
+	for (; pos+8 <= _count; pos+=8) {
+		_destination[(_destinationStart+pos)/8] = eci::Value(int64_t(readWord(_source, _sourceNbWord, _sourceStart+pos)));
+	}
+	for (; pos<_count; ++pos) {
+		setByte(_destination, _destinationStart+pos, getByte(_source, _sourceStart+pos));
+	}
+}
+
+static size_t getNbWord(size_t _length) {
+	return (_length+7) / 8;
+}
+
+static uint64_t getTextHash(const eci::Value* _words, size_t _length) {
+	uint64_t out = _length;
+	for (size_t iii=0; iii<getNbWord(_length); ++iii) {
+		out = (out ^ uint64_t(_words[iii].m_int64)) * 0x9E3779B97F4A7C15ULL;
+		out ^= out >> 29;
+	}
+	return mix(out);
+}
+
+// A string declared without value ("string name;") has only one field: it is the empty string.
+
+static size_t getLength(const eci::Object* _text) {
+	if (_text->m_nbField < eci::Container::stringHeader) {
+		return 0;
+	}
+	return size_t(_text->m_fields[fieldLength].m_int64);
+}
+
+static const eci::Value* getWords(const eci::Object* _text) {
+	return _text->m_fields + eci::Container::stringHeader;
+}
+
+static uint64_t getHash(const eci::Object* _text) {
+	if (_text->m_nbField < eci::Container::stringHeader) {
+		return getTextHash(null, 0);
+	}
+	return uint64_t(_text->m_fields[fieldHash].m_int64);
+}
+
+/**
+ * @brief Create a string with all its bytes at 0 (set by the caller, then @ref finishString).
+ * @return The string (null if it can not be allocated).
+ */
+static eci::Object* createText(eci::Interpreter& _interpreter, const eci::Container& _container, size_t _length) {
+	eci::Object* out = _interpreter.createArray(_container.m_string, eci::Container::stringHeader + getNbWord(_length));
+	if (out == null) {
+		return null;
+	}
+	out->m_fields[fieldLength] = eci::Value(int64_t(_length));
+	return out;
+}
+
+static eci::Value finishString(eci::Object* _text) {
+	_text->m_fields[fieldHash] = eci::Value(int64_t(getTextHash(getWords(_text), getLength(_text))));
+	return eci::Value(_text);
+}
+
+static bool isEqualText(const eci::Object* _left, const eci::Object* _right) {
+	if (_left == _right) {
+		return true;
+	}
+	size_t length = getLength(_left);
+	if (    length != getLength(_right)
+	     || getHash(_left) != getHash(_right)) {
+		return false;
+	}
+	const eci::Value* left = getWords(_left);
+	const eci::Value* right = getWords(_right);
+	for (size_t iii=0; iii<getNbWord(length); ++iii) {
+		if (left[iii].m_int64 != right[iii].m_int64) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Get the byte order of a word (the first byte is the most significant).
+ */
+static uint64_t getOrder(uint64_t _word) {
+	uint64_t out = 0;
+	for (int32_t iii=0; iii<8; ++iii) {
+		out = (out << 8) | ((_word >> (iii*8)) & 0xFF);
+	}
+	return out;
+}
+
+// Hash tables: an entry is "stride" consecutive fields of the table (the key, then the value of a map), a void key is
+// an empty entry. The capacity is a power of 2 and at least one entry stay empty (the search always stop).
+
+/**
+ * @brief Get the key of a value (the integers are compared in 64 bits).
+ * @return false if the value can not be a key.
+ */
+static bool getKey(const eci::Value& _value, eci::Value& _key) {
+	switch (_value.m_type) {
+		case eci::valueTypeVoid:
+			return false;
+		case eci::valueTypeFloat:
+		case eci::valueTypeDouble:
+			_key = _value.convert(eci::valueTypeDouble);
+			return true;
+		case eci::valueTypeObject:
+			if (    _value.m_object == null
+			     || _value.m_object->m_fields == null) {
+				return false;
+			}
+			_key = _value;
+			return true;
+		default:
+			_key = eci::Value(_value.get<int64_t>());
+			return true;
+	}
+}
+
+static uint64_t getKeyHash(const eci::Container& _container, const eci::Value& _key) {
+	if (_key.m_type != eci::valueTypeObject) {
+		return mix(_key.m_uint64 + _key.m_type);
+	}
+	if (_key.m_object->m_class == _container.m_string) {
+		return getHash(_key.m_object);
+	}
+	return mix(uint64_t(_key.m_object));
+}
+
+static bool isEqualKey(const eci::Container& _container, const eci::Value& _left, const eci::Value& _right) {
+	if (_left.m_type != _right.m_type) {
+		return false;
+	}
+	if (_left.m_type != eci::valueTypeObject) {
+		return _left.m_uint64 == _right.m_uint64;
+	}
+	if (_left.m_object == _right.m_object) {
+		return true;
+	}
+	return    _left.m_object->m_class == _container.m_string
+	       && _right.m_object->m_class == _container.m_string
+	       && isEqualText(_left.m_object, _right.m_object);
+}
+
+static eci::Object* getTable(const eci::Object* _object) {
+	const eci::Value& table = _object->m_fields[fieldTable];
+	if (    table.m_type != eci::valueTypeObject
+	     || table.m_object == null
+	     || table.m_object->m_fields == null) {
+		return null;
+	}
+	return table.m_object;
+}
+
+/**
+ * @brief Get the number of entries of a table (0 for the table created with the object).
+ */
+static size_t getCapacity(const eci::Object* _table, size_t _stride) {
+	if (_table == null) {
+		return 0;
+	}
+	size_t out = _table->m_nbField / _stride;
+	if (    out < minCapacity
+	     || (out & (out-1)) != 0) {
+		return 0;
+	}
+	return out;
+}
+
+/**
+ * @brief Search a key in a table.
+ * @param[out] _position Entry of the key, or empty entry where the key is inserted.
+ * @return true if the key is found.
+ */
+static bool findEntry(const eci::Container& _container, const eci::Object* _table, size_t _stride, const eci::Value& _key, uint64_t _hash, size_t& _position) {
+	size_t capacity = getCapacity(_table, _stride);
+	if (capacity == 0) {
+		return false;
+	}
+	size_t mask = capacity - 1;
+	size_t position = _hash & mask;
+	while (true) {
+		const eci::Value& entry = _table->m_fields[position*_stride];
+		if (entry.m_type == eci::valueTypeVoid) {
+			_position = position;
+			return false;
+		}
+		if (isEqualKey(_container, entry, _key) == true) {
+			_position = position;
+			return true;
+		}
+		position = (position + 1) & mask;
+	}
+}
+
+/**
+ * @brief Move all the entries in a new table of twice the capacity.
+ * @return false if the new table can not be allocated (the table is not modified).
+ */
+static bool grow(eci::Interpreter& _interpreter, const eci::Container& _container, eci::Object* _object, size_t _stride) {
+	eci::Object* table = getTable(_object);
+	size_t capacity = getCapacity(table, _stride);
+	size_t newCapacity = etk::max(minCapacity, capacity*2);
+	eci::Object* newTable = _interpreter.createArray(_object->m_class->getLayout()[fieldTable].m_class, newCapacity*_stride);
+	if (newTable == null) {
+		return false;
+	}
+	for (size_t iii=0; iii<newTable->m_nbField; ++iii) {
+		newTable->m_fields[iii] = eci::Value();
+	}
+	for (size_t iii=0; iii<capacity; ++iii) {
+		const eci::Value* entry = &table->m_fields[iii*_stride];
+		if (entry[0].m_type == eci::valueTypeVoid) {
+			continue;
+		}
+		size_t position = getKeyHash(_container, entry[0]) & (newCapacity-1);
+		while (newTable->m_fields[position*_stride].m_type != eci::valueTypeVoid) {
+			position = (position + 1) & (newCapacity-1);
+		}
+		// the old table is released: the objects are only referenced by the new one
+		for (size_t jjj=0; jjj<_stride; ++jjj) {
+			store(_interpreter, newTable->m_fields[position*_stride+jjj], entry[jjj]);
+		}
+	}
+	eci::Value old = _object->m_fields[fieldTable];
+	store(_interpreter, _object->m_fields[fieldTable], eci::Value(newTable));
+	releaseArray(_interpreter, old);
+	return true;
+}
+
+/**
+ * @brief Get the entry of a key, inserted if not found (the table grow before its load is over 3/4).
+ * @param[out] _added The key has been inserted (the value of a map is void).
+ * @return The entry (null if the value can not be a key or if the table can not grow).
+ */
+static eci::Value* insert(eci::Interpreter& _interpreter, const eci::Container& _container, eci::Object* _object, size_t _stride, const eci::Value& _value, bool& _added) {
+	_added = false;
+	eci::Value key;
+	if (getKey(_value, key) == false) {
+		ECI_ERROR("Container : the key can not be void or a deleted object");
+		return null;
+	}
+	uint64_t hash = getKeyHash(_container, key);
+	size_t position = 0;
+	if (findEntry(_container, getTable(_object), _stride, key, hash, position) == true) {
+		return &getTable(_object)->m_fields[position*_stride];
+	}
+	int64_t size = _object->m_fields[fieldSize].m_int64;
+	if (size_t(size+1)*4 > getCapacity(getTable(_object), _stride)*3) {
+		if (grow(_interpreter, _container, _object, _stride) == false) {
+			return null;
+		}
+		findEntry(_container, getTable(_object), _stride, key, hash, position);
+	}
+	eci::Value* entry = &getTable(_object)->m_fields[position*_stride];
+	store(_interpreter, entry[0], key);
+	for (size_t iii=1; iii<_stride; ++iii) {
+		entry[iii] = eci::Value();
+	}
+	_object->m_fields[fieldSize] = eci::Value(int64_t(size+1));
+	_added = true;
+	return entry;
+}
+
+/**
+ * @brief Get the entry of a key.
+ * @return The entry or null if not found.
+ */
+static eci::Value* find(const eci::Container& _container, eci::Object* _object, size_t _stride, const eci::Value& _value) {
+	eci::Value key;
+	if (getKey(_value, key) == false) {
+		return null;
+	}
+	eci::Object* table = getTable(_object);
+	size_t position = 0;
+	if (findEntry(_container, table, _stride, key, getKeyHash(_container, key), position) == false) {
+		return null;
+	}
+	return &table->m_fields[position*_stride];
+}
+
+/**
+ * @brief Remove a key: the next entries of the cluster are moved back (no tombstone, the search stay short).
+ * @return true if the key was in the table.
+ */
+static bool remove(eci::Interpreter& _interpreter, const eci::Container& _container, eci::Object* _object, size_t _stride, const eci::Value& _value) {
+	eci::Value key;
+	if (getKey(_value, key) == false) {
+		return false;
+	}
+	eci::Object* table = getTable(_object);
+	size_t position = 0;
+	if (findEntry(_container, table, _stride, key, getKeyHash(_container, key), position) == false) {
+		return false;
+	}
+	size_t mask = getCapacity(table, _stride) - 1;
+	size_t next = position;
+	while (true) {
+		next = (next + 1) & mask;
+		const eci::Value* entry = &table->m_fields[next*_stride];
+		if (entry[0].m_type == eci::valueTypeVoid) {
+			break;
+		}
+		// an entry is moved in the hole if its home position is not between the hole and the entry
+		size_t home = getKeyHash(_container, entry[0]) & mask;
+		if (((next - home) & mask) >= ((next - position) & mask)) {
+			for (size_t iii=0; iii<_stride; ++iii) {
+				store(_interpreter, table->m_fields[position*_stride+iii], entry[iii]);
+			}
+			position = next;
+		}
+	}
+	for (size_t iii=0; iii<_stride; ++iii) {
+		table->m_fields[position*_stride+iii] = eci::Value();
+	}
+	_object->m_fields[fieldSize] = eci::Value(_object->m_fields[fieldSize].m_int64 - 1);
+	return true;
+}
+
+static void clear(eci::Object* _object, size_t _stride) {
+	eci::Object* table = getTable(_object);
+	for (size_t iii=0; iii<getCapacity(table, _stride)*_stride; ++iii) {
+		table->m_fields[iii] = eci::Value();
+	}
+	_object->m_fields[fieldSize] = eci::Value(int64_t(0));
+}
+
+/**
+ * @brief Get the first used entry at or after a position.
+ * @return The entry or -1 at the end of the table.
+ */
+static int32_t next(eci::Object* _object, size_t _stride, int32_t _position) {
+	eci::Object* table = getTable(_object);
+	size_t capacity = getCapacity(table, _stride);
+	for (size_t iii=size_t(etk::max(_position, 0)); iii<capacity; ++iii) {
+		if (table->m_fields[iii*_stride].m_type != eci::valueTypeVoid) {
+			return iii;
+		}
+	}
+	return -1;
+}
+
+/**
+ * @brief Get a used entry of a table (an error if the position is not an entry).
+ */
+static eci::Value* getEntry(eci::Object* _object, size_t _stride, int32_t _position, const char* _function) {
+	eci::Object* table = getTable(_object);
+	if (    _position < 0
+	     || size_t(_position) >= getCapacity(table, _stride)
+	     || table->m_fields[_position*_stride].m_type == eci::valueTypeVoid) {
+		ECI_ERROR("Function '" << _function << "' : no entry at the position " << _position);
+		return null;
+	}
+	return &table->m_fields[_position*_stride];
+}
+
+/**
+ * @brief Write an integer in decimal.
+ * @param[out] _buffer Text (at least 20 bytes).
+ * @return Number of bytes.
+ */
+static size_t formatInteger(int64_t _value, char* _buffer) {
+	char digits[20];
+	size_t nbDigit = 0;
+	uint64_t value = _value < 0 ? uint64_t(0) - uint64_t(_value) : uint64_t(_value);
+	do {
+		digits[nbDigit++] = char('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	size_t out = 0;
+	if (_value < 0) {
+		_buffer[out++] = '-';
+	}
+	while (nbDigit > 0) {
+		_buffer[out++] = digits[--nbDigit];
+	}
+	return out;
+}
+
+// Functions of the scripts:
+
+#define ECI_CONTAINER(_name) static eci::Value _name(eci::Interpreter& _interpreter, const eci::Library& _library, const eci::Value* _arguments)
+
+static const eci::Container& getContainer(const eci::Library& _library) {
+	return static_cast<const eci::Container&>(_library);
+}
+
+ECI_CONTAINER(callStringLength) {
+	eci::Object* text = getInstance(_arguments[0], getContainer(_library).m_string, "stringLength");
+	if (text == null) {
+		return eci::Value(int32_t(0));
+	}
+	return eci::Value(int32_t(getLength(text)));
+}
+
+ECI_CONTAINER(callStringAt) {
+	eci::Object* text = getInstance(_arguments[0], getContainer(_library).m_string, "stringAt");
+	int32_t index = _arguments[1].get<int32_t>();
+	if (    text == null
+	     || index < 0
+	     || size_t(index) >= getLength(text)) {
+		return eci::Value(int8_t(0));
+	}
+	return eci::Value(int8_t(getByte(getWords(text), index)));
+}
+
+ECI_CONTAINER(callStringConcat) {
+	const eci::Container& container = getContainer(_library);
+	eci::Object* left = getInstance(_arguments[0], container.m_string, "stringConcat");
+	eci::Object* right = getInstance(_arguments[1], container.m_string, "stringConcat");
+	if (    left == null
+	     || right == null) {
+		return eci::Value();
+	}
+	size_t leftLength = getLength(left);
+	size_t rightLength = getLength(right);
+	eci::Object* out = createText(_interpreter, container, leftLength + rightLength);
+	if (out == null) {
+		return eci::Value();
+	}
+	eci::Value* words = out->m_fields + eci::Container::stringHeader;
+	copyText(words, 0, getWords(left), getNbWord(leftLength), 0, leftLength);
+	copyText(words, leftLength, getWords(right), getNbWord(rightLength), 0, rightLength);
+	return finishString(out);
+}
+
+ECI_CONTAINER(callStringSub) {
+	const eci::Container& container = getContainer(_library);
+	eci::Object* text = getInstance(_arguments[0], container.m_string, "stringSub");
+	if (text == null) {
+		return eci::Value();
+	}
+	size_t length = getLength(text);
+	size_t start = size_t(etk::min(etk::max(_arguments[1].get<int64_t>(), int64_t(0)), int64_t(length)));
+	size_t count = size_t(etk::min(etk::max(_arguments[2].get<int64_t>(), int64_t(0)), int64_t(length - start)));
+	eci::Object* out = createText(_interpreter, container, count);
+	if (out == null) {
+		return eci::Value();
+	}
+	copyText(out->m_fields + eci::Container::stringHeader, 0, getWords(text), getNbWord(length), start, count);
+	return finishString(out);
+}
+
+ECI_CONTAINER(callStringFind) {
+	const eci::Container& container = getContainer(_library);
+	eci::Object* text = getInstance(_arguments[0], container.m_string, "stringFind");
+	eci::Object* pattern = getInstance(_arguments[1], container.m_string, "stringFind");
+	if (    text == null
+	     || pattern == null) {
+		return eci::Value(int32_t(-1));
+	}
+	size_t length = getLength(text);
+	size_t patternLength = getLength(pattern);
+	const eci::Value* words = getWords(text);
+	const eci::Value* patternWords = getWords(pattern);
+	for (size_t iii=size_t(etk::max(_arguments[2].get<int32_t>(), 0)); iii+patternLength<=length; ++iii) {
+		size_t jjj = 0;
+		while (    jjj < patternLength
+		        && getByte(words, iii+jjj) == getByte(patternWords, jjj)) {
+			++jjj;
+		}
+		if (jjj == patternLength) {
+			return eci::Value(int32_t(iii));
+		}
+	}
+	return eci::Value(int32_t(-1));
+}
+
+ECI_CONTAINER(callStringEqual) {
+	const eci::Container& container = getContainer(_library);
+	eci::Object* left = getInstance(_arguments[0], container.m_string, "stringEqual");
+	eci::Object* right = getInstance(_arguments[1], container.m_string, "stringEqual");
+	return eci::Value(    left != null
+	                   && right != null
+	                   && isEqualText(left, right) == true);
+}
+
+ECI_CONTAINER(callStringCompare) {
+	const eci::Container& container = getContainer(_library);
+	eci::Object* left = getInstance(_arguments[0], container.m_string, "stringCompare");
+	eci::Object* right = getInstance(_arguments[1], container.m_string, "stringCompare");
+	if (    left == null
+	     || right == null) {
+		return eci::Value(int32_t(0));
+	}
+	size_t leftLength = getLength(left);
+	size_t rightLength = getLength(right);
+	// the end of a word is 0: a prefix is equal on its words, then smaller by its length
+	for (size_t iii=0; iii<getNbWord(etk::min(leftLength, rightLength)); ++iii) {
+		uint64_t leftWord = getOrder(uint64_t(getWords(left)[iii].m_int64));
+		uint64_t rightWord = getOrder(uint64_t(getWords(right)[iii].m_int64));
+		if (leftWord != rightWord) {
+			return eci::Value(int32_t(leftWord < rightWord ? -1 : 1));
+		}
+	}
+	if (leftLength == rightLength) {
+		return eci::Value(int32_t(0));
+	}
+	return eci::Value(int32_t(leftLength < rightLength ? -1 : 1));
+}
+
+ECI_CONTAINER(callStringFromInt) {
+	char buffer[24];
+	size_t size = formatInteger(_arguments[0].get<int64_t>(), buffer);
+	return eci::Value(getContainer(_library).createString(_interpreter, buffer, size));
+}
+
+ECI_CONTAINER(callStringToInt) {
+	eci::Object* text = getInstance(_arguments[0], getContainer(_library).m_string, "stringToInt");
+	if (text == null) {
+		return eci::Value(int64_t(0));
+	}
+	size_t length = getLength(text);
+	const eci::Value* words = getWords(text);
+	size_t pos = 0;
+	bool negative = false;
+	if (    length != 0
+	     && (    getByte(words, 0) == '-'
+	          || getByte(words, 0) == '+')) {
+		negative = getByte(words, 0) == '-';
+		++pos;
+	}
+	uint64_t out = 0;
+	for (; pos<length; ++pos) {
+		uint8_t value = getByte(words, pos);
+		if (    value < '0'
+		     || value > '9') {
+			break;
+		}
+		out = out * 10 + (value - '0');
+	}
+	return eci::Value(negative == true ? int64_t(uint64_t(0) - out) : int64_t(out));
+}
+
+ECI_CONTAINER(callStringIntern) {
+	const eci::Container& container = getContainer(_library);
+	if (getInstance(_arguments[0], container.m_string, "stringIntern") == null) {
+		return eci::Value();
+	}
+	return container.intern(_interpreter, _arguments[0]);
+}
+
+/**
+ * @brief Get a builder with a buffer of at least a size (the buffer grow by doubling).
+ * @return The bytes of the buffer (null on error).
+ */
+static eci::Value* reserveBuilder(eci::Interpreter& _interpreter, eci::Object* _builder, size_t _size) {
+	const eci::Value& buffer = _builder->m_fields[fieldBuffer];
+	size_t nbWord = 0;
+	if (    buffer.m_type == eci::valueTypeObject
+	     && buffer.m_object != null
+	     && buffer.m_object->m_fields != null) {
+		nbWord = buffer.m_object->m_nbField;
+	}
+	if (getNbWord(_size) <= nbWord) {
+		return buffer.m_object->m_fields;
+	}
+	size_t length = size_t(_builder->m_fields[fieldLength].m_int64);
+	eci::Object* newBuffer = _interpreter.createArray(_builder->m_class->getLayout()[fieldBuffer].m_class, etk::max(getNbWord(_size), etk::max(nbWord*2, size_t(4))));
+	if (newBuffer == null) {
+		return null;
+	}
+	for (size_t iii=0; iii<getNbWord(length); ++iii) {
+		newBuffer->m_fields[iii] = buffer.m_object->m_fields[iii];
+	}
+	eci::Value old = buffer;
+	store(_interpreter, _builder->m_fields[fieldBuffer], eci::Value(newBuffer));
+	releaseArray(_interpreter, old);
+	return newBuffer->m_fields;
+}
+
+ECI_CONTAINER(callBuilderAppend) {
+	const eci::Container& container = getContainer(_library);
+	eci::Object* builder = getInstance(_arguments[0], container.m_builder, "builderAppend");
+	eci::Object* text = getInstance(_arguments[1], container.m_string, "builderAppend");
+	if (    builder == null
+	     || text == null) {
+		return eci::Value();
+	}
+	size_t length = size_t(builder->m_fields[fieldLength].m_int64);
+	size_t textLength = getLength(text);
+	eci::Value* words = reserveBuilder(_interpreter, builder, length + textLength);
+	if (words == null) {
+		return eci::Value();
+	}
+	copyText(words, length, getWords(text), getNbWord(textLength), 0, textLength);
+	builder->m_fields[fieldLength] = eci::Value(int64_t(length + textLength));
+	return eci::Value();
+}
+
+ECI_CONTAINER(callBuilderAppendChar) {
+	eci::Object* builder = getInstance(_arguments[0], getContainer(_library).m_builder, "builderAppendChar");
+	if (builder == null) {
+		return eci::Value();
+	}
+	size_t length = size_t(builder->m_fields[fieldLength].m_int64);
+	eci::Value* words = reserveBuilder(_interpreter, builder, length + 1);
+	if (words == null) {
+		return eci::Value();
+	}
+	setByte(words, length, uint8_t(_arguments[1].get<int8_t>()));
+	builder->m_fields[fieldLength] = eci::Value(int64_t(length + 1));
+	return eci::Value();
+}
+
+ECI_CONTAINER(callBuilderAppendInt) {
+	eci::Object* builder = getInstance(_arguments[0], getContainer(_library).m_builder, "builderAppendInt");
+	if (builder == null) {
+		return eci::Value();
+	}
+	char buffer[24];
+	size_t size = formatInteger(_arguments[1].get<int64_t>(), buffer);
+	size_t length = size_t(builder->m_fields[fieldLength].m_int64);
+	eci::Value* words = reserveBuilder(_interpreter, builder, length + size);
+	if (words == null) {
+		return eci::Value();
+	}
+	for (size_t iii=0; iii<size; ++iii) {
+		setByte(words, length+iii, uint8_t(buffer[iii]));
+	}
+	builder->m_fields[fieldLength] = eci::Value(int64_t(length + size));
+	return eci::Value();
+}
+
+ECI_CONTAINER(callBuilderLength) {
+	eci::Object* builder = getInstance(_arguments[0], getContainer(_library).m_builder, "builderLength");
+	if (builder == null) {
+		return eci::Value(int32_t(0));
+	}
+	return eci::Value(int32_t(builder->m_fields[fieldLength].m_int64));
+}
+
+ECI_CONTAINER(callBuilderToString) {
+	const eci::Container& container = getContainer(_library);
+	eci::Object* builder = getInstance(_arguments[0], container.m_builder, "builderToString");
+	if (builder == null) {
+		return eci::Value();
+	}
+	size_t length = size_t(builder->m_fields[fieldLength].m_int64);
+	eci::Object* out = createText(_interpreter, container, length);
+	if (out == null) {
+		return eci::Value();
+	}
+	if (length != 0) {
+		const eci::Object* buffer = builder->m_fields[fieldBuffer].m_object;
+		copyText(out->m_fields + eci::Container::stringHeader, 0, buffer->m_fields, buffer->m_nbField, 0, length);
+	}
+	return finishString(out);
+}
+
+ECI_CONTAINER(callBuilderClear) {
+	eci::Object* builder = getInstance(_arguments[0], getContainer(_library).m_builder, "builderClear");
+	if (builder != null) {
+		builder->m_fields[fieldLength] = eci::Value(int64_t(0));
+	}
+	return eci::Value();
+}
+
+/**
+ * @brief Get the map or the set of the first argument.
+ * @param[out] _stride Number of fields of an entry.
+ */
+static eci::Object* getTableObject(const eci::Container& _container, const eci::Value& _value, bool _map, const char* _function, size_t& _stride) {
+	_stride = _map == true ? 2 : 1;
+	return getInstance(_value, _map == true ? _container.m_map : _container.m_set, _function);
+}
+
+ECI_CONTAINER(callMapSet) {
+	const eci::Container& container = getContainer(_library);
+	eci::Object* map = getInstance(_arguments[0], container.m_map, "mapSet");
+	bool added = false;
+	eci::Value* entry = (map == null ? null : insert(_interpreter, container, map, 2, _arguments[1], added));
+	if (entry != null) {
+		store(_interpreter, entry[1], _arguments[2]);
+	}
+	return eci::Value();
+}
+
+ECI_CONTAINER(callMapGet) {
+	const eci::Container& container = getContainer(_library);
+	eci::Object* map = getInstance(_arguments[0], container.m_map, "mapGet");
+	eci::Value* entry = (map == null ? null : find(container, map, 2, _arguments[1]));
+	if (entry == null) {
+		return eci::Value(int64_t(0));
+	}
+	return entry[1];
+}
+
+ECI_CONTAINER(callMapAdd) {
+	const eci::Container& container = getContainer(_library);
+	eci::Object* map = getInstance(_arguments[0], container.m_map, "mapAdd");
+	bool added = false;
+	eci::Value* entry = (map == null ? null : insert(_interpreter, container, map, 2, _arguments[1], added));
+	if (entry == null) {
+		return eci::Value(int64_t(0));
+	}
+	// one search for the read and the write of the counter
+	entry[1] = eci::Value(entry[1].get<int64_t>() + _arguments[2].get<int64_t>());
+	return entry[1];
+}
+
+static eci::Value callHas(const eci::Library& _library, const eci::Value* _arguments, bool _map, const char* _function) {
+	const eci::Container& container = getContainer(_library);
+	size_t stride = 0;
+	eci::Object* object = getTableObject(container, _arguments[0], _map, _function, stride);
+	return eci::Value(    object != null
+	                   && find(container, object, stride, _arguments[1]) != null);
+}
+
+static eci::Value callRemove(eci::Interpreter& _interpreter, const eci::Library& _library, const eci::Value* _arguments, bool _map, const char* _function) {
+	const eci::Container& container = getContainer(_library);
+	size_t stride = 0;
+	eci::Object* object = getTableObject(container, _arguments[0], _map, _function, stride);
+	return eci::Value(    object != null
+	                   && remove(_interpreter, container, object, stride, _arguments[1]) == true);
+}
+
+static eci::Value callSize(const eci::Library& _library, const eci::Value* _arguments, bool _map, const char* _function) {
+	size_t stride = 0;
+	eci::Object* object = getTableObject(getContainer(_library), _arguments[0], _map, _function, stride);
+	if (object == null) {
+		return eci::Value(int32_t(0));
+	}
+	return eci::Value(int32_t(object->m_fields[fieldSize].m_int64));
+}
+
+static eci::Value callClear(const eci::Library& _library, const eci::Value* _arguments, bool _map, const char* _function) {
+	size_t stride = 0;
+	eci::Object* object = getTableObject(getContainer(_library), _arguments[0], _map, _function, stride);
+	if (object != null) {
+		clear(object, stride);
+	}
+	return eci::Value();
+}
+
+static eci::Value callNext(const eci::Library& _library, const eci::Value* _arguments, bool _map, const char* _function) {
+	size_t stride = 0;
+	eci::Object* object = getTableObject(getContainer(_library), _arguments[0], _map, _function, stride);
+	if (object == null) {
+		return eci::Value(int32_t(-1));
+	}
+	return eci::Value(next(object, stride, _arguments[1].get<int32_t>()));
+}
+
+static eci::Value callEntry(const eci::Library& _library, const eci::Value* _arguments, bool _map, size_t _field, const char* _function) {
+	size_t stride = 0;
+	eci::Object* object = getTableObject(getContainer(_library), _arguments[0], _map, _function, stride);
+	eci::Value* entry = (object == null ? null : getEntry(object, stride, _arguments[1].get<int32_t>(), _function));
+	if (entry == null) {
+		return eci::Value();
+	}
+	return entry[_field];
+}
+
+ECI_CONTAINER(callMapHas) {
+	return callHas(_library, _arguments, true, "mapHas");
+}
+
+ECI_CONTAINER(callMapRemove) {
+	return callRemove(_interpreter, _library, _arguments, true, "mapRemove");
+}
+
+ECI_CONTAINER(callMapSize) {
+	return callSize(_library, _arguments, true, "mapSize");
+}
+
+ECI_CONTAINER(callMapClear) {
+	return callClear(_library, _arguments, true, "mapClear");
+}
+
+ECI_CONTAINER(callMapNext) {
+	return callNext(_library, _arguments, true, "mapNext");
+}
+
+ECI_CONTAINER(callMapKey) {
+	return callEntry(_library, _arguments, true, 0, "mapKey");
+}
+
+ECI_CONTAINER(callMapValue) {
+	return callEntry(_library, _arguments, true, 1, "mapValue");
+}
+
+ECI_CONTAINER(callSetAdd) {
+	const eci::Container& container = getContainer(_library);
+	eci::Object* set = getInstance(_arguments[0], container.m_set, "setAdd");
+	bool added = false;
+	if (set != null) {
+		insert(_interpreter, container, set, 1, _arguments[1], added);
+	}
+	return eci::Value(added);
+}
+
+ECI_CONTAINER(callSetHas) {
+	return callHas(_library, _arguments, false, "setHas");
+}
+
+ECI_CONTAINER(callSetRemove) {
+	return callRemove(_interpreter, _library, _arguments, false, "setRemove");
+}
+
+ECI_CONTAINER(callSetSize) {
+	return callSize(_library, _arguments, false, "setSize");
+}
+
+ECI_CONTAINER(callSetClear) {
+	return callClear(_library, _arguments, false, "setClear");
+}
+
+ECI_CONTAINER(callSetNext) {
+	return callNext(_library, _arguments, false, "setNext");
+}
+
+ECI_CONTAINER(callSetKey) {
+	return callEntry(_library, _arguments, false, 0, "setKey");
+}
+
+#undef ECI_CONTAINER
+
+eci::Container::Container() :
+  eci::Library(libraryName, true) {
+	ememory::SharedPtr<eci::Class> string = ememory::makeShared<eci::Class>("string");
+	string->setElementTypeName("long");
+	m_string = string.get();
+	ememory::SharedPtr<eci::Class> builder = ememory::makeShared<eci::Class>("builder");
+	builder->addField(eci::Variable("length", "long"));
+	builder->addField(eci::Variable("buffer", "long[]"));
+	m_builder = builder.get();
+	ememory::SharedPtr<eci::Class> map = ememory::makeShared<eci::Class>("map");
+	map->addField(eci::Variable("size", "long"));
+	map->addField(eci::Variable("table", "long[]"));
+	m_map = map.get();
+	ememory::SharedPtr<eci::Class> set = ememory::makeShared<eci::Class>("set");
+	set->addField(eci::Variable("size", "long"));
+	set->addField(eci::Variable("table", "long[]"));
+	m_set = set.get();
+	m_classes.pushBack(string);
+	m_classes.pushBack(builder);
+	m_classes.pushBack(map);
+	m_classes.pushBack(set);
+	addBuiltin("stringLength", &callStringLength);
+	addBuiltin("stringAt", &callStringAt);
+	addBuiltin("stringConcat", &callStringConcat);
+	addBuiltin("stringSub", &callStringSub);
+	addBuiltin("stringFind", &callStringFind);
+	addBuiltin("stringEqual", &callStringEqual);
+	addBuiltin("stringCompare", &callStringCompare);
+	addBuiltin("stringFromInt", &callStringFromInt);
+	addBuiltin("stringToInt", &callStringToInt);
+	addBuiltin("stringIntern", &callStringIntern);
+	addBuiltin("builderAppend", &callBuilderAppend);
+	addBuiltin("builderAppendChar", &callBuilderAppendChar);
+	addBuiltin("builderAppendInt", &callBuilderAppendInt);
+	addBuiltin("builderLength", &callBuilderLength);
+	addBuiltin("builderToString", &callBuilderToString);
+	addBuiltin("builderClear", &callBuilderClear);
+	addBuiltin("mapSet", &callMapSet);
+	addBuiltin("mapGet", &callMapGet);
+	addBuiltin("mapAdd", &callMapAdd);
+	addBuiltin("mapHas", &callMapHas);
+	addBuiltin("mapRemove", &callMapRemove);
+	addBuiltin("mapSize", &callMapSize);
+	addBuiltin("mapClear", &callMapClear);
+	addBuiltin("mapNext", &callMapNext);
+	addBuiltin("mapKey", &callMapKey);
+	addBuiltin("mapValue", &callMapValue);
+	addBuiltin("setAdd", &callSetAdd);
+	addBuiltin("setHas", &callSetHas);
+	addBuiltin("setRemove", &callSetRemove);
+	addBuiltin("setSize", &callSetSize);
+	addBuiltin("setClear", &callSetClear);
+	addBuiltin("setNext", &callSetNext);
+	addBuiltin("setKey", &callSetKey);
+}
+
+eci::Container::~Container() {
+	
+}
+
+void eci::Container::addBuiltin(const etk::String& _name, eci::NativeCall::builtin _function) {
+	m_builtins.pushBack(etk::makePair(_name, _function));
+}
+
+eci::NativeCall::builtin eci::Container::getBuiltin(const etk::String& _name) const {
+	for (auto &it : m_builtins) {
+		if (it.first == _name) {
+			return it.second;
+		}
+	}
+	return null;
+}
+
+etk::Vector<etk::String> eci::Container::getClassNames() {
+	etk::Vector<etk::String> out;
+	out.pushBack("string");
+	out.pushBack("builder");
+	out.pushBack("map");
+	out.pushBack("set");
+	return out;
+}
+
+eci::Object* eci::Container::createString(eci::Interpreter& _interpreter, const char* _data, size_t _size) const {
+	eci::Object* out = createText(_interpreter, *this, _size);
+	if (out == null) {
+		return null;
+	}
+	eci::Value* words = out->m_fields + stringHeader;
+	for (size_t iii=0; iii<_size; ++iii) {
+		setByte(words, iii, uint8_t(_data[iii]));
+	}
+	finishString(out);
+	return out;
+}
+
+eci::Value eci::Container::intern(eci::Interpreter& _interpreter, const eci::Value& _value) const {
+	if (    _value.m_type != eci::valueTypeObject
+	     || _value.m_object == null
+	     || _value.m_object->m_class != m_string) {
+		return _value;
+	}
+	// the table is a root of the collector: the interned strings are kept by the interpreter
+	eci::Value& table = _interpreter.getInternTable();
+	if (    table.m_type != eci::valueTypeObject
+	     || table.m_object == null) {
+		table = eci::Value(_interpreter.createObject(m_set));
+		if (table.m_object == null) {
+			return _value;
+		}
+	}
+	bool added = false;
+	eci::Value* entry = insert(_interpreter, *this, table.m_object, 1, _value, added);
+	if (entry == null) {
+		return _value;
+	}
+	return entry[0];
+}
+
@@ -0,0 +1,101 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/String.hpp>
+#include <etk/Vector.hpp>
+#include <etk/Pair.hpp>
+#include <eci/Library.hpp>
+
+namespace eci {
+	class Object;
+	/**
+	 * @brief Builtin library "eci/container": strings, string builder and hash tables for the scripts. The import add the
+	 * classes "string", "builder", "map" and "set" in the program, the functions are bound on their declarations:
+	 * @code
+	 * #import <eci/container>
+	 * int stringLength(string text);
+	 * char stringAt(string text, int index);                   // 0 out of the string
+	 * string stringConcat(string left, string right);
+	 * string stringSub(string text, int start, int count);     // limited to the string
+	 * int stringFind(string text, string pattern, int start);  // position or -1
+	 * bool stringEqual(string left, string right);             // same text
+	 * int stringCompare(string left, string right);            // <0, 0 or >0 (order of the bytes)
+	 * string stringFromInt(long value);
+	 * long stringToInt(string text);
+	 * string stringIntern(string text);                        // same object for the same text (as the literals)
+	 * void builderAppend(builder out, string text);            // also builderAppendChar(out, char) and builderAppendInt(out, long)
+	 * int builderLength(builder out);
+	 * string builderToString(builder out);
+	 * void builderClear(builder out);                          // keep the buffer
+	 * void mapSet(map table, auto key, auto value);
+	 * long mapGet(map table, auto key);                        // value converted in the return type (0 if not found)
+	 * long mapAdd(map table, auto key, long delta);            // add delta to the value (0 if not found) and return it
+	 * bool mapHas(map table, auto key);
+	 * bool mapRemove(map table, auto key);
+	 * int mapSize(map table);
+	 * void mapClear(map table);
+	 * int mapNext(map table, int position);                    // first entry at or after the position, -1 at the end
+	 * string mapKey(map table, int position);                  // key of an entry (return type of the keys)
+	 * long mapValue(map table, int position);
+	 * bool setAdd(set table, auto key);                        // false if the key is already in the set
+	 * // setHas, setRemove, setSize, setClear, setNext and setKey as the functions of the map
+	 * @endcode
+	 * A string is immutable and stored in one block: its length, its hash (computed at the creation) and its bytes packed by
+	 * 8 in the fields (no other buffer, a short string is a small block of the heap). A string literal "xxx" is an interned
+	 * string (see @ref eci::Interpreter::getLiteral). The builder append in a buffer that grow by doubling: a loop of append
+	 * is linear (no copy of the previous text for each concatenation).
+	 * The hash tables use open addressing in one flat array (the key and the value of an entry are 2 consecutive fields,
+	 * linear probing, size power of 2, load max 3/4, deletion by backward shift: no tombstone). The keys are integers,
+	 * strings (compared by the hash then the text, the same object is equal without reading the text: an interned key is
+	 * found without comparison of the bytes) or other objects (compared by reference). An insertion allocate only when the
+	 * table grow.
+	 */
+	class Container : public eci::Library {
+		public:
+			static const char* const libraryName; //!< Name of the library in the "#import" directive.
+			static const size_t stringHeader = 2; //!< Fields of a string before its bytes (length and hash).
+		private:
+			etk::Vector<etk::Pair<etk::String, eci::NativeCall::builtin>> m_builtins; //!< Functions by name.
+		public:
+			eci::Class* m_string; //!< Class "string" (array of the packed bytes, after the header).
+			eci::Class* m_builder; //!< Class "builder" (length and buffer).
+			eci::Class* m_map; //!< Class "map" (number of entries and table of the key/value pairs).
+			eci::Class* m_set; //!< Class "set" (number of keys and table of the keys).
+		public:
+			Container();
+			virtual ~Container();
+			virtual bool isValid() const {
+				return true;
+			}
+			virtual eci::NativeCall::builtin getBuiltin(const etk::String& _name) const;
+			/**
+			 * @brief Get the names of the classes of the library (declared in the parser by the import).
+			 * @return The class names.
+			 */
+			static etk::Vector<etk::String> getClassNames();
+			/**
+			 * @brief Create a string.
+			 * @param[in] _interpreter Interpreter that own the object.
+			 * @param[in] _data Bytes of the string.
+			 * @param[in] _size Number of bytes.
+			 * @return The new string.
+			 */
+			eci::Object* createString(eci::Interpreter& _interpreter, const char* _data, size_t _size) const;
+			/**
+			 * @brief Get the interned string with the same text (added in the intern table of the interpreter if not found).
+			 * @param[in] _interpreter Interpreter that own the intern table (see @ref eci::Interpreter::getInternTable).
+			 * @param[in] _value String to intern.
+			 * @return The interned string.
+			 */
+			eci::Value intern(eci::Interpreter& _interpreter, const eci::Value& _value) const;
+		private:
+			void addBuiltin(const etk::String& _name, eci::NativeCall::builtin _function);
+	};
+}
+
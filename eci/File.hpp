@@ -13,9 +13,32 @@
 #include <eci/Function.hpp>
 
 namespace eci {
+	class Lexer;
 	class File {
 		public:
-			File(const etk::String& _filename);
+			/**
+			 * @brief Load and parse a file.
+			 * @param[in] _filename Name of the file.
+			 * @param[in] _lexer C++ lexer to use (null: create a new one).
+			 */
+			File(const etk::String& _filename, const ememory::SharedPtr<eci::Lexer>& _lexer=null);
+			/**
+			 * @brief Parse a C++ source that is not in a file (interactive input ...).
+			 * @param[in] _name Name of the source (used in the messages).
+			 * @param[in] _data Source code.
+			 * @param[in] _lexer C++ lexer to use (null: create a new one).
+			 * @param[in] _classNames Name of the classes already defined in the program.
+			 */
+			File(const etk::String& _name,
+			     const etk::String& _data,
+			     const ememory::SharedPtr<eci::Lexer>& _lexer,
+			     const etk::Vector<etk::String>& _classNames);
+			/**
+			 * @brief Create a file restored from an image (see @ref eci::Snapshot): only the name and the imports are known.
+			 * @param[in] _name Name of the file.
+			 * @param[in] _imports Native libraries imported by the file.
+			 */
+			File(const etk::String& _name, const etk::Vector<etk::String>& _imports);
 			~File() {};
 		protected:
 			etk::String m_fileName; //!< Name of the file.
@@ -23,6 +46,41 @@ namespace eci {
 			etk::Vector<ememory::SharedPtr<eci::Function>> m_listFunction; // all function in the file
 			etk::Vector<ememory::SharedPtr<eci::Class>> m_listClass; // all class in the file
 			etk::Vector<ememory::SharedPtr<eci::Variable>> m_listVariable; // all variable in the file
+			ememory::SharedPtr<eci::interpreter::Block> m_init; //!< global variable initialisation of the file.
+			etk::Vector<etk::String> m_listImport; //!< Native libraries imported by the file.
+			bool m_valid; //!< The file has been parsed without error.
+			int64_t m_timeLex; //!< Duration of the lexing (in us).
+			int64_t m_timeParse; //!< Duration of the parsing (in us).
+		public:
+			bool isValid() const {
+				return m_valid;
+			}
+			const etk::String& getName() const {
+				return m_fileName;
+			}
+			const etk::Vector<ememory::SharedPtr<eci::Function>>& getFunctions() const {
+				return m_listFunction;
+			}
+			const etk::Vector<ememory::SharedPtr<eci::Class>>& getClasses() const {
+				return m_listClass;
+			}
+			const etk::Vector<ememory::SharedPtr<eci::Variable>>& getVariables() const {
+				return m_listVariable;
+			}
+			const etk::Vector<etk::String>& getImports() const {
+				return m_listImport;
+			}
+			const ememory::SharedPtr<eci::interpreter::Block>& getInit() const {
+				return m_init;
+			}
+			int64_t getTimeLex() const {
+				return m_timeLex;
+			}
+			int64_t getTimeParse() const {
+				return m_timeParse;
+			}
+		private:
+			void parseCpp(const ememory::SharedPtr<eci::Lexer>& _lexer, const etk::Vector<etk::String>& _classNames);
 	};
 }
 
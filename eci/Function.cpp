@@ -6,12 +6,20 @@
 
 #include <eci/Function.hpp>
 #include <eci/debug.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/Stack.hpp>
 
 
 eci::Function::Function() :
+  m_line(0),
   m_const(false),
   m_static(false),
-  m_visibility(eci::visibilityPublic){
+  m_visibility(eci::visibilityPublic),
+  m_frameSize(0),
+  m_class(null),
+  m_nbCall(0),
+  m_jitState(eci::jitStateNone),
+  m_jitEntry(&eci::Jit::callInterpreter) {
 	
 }
 
@@ -19,8 +27,109 @@ eci::Function::~Function() {
 	
 }
 
-etk::Vector<ememory::SharedPtr<eci::Value>> eci::Function::call(const etk::Vector<ememory::SharedPtr<eci::Value>>& _input) {
-	return etk::Vector<ememory::SharedPtr<eci::Value>>();
+void eci::Function::setNative(const ememory::SharedPtr<eci::NativeCall>& _native) {
+	m_native = _native;
+	m_jitEntry = &eci::Jit::callInterpreter;
+	if (m_native != null) {
+		m_frameSize = m_arguments.size();
+		// a builtin function get the values (called by the interpreter)
+		if (m_native->isBuiltin() == false) {
+			m_jitEntry = &eci::NativeCall::callJit;
+		}
+	}
 }
 
+eci::Value eci::Function::call(eci::Interpreter& _interpreter, size_t _base) const {
+	eci::Stack& stack = _interpreter.getStack();
+	if (_interpreter.isAborted() == true) {
+		return getAbortValue();
+	}
+	if (m_native != null) {
+		return m_native->call(_interpreter, _base);
+	}
+	if (m_lazyBody != null) {
+		int32_t reserved = m_frameSize;
+		if (_interpreter.compileFunction(*this) == false) {
+			// the program can not continue: the callers return without executing more code
+			_interpreter.abort();
+			return getAbortValue();
+		}
+		// the caller reserved the arguments only: the locals are just over them (released with the window).
+		if (m_frameSize > reserved) {
+			stack.reserve(m_frameSize - reserved);
+		}
+	}
+	if (m_body == null) {
+		ECI_ERROR("Call a function without body : '" << m_name << "'");
+		_interpreter.abort();
+		return getAbortValue();
+	}
+	if (m_jitState == eci::jitStateNone) {
+		eci::Jit& jit = _interpreter.getJit();
+		if (    jit.getEnable() == true
+		     && ++m_nbCall >= jit.getThreshold()) {
+			jit.compile(_interpreter, *this);
+		}
+	}
+	if (m_jitState == eci::jitStateCompiled) {
+		int64_t arguments[eci::Jit::maxArgument];
+		for (size_t iii=0; iii<m_arguments.size(); ++iii) {
+			arguments[iii] = eci::Jit::toRaw(stack.get(_base+iii).convert(m_arguments[iii].getValueType()));
+		}
+		stack.startNative();
+		int64_t ret = m_jitEntry(arguments, &_interpreter, this);
+		if (_interpreter.isAborted() == true) {
+			// the native code has called a function that abort the execution
+			_interpreter.abort();
+			return getAbortValue();
+		}
+		if (m_return.size() == 0) {
+			return eci::Value();
+		}
+		return eci::Jit::fromRaw(ret, m_return[0].getValueType());
+	}
+	eci::Frame* frame = stack.pushFrame();
+	if (frame == null) {
+		ECI_ERROR("Max call depth reached in : '" << m_name << "'");
+		// the result of the call does not exist: the callers return without executing more code
+		_interpreter.abort();
+		return getAbortValue();
+	}
+	frame->m_interpreter = &_interpreter;
+	frame->m_stack = &stack;
+	frame->m_function = this;
+	frame->m_base = _base;
+	frame->m_state = eci::frameStateNormal;
+	frame->m_return = eci::Value();
+	// safe point of the profiler
+	if (_interpreter.getProfiler().isPending() == true) {
+		_interpreter.getProfiler().sample(stack);
+	}
+	executeBody(*frame);
+	eci::Value ret = frame->m_return;
+	stack.popFrame();
+	if (_interpreter.isAborted() == true) {
+		_interpreter.abort();
+		return getAbortValue();
+	}
+	if (m_return.size() == 0) {
+		return eci::Value();
+	}
+	return ret.convert(m_return[0].getValueType());
+}
+
+void eci::Function::executeBody(eci::Frame& _frame) const {
+	while (true) {
+		_frame.m_state = eci::frameStateNormal;
+		m_body->execute(_frame);
+		if (    _frame.m_state != eci::frameStateTailCall
+		     || _frame.m_interpreter->isAborted() == true) {
+			return;
+		}
+		// safe point of the profiler (the tail call is a cycle)
+		if (_frame.m_interpreter->getProfiler().isPending() == true) {
+			_frame.m_interpreter->getProfiler().sample(*_frame.m_stack);
+		}
+	}
+}
 
@@ -10,22 +10,165 @@
 #include <eci/visibility.hpp>
 #include <eci/Variable.hpp>
 #include <eci/Value.hpp>
+#include <eci/interpreter/Element.hpp>
+#include <eci/Jit.hpp>
+#include <eci/Library.hpp>
 #include <ememory/memory.hpp>
 
 namespace eci {
+	class Interpreter;
+	class Class;
+	/**
+	 * @brief Body of a function that is not parsed yet (the parser keep its tokens until the first call).
+	 */
+	class LazyBody {
+		public:
+			virtual ~LazyBody() {}
+			/**
+			 * @brief Parse the body.
+			 * @return The code of the function (null on error).
+			 */
+			virtual ememory::SharedPtr<eci::interpreter::Block> parse() = 0;
+	};
 	class Function {
+		friend class eci::Jit;
 		public:
 			Function();
 			~Function();
 		protected:
 			etk::String m_name; //!< Function Name.
+			int32_t m_line; //!< Line of the declaration in the file (0 if unknown).
 			bool m_const; //!< The function is const.
 			bool m_static; //!< function is static.
 			enum eci::visibility m_visibility; //!< Visibility of the function
 			etk::Vector<eci::Variable> m_return; //!< return value.
 			etk::Vector<eci::Variable> m_arguments; //!< return value.
+			ememory::SharedPtr<eci::interpreter::Block> m_body; //!< Code of the function (null for a simple declaration or a body not parsed yet).
+			ememory::SharedPtr<eci::LazyBody> m_lazyBody; //!< Body to parse on the first call (null when the body is parsed).
+			ememory::SharedPtr<eci::NativeCall> m_native; //!< C function of a library bound on the declaration (null for a script function).
+			int32_t m_frameSize; //!< Number of slot needed in the frame (arguments + locals), set by the resolver.
+			const eci::Class* m_class; //!< Class of a method (the object is the first argument "this"), null for a function.
+			mutable int32_t m_nbCall; //!< Number of call executed by the interpreter (select the hot functions for the JIT).
+			mutable enum eci::jitState m_jitState; //!< State of the native code.
+			mutable eci::jitEntry m_jitEntry; //!< Native entry point (call the interpreter while the function is not compiled).
+		public:
+			/**
+			 * @brief Execute the function.
+			 * @param[in] _interpreter Interpreter that execute the function.
+			 * @param[in] _base Index in the value stack of the window of the function: the arguments are already
+			 *                  set in the first slots, the window size is @ref getFrameSize.
+			 * @return The return value (in the declared return type).
+			 */
+			eci::Value call(eci::Interpreter& _interpreter, size_t _base) const;
+			/**
+			 * @brief Execute the body in a frame: a tail call of the function (see @ref eci::interpreter::Return::m_tailCall)
+			 * set the new arguments in the frame and the body is executed again (constant stack space).
+			 * @param[in] _frame Frame of the call (the arguments are set).
+			 */
+			void executeBody(eci::Frame& _frame) const;
+			/**
+			 * @brief Get the value returned by a call when the execution is aborted (see @ref eci::Interpreter::abort).
+			 * @return The zero of the return type (the expression of the caller does not report an error on it).
+			 */
+			eci::Value getAbortValue() const {
+				if (m_return.size() == 0) {
+					return eci::Value();
+				}
+				return eci::Value().convert(m_return[0].getValueType());
+			}
 			
-			etk::Vector<ememory::SharedPtr<eci::Value>> call(const etk::Vector<ememory::SharedPtr<eci::Value>>& _input);
+			const etk::String& getName() const {
+				return m_name;
+			}
+			void setName(const etk::String& _name) {
+				m_name = _name;
+			}
+			int32_t getLine() const {
+				return m_line;
+			}
+			void setLine(int32_t _value) {
+				m_line = _value;
+			}
+			bool getConst() const {
+				return m_const;
+			}
+			void setConst(bool _value) {
+				m_const = _value;
+			}
+			bool getStatic() const {
+				return m_static;
+			}
+			void setStatic(bool _value) {
+				m_static = _value;
+			}
+			enum eci::visibility getVisibility() const {
+				return m_visibility;
+			}
+			void setVisibility(enum eci::visibility _value) {
+				m_visibility = _value;
+			}
+			const etk::Vector<eci::Variable>& getReturn() const {
+				return m_return;
+			}
+			void addReturn(const eci::Variable& _value) {
+				m_return.pushBack(_value);
+			}
+			const etk::Vector<eci::Variable>& getArguments() const {
+				return m_arguments;
+			}
+			void addArgument(const eci::Variable& _value) {
+				m_arguments.pushBack(_value);
+			}
+			const ememory::SharedPtr<eci::interpreter::Block>& getBody() const {
+				return m_body;
+			}
+			void setBody(const ememory::SharedPtr<eci::interpreter::Block>& _body) {
+				m_body = _body;
+			}
+			const ememory::SharedPtr<eci::LazyBody>& getLazyBody() const {
+				return m_lazyBody;
+			}
+			void setLazyBody(const ememory::SharedPtr<eci::LazyBody>& _body) {
+				m_lazyBody = _body;
+			}
+			const ememory::SharedPtr<eci::NativeCall>& getNative() const {
+				return m_native;
+			}
+			/**
+			 * @brief Bind a C function on the declaration (the native code of the JIT call it directly).
+			 * @param[in] _native Bound C function.
+			 */
+			void setNative(const ememory::SharedPtr<eci::NativeCall>& _native);
+			/**
+			 * @brief Check if the function is defined (parsed body or body to parse on the first call).
+			 * @return false for a simple declaration.
+			 */
+			bool hasBody() const {
+				return    m_body != null
+				       || m_lazyBody != null;
+			}
+			int32_t getFrameSize() const {
+				return m_frameSize;
+			}
+			void setFrameSize(int32_t _value) {
+				m_frameSize = _value;
+			}
+			const eci::Class* getClass() const {
+				return m_class;
+			}
+			void setClass(const eci::Class* _value) {
+				m_class = _value;
+			}
+			enum eci::jitState getJitState() const {
+				return m_jitState;
+			}
+			/**
+			 * @brief Get the address of the native entry point (the native code call the function through it).
+			 * @return Address of the entry point.
+			 */
+			const eci::jitEntry* getJitEntryAddress() const {
+				return &m_jitEntry;
+			}
 			
 			// 3 step:
 			//    - first get Tockens (returns , names, const, parameters, codes
@@ -33,4 +176,3 @@ namespace eci {
 			//    - all is linked
 	};
 }
-
@@ -0,0 +1,75 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Handle.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/Function.hpp>
+#include <eci/debug.hpp>
+
+bool eci::HandleBase::bind(eci::Interpreter& _interpreter,
+                           const etk::String& _name,
+                           enum eci::valueType _return,
+                           const enum eci::valueType* _arguments,
+                           size_t _nbArgument) {
+	m_interpreter = null;
+	m_stack = null;
+	m_function = null;
+	if (_interpreter.isFrozen() == true) {
+		ECI_ERROR("Can not execute a module : '" << _name << "'");
+		return false;
+	}
+	int32_t id = _interpreter.findFunction(_name);
+	if (id < 0) {
+		ECI_ERROR("Bind an unknown function : '" << _name << "'");
+		return false;
+	}
+	const eci::Function& function = *_interpreter.getFunction(id);
+	if (function.getClass() != null) {
+		ECI_ERROR("Bind a method is not supported : '" << _name << "'");
+		return false;
+	}
+	enum eci::valueType returnType = eci::valueTypeVoid;
+	if (function.getReturn().size() != 0) {
+		returnType = function.getReturn()[0].getValueType();
+	}
+	if (returnType != _return) {
+		ECI_ERROR("Bind function '" << _name << "' that return '" << eci::getValueTypeName(returnType)
+		          << "' with the return type '" << eci::getValueTypeName(_return) << "'");
+		return false;
+	}
+	if (function.getArguments().size() != _nbArgument) {
+		ECI_ERROR("Bind function '" << _name << "' with " << function.getArguments().size()
+		          << " arguments with " << _nbArgument << " argument types");
+		return false;
+	}
+	for (size_t iii=0; iii<_nbArgument; ++iii) {
+		if (function.getArguments()[iii].getValueType() != _arguments[iii]) {
+			ECI_ERROR("Bind function '" << _name << "' argument '" << function.getArguments()[iii].getName() << "' is '"
+			          << eci::getValueTypeName(function.getArguments()[iii].getValueType())
+			          << "' with the type '" << eci::getValueTypeName(_arguments[iii]) << "'");
+			return false;
+		}
+	}
+	// the body is parsed once: the frame size is known for all the calls
+	if (    function.getLazyBody() != null
+	     && _interpreter.compileFunction(function) == false) {
+		return false;
+	}
+	if (function.hasBody() == false) {
+		ECI_ERROR("Bind a function without body : '" << _name << "'");
+		return false;
+	}
+	m_interpreter = &_interpreter;
+	m_stack = &_interpreter.getStack();
+	m_function = &function;
+	m_frameSize = function.getFrameSize();
+	return true;
+}
+
+eci::Value eci::HandleBase::execute(size_t _base) const {
+	return m_function->call(*m_interpreter, _base);
+}
+
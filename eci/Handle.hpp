@@ -0,0 +1,144 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/String.hpp>
+#include <eci/Value.hpp>
+#include <eci/Stack.hpp>
+
+namespace eci {
+	class Interpreter;
+	class Function;
+	/**
+	 * @brief Get the value type of a native C++ type.
+	 * @return The type (valueTypeVoid for void).
+	 */
+	template<typename T> inline enum eci::valueType getNativeType() {
+		return eci::Value(T()).m_type;
+	}
+	template<> inline enum eci::valueType getNativeType<void>() {
+		return eci::valueTypeVoid;
+	}
+	/**
+	 * @brief Convert a returned value in a native C++ type.
+	 * @param[in] _value Value returned by the function.
+	 * @return The native value.
+	 */
+	template<typename T> inline T getNativeValue(const eci::Value& _value) {
+		return _value.get<T>();
+	}
+	template<> inline void getNativeValue<void>(const eci::Value&) {
+		
+	}
+	template<> inline eci::Object* getNativeValue<eci::Object*>(const eci::Value& _value) {
+		if (_value.m_type != eci::valueTypeObject) {
+			return null;
+		}
+		return _value.m_object;
+	}
+	/**
+	 * @brief Function of an interpreter bound by its name (not typed part of @ref eci::Handle).
+	 */
+	class HandleBase {
+		protected:
+			eci::Interpreter* m_interpreter; //!< Interpreter that execute the function (null when not bound).
+			eci::Stack* m_stack; //!< Value stack of the interpreter.
+			const eci::Function* m_function; //!< Bound function (null when not bound).
+			size_t m_frameSize; //!< Number of slot reserved for a call.
+		protected:
+			HandleBase() :
+			  m_interpreter(null),
+			  m_stack(null),
+			  m_function(null),
+			  m_frameSize(0) {
+				
+			}
+			/**
+			 * @brief Find the function, check its signature and parse its body.
+			 * @param[in] _interpreter Interpreter that own the function.
+			 * @param[in] _name Name of the function.
+			 * @param[in] _return Return type expected by the caller.
+			 * @param[in] _arguments Argument types given by the caller.
+			 * @param[in] _nbArgument Number of argument.
+			 * @return true if the function is bound.
+			 */
+			bool bind(eci::Interpreter& _interpreter,
+			          const etk::String& _name,
+			          enum eci::valueType _return,
+			          const enum eci::valueType* _arguments,
+			          size_t _nbArgument);
+			/**
+			 * @brief Execute the function (the arguments are set in the reserved window).
+			 * @param[in] _base Index of the window in the value stack.
+			 * @return The value returned by the function.
+			 */
+			eci::Value execute(size_t _base) const;
+			static void setArgument(eci::Stack&, size_t) {
+				// end of the argument list
+			}
+			template<typename T, typename... ARGS>
+			static void setArgument(eci::Stack& _stack, size_t _slot, T _value, ARGS... _args) {
+				_stack.get(_slot) = eci::Value(_value);
+				setArgument(_stack, _slot+1, _args...);
+			}
+		public:
+			bool isValid() const {
+				return m_function != null;
+			}
+			/**
+			 * @brief Get the bound function.
+			 * @return The function (null when not bound).
+			 */
+			const eci::Function* getFunction() const {
+				return m_function;
+			}
+	};
+	/**
+	 * @brief Typed call of a script function from the host application: the function is searched and its signature
+	 * checked once, a call set the native arguments in the value stack of the interpreter and execute the function
+	 * (no name search, no string compare and no allocation when the stack has reached its working size).
+	 * The types must be the declared types of the function (int32_t for "int", double for "double" ...).
+	 * A handle use only its interpreter: handles of separate interpreters can be called from separate threads.
+	 * @code
+	 * eci::Handle<double, double, int32_t> scale(interpreter, "scale");
+	 * double value = scale(2.5, 4);
+	 * @endcode
+	 */
+	template<typename RET, typename... ARGS>
+	class Handle : public eci::HandleBase {
+		public:
+			/**
+			 * @brief Bind a function (the global variables must be initialized before the first call, see @ref eci::Interpreter::main).
+			 * @param[in] _interpreter Interpreter that own the function.
+			 * @param[in] _name Name of the function.
+			 */
+			Handle(eci::Interpreter& _interpreter, const etk::String& _name) {
+				enum eci::valueType arguments[] = { eci::getNativeType<ARGS>()..., eci::valueTypeVoid };
+				bind(_interpreter, _name, eci::getNativeType<RET>(), arguments, sizeof...(ARGS));
+			}
+			/**
+			 * @brief Call the function.
+			 * @param[in] _args Arguments of the function.
+			 * @return The value returned by the function (0 if the handle is not bound).
+			 */
+			RET call(ARGS... _args) const {
+				eci::Value ret;
+				if (m_function != null) {
+					size_t base = m_stack->reserve(m_frameSize);
+					setArgument(*m_stack, base, _args...);
+					ret = execute(base);
+					m_stack->release(base);
+				}
+				return eci::getNativeValue<RET>(ret);
+			}
+			RET operator()(ARGS... _args) const {
+				return call(_args...);
+			}
+	};
+}
+
@@ -0,0 +1,249 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Heap.hpp>
+#include <eci/debug.hpp>
+#include <stdlib.h>
+
+void* eci::Heap::Arena::allocate(size_t _size) {
+	if (_size > eci::Heap::pageSize) {
+		void* page = malloc(_size);
+		if (page == null) {
+			return null;
+		}
+		m_pages.pushBack(etk::makePair(page, _size));
+		m_sizeReserved += _size;
+		return page;
+	}
+	if (m_current + _size > m_end) {
+		if (m_current != null) {
+			m_sizeLost += m_end - m_current;
+		}
+		if (    m_current != null
+		     && m_page + 1 < m_pages.size()) {
+			// page kept by a rewind
+			++m_page;
+			m_current = static_cast<uint8_t*>(m_pages[m_page].first);
+			m_end = m_current + m_pages[m_page].second;
+		} else {
+			uint8_t* page = static_cast<uint8_t*>(malloc(eci::Heap::pageSize));
+			if (page == null) {
+				return null;
+			}
+			m_pages.pushBack(etk::makePair(static_cast<void*>(page), eci::Heap::pageSize));
+			m_sizeReserved += eci::Heap::pageSize;
+			m_page = m_pages.size() - 1;
+			m_current = page;
+			m_end = page + eci::Heap::pageSize;
+		}
+	}
+	void* out = m_current;
+	m_current += _size;
+	return out;
+}
+
+void eci::Heap::Arena::clear() {
+	for (auto &it : m_pages) {
+		free(it.first);
+	}
+	m_pages.clear();
+	m_current = null;
+	m_end = null;
+	m_sizeLost = 0;
+	m_sizeReserved = 0;
+	m_page = 0;
+}
+
+void eci::Heap::Arena::rewind() {
+	m_sizeLost = 0;
+	m_page = 0;
+	if (m_pages.size() == 0) {
+		m_current = null;
+		m_end = null;
+		return;
+	}
+	m_current = static_cast<uint8_t*>(m_pages[0].first);
+	m_end = m_current + m_pages[0].second;
+}
+
+bool eci::Heap::Arena::contain(const void* _pointer) const {
+	const uint8_t* pointer = static_cast<const uint8_t*>(_pointer);
+	for (auto &it : m_pages) {
+		const uint8_t* page = static_cast<const uint8_t*>(it.first);
+		if (    pointer >= page
+		     && pointer < page + it.second) {
+			return true;
+		}
+	}
+	return false;
+}
+
+eci::Heap::Heap() :
+  m_regionDepth(0),
+  m_nbRegionBlock(0),
+  m_sizeRegion(0),
+  m_nbRegionReset(0),
+  m_nbAllocation(0),
+  m_nbRelease(0),
+  m_nbLarge(0),
+  m_sizeLarge(0),
+  m_large(null) {
+	// 16 bytes steps up to 256, then 128 bytes steps
+	for (size_t size=alignment; size<=256; size+=alignment) {
+		m_classes.pushBack(SizeClass(size));
+	}
+	for (size_t size=384; size<=maxSmallSize; size+=128) {
+		m_classes.pushBack(SizeClass(size));
+	}
+}
+
+eci::Heap::~Heap() {
+	// the blocks that are not released are freed with their pages
+	m_arena.clear();
+	m_region.clear();
+	while (m_large != null) {
+		Large* previous = m_large->m_previous;
+		free(m_large);
+		m_large = previous;
+	}
+}
+
+size_t eci::Heap::getClassId(size_t _size) {
+	if (_size <= 256) {
+		return (etk::max(_size, size_t(1)) + alignment - 1) / alignment - 1;
+	}
+	return 16 + (_size - 256 + 127) / 128 - 1;
+}
+
+void* eci::Heap::allocate(size_t _size) {
+	if (_size > maxBlockSize) {
+		return null;
+	}
+	++m_nbAllocation;
+	if (    m_regionDepth > 0
+	     && _size <= maxSmallSize) {
+		size_t size = (etk::max(_size, size_t(1)) + alignment - 1) & ~(alignment - 1);
+		void* out = m_region.allocate(size);
+		if (out != null) {
+			++m_nbRegionBlock;
+			m_sizeRegion += size;
+		}
+		return out;
+	}
+	if (_size > maxSmallSize) {
+		Large* block = static_cast<Large*>(malloc(sizeof(Large) + _size));
+		if (block == null) {
+			return null;
+		}
+		++m_nbLarge;
+		m_sizeLarge += _size;
+		block->m_previous = m_large;
+		block->m_next = null;
+		if (m_large != null) {
+			m_large->m_next = block;
+		}
+		m_large = block;
+		return block + 1;
+	}
+	SizeClass& sizeClass = m_classes[getClassId(_size)];
+	++sizeClass.m_nbUsed;
+	if (sizeClass.m_freeList != null) {
+		void* out = sizeClass.m_freeList;
+		sizeClass.m_freeList = *static_cast<void**>(out);
+		--sizeClass.m_nbFree;
+		return out;
+	}
+	void* out = m_arena.allocate(sizeClass.m_size);
+	if (out == null) {
+		--sizeClass.m_nbUsed;
+	}
+	return out;
+}
+
+void eci::Heap::release(void* _pointer, size_t _size) {
+	if (_pointer == null) {
+		return;
+	}
+	++m_nbRelease;
+	if (    _size <= maxSmallSize
+	     && m_region.m_pages.size() != 0
+	     && m_region.contain(_pointer) == true) {
+		// freed by the reset of the region
+		--m_nbRegionBlock;
+		m_sizeRegion -= (etk::max(_size, size_t(1)) + alignment - 1) & ~(alignment - 1);
+		return;
+	}
+	if (_size > maxSmallSize) {
+		--m_nbLarge;
+		m_sizeLarge -= _size;
+		Large* block = static_cast<Large*>(_pointer) - 1;
+		if (block->m_previous != null) {
+			block->m_previous->m_next = block->m_next;
+		}
+		if (block->m_next != null) {
+			block->m_next->m_previous = block->m_previous;
+		} else {
+			m_large = block->m_previous;
+		}
+		free(block);
+		return;
+	}
+	SizeClass& sizeClass = m_classes[getClassId(_size)];
+	--sizeClass.m_nbUsed;
+	*static_cast<void**>(_pointer) = sizeClass.m_freeList;
+	sizeClass.m_freeList = _pointer;
+	++sizeClass.m_nbFree;
+}
+
+void eci::Heap::beginRegion() {
+	++m_regionDepth;
+}
+
+bool eci::Heap::endRegion() {
+	if (m_regionDepth <= 0) {
+		ECI_ERROR("Close a region that is not opened");
+		return false;
+	}
+	--m_regionDepth;
+	if (m_regionDepth != 0) {
+		return true;
+	}
+	if (m_nbRegionBlock != 0) {
+		ECI_WARNING("Reset of the region refused: " << m_nbRegionBlock << " block(s) still used");
+		return false;
+	}
+	m_region.rewind();
+	++m_nbRegionReset;
+	return true;
+}
+
+size_t eci::Heap::getSizeUsed() const {
+	size_t out = m_sizeLarge + m_sizeRegion;
+	for (auto &it : m_classes) {
+		out += it.m_nbUsed * it.m_size;
+	}
+	return out;
+}
+
+size_t eci::Heap::getSizeReserved() const {
+	return m_arena.m_sizeReserved + m_region.m_sizeReserved + m_sizeLarge;
+}
+
+size_t eci::Heap::getSizeFree() const {
+	size_t out = 0;
+	for (auto &it : m_classes) {
+		out += it.m_nbFree * it.m_size;
+	}
+	return out;
+}
+
+double eci::Heap::getFragmentation() const {
+	size_t reserved = getSizeReserved();
+	if (reserved == 0) {
+		return 0.0;
+	}
+	return double(reserved - getSizeUsed()) / double(reserved);
+}
@@ -0,0 +1,175 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/Vector.hpp>
+#include <etk/Pair.hpp>
+
+namespace eci {
+	/**
+	 * @brief Memory of the script objects: the small blocks are allocated in size classes (a free list per class
+	 * and a bump pointer in the current page), the big blocks are allocated with malloc. An interpreter is executed
+	 * by one thread: its heap is the pool of this thread (no lock).
+	 * A region can be opened around a request: its small blocks are allocated with a bump pointer and all its pages
+	 * are reset in one step when it is closed, only if none of its blocks is still used.
+	 */
+	class Heap {
+		public:
+			static const size_t pageSize = 64*1024; //!< Size of the pages allocated for the small blocks.
+			static const size_t maxSmallSize = 1024; //!< Bigger blocks are allocated with malloc.
+			static const size_t alignment = 16; //!< Alignment of all the blocks.
+			static const size_t maxBlockSize = size_t(1) << 32; //!< Bigger blocks are refused (the size of an array come from the script).
+		private:
+			/**
+			 * @brief Blocks of a size class.
+			 */
+			class SizeClass {
+				public:
+					size_t m_size; //!< Size of the blocks.
+					void* m_freeList; //!< Released blocks (the next block is stored in the block).
+					size_t m_nbUsed; //!< Number of allocated blocks.
+					size_t m_nbFree; //!< Number of blocks in the free list.
+					SizeClass(size_t _size=0) :
+					  m_size(_size),
+					  m_freeList(null),
+					  m_nbUsed(0),
+					  m_nbFree(0) {
+						
+					}
+			};
+			/**
+			 * @brief Pages with a bump pointer.
+			 */
+			class Arena {
+				public:
+					etk::Vector<etk::Pair<void*, size_t>> m_pages; //!< All the pages of the arena (and their size).
+					uint8_t* m_current; //!< Next free byte in the last page.
+					uint8_t* m_end; //!< End of the last page.
+					size_t m_sizeLost; //!< End of the previous pages that can not be used.
+					size_t m_sizeReserved; //!< Size of all the pages.
+					size_t m_page; //!< Index of the current page.
+					Arena() :
+					  m_current(null),
+					  m_end(null),
+					  m_sizeLost(0),
+					  m_sizeReserved(0),
+					  m_page(0) {
+						
+					}
+					/**
+					 * @brief Get a new block (a block bigger than a page has its own page).
+					 * @param[in] _size Size of the block (multiple of the alignment).
+					 * @return The block (null if the memory is full).
+					 */
+					void* allocate(size_t _size);
+					/**
+					 * @brief Release all the pages.
+					 */
+					void clear();
+					/**
+					 * @brief Restart the allocation at the first page (the pages are kept and reused).
+					 */
+					void rewind();
+					/**
+					 * @brief Check if a block is in a page of the arena.
+					 * @param[in] _pointer Block to check.
+					 * @return true if the block is in the arena.
+					 */
+					bool contain(const void* _pointer) const;
+			};
+			/**
+			 * @brief Header of a big block (the big blocks are linked to be freed with the heap).
+			 */
+			class Large {
+				public:
+					Large* m_previous; //!< Previous big block.
+					Large* m_next; //!< Next big block.
+			};
+			etk::Vector<SizeClass> m_classes; //!< Size classes of the small blocks.
+			Arena m_arena; //!< Pages of the size classes.
+			Arena m_region; //!< Pages of the region.
+			int32_t m_regionDepth; //!< Number of region opened (the small blocks are in the region when > 0).
+			size_t m_nbRegionBlock; //!< Number of blocks of the region that are not released.
+			size_t m_sizeRegion; //!< Size of the blocks of the region that are not released.
+			size_t m_nbRegionReset; //!< Number of reset of the region.
+			size_t m_nbAllocation; //!< Total number of allocation.
+			size_t m_nbRelease; //!< Total number of release.
+			size_t m_nbLarge; //!< Number of big blocks currently allocated.
+			size_t m_sizeLarge; //!< Size of the big blocks currently allocated.
+			Large* m_large; //!< Last big block allocated (null if none).
+		public:
+			Heap();
+			~Heap();
+			/**
+			 * @brief Allocate a block.
+			 * @param[in] _size Size of the block.
+			 * @return The block (aligned on @ref alignment), null if it is bigger than @ref maxBlockSize or if the memory is full.
+			 */
+			void* allocate(size_t _size);
+			/**
+			 * @brief Release a block.
+			 * @param[in] _pointer Block to release.
+			 * @param[in] _size Size given at the allocation.
+			 */
+			void release(void* _pointer, size_t _size);
+			/**
+			 * @brief Open a region: the next small blocks are allocated in the region.
+			 */
+			void beginRegion();
+			/**
+			 * @brief Close a region: when the last region is closed, its pages are reset in one step. The reset is
+			 * refused while a block of the region is not released (an object still use it): the blocks stay valid and
+			 * the pages are reset by the close of a later region.
+			 * @return true if the region is reset, false if it is still used or not opened.
+			 */
+			bool endRegion();
+			bool inRegion() const {
+				return m_regionDepth > 0;
+			}
+			size_t getNbRegionBlock() const {
+				return m_nbRegionBlock;
+			}
+			size_t getNbRegionReset() const {
+				return m_nbRegionReset;
+			}
+			size_t getNbAllocation() const {
+				return m_nbAllocation;
+			}
+			size_t getNbRelease() const {
+				return m_nbRelease;
+			}
+			/**
+			 * @brief Get the size of the blocks currently allocated (rounded on the size classes).
+			 * @return Size in byte.
+			 */
+			size_t getSizeUsed() const;
+			/**
+			 * @brief Get the size of the memory reserved by the heap (pages and big blocks).
+			 * @return Size in byte.
+			 */
+			size_t getSizeReserved() const;
+			/**
+			 * @brief Get the size of the released blocks that wait in the free lists.
+			 * @return Size in byte.
+			 */
+			size_t getSizeFree() const;
+			/**
+			 * @brief Get the fragmentation of the heap: part of the reserved memory that is not used by a block.
+			 * @return Ratio in [0..1].
+			 */
+			double getFragmentation() const;
+		private:
+			/**
+			 * @brief Get the size class of a small block.
+			 * @param[in] _size Size of the block (<= @ref maxSmallSize).
+			 * @return Index of the size class.
+			 */
+			static size_t getClassId(size_t _size);
+	};
+}
+
@@ -0,0 +1,90 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <atomic>
+
+namespace eci {
+	class Class;
+	/**
+	 * @brief Inline cache of an access site ("xxx.yyy" or "xxx.yyy(...)"): keep the result of the lookup by name
+	 * (offset of the field or index of the method) for the classes seen on the site. A monomorphic site cost
+	 * one compare, a polymorphic site some compares, and a megamorphic site (more than @ref maxEntry classes)
+	 * use the lookup by name for the classes that are not in the cache.
+	 * The code of a module is executed by several threads: an entry is reserved by one thread, and its class is
+	 * published after its value (a reader see a full entry or an empty one, a class can be in 2 entries).
+	 */
+	class InlineCache {
+		public:
+			static const int32_t maxEntry = 4; //!< Number of classes kept in the cache.
+		private:
+			std::atomic<const eci::Class*> m_class[maxEntry]; //!< Classes seen on the site (null: entry not published).
+			int32_t m_value[maxEntry]; //!< Result of the lookup for each class.
+			std::atomic<int32_t> m_reserved; //!< Number of entries reserved.
+			std::atomic<bool> m_megamorphic; //!< More classes than entries have been seen.
+		public:
+			InlineCache() :
+			  m_reserved(0),
+			  m_megamorphic(false) {
+				for (int32_t iii=0; iii<maxEntry; ++iii) {
+					m_class[iii].store(null, std::memory_order_relaxed);
+				}
+			}
+			/**
+			 * @brief Get the cached result of a class.
+			 * @param[in] _class Class of the object.
+			 * @return The cached value or -1 if the class is not in the cache.
+			 */
+			int32_t find(const eci::Class* _class) const {
+				for (int32_t iii=0; iii<maxEntry; ++iii) {
+					if (m_class[iii].load(std::memory_order_acquire) == _class) {
+						return m_value[iii];
+					}
+				}
+				return -1;
+			}
+			/**
+			 * @brief Add the result of a lookup in the cache.
+			 * @param[in] _class Class of the object.
+			 * @param[in] _value Result of the lookup.
+			 */
+			void add(const eci::Class* _class, int32_t _value) {
+				if (m_reserved.load(std::memory_order_relaxed) >= maxEntry) {
+					m_megamorphic.store(true, std::memory_order_relaxed);
+					return;
+				}
+				int32_t id = m_reserved.fetch_add(1, std::memory_order_relaxed);
+				if (id >= maxEntry) {
+					m_megamorphic.store(true, std::memory_order_relaxed);
+					return;
+				}
+				m_value[id] = _value;
+				m_class[id].store(_class, std::memory_order_release);
+			}
+			/**
+			 * @brief Get the number of classes in the cache.
+			 * @return 0 (not executed), 1 (monomorphic) ... @ref maxEntry (polymorphic).
+			 */
+			int32_t getSize() const {
+				int32_t out = 0;
+				for (int32_t iii=0; iii<maxEntry; ++iii) {
+					if (m_class[iii].load(std::memory_order_relaxed) != null) {
+						++out;
+					}
+				}
+				return out;
+			}
+			/**
+			 * @brief Check if the site has seen more classes than the cache size.
+			 * @return true if the site is megamorphic.
+			 */
+			bool isMegamorphic() const {
+				return m_megamorphic.load(std::memory_order_relaxed);
+			}
+	};
+}
@@ -5,23 +5,634 @@
  */
 
 #include <eci/Interpreter.hpp>
+#include <eci/Resolver.hpp>
+#include <eci/Kernel.hpp>
+#include <eci/Container.hpp>
+#include <eci/lang/ParserCpp.hpp>
 #include <eci/debug.hpp>
+#include <new>
 
-eci::Interpreter::Interpreter() {
+eci::Interpreter::Interpreter() :
+  m_nbObject(0),
+  m_nbCacheMiss(0),
+  m_valid(true),
+  m_lazyCompilation(true),
+  m_frozen(false),
+  m_globalInitialized(false),
+  m_aborted(false) {
 	
 }
 
+eci::Interpreter::Interpreter(const ememory::SharedPtr<const eci::Interpreter>& _module) :
+  m_libraries(_module->m_libraries),
+  m_files(_module->m_files),
+  m_functions(_module->m_functions),
+  m_globals(_module->m_globals),
+  m_classes(_module->m_classes),
+  m_literals(_module->m_literals),
+  m_nbObject(0),
+  m_nbCacheMiss(0),
+  m_valid(_module->m_valid),
+  m_optimizer(_module->m_optimizer),
+  m_lazyCompilation(_module->m_lazyCompilation),
+  m_module(_module),
+  m_frozen(false),
+  m_globalInitialized(true),
+  m_aborted(false) {
+	if (_module->m_frozen == false) {
+		ECI_ERROR("Create an interpreter on a program that is not a module");
+		m_valid = false;
+	}
+	// the state of the native code is in the shared functions
+	m_jit.setAvailable(false);
+	// an object referenced by several globals is copied once
+	etk::Map<const eci::Object*, eci::Object*> clones;
+	m_globalValues.resize(_module->m_globalValues.size());
+	for (size_t iii=0; iii<m_globalValues.size(); ++iii) {
+		m_globalValues[iii] = cloneValue(_module->m_globalValues[iii], clones);
+	}
+	// the strings of the literals are created by each interpreter (on the first use)
+	m_literalValues.resize(m_literals.size());
+}
+
 eci::Interpreter::~Interpreter() {
 	
 }
 
+const ememory::SharedPtr<eci::Lexer>& eci::Interpreter::getLexer() {
+	if (m_lexer == null) {
+		m_lexer = eci::ParserCpp::createLexer();
+	}
+	return m_lexer;
+}
+
 void eci::Interpreter::addFile(const etk::String& _filename) {
-	// TODO : Check if file is not previously loaded ...
-	m_files.pushBack(eci::File(_filename));
+	if (m_frozen == true) {
+		ECI_ERROR("Can not add a file in a module : '" << _filename << "'");
+		return;
+	}
+	for (auto &it : m_files) {
+		if (it->getName() == _filename) {
+			ECI_WARNING("File already loaded : '" << _filename << "'");
+			return;
+		}
+	}
+	m_files.pushBack(ememory::makeShared<eci::File>(_filename, getLexer()));
+	if (link(*m_files.back()) == false) {
+		m_valid = false;
+	}
+}
+
+bool eci::Interpreter::addSource(const etk::String& _name, const etk::String& _data) {
+	if (m_frozen == true) {
+		ECI_ERROR("Can not add a source in a module : '" << _name << "'");
+		return false;
+	}
+	etk::Vector<etk::String> classNames;
+	for (auto &it : m_classes) {
+		classNames.pushBack(it->getName());
+	}
+	m_files.pushBack(ememory::makeShared<eci::File>(_name, _data, getLexer(), classNames));
+	// keep the current program: a definition can replace a declaration in the function table.
+	etk::Vector<ememory::SharedPtr<eci::Function>> functions = m_functions;
+	size_t nbGlobal = m_globals.size();
+	size_t nbClass = m_classes.size();
+	size_t nbLibrary = m_libraries.size();
+	if (link(*m_files.back()) == false) {
+		m_functions = functions;
+		m_globals.resize(nbGlobal);
+		m_globalValues.resize(nbGlobal);
+		m_classes.resize(nbClass);
+		// the classes of a library are added with the library
+		m_libraries.resize(nbLibrary);
+		m_files.popBack();
+		return false;
+	}
+	m_aborted = false;
+	initGlobals(*m_files.back());
+	if (m_aborted == true) {
+		// the source stay in the program: the next inputs can use its functions
+		ECI_ERROR("The initialization of the global variables of '" << _name << "' is aborted");
+	}
+	return true;
+}
+
+bool eci::Interpreter::link(eci::File& _file) {
+	if (_file.isValid() == false) {
+		return false;
+	}
+	bool ret = true;
+	for (auto &it : _file.getImports()) {
+		if (addLibrary(it) == false) {
+			ret = false;
+		}
+	}
+	// register all the names before resolving, a function can call a function defined later in the file.
+	for (auto &it : _file.getFunctions()) {
+		if (addFunction(it) == false) {
+			ret = false;
+		} else if (bindNative(m_functions[findFunction(it->getName())]) == false) {
+			ret = false;
+		}
+	}
+	for (auto &it : _file.getVariables()) {
+		if (addGlobal(it) == false) {
+			ret = false;
+		}
+	}
+	// the methods are registered: the layout and the method table can be computed.
+	for (auto &it : _file.getClasses()) {
+		if (addClass(it) == false) {
+			ret = false;
+		}
+	}
+	eci::Resolver resolver(*this);
+	if (resolver.resolveGlobal(_file.getInit()) == false) {
+		ECI_ERROR("Can not resolve global variables of : '" << _file.getName() << "'");
+		return false;
+	}
+	// the global initialisation is optimized first: the const globals are used in the functions.
+	m_optimizer.optimizeGlobal(_file.getInit());
+	for (auto &it : _file.getFunctions()) {
+		if (    m_lazyCompilation == true
+		     && it->getLazyBody() != null) {
+			// parsed on the first call
+			continue;
+		}
+		if (compileBody(it) == false) {
+			ECI_ERROR("Can not compile function '" << it->getName() << "' in : '" << _file.getName() << "'");
+			ret = false;
+		}
+	}
+	return ret;
+}
+
+bool eci::Interpreter::addLibrary(const etk::String& _name) {
+	for (auto &it : m_libraries) {
+		if (it->getName() == _name) {
+			return true;
+		}
+	}
+	ememory::SharedPtr<eci::Library> library;
+	if (_name == eci::Kernel::libraryName) {
+		library = ememory::makeShared<eci::Kernel>();
+	} else if (_name == eci::Container::libraryName) {
+		library = ememory::makeShared<eci::Container>();
+	} else {
+		library = ememory::makeShared<eci::Library>(_name);
+	}
+	if (library->isValid() == false) {
+		return false;
+	}
+	m_libraries.pushBack(library);
+	for (auto &it : library->getClasses()) {
+		// the arrays of the fields are defined before the class
+		for (auto &itField : it->getFields()) {
+			const etk::String& typeName = itField.getTypeName();
+			if (    typeName.endWith("[]") == true
+			     && getArrayClass(etk::String(typeName, 0, typeName.size()-2)) == null) {
+				return false;
+			}
+		}
+		if (addClass(it) == false) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool eci::Interpreter::bindNative(const ememory::SharedPtr<eci::Function>& _function) {
+	if (    _function->hasBody() == true
+	     || _function->getNative() != null
+	     || _function->getClass() != null) {
+		return true;
+	}
+	// the last imported library hide the symbols of the previous ones
+	for (int32_t iii=int32_t(m_libraries.size())-1; iii>=0; --iii) {
+		eci::NativeCall::builtin builtin = m_libraries[iii]->getBuiltin(_function->getName());
+		void* symbol = null;
+		if (builtin == null) {
+			symbol = m_libraries[iii]->getSymbol(_function->getName());
+			if (symbol == null) {
+				continue;
+			}
+		}
+		ememory::SharedPtr<eci::NativeCall> native = ememory::makeShared<eci::NativeCall>();
+		if (builtin != null) {
+			if (native->bindBuiltin(builtin, *m_libraries[iii], *_function) == false) {
+				return false;
+			}
+		} else if (native->bind(symbol, *_function, m_libraries[iii]->isBuiltin()) == false) {
+			return false;
+		}
+		_function->setNative(native);
+		ECI_DEBUG("Bind function '" << _function->getName() << "' on library '" << m_libraries[iii]->getName() << "'");
+		return true;
+	}
+	// simple declaration: the definition can be in the next files
+	return true;
+}
+
+int32_t eci::Interpreter::addLiteral(const etk::String& _value) {
+	for (size_t iii=0; iii<m_literals.size(); ++iii) {
+		if (m_literals[iii] == _value) {
+			return iii;
+		}
+	}
+	m_literals.pushBack(_value);
+	m_literalValues.pushBack(eci::Value());
+	return m_literals.size()-1;
+}
+
+const eci::Value& eci::Interpreter::createLiteral(int32_t _slot) {
+	const eci::Container* container = null;
+	for (auto &it : m_libraries) {
+		if (it->getName() == eci::Container::libraryName) {
+			container = static_cast<const eci::Container*>(it.get());
+		}
+	}
+	if (container == null) {
+		ECI_ERROR("Can not create the literal \"" << m_literals[_slot] << "\" : the library '" << eci::Container::libraryName << "' is not imported");
+		return m_literalValues[_slot];
+	}
+	const etk::String& text = m_literals[_slot];
+	// stored before the intern: the string is a root when the intern table grow
+	m_literalValues[_slot] = eci::Value(container->createString(*this, text.c_str(), text.size()));
+	m_literalValues[_slot] = container->intern(*this, m_literalValues[_slot]);
+	return m_literalValues[_slot];
+}
+
+void eci::Interpreter::initGlobals(const eci::File& _file) {
+	if (_file.getInit() == null) {
+		return;
+	}
+	eci::Frame* frame = m_stack.pushFrame();
+	frame->m_interpreter = this;
+	frame->m_stack = &m_stack;
+	frame->m_function = null;
+	frame->m_base = m_stack.reserve(0);
+	frame->m_state = eci::frameStateNormal;
+	_file.getInit()->execute(*frame);
+	m_stack.popFrame();
+}
+
+bool eci::Interpreter::call(const etk::String& _name, eci::Value& _result) {
+	if (m_frozen == true) {
+		ECI_ERROR("Can not execute a module : '" << _name << "'");
+		return false;
+	}
+	int32_t id = findFunction(_name);
+	if (id < 0) {
+		ECI_ERROR("Call an unknown function : '" << _name << "'");
+		return false;
+	}
+	const eci::Function& function = *m_functions[id];
+	if (function.getArguments().size() != 0) {
+		ECI_ERROR("Call function '" << _name << "' with arguments is not supported");
+		return false;
+	}
+	m_aborted = false;
+	size_t base = m_stack.reserve(function.getFrameSize());
+	_result = function.call(*this, base);
+	m_stack.release(base);
+	if (m_aborted == true) {
+		ECI_ERROR("The execution of '" << _name << "' is aborted");
+		return false;
+	}
+	return true;
+}
+
+void eci::Interpreter::abort() {
+	m_aborted = true;
+	if (m_stack.getDepth() > 0) {
+		m_stack.getFrame(m_stack.getDepth()-1).m_state = eci::frameStateAbort;
+	}
+}
+
+bool eci::Interpreter::compileFunction(const eci::Function& _function) {
+	int32_t id = findFunction(_function.getName());
+	if (    id < 0
+	     || m_functions[id].get() != &_function) {
+		ECI_ERROR("Compile a function that is not registered : '" << _function.getName() << "'");
+		return false;
+	}
+	if (compileBody(m_functions[id]) == false) {
+		ECI_ERROR("Can not compile function '" << _function.getName() << "'");
+		return false;
+	}
+	return true;
+}
+
+bool eci::Interpreter::compileBody(const ememory::SharedPtr<eci::Function>& _function) {
+	if (_function->getLazyBody() != null) {
+		ememory::SharedPtr<eci::interpreter::Block> body = _function->getLazyBody()->parse();
+		// the tokens are released: a body with errors is not parsed again (it become a declaration).
+		_function->setLazyBody(null);
+		if (body == null) {
+			return false;
+		}
+		_function->setBody(body);
+	}
+	eci::Resolver resolver(*this);
+	if (resolver.resolve(_function) == false) {
+		_function->setBody(null);
+		return false;
+	}
+	// the index of the function is the target of its recursive calls
+	int32_t id = findFunction(_function->getName());
+	if (    id >= 0
+	     && m_functions[id].get() != _function.get()) {
+		id = -1;
+	}
+	m_optimizer.optimize(_function, id);
+	return true;
+}
+
+size_t eci::Interpreter::getNbFunctionCompiled() const {
+	size_t out = 0;
+	for (auto &it : m_functions) {
+		if (it->getBody() != null) {
+			++out;
+		}
+	}
+	return out;
 }
 
-void eci::Interpreter::main() {
-	ECI_TODO("create the main ... ");
+bool eci::Interpreter::addFunction(const ememory::SharedPtr<eci::Function>& _function) {
+	int32_t id = findFunction(_function->getName());
+	if (id < 0) {
+		m_functions.pushBack(_function);
+		return true;
+	}
+	if (m_functions[id]->hasBody() == false) {
+		// previous element is a declaration ==> keep the index
+		if (m_functions[id]->getArguments().size() != _function->getArguments().size()) {
+			ECI_ERROR("Function '" << _function->getName() << "' declaration and definition does not match");
+			return false;
+		}
+		m_functions[id] = _function;
+		return true;
+	}
+	if (_function->hasBody() == false) {
+		// redeclaration of an existing function
+		return true;
+	}
+	ECI_ERROR("Function already defined : '" << _function->getName() << "'");
+	return false;
 }
 
+bool eci::Interpreter::addClass(const ememory::SharedPtr<eci::Class>& _class) {
+	if (findClass(_class->getName()) != null) {
+		ECI_ERROR("Class already defined : '" << _class->getName() << "'");
+		return false;
+	}
+	m_classes.pushBack(_class);
+	return _class->define(*this);
+}
+
+const eci::Class* eci::Interpreter::findClass(const etk::String& _name) const {
+	for (auto &it : m_classes) {
+		if (it->getName() == _name) {
+			return it.get();
+		}
+	}
+	return null;
+}
+
+const eci::Class* eci::Interpreter::getArrayClass(const etk::String& _typeName) {
+	const eci::Class* out = findClass(_typeName + "[]");
+	if (out != null) {
+		return out;
+	}
+	ememory::SharedPtr<eci::Class> array = ememory::makeShared<eci::Class>(_typeName + "[]");
+	array->setElementTypeName(_typeName);
+	if (array->define(*this) == false) {
+		return null;
+	}
+	m_classes.pushBack(array);
+	return array.get();
+}
+
+eci::Object* eci::Interpreter::createObject(const eci::Class* _class) {
+	if (m_collector.getEnable() == true) {
+		// safe point: all the objects used by the execution are in the roots
+		m_collector.step(*this);
+	}
+	eci::Object* object = allocateObject(_class);
+	if (object == null) {
+		// the program can not continue without its object
+		abort();
+	}
+	return object;
+}
+
+eci::Object* eci::Interpreter::createArray(const eci::Class* _class, size_t _size) {
+	if (m_collector.getEnable() == true) {
+		m_collector.step(*this);
+	}
+	const etk::Vector<eci::Class::Field>& layout = _class->getLayout();
+	if (_size > eci::Heap::maxBlockSize / etk::max(layout.size(), size_t(1))) {
+		ECI_ERROR("Can not create an array of " << _size << " elements : too big");
+		abort();
+		return null;
+	}
+	eci::Object* object = allocateBlock(_class, _size * layout.size());
+	if (object == null) {
+		abort();
+		return null;
+	}
+	// the elements have only native fields: no object to create
+	for (size_t iii=0; iii<object->m_nbField; ++iii) {
+		object->m_fields[iii] = eci::Value().convert(layout[iii % layout.size()].m_valueType);
+	}
+	return object;
+}
+
+eci::Object* eci::Interpreter::allocateObject(const eci::Class* _class) {
+	const etk::Vector<eci::Class::Field>& layout = _class->getLayout();
+	eci::Object* object = allocateBlock(_class, layout.size());
+	if (object == null) {
+		return null;
+	}
+	for (size_t iii=0; iii<layout.size(); ++iii) {
+		if (layout[iii].m_class != null) {
+			eci::Object* field = allocateObject(layout[iii].m_class);
+			if (field == null) {
+				// the fields created before are released with the object
+				destroyObject(object);
+				return null;
+			}
+			object->m_fields[iii] = eci::Value(field);
+		} else {
+			object->m_fields[iii] = eci::Value().convert(layout[iii].m_valueType);
+		}
+	}
+	return object;
+}
+
+eci::Object* eci::Interpreter::allocateBlock(const eci::Class* _class, size_t _nbField) {
+	void* memory = null;
+	if (_nbField <= (eci::Heap::maxBlockSize - sizeof(eci::Object)) / sizeof(eci::Value)) {
+		memory = m_heap.allocate(eci::Object::getSize(_nbField));
+	}
+	if (memory == null) {
+		ECI_ERROR("Can not allocate an object of " << _nbField << " fields");
+		return null;
+	}
+	eci::Object* object = new (memory) eci::Object(_class);
+	++m_nbObject;
+	object->m_fields = reinterpret_cast<eci::Value*>(object + 1);
+	object->m_nbField = _nbField;
+	for (size_t iii=0; iii<_nbField; ++iii) {
+		new (&object->m_fields[iii]) eci::Value();
+	}
+	if (m_collector.getEnable() == true) {
+		m_collector.add(object);
+	}
+	return object;
+}
+
+bool eci::Interpreter::destroyObject(eci::Object* _object) {
+	if (_object->m_fields == null) {
+		ECI_ERROR("Delete an object already deleted");
+		return false;
+	}
+	// the fields of a class type are part of the object (not the pointers)
+	const etk::Vector<eci::Class::Field>& layout = _object->m_class->getLayout();
+	for (size_t iii=0; iii<layout.size(); ++iii) {
+		if (    layout[iii].m_class != null
+		     && _object->m_fields[iii].m_type == eci::valueTypeObject
+		     && _object->m_fields[iii].m_object != null
+		     && _object->m_fields[iii].m_object->m_fields != null) {
+			destroyObject(_object->m_fields[iii].m_object);
+		}
+	}
+	// the class is overwritten by the free list of the heap: the fields mark the deleted object (until the block is reused).
+	_object->m_class = null;
+	_object->m_fields = null;
+	if (_object->m_managed == true) {
+		// an other reference can exist: released by the collector
+		return true;
+	}
+	m_heap.release(_object, eci::Object::getSize(_object->m_nbField));
+	return true;
+}
+
+eci::Value eci::Interpreter::cloneValue(const eci::Value& _value, etk::Map<const eci::Object*, eci::Object*>& _clones) {
+	if (    _value.m_type != eci::valueTypeObject
+	     || _value.m_object == null) {
+		return _value;
+	}
+	const eci::Object* object = _value.m_object;
+	if (object->m_fields == null) {
+		// deleted object
+		return eci::Value(static_cast<eci::Object*>(null));
+	}
+	if (_clones.exist(object) == true) {
+		return eci::Value(_clones[object]);
+	}
+	eci::Object* clone = allocateBlock(object->m_class, object->m_nbField);
+	if (clone == null) {
+		return eci::Value(static_cast<eci::Object*>(null));
+	}
+	// registered before the fields: a cycle reference the clone
+	_clones.add(object, clone);
+	for (size_t iii=0; iii<clone->m_nbField; ++iii) {
+		clone->m_fields[iii] = cloneValue(object->m_fields[iii], _clones);
+	}
+	return eci::Value(clone);
+}
+
+bool eci::Interpreter::freeze() {
+	if (m_frozen == true) {
+		return true;
+	}
+	if (m_valid == false) {
+		ECI_ERROR("Can not make a module of a program with errors");
+		return false;
+	}
+	// the shared functions are never modified by the execution: no lazy body, no native code
+	for (auto &it : m_functions) {
+		if (    it->getLazyBody() != null
+		     && compileBody(it) == false) {
+			ECI_ERROR("Can not compile function '" << it->getName() << "'");
+			m_valid = false;
+			return false;
+		}
+	}
+	m_jit.setAvailable(false);
+	if (m_globalInitialized == false) {
+		for (auto &it : m_files) {
+			initGlobals(*it);
+		}
+		m_globalInitialized = true;
+	}
+	m_frozen = true;
+	return true;
+}
+
+bool eci::Interpreter::addGlobal(const ememory::SharedPtr<eci::Variable>& _variable) {
+	if (findGlobal(_variable->getName()) >= 0) {
+		ECI_ERROR("Global variable already defined : '" << _variable->getName() << "'");
+		return false;
+	}
+	m_globals.pushBack(_variable);
+	m_globalValues.pushBack(eci::Value().convert(_variable->getValueType()));
+	return true;
+}
+
+int32_t eci::Interpreter::findFunction(const etk::String& _name) const {
+	for (size_t iii=0; iii<m_functions.size(); ++iii) {
+		if (m_functions[iii]->getName() == _name) {
+			return iii;
+		}
+	}
+	return -1;
+}
+
+int32_t eci::Interpreter::findGlobal(const etk::String& _name) const {
+	for (size_t iii=0; iii<m_globals.size(); ++iii) {
+		if (m_globals[iii]->getName() == _name) {
+			return iii;
+		}
+	}
+	return -1;
+}
+
+bool eci::Interpreter::main() {
+	if (m_valid == false) {
+		ECI_ERROR("Can not execute a program with errors");
+		return false;
+	}
+	if (m_frozen == true) {
+		ECI_ERROR("Can not execute a module");
+		return false;
+	}
+	// Initialize the global variables:
+	if (m_globalInitialized == false) {
+		m_aborted = false;
+		for (auto &it : m_files) {
+			initGlobals(*it);
+			if (m_aborted == true) {
+				ECI_ERROR("The initialization of the global variables is aborted");
+				return false;
+			}
+		}
+		m_globalInitialized = true;
+	}
+	int32_t id = findFunction("main");
+	if (id < 0) {
+		ECI_INFO("No 'main' function");
+		return true;
+	}
+	if (m_functions[id]->getArguments().size() != 0) {
+		ECI_ERROR("'main' function with arguments is not supported");
+		return false;
+	}
+	if (call("main", m_returnValue) == false) {
+		return false;
+	}
+	ECI_INFO("main() return " << m_returnValue.toString());
+	return true;
+}
 
@@ -9,167 +9,369 @@
 #include <etk/types.hpp>
 #include <eci/Library.hpp>
 #include <eci/File.hpp>
+#include <eci/interpreter/Element.hpp>
+#include <eci/Stack.hpp>
+#include <eci/Optimizer.hpp>
+#include <eci/Jit.hpp>
+#include <eci/Class.hpp>
+#include <eci/Object.hpp>
+#include <eci/Heap.hpp>
+#include <eci/Collector.hpp>
+#include <eci/Profiler.hpp>
+#include <etk/Map.hpp>
 
 namespace eci {
-	namespace interpreter {
-		enum type {
-			typeBlock, //!< block area definition
-			typeType, //!< type definition
-			typeVariable, //!< new variable use
-			typeVariableDeclaration, //!< new variable definition
-			typeFunction, //!< function definition
-			typeClass, //!< Class definition
-			typeNamespace, //!< Namespace definition
-			typeCondition, //!< Classicle condition (with else)
-			typeFor, //!< classicle C cycle (init, inc, condition)
-			typeWhile, //!< Call a cycle (option action previous condition or condition previous action)
-			typeOperator, //!< Call operator "xx" ex : "*" "++" "=" "=="
-			typeReserveId = 5000,
-		};
-		class Element : public ememory::EnableSharedFromThis<Element> {
-			protected:
-				int32_t m_tockenId;
-			public:
-				int32_t getTockenId() {
-					return m_tockenId;
-				}
-			public:
-				Element(int32_t _tockenId=-1) :
-				  m_tockenId(_tockenId) {
-					
-				}
-				virtual ~Element() {}
-		};
-		class Block : public Element {
-			protected:
-				etk::Vector<ememory::SharedPtr<Element>> m_actions;
-			public:
-				Block() :
-				  Element(interpreter::typeBlock) {
-					
-				}
-				virtual ~Block() {}
-		};
-		class Type : public Element {
-			protected:
-				
-			public:
-				Type() :
-				  Element(interpreter::typeType) {
-					
-				}
-				virtual ~Type() {}
-		};
-		class Variable : public Element {
-			protected:
-				
-			public:
-				Variable() :
-				  Element(interpreter::typeVariable) {
-					
-				}
-				virtual ~Variable() {}
-		};
-		class VariableDeclaration : public Element {
-			protected:
-				
-			public:
-				VariableDeclaration() :
-				  Element(interpreter::typeVariableDeclaration) {
-					
-				}
-				virtual ~VariableDeclaration() {}
-		};
-		class Function : public Element {
-			protected:
-				
-			public:
-				Function() :
-				  Element(interpreter::typeFunction) {
-					
-				}
-				virtual ~Function() {}
-		};
-		class Class : public Element {
-			protected:
-				
-			public:
-				Class() :
-				  Element(interpreter::typeClass) {
-					
-				}
-				virtual ~Class() {}
-		};
-		class Namespace : public Element {
-			protected:
-				
-			public:
-				Namespace() :
-				  Element(interpreter::typeNamespace) {
-					
-				}
-				virtual ~Namespace() {}
-		};
-		class Condition : public Element {
-			protected:
-				ememory::SharedPtr<Element> m_condition;
-				ememory::SharedPtr<Block> m_block;
-				ememory::SharedPtr<Block> m_blockElse;
-			public:
-				Condition() :
-				  Element(interpreter::typeCondition) {
-					
-				}
-				virtual ~Condition() {}
-				
-		};
-		class For : public Element {
-			protected:
-				ememory::SharedPtr<Element> m_init;
-				ememory::SharedPtr<Element> m_condition;
-				ememory::SharedPtr<Element> m_increment;
-				ememory::SharedPtr<Block> m_block;
-			public:
-				For() :
-				  Element(interpreter::typeFor) {
-					
-				}
-				virtual ~For() {}
-				
-		};
-		class While : public Element {
-			protected:
-				bool m_conditionAtStart;
-				ememory::SharedPtr<Element> m_condition;
-				ememory::SharedPtr<Element> m_action;
-			public:
-				While() :
-				  Element(interpreter::typeWhile) {
-					
-				}
-				virtual ~While() {}
-		};
-		class Operator : public Element {
-			protected:
-				etk::String m_operator;
-			public:
-				Operator() :
-				  Element(interpreter::typeOperator) {
-					
-				}
-				virtual ~Operator() {}
-		};
-		
-	}
+	class Snapshot;
+	/**
+	 * @brief A program and its execution state. An interpreter is an isolate: it owns its files, compiled code,
+	 * globals, value stack, heap, collector, JIT code and libraries, and it is used by one thread at a time.
+	 * Several interpreters can run at the same time on different threads without lock: the state shared between
+	 * them is immutable (the constant strings and the id of the log, initialized on the first use in a thread safe way).
+	 * The compiled code of a file loaded by an interpreter is owned by it: it is modified by the execution (lazy bodies, JIT counters).
+	 * A module (see @ref freeze) is a loaded program that is never executed: the interpreters created on it share its compiled code
+	 * (all the bodies compiled, no JIT, inline caches updated without lock) and copy its initialized global variables.
+	 * Each interpreter has its own lexer (a regex keep the state of its last search).
+	 */
 	class Interpreter {
+		friend class eci::Snapshot;
 		public:
 			Interpreter();
+			/**
+			 * @brief Create an interpreter on a module: the files, functions and classes are shared, the global variables
+			 * are copied with the objects they reference (the module is not modified by the execution).
+			 * @param[in] _module Frozen interpreter (see @ref freeze).
+			 */
+			Interpreter(const ememory::SharedPtr<const eci::Interpreter>& _module);
 			~Interpreter();
 		protected:
-			etk::Vector<eci::Library> m_libraries; //!< list of all loaded libraries.
-			etk::Vector<eci::File> m_files; //!< List of all files in the current program.
+			etk::Vector<ememory::SharedPtr<eci::Library>> m_libraries; //!< list of all loaded libraries.
+			etk::Vector<ememory::SharedPtr<eci::File>> m_files; //!< List of all files in the current program.
+			etk::Vector<ememory::SharedPtr<eci::Function>> m_functions; //!< All the functions of the program (index used by the function call).
+			etk::Vector<ememory::SharedPtr<eci::Variable>> m_globals; //!< Global table of the program (index used by the global variable).
+			etk::Vector<eci::Value> m_globalValues; //!< Value of the global variables (same index as m_globals).
+			etk::Vector<ememory::SharedPtr<eci::Class>> m_classes; //!< All the classes of the program.
+			etk::Vector<etk::String> m_literals; //!< Text of the string literals of the program (index used by the literal).
+			etk::Vector<eci::Value> m_literalValues; //!< Interned string of each literal (void until its first use).
+			eci::Value m_interned; //!< Set of the interned strings (see @ref eci::Container::intern).
+			eci::Heap m_heap; //!< Memory of the instances created by the program (the remaining ones are released with the interpreter).
+			eci::Collector m_collector; //!< Release the unreachable instances (disable by default).
+			eci::Profiler m_profiler; //!< Sample the call stacks of the execution (stopped by default).
+			size_t m_nbObject; //!< Number of instances created.
+			size_t m_nbCacheMiss; //!< Number of lookup by name done by the member access (inline cache miss).
+			eci::Stack m_stack; //!< Value stack used by all the calls.
+			bool m_valid; //!< All the files are parsed and resolved.
+			eci::Value m_returnValue; //!< Value returned by the "main" function.
+			eci::Optimizer m_optimizer; //!< Optimizer applied on each file after the resolution.
+			eci::Jit m_jit; //!< Compiler of the hot functions (disable by default).
+			bool m_lazyCompilation; //!< The function bodies are parsed and resolved on the first call.
+			ememory::SharedPtr<eci::Lexer> m_lexer; //!< C++ lexer shared by all the files (the regex are compiled once).
+			ememory::SharedPtr<const eci::Interpreter> m_module; //!< Module that own the compiled code of the program (null if loaded by this interpreter).
+			bool m_frozen; //!< The program is a module: it can not be modified or executed.
+			bool m_globalInitialized; //!< The global variables of the files are initialized (the "main" does not initialize them again).
+			bool m_aborted; //!< The current execution is aborted (see @ref abort).
 		public:
 			void addFile(const etk::String& _filename);
-			void main();
+			/**
+			 * @brief Add a source code in the current program (interactive mode): it is parsed and resolved
+			 * against the existing global scope and its global variables are initialized immediately.
+			 * On error, nothing is added in the program (the previous sources stay usable).
+			 * @param[in] _name Name of the source (used in the messages).
+			 * @param[in] _data Source code.
+			 * @return true if the source has been added.
+			 */
+			bool addSource(const etk::String& _name, const etk::String& _data);
+			/**
+			 * @brief Call a function without argument.
+			 * @param[in] _name Name of the function.
+			 * @param[out] _result Value returned by the function.
+			 * @return true if the function has been called (false if the execution has been aborted).
+			 */
+			bool call(const etk::String& _name, eci::Value& _result);
+			/**
+			 * @brief Abort the current execution (a called function can not be compiled): the current frame stop, then each
+			 * call return to its caller without executing more code, and @ref call return false.
+			 */
+			void abort();
+			bool isAborted() const {
+				return m_aborted;
+			}
+			/**
+			 * @brief Get the address of the abort flag (the native code of the JIT check it after each call).
+			 * @return Address of the flag.
+			 */
+			const bool* getAbortedAddress() const {
+				return &m_aborted;
+			}
+			/**
+			 * @brief Get the last added file.
+			 * @return The file.
+			 */
+			const eci::File& getLastFile() const {
+				return *m_files.back();
+			}
+			const etk::Vector<ememory::SharedPtr<eci::File>>& getFiles() const {
+				return m_files;
+			}
+			/**
+			 * @brief Make the program a module that can be shared by interpreters on several threads: all the function bodies
+			 * are compiled and the global variables are initialized, then the program can not be modified or executed.
+			 * @return true if the program is valid.
+			 */
+			bool freeze();
+			bool isFrozen() const {
+				return m_frozen;
+			}
+			/**
+			 * @brief Get the module the program come from.
+			 * @return The module or null if the program has been loaded by this interpreter.
+			 */
+			const ememory::SharedPtr<const eci::Interpreter>& getModule() const {
+				return m_module;
+			}
+			/**
+			 * @brief Initialize the global variables and call the "main" function (if it exist).
+			 * @return true if the program has been executed (false if the execution has been aborted).
+			 */
+			bool main();
+			/**
+			 * @brief Get the value returned by the "main" function.
+			 * @return The value (void if there is no "main" function).
+			 */
+			const eci::Value& getReturnValue() const {
+				return m_returnValue;
+			}
+			/**
+			 * @brief Get the value stack of the interpreter.
+			 * @return The value stack.
+			 */
+			eci::Stack& getStack() {
+				return m_stack;
+			}
+			/**
+			 * @brief Set the optimization level of the next added files.
+			 * @param[in] _level New level (0 disable the optimizer).
+			 */
+			void setOptimizationLevel(int32_t _level) {
+				m_optimizer.setLevel(_level);
+			}
+			/**
+			 * @brief Count the executions of the operator sites of the next added files (no superinstruction, see @ref eci::Optimizer::setProfile).
+			 * @param[in] _value true to count the executions.
+			 */
+			void setOperatorProfile(bool _value) {
+				m_optimizer.setProfile(_value);
+			}
+			/**
+			 * @brief Get the optimizer of the interpreter (for the statistics).
+			 * @return The optimizer.
+			 */
+			const eci::Optimizer& getOptimizer() const {
+				return m_optimizer;
+			}
+			/**
+			 * @brief Get the JIT of the interpreter (enable, threshold and statistics).
+			 * @return The JIT.
+			 */
+			eci::Jit& getJit() {
+				return m_jit;
+			}
+			/**
+			 * @brief Select when the function bodies of the next added files are parsed and resolved.
+			 * @param[in] _value true: on the first call (default), false: when the file is added (all the errors are reported at the load).
+			 */
+			void setLazyCompilation(bool _value) {
+				m_lazyCompilation = _value;
+			}
+			bool getLazyCompilation() const {
+				return m_lazyCompilation;
+			}
+			/**
+			 * @brief Parse, resolve and optimize the body of a function (done on the first call in lazy mode).
+			 * @param[in] _function Function to compile.
+			 * @return true if the function can be executed.
+			 */
+			bool compileFunction(const eci::Function& _function);
+			/**
+			 * @brief Get the number of functions (for the statistics).
+			 * @return Number of function.
+			 */
+			size_t getNbFunction() const {
+				return m_functions.size();
+			}
+			/**
+			 * @brief Get the number of functions with a parsed body (for the statistics).
+			 * @return Number of function.
+			 */
+			size_t getNbFunctionCompiled() const;
+			/**
+			 * @brief Get a global variable value.
+			 * @param[in] _slot Slot of the variable (set by the resolver).
+			 * @return Reference on the value.
+			 */
+			eci::Value& getGlobal(int32_t _slot) {
+				return m_globalValues[_slot];
+			}
+			size_t getNbGlobal() const {
+				return m_globalValues.size();
+			}
+			/**
+			 * @brief Get the slot of a string literal (only used by the resolver, the same text has the same slot).
+			 * @param[in] _value Text of the literal.
+			 * @return Slot of the literal.
+			 */
+			int32_t addLiteral(const etk::String& _value);
+			/**
+			 * @brief Get the string of a literal: interned on the first use (the same object for each evaluation).
+			 * @param[in] _slot Slot of the literal (see @ref addLiteral).
+			 * @return The string (void if the library "eci/container" is not loaded).
+			 */
+			const eci::Value& getLiteral(int32_t _slot) {
+				if (m_literalValues[_slot].m_type == eci::valueTypeObject) {
+					return m_literalValues[_slot];
+				}
+				return createLiteral(_slot);
+			}
+			size_t getNbLiteral() const {
+				return m_literalValues.size();
+			}
+			const eci::Value& getLiteralValue(size_t _slot) const {
+				return m_literalValues[_slot];
+			}
+			/**
+			 * @brief Get the set of the interned strings (a root of the collector).
+			 * @return The set (void before the first interned string).
+			 */
+			eci::Value& getInternTable() {
+				return m_interned;
+			}
+		public:
+			/**
+			 * @brief Get the index of a function (only used by the resolver).
+			 * @param[in] _name Name of the function.
+			 * @return Index of the function or -1 if not found.
+			 */
+			int32_t findFunction(const etk::String& _name) const;
+			/**
+			 * @brief Get a function with its index.
+			 * @param[in] _id Index of the function (see @ref findFunction).
+			 * @return The function.
+			 */
+			const ememory::SharedPtr<eci::Function>& getFunction(int32_t _id) const {
+				return m_functions[_id];
+			}
+			/**
+			 * @brief Get the slot of a global variable (only used by the resolver).
+			 * @param[in] _name Name of the variable.
+			 * @return Slot of the variable or -1 if not found.
+			 */
+			int32_t findGlobal(const etk::String& _name) const;
+			/**
+			 * @brief Get the descriptor of a global variable.
+			 * @param[in] _slot Slot of the variable.
+			 * @return The descriptor (name, type, const ...).
+			 */
+			const ememory::SharedPtr<eci::Variable>& getGlobalDescriptor(int32_t _slot) const {
+				return m_globals[_slot];
+			}
+			/**
+			 * @brief Get a class with its name.
+			 * @param[in] _name Name of the class.
+			 * @return The class or null if not found.
+			 */
+			const eci::Class* findClass(const etk::String& _name) const;
+			/**
+			 * @brief Get the class of the arrays of a type (created on the first request).
+			 * @param[in] _typeName Type of the elements (native type, pointer or structure with only native fields).
+			 * @return The class "xxx[]" or null if the type can not be stored in an array.
+			 */
+			const eci::Class* getArrayClass(const etk::String& _typeName);
+			/**
+			 * @brief Create a new instance of a class (the fields of an object type are created too).
+			 * @param[in] _class Class of the object (must be defined).
+			 * @return The new object (owned by the interpreter), null if the memory is full (the execution is aborted).
+			 */
+			eci::Object* createObject(const eci::Class* _class);
+			/**
+			 * @brief Create a new array: all the elements are stored in the fields of the object (initialized to 0).
+			 * @param[in] _class Class of the array (see @ref getArrayClass).
+			 * @param[in] _size Number of elements.
+			 * @return The new object (owned by the interpreter), null if the array is too big (the execution is aborted).
+			 */
+			eci::Object* createArray(const eci::Class* _class, size_t _size);
+			/**
+			 * @brief Release an instance ("delete") and the objects of its fields of a class type (not the pointers).
+			 * An object managed by the collector is marked deleted, its block is released when it is not referenced anymore.
+			 * @param[in] _object Object to release.
+			 * @return false if the object is already deleted.
+			 */
+			bool destroyObject(eci::Object* _object);
+			/**
+			 * @brief Get the number of objects created.
+			 * @return Number of object.
+			 */
+			size_t getNbObject() const {
+				return m_nbObject;
+			}
+			/**
+			 * @brief Get the heap of the objects (statistics and regions).
+			 * @return The heap.
+			 */
+			eci::Heap& getHeap() {
+				return m_heap;
+			}
+			/**
+			 * @brief Get the garbage collector (enable, budget and statistics).
+			 * @return The collector.
+			 */
+			eci::Collector& getCollector() {
+				return m_collector;
+			}
+			/**
+			 * @brief Get the sampling profiler (start, stop and folded stacks).
+			 * @return The profiler.
+			 */
+			eci::Profiler& getProfiler() {
+				return m_profiler;
+			}
+			const eci::Profiler& getProfiler() const {
+				return m_profiler;
+			}
+			/**
+			 * @brief Count an inline cache miss (a member has been searched by name).
+			 */
+			void addCacheMiss() {
+				++m_nbCacheMiss;
+			}
+			/**
+			 * @brief Get the number of inline cache miss (for the statistics).
+			 * @return Number of lookup by name.
+			 */
+			size_t getNbCacheMiss() const {
+				return m_nbCacheMiss;
+			}
+			/**
+			 * @brief Get the lexer of the files (created on the first use).
+			 * @return The lexer shared by all the files of the interpreter.
+			 */
+			const ememory::SharedPtr<eci::Lexer>& getLexer();
+		private:
+			eci::Object* allocateObject(const eci::Class* _class);
+			/**
+			 * @brief Allocate an object with void fields (registered in the collector when it is enable).
+			 * @param[in] _class Class of the object.
+			 * @param[in] _nbField Number of fields.
+			 * @return The new object (null if it can not be allocated).
+			 */
+			eci::Object* allocateBlock(const eci::Class* _class, size_t _nbField);
+			const eci::Value& createLiteral(int32_t _slot);
+			eci::Value cloneValue(const eci::Value& _value, etk::Map<const eci::Object*, eci::Object*>& _clones);
+			bool link(eci::File& _file);
+			bool addLibrary(const etk::String& _name);
+			bool bindNative(const ememory::SharedPtr<eci::Function>& _function);
+			void initGlobals(const eci::File& _file);
+			bool compileBody(const ememory::SharedPtr<eci::Function>& _function);
+			bool addClass(const ememory::SharedPtr<eci::Class>& _class);
+			bool addFunction(const ememory::SharedPtr<eci::Function>& _function);
+			bool addGlobal(const ememory::SharedPtr<eci::Variable>& _variable);
 	};
 }
@@ -0,0 +1,1353 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Jit.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/Function.hpp>
+#include <eci/Type.hpp>
+#include <eci/debug.hpp>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__linux__)
+	#define ECI_JIT_X86_64
+	#include <sys/mman.h>
+#endif
+
+eci::Jit::Jit() :
+  m_enable(false),
+  m_available(true),
+  m_threshold(10),
+  m_nbCompiled(0),
+  m_nbFailed(0),
+  m_codeSize(0) {
+	
+}
+
+eci::Jit::~Jit() {
+	#ifdef ECI_JIT_X86_64
+		for (auto &it : m_memory) {
+			munmap(it.first, it.second);
+		}
+	#endif
+}
+
+bool eci::Jit::isSupported() {
+	#ifdef ECI_JIT_X86_64
+		return true;
+	#else
+		return false;
+	#endif
+}
+
+int64_t eci::Jit::toRaw(const eci::Value& _value) {
+	switch (_value.m_type) {
+		case eci::valueTypeBool:
+			return _value.m_bool == true ? 1 : 0;
+		case eci::valueTypeInt32:
+			return int64_t(_value.m_int32);
+		case eci::valueTypeDouble: {
+			int64_t out;
+			memcpy(&out, &_value.m_double, sizeof(out));
+			return out;
+		}
+		default:
+			break;
+	}
+	return _value.get<int64_t>();
+}
+
+eci::Value eci::Jit::fromRaw(int64_t _value, enum eci::valueType _type) {
+	switch (_type) {
+		case eci::valueTypeBool:
+			return eci::Value(_value != 0);
+		case eci::valueTypeInt32:
+			return eci::Value(int32_t(_value));
+		case eci::valueTypeInt64:
+			return eci::Value(_value);
+		case eci::valueTypeDouble: {
+			double out;
+			memcpy(&out, &_value, sizeof(out));
+			return eci::Value(out);
+		}
+		default:
+			break;
+	}
+	return eci::Value();
+}
+
+int64_t eci::Jit::callInterpreter(const int64_t* _arguments, eci::Interpreter* _interpreter, const eci::Function* _function) {
+	eci::Stack& stack = _interpreter->getStack();
+	size_t base = stack.reserve(_function->getFrameSize());
+	const etk::Vector<eci::Variable>& arguments = _function->getArguments();
+	for (size_t iii=0; iii<arguments.size(); ++iii) {
+		stack.get(base+iii) = fromRaw(_arguments[iii], arguments[iii].getValueType());
+	}
+	eci::Value ret = _function->call(*_interpreter, base);
+	stack.release(base);
+	return toRaw(ret);
+}
+
+#ifdef ECI_JIT_X86_64
+
+/**
+ * @brief Error helper called by the native code (same message as the interpreter).
+ */
+static void jitDivideByZero() {
+	ECI_ERROR("Divide by 0");
+}
+
+/**
+ * @brief Error helper called by the native code (same message as the interpreter).
+ */
+static void jitModuloByZero() {
+	ECI_ERROR("Modulo by 0");
+}
+
+/**
+ * @brief Error helper called by the native code when a call is refused (same message as the interpreter).
+ * @param[in] _interpreter Interpreter that execute the function (its execution is aborted).
+ * @param[in] _function Called function.
+ */
+static void jitMaxDepth(eci::Interpreter* _interpreter, const eci::Function* _function) {
+	ECI_ERROR("Max call depth reached in : '" << _function->getName() << "'");
+	_interpreter->abort();
+}
+
+/**
+ * @brief Check if a type can be used by the native code.
+ * @param[in] _type Type to check.
+ * @return true for bool, int32, int64 and double.
+ */
+static bool isJitType(enum eci::valueType _type) {
+	return    _type == eci::valueTypeBool
+	       || _type == eci::valueTypeInt32
+	       || _type == eci::valueTypeInt64
+	       || _type == eci::valueTypeDouble;
+}
+
+/**
+ * @brief x86-64 code generator of one function. All the values are raw 64 bits values computed in rax,
+ * the locals are in the machine frame: [rbp-8] is the interpreter, the slot N is in [rbp-16-8*N].
+ * Temporary values are pushed on the machine stack.
+ */
+class JitCompiler {
+	private:
+		eci::Interpreter& m_interpreter; //!< Interpreter that own the called functions (and the value stack that count the calls).
+		const eci::Function& m_function; //!< Compiled function.
+		etk::Vector<uint8_t> m_code; //!< Generated code.
+		etk::Vector<int32_t> m_labels; //!< Position of the labels in the code (-1 if not bound).
+		etk::Vector<etk::Pair<size_t, int32_t>> m_patches; //!< Relative jumps to patch (position of the offset, label).
+		etk::Vector<enum eci::valueType> m_slotType; //!< Type of the value in each slot of the frame.
+		etk::Vector<etk::Pair<int32_t, int32_t>> m_cycles; //!< Labels of the current cycles (continue, break).
+		int32_t m_depth; //!< Number of 8 bytes values pushed over the locals (used to align the calls).
+		int32_t m_labelReturn; //!< Label of the epilogue.
+		int32_t m_labelAbort; //!< Label of the return of an aborted execution (checked after each call).
+		int32_t m_labelBody; //!< Label of the start of the body (target of the tail calls).
+		etk::String m_error; //!< Reason of the failure.
+	public:
+		JitCompiler(eci::Interpreter& _interpreter, const eci::Function& _function) :
+		  m_interpreter(_interpreter),
+		  m_function(_function),
+		  m_depth(0),
+		  m_labelReturn(-1),
+		  m_labelAbort(-1),
+		  m_labelBody(-1) {
+			
+		}
+		const etk::Vector<uint8_t>& getCode() const {
+			return m_code;
+		}
+		const etk::String& getError() const {
+			return m_error;
+		}
+		bool compile();
+	private:
+		bool fail(const etk::String& _error) {
+			if (m_error == "") {
+				m_error = _error;
+			}
+			return false;
+		}
+		void emit(uint8_t _value) {
+			m_code.pushBack(_value);
+		}
+		void emit(const uint8_t* _data, size_t _size) {
+			for (size_t iii=0; iii<_size; ++iii) {
+				m_code.pushBack(_data[iii]);
+			}
+		}
+		void emit32(int32_t _value) {
+			emit(reinterpret_cast<const uint8_t*>(&_value), 4);
+		}
+		void emit64(int64_t _value) {
+			emit(reinterpret_cast<const uint8_t*>(&_value), 8);
+		}
+		int32_t newLabel() {
+			m_labels.pushBack(-1);
+			return m_labels.size()-1;
+		}
+		void bind(int32_t _label) {
+			m_labels[_label] = m_code.size();
+		}
+		void jump(int32_t _label) {
+			emit(0xE9); // jmp rel32
+			m_patches.pushBack(etk::makePair(m_code.size(), _label));
+			emit32(0);
+		}
+		void jumpIf(uint8_t _condition, int32_t _label) {
+			emit(0x0F); // jcc rel32
+			emit(0x80 | _condition);
+			m_patches.pushBack(etk::makePair(m_code.size(), _label));
+			emit32(0);
+		}
+		void push() {
+			emit(0x50); // push rax
+			++m_depth;
+		}
+		void popRax() {
+			emit(0x58); // pop rax
+			--m_depth;
+		}
+		void movRaxImmediate(int64_t _value) {
+			emit(0x48); // mov rax, imm64
+			emit(0xB8);
+			emit64(_value);
+		}
+		void movRcxRax() {
+			static const uint8_t data[] = {0x48, 0x89, 0xC1}; // mov rcx, rax
+			emit(data, sizeof(data));
+		}
+		int32_t getSlotOffset(int32_t _slot) {
+			return -16 - 8*_slot;
+		}
+		void loadSlot(int32_t _slot) {
+			static const uint8_t data[] = {0x48, 0x8B, 0x85}; // mov rax, [rbp+disp32]
+			emit(data, sizeof(data));
+			emit32(getSlotOffset(_slot));
+		}
+		void storeSlot(int32_t _slot) {
+			static const uint8_t data[] = {0x48, 0x89, 0x85}; // mov [rbp+disp32], rax
+			emit(data, sizeof(data));
+			emit32(getSlotOffset(_slot));
+		}
+		void setBool(uint8_t _condition) {
+			emit(0x0F); // setcc al
+			emit(0x90 | _condition);
+			emit(0xC0);
+			static const uint8_t data[] = {0x0F, 0xB6, 0xC0}; // movzx eax, al
+			emit(data, sizeof(data));
+		}
+		void signExtend32() {
+			static const uint8_t data[] = {0x48, 0x63, 0xC0}; // movsxd rax, eax
+			emit(data, sizeof(data));
+		}
+		void moveToXmm() {
+			static const uint8_t data[] = {0x66, 0x48, 0x0F, 0x6E, 0xC0, // movq xmm0, rax
+			                               0x66, 0x48, 0x0F, 0x6E, 0xC9}; // movq xmm1, rcx
+			emit(data, sizeof(data));
+		}
+		void moveFromXmm() {
+			static const uint8_t data[] = {0x66, 0x48, 0x0F, 0x7E, 0xC0}; // movq rax, xmm0
+			emit(data, sizeof(data));
+		}
+		void callHelper(void (*_function)()) {
+			bool align = (m_depth%2) != 0;
+			if (align == true) {
+				static const uint8_t data[] = {0x48, 0x83, 0xEC, 0x08}; // sub rsp, 8
+				emit(data, sizeof(data));
+			}
+			movRaxImmediate(reinterpret_cast<int64_t>(_function));
+			static const uint8_t data[] = {0xFF, 0xD0}; // call rax
+			emit(data, sizeof(data));
+			if (align == true) {
+				static const uint8_t data[] = {0x48, 0x83, 0xC4, 0x08}; // add rsp, 8
+				emit(data, sizeof(data));
+			}
+		}
+		bool convert(enum eci::valueType _from, enum eci::valueType _to);
+		bool testCondition(const ememory::SharedPtr<eci::interpreter::Element>& _element, int32_t _labelFalse);
+		int32_t getIntegerSlot(const ememory::SharedPtr<eci::interpreter::Element>& _element);
+		bool compareBranch(const ememory::SharedPtr<eci::interpreter::Element>& _element, int32_t _labelFalse);
+		bool binaryOperator(enum eci::operatorId _operator, enum eci::valueType _type, enum eci::valueType& _result);
+		bool getLocalSlot(const ememory::SharedPtr<eci::interpreter::Element>& _element, int32_t& _slot);
+		bool statement(const ememory::SharedPtr<eci::interpreter::Element>& _element);
+		bool statementSwitch(eci::interpreter::Switch* _element);
+		void compareRax(int64_t _value);
+		void switchSearch(const etk::Vector<etk::Pair<int64_t, int32_t>>& _cases, size_t _begin, size_t _end, const etk::Vector<int32_t>& _labels, int32_t _labelDefault);
+		bool block(const ememory::SharedPtr<eci::interpreter::Block>& _element);
+		bool expression(const ememory::SharedPtr<eci::interpreter::Element>& _element, enum eci::valueType& _type);
+		bool expressionOperator(eci::interpreter::Operator* _element, enum eci::valueType& _type);
+		void nativeCall(const eci::NativeCall& _native);
+		bool expressionCall(eci::interpreter::FunctionCall* _element, enum eci::valueType& _type);
+};
+
+bool JitCompiler::compile() {
+	if (m_function.getArguments().size() > size_t(eci::Jit::maxArgument)) {
+		return fail("too many arguments");
+	}
+	if (    m_function.getReturn().size() != 0
+	     && isJitType(m_function.getReturn()[0].getValueType()) == false) {
+		return fail("unsupported return type");
+	}
+	m_slotType.resize(m_function.getFrameSize(), eci::valueTypeVoid);
+	for (size_t iii=0; iii<m_function.getArguments().size(); ++iii) {
+		if (isJitType(m_function.getArguments()[iii].getValueType()) == false) {
+			return fail("unsupported argument type");
+		}
+		m_slotType[iii] = m_function.getArguments()[iii].getValueType();
+	}
+	m_labelReturn = newLabel();
+	m_labelAbort = newLabel();
+	int32_t labelMaxDepth = newLabel();
+	// prologue: the frame size keep the stack aligned on 16 bytes
+	int32_t frameByte = 8 + 8*m_function.getFrameSize();
+	frameByte = (frameByte+15) & ~15;
+	static const uint8_t prologue[] = {0x55, // push rbp
+	                                   0x48, 0x89, 0xE5, // mov rbp, rsp
+	                                   0x48, 0x81, 0xEC}; // sub rsp, imm32
+	emit(prologue, sizeof(prologue));
+	emit32(frameByte);
+	static const uint8_t saveInterpreter[] = {0x48, 0x89, 0x75, 0xF8}; // mov [rbp-8], rsi
+	emit(saveInterpreter, sizeof(saveInterpreter));
+	for (size_t iii=0; iii<m_function.getArguments().size(); ++iii) {
+		static const uint8_t data[] = {0x48, 0x8B, 0x87}; // mov rax, [rdi+disp32]
+		emit(data, sizeof(data));
+		emit32(8*iii);
+		storeSlot(iii);
+	}
+	// the calls of the native code have no frame: they are counted in the value stack and refused as a new frame
+	// (end of the native stack or max depth)
+	eci::Stack& stack = m_interpreter.getStack();
+	movRaxImmediate(reinterpret_cast<int64_t>(stack.getNativeLimitAddress()));
+	static const uint8_t checkLimit[] = {0x48, 0x3B, 0x20}; // cmp rsp, [rax]
+	emit(checkLimit, sizeof(checkLimit));
+	jumpIf(0x2, labelMaxDepth); // jb
+	movRaxImmediate(reinterpret_cast<int64_t>(stack.getNbCallAddress()));
+	static const uint8_t loadCall[] = {0x48, 0x8B, 0x08, // mov rcx, [rax]
+	                                   0x48, 0xBA}; // mov rdx, imm64
+	emit(loadCall, sizeof(loadCall));
+	emit64(reinterpret_cast<int64_t>(stack.getMaxDepthAddress()));
+	static const uint8_t checkDepth[] = {0x48, 0x3B, 0x0A}; // cmp rcx, [rdx]
+	emit(checkDepth, sizeof(checkDepth));
+	jumpIf(0x3, labelMaxDepth); // jae
+	static const uint8_t countCall[] = {0x48, 0xFF, 0xC1, // inc rcx
+	                                    0x48, 0x89, 0x08}; // mov [rax], rcx
+	emit(countCall, sizeof(countCall));
+	m_labelBody = newLabel();
+	bind(m_labelBody);
+	if (block(m_function.getBody()) == false) {
+		return false;
+	}
+	// end of the function without return: default value
+	static const uint8_t clear[] = {0x31, 0xC0}; // xor eax, eax
+	emit(clear, sizeof(clear));
+	bind(m_labelReturn);
+	emit(0x48); // mov rcx, imm64
+	emit(0xB9);
+	emit64(reinterpret_cast<int64_t>(stack.getNbCallAddress()));
+	static const uint8_t uncountCall[] = {0x48, 0xFF, 0x09}; // dec qword [rcx]
+	emit(uncountCall, sizeof(uncountCall));
+	static const uint8_t epilogue[] = {0x48, 0x89, 0xEC, // mov rsp, rbp
+	                                   0x5D, // pop rbp
+	                                   0xC3}; // ret
+	emit(epilogue, sizeof(epilogue));
+	// a called function has aborted the execution: return without executing more code (the caller check it too)
+	bind(m_labelAbort);
+	emit(clear, sizeof(clear));
+	jump(m_labelReturn);
+	// call refused (not counted): the execution is aborted
+	bind(labelMaxDepth);
+	static const uint8_t loadError[] = {0x48, 0x8B, 0x7D, 0xF8, // mov rdi, [rbp-8]
+	                                    0x48, 0xBE}; // mov rsi, imm64
+	emit(loadError, sizeof(loadError));
+	emit64(reinterpret_cast<int64_t>(&m_function));
+	movRaxImmediate(reinterpret_cast<int64_t>(&jitMaxDepth));
+	static const uint8_t callError[] = {0xFF, 0xD0}; // call rax
+	emit(callError, sizeof(callError));
+	emit(clear, sizeof(clear));
+	emit(epilogue, sizeof(epilogue));
+	for (auto &it : m_patches) {
+		int32_t offset = m_labels[it.second] - int32_t(it.first + 4);
+		memcpy(&m_code[it.first], &offset, 4);
+	}
+	return true;
+}
+
+bool JitCompiler::convert(enum eci::valueType _from, enum eci::valueType _to) {
+	if (_from == _to) {
+		return true;
+	}
+	if (    isJitType(_from) == false
+	     || isJitType(_to) == false) {
+		return fail("unsupported conversion");
+	}
+	switch (_to) {
+		case eci::valueTypeBool:
+			if (_from == eci::valueTypeDouble) {
+				// NaN is true
+				static const uint8_t data[] = {0x66, 0x48, 0x0F, 0x6E, 0xC0, // movq xmm0, rax
+				                               0x66, 0x0F, 0x57, 0xC9, // xorpd xmm1, xmm1
+				                               0x66, 0x0F, 0x2E, 0xC1, // ucomisd xmm0, xmm1
+				                               0x0F, 0x95, 0xC0, // setne al
+				                               0x0F, 0x9A, 0xC2, // setp dl
+				                               0x08, 0xD0, // or al, dl
+				                               0x0F, 0xB6, 0xC0}; // movzx eax, al
+				emit(data, sizeof(data));
+			} else {
+				static const uint8_t data[] = {0x48, 0x85, 0xC0}; // test rax, rax
+				emit(data, sizeof(data));
+				setBool(0x05);
+			}
+			return true;
+		case eci::valueTypeInt32:
+			if (_from == eci::valueTypeDouble) {
+				static const uint8_t data[] = {0x66, 0x48, 0x0F, 0x6E, 0xC0, // movq xmm0, rax
+				                               0xF2, 0x0F, 0x2C, 0xC0}; // cvttsd2si eax, xmm0
+				emit(data, sizeof(data));
+			}
+			if (_from != eci::valueTypeBool) {
+				signExtend32();
+			}
+			return true;
+		case eci::valueTypeInt64:
+			if (_from == eci::valueTypeDouble) {
+				static const uint8_t data[] = {0x66, 0x48, 0x0F, 0x6E, 0xC0, // movq xmm0, rax
+				                               0xF2, 0x48, 0x0F, 0x2C, 0xC0}; // cvttsd2si rax, xmm0
+				emit(data, sizeof(data));
+			}
+			// bool and int32 are already sign extended
+			return true;
+		case eci::valueTypeDouble: {
+			static const uint8_t data[] = {0xF2, 0x48, 0x0F, 0x2A, 0xC0}; // cvtsi2sd xmm0, rax
+			emit(data, sizeof(data));
+			moveFromXmm();
+			return true;
+		}
+		default:
+			break;
+	}
+	return fail("unsupported conversion");
+}
+
+bool JitCompiler::testCondition(const ememory::SharedPtr<eci::interpreter::Element>& _element, int32_t _labelFalse) {
+	if (compareBranch(_element, _labelFalse) == true) {
+		return true;
+	}
+	enum eci::valueType type = eci::valueTypeVoid;
+	if (    expression(_element, type) == false
+	     || convert(type, eci::valueTypeBool) == false) {
+		return false;
+	}
+	static const uint8_t data[] = {0x48, 0x85, 0xC0}; // test rax, rax
+	emit(data, sizeof(data));
+	jumpIf(0x04, _labelFalse); // je
+	return true;
+}
+
+int32_t JitCompiler::getIntegerSlot(const ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	if (    _element == null
+	     || _element->getTockenId() != eci::interpreter::typeVariable) {
+		return -1;
+	}
+	eci::interpreter::Variable* variable = static_cast<eci::interpreter::Variable*>(_element.get());
+	if (    variable->m_global == true
+	     || variable->m_slot < 0
+	     || (    m_slotType[variable->m_slot] != eci::valueTypeInt32
+	          && m_slotType[variable->m_slot] != eci::valueTypeInt64)) {
+		return -1;
+	}
+	return variable->m_slot;
+}
+
+bool JitCompiler::compareBranch(const ememory::SharedPtr<eci::interpreter::Element>& _element, int32_t _labelFalse) {
+	if (_element->getTockenId() != eci::interpreter::typeOperator) {
+		return false;
+	}
+	eci::interpreter::Operator* element = static_cast<eci::interpreter::Operator*>(_element.get());
+	uint8_t condition = 0;
+	switch (element->m_operatorId) {
+		case eci::operatorLess:         condition = 0x0D; break; // jge
+		case eci::operatorLessEqual:    condition = 0x0F; break; // jg
+		case eci::operatorGreater:      condition = 0x0E; break; // jle
+		case eci::operatorGreaterEqual: condition = 0x0C; break; // jl
+		case eci::operatorEqual:        condition = 0x05; break; // jne
+		case eci::operatorNotEqual:     condition = 0x04; break; // je
+		default:
+			return false;
+	}
+	// only "local op local" and "local op constant" on integers (int32 values are sign extended: the 64 bits compare is valid)
+	int32_t slotLeft = getIntegerSlot(element->m_left);
+	if (    slotLeft < 0
+	     || element->m_right == null) {
+		return false;
+	}
+	if (element->m_right->getTockenId() == eci::interpreter::typeConstant) {
+		const eci::Value& value = static_cast<eci::interpreter::Constant*>(element->m_right.get())->m_value;
+		if (    (    value.m_type != eci::valueTypeInt32
+		          && value.m_type != eci::valueTypeInt64)
+		     || int64_t(int32_t(value.get<int64_t>())) != value.get<int64_t>()) {
+			return false;
+		}
+		loadSlot(slotLeft);
+		compareRax(value.get<int64_t>());
+		jumpIf(condition, _labelFalse);
+		return true;
+	}
+	int32_t slotRight = getIntegerSlot(element->m_right);
+	if (slotRight < 0) {
+		return false;
+	}
+	loadSlot(slotLeft);
+	static const uint8_t data[] = {0x48, 0x3B, 0x85}; // cmp rax, [rbp+disp32]
+	emit(data, sizeof(data));
+	emit32(getSlotOffset(slotRight));
+	jumpIf(condition, _labelFalse);
+	return true;
+}
+
+bool JitCompiler::binaryOperator(enum eci::operatorId _operator, enum eci::valueType _type, enum eci::valueType& _result) {
+	// left value in rax, right value in rcx (both in _type)
+	_result = _type;
+	if (_type == eci::valueTypeDouble) {
+		moveToXmm();
+		uint8_t opcode = 0;
+		switch (_operator) {
+			case eci::operatorAdd: opcode = 0x58; break;
+			case eci::operatorSub: opcode = 0x5C; break;
+			case eci::operatorMul: opcode = 0x59; break;
+			case eci::operatorDiv: opcode = 0x5E; break;
+			default: break;
+		}
+		if (opcode != 0) {
+			emit(0xF2); // xxxsd xmm0, xmm1
+			emit(0x0F);
+			emit(opcode);
+			emit(0xC1);
+			moveFromXmm();
+			return true;
+		}
+		_result = eci::valueTypeBool;
+		static const uint8_t compare[] = {0x66, 0x0F, 0x2E, 0xC1}; // ucomisd xmm0, xmm1
+		static const uint8_t compareSwap[] = {0x66, 0x0F, 0x2E, 0xC8}; // ucomisd xmm1, xmm0
+		switch (_operator) {
+			case eci::operatorLess:
+				emit(compareSwap, sizeof(compareSwap));
+				setBool(0x07); // seta
+				return true;
+			case eci::operatorLessEqual:
+				emit(compareSwap, sizeof(compareSwap));
+				setBool(0x03); // setae
+				return true;
+			case eci::operatorGreater:
+				emit(compare, sizeof(compare));
+				setBool(0x07); // seta
+				return true;
+			case eci::operatorGreaterEqual:
+				emit(compare, sizeof(compare));
+				setBool(0x03); // setae
+				return true;
+			case eci::operatorEqual: {
+				emit(compare, sizeof(compare));
+				static const uint8_t data[] = {0x0F, 0x94, 0xC0, // sete al
+				                               0x0F, 0x9B, 0xC2, // setnp dl
+				                               0x20, 0xD0, // and al, dl
+				                               0x0F, 0xB6, 0xC0}; // movzx eax, al
+				emit(data, sizeof(data));
+				return true;
+			}
+			case eci::operatorNotEqual: {
+				emit(compare, sizeof(compare));
+				static const uint8_t data[] = {0x0F, 0x95, 0xC0, // setne al
+				                               0x0F, 0x9A, 0xC2, // setp dl
+				                               0x08, 0xD0, // or al, dl
+				                               0x0F, 0xB6, 0xC0}; // movzx eax, al
+				emit(data, sizeof(data));
+				return true;
+			}
+			default:
+				break;
+		}
+		return fail("unsupported operator on double");
+	}
+	if (    _type != eci::valueTypeInt32
+	     && _type != eci::valueTypeInt64) {
+		return fail("unsupported operator type");
+	}
+	bool is64 = _type == eci::valueTypeInt64;
+	switch (_operator) {
+		case eci::operatorAdd:
+		case eci::operatorSub:
+		case eci::operatorBinaryAnd:
+			if (is64 == true) {
+				emit(0x48);
+			}
+			emit(_operator == eci::operatorAdd ? 0x01 : (_operator == eci::operatorSub ? 0x29 : 0x21)); // add/sub/and eax, ecx
+			emit(0xC8);
+			break;
+		case eci::operatorMul:
+			if (is64 == true) {
+				emit(0x48);
+			}
+			emit(0x0F); // imul eax, ecx
+			emit(0xAF);
+			emit(0xC1);
+			break;
+		case eci::operatorDiv:
+		case eci::operatorMod: {
+			int32_t labelDivide = newLabel();
+			int32_t labelEnd = newLabel();
+			static const uint8_t test[] = {0x48, 0x85, 0xC9}; // test rcx, rcx
+			emit(test, sizeof(test));
+			jumpIf(0x05, labelDivide); // jne
+			callHelper(_operator == eci::operatorDiv ? &jitDivideByZero : &jitModuloByZero);
+			static const uint8_t clear[] = {0x31, 0xC0}; // xor eax, eax
+			emit(clear, sizeof(clear));
+			jump(labelEnd);
+			bind(labelDivide);
+			// the minimum divided by -1 trap in idiv: the quotient is the negation (wrap) and the remainder 0
+			int32_t labelIdiv = newLabel();
+			if (is64 == true) {
+				emit(0x48);
+			}
+			static const uint8_t compare[] = {0x83, 0xF9, 0xFF}; // cmp ecx, -1
+			emit(compare, sizeof(compare));
+			jumpIf(0x05, labelIdiv); // jne
+			if (_operator == eci::operatorDiv) {
+				if (is64 == true) {
+					emit(0x48);
+				}
+				emit(0xF7); // neg eax
+				emit(0xD8);
+			} else {
+				emit(clear, sizeof(clear));
+			}
+			jump(labelEnd);
+			bind(labelIdiv);
+			if (is64 == true) {
+				static const uint8_t data[] = {0x48, 0x99, // cqo
+				                               0x48, 0xF7, 0xF9}; // idiv rcx
+				emit(data, sizeof(data));
+			} else {
+				static const uint8_t data[] = {0x99, // cdq
+				                               0xF7, 0xF9}; // idiv ecx
+				emit(data, sizeof(data));
+			}
+			if (_operator == eci::operatorMod) {
+				if (is64 == true) {
+					emit(0x48);
+				}
+				emit(0x89); // mov eax, edx
+				emit(0xD0);
+			}
+			bind(labelEnd);
+			break;
+		}
+		case eci::operatorLess:
+		case eci::operatorLessEqual:
+		case eci::operatorGreater:
+		case eci::operatorGreaterEqual:
+		case eci::operatorEqual:
+		case eci::operatorNotEqual: {
+			// int32 values are sign extended: the 64 bits compare is valid
+			static const uint8_t data[] = {0x48, 0x39, 0xC8}; // cmp rax, rcx
+			emit(data, sizeof(data));
+			uint8_t condition = 0;
+			switch (_operator) {
+				case eci::operatorLess:         condition = 0x0C; break; // setl
+				case eci::operatorLessEqual:    condition = 0x0E; break; // setle
+				case eci::operatorGreater:      condition = 0x0F; break; // setg
+				case eci::operatorGreaterEqual: condition = 0x0D; break; // setge
+				case eci::operatorEqual:        condition = 0x04; break; // sete
+				default:                        condition = 0x05; break; // setne
+			}
+			setBool(condition);
+			_result = eci::valueTypeBool;
+			return true;
+		}
+		default:
+			return fail("unsupported operator");
+	}
+	if (is64 == false) {
+		signExtend32();
+	}
+	return true;
+}
+
+bool JitCompiler::getLocalSlot(const ememory::SharedPtr<eci::interpreter::Element>& _element, int32_t& _slot) {
+	if (    _element == null
+	     || _element->getTockenId() != eci::interpreter::typeVariable) {
+		return fail("assignation on a non local variable");
+	}
+	eci::interpreter::Variable* variable = static_cast<eci::interpreter::Variable*>(_element.get());
+	if (    variable->m_global == true
+	     || variable->m_slot < 0
+	     || isJitType(m_slotType[variable->m_slot]) == false) {
+		return fail("access on a global variable");
+	}
+	_slot = variable->m_slot;
+	return true;
+}
+
+bool JitCompiler::block(const ememory::SharedPtr<eci::interpreter::Block>& _element) {
+	if (_element == null) {
+		return true;
+	}
+	for (auto &it : _element->m_actions) {
+		if (statement(it) == false) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool JitCompiler::statement(const ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	if (_element == null) {
+		return true;
+	}
+	switch (_element->getTockenId()) {
+		case eci::interpreter::typeBlock:
+			return block(ememory::staticPointerCast<eci::interpreter::Block>(_element));
+		case eci::interpreter::typeVariableDeclaration: {
+			eci::interpreter::VariableDeclaration* element = static_cast<eci::interpreter::VariableDeclaration*>(_element.get());
+			if (    element->m_global == true
+			     || element->m_class != null
+			     || element->m_slot < 0) {
+				return fail("unsupported declaration");
+			}
+			enum eci::valueType type = element->m_valueType;
+			if (element->m_init != null) {
+				enum eci::valueType typeInit = eci::valueTypeVoid;
+				if (expression(element->m_init, typeInit) == false) {
+					return false;
+				}
+				if (type == eci::valueTypeVoid) {
+					// auto
+					type = typeInit;
+				}
+				if (convert(typeInit, type) == false) {
+					return false;
+				}
+			} else {
+				static const uint8_t clear[] = {0x31, 0xC0}; // xor eax, eax
+				emit(clear, sizeof(clear));
+			}
+			if (isJitType(type) == false) {
+				return fail("unsupported variable type");
+			}
+			m_slotType[element->m_slot] = type;
+			storeSlot(element->m_slot);
+			return true;
+		}
+		case eci::interpreter::typeCondition: {
+			eci::interpreter::Condition* element = static_cast<eci::interpreter::Condition*>(_element.get());
+			int32_t labelElse = newLabel();
+			int32_t labelEnd = newLabel();
+			if (testCondition(element->m_condition, labelElse) == false) {
+				return false;
+			}
+			if (block(element->m_block) == false) {
+				return false;
+			}
+			jump(labelEnd);
+			bind(labelElse);
+			if (block(element->m_blockElse) == false) {
+				return false;
+			}
+			bind(labelEnd);
+			return true;
+		}
+		case eci::interpreter::typeFor: {
+			eci::interpreter::For* element = static_cast<eci::interpreter::For*>(_element.get());
+			int32_t labelCondition = newLabel();
+			int32_t labelContinue = newLabel();
+			int32_t labelEnd = newLabel();
+			if (statement(element->m_init) == false) {
+				return false;
+			}
+			bind(labelCondition);
+			if (    element->m_condition != null
+			     && testCondition(element->m_condition, labelEnd) == false) {
+				return false;
+			}
+			m_cycles.pushBack(etk::makePair(labelContinue, labelEnd));
+			if (block(element->m_block) == false) {
+				return false;
+			}
+			m_cycles.popBack();
+			bind(labelContinue);
+			if (statement(element->m_increment) == false) {
+				return false;
+			}
+			jump(labelCondition);
+			bind(labelEnd);
+			return true;
+		}
+		case eci::interpreter::typeWhile: {
+			eci::interpreter::While* element = static_cast<eci::interpreter::While*>(_element.get());
+			int32_t labelStart = newLabel();
+			int32_t labelCondition = newLabel();
+			int32_t labelEnd = newLabel();
+			if (element->m_conditionAtStart == true) {
+				jump(labelCondition);
+			}
+			bind(labelStart);
+			m_cycles.pushBack(etk::makePair(labelCondition, labelEnd));
+			if (statement(element->m_action) == false) {
+				return false;
+			}
+			m_cycles.popBack();
+			bind(labelCondition);
+			enum eci::valueType type = eci::valueTypeVoid;
+			if (    expression(element->m_condition, type) == false
+			     || convert(type, eci::valueTypeBool) == false) {
+				return false;
+			}
+			static const uint8_t data[] = {0x48, 0x85, 0xC0}; // test rax, rax
+			emit(data, sizeof(data));
+			jumpIf(0x05, labelStart); // jne
+			bind(labelEnd);
+			return true;
+		}
+		case eci::interpreter::typeReturn: {
+			eci::interpreter::Return* element = static_cast<eci::interpreter::Return*>(_element.get());
+			if (element->m_tailCall == true) {
+				// the new arguments are computed on the machine stack, then stored in the argument slots
+				eci::interpreter::FunctionCall* call = static_cast<eci::interpreter::FunctionCall*>(element->m_value.get());
+				const etk::Vector<eci::Variable>& arguments = m_function.getArguments();
+				for (size_t iii=0; iii<arguments.size(); ++iii) {
+					enum eci::valueType type = eci::valueTypeVoid;
+					if (    expression(call->m_arguments[iii], type) == false
+					     || convert(type, arguments[iii].getValueType()) == false) {
+						return false;
+					}
+					push();
+				}
+				for (size_t iii=arguments.size(); iii>0; --iii) {
+					popRax();
+					storeSlot(iii-1);
+				}
+				jump(m_labelBody);
+				return true;
+			}
+			if (element->m_value != null) {
+				enum eci::valueType type = eci::valueTypeVoid;
+				if (expression(element->m_value, type) == false) {
+					return false;
+				}
+				if (    m_function.getReturn().size() != 0
+				     && convert(type, m_function.getReturn()[0].getValueType()) == false) {
+					return false;
+				}
+			} else {
+				static const uint8_t clear[] = {0x31, 0xC0}; // xor eax, eax
+				emit(clear, sizeof(clear));
+			}
+			jump(m_labelReturn);
+			return true;
+		}
+		case eci::interpreter::typeSwitch:
+			return statementSwitch(static_cast<eci::interpreter::Switch*>(_element.get()));
+		case eci::interpreter::typeBreak:
+		case eci::interpreter::typeContinue: {
+			if (m_cycles.size() == 0) {
+				return fail("break or continue out of a cycle");
+			}
+			int32_t label = _element->getTockenId() == eci::interpreter::typeBreak ? m_cycles.back().second : m_cycles.back().first;
+			if (label < 0) {
+				// "continue" in a switch out of a cycle
+				return fail("break or continue out of a cycle");
+			}
+			jump(label);
+			return true;
+		}
+		default:
+			break;
+	}
+	enum eci::valueType type = eci::valueTypeVoid;
+	return expression(_element, type);
+}
+
+void JitCompiler::compareRax(int64_t _value) {
+	if (int64_t(int32_t(_value)) == _value) {
+		static const uint8_t data[] = {0x48, 0x3D}; // cmp rax, imm32
+		emit(data, sizeof(data));
+		emit32(int32_t(_value));
+		return;
+	}
+	static const uint8_t data[] = {0x48, 0xB9}; // mov rcx, imm64
+	emit(data, sizeof(data));
+	emit64(_value);
+	static const uint8_t compare[] = {0x48, 0x39, 0xC8}; // cmp rax, rcx
+	emit(compare, sizeof(compare));
+}
+
+void JitCompiler::switchSearch(const etk::Vector<etk::Pair<int64_t, int32_t>>& _cases,
+                               size_t _begin,
+                               size_t _end,
+                               const etk::Vector<int32_t>& _labels,
+                               int32_t _labelDefault) {
+	if (_end - _begin <= 4) {
+		// a few labels are compared in sequence
+		for (size_t iii=_begin; iii<_end; ++iii) {
+			compareRax(_cases[iii].first);
+			jumpIf(0x04, _labels[_cases[iii].second]); // je
+		}
+		jump(_labelDefault);
+		return;
+	}
+	size_t middle = (_begin + _end) / 2;
+	int32_t labelHigh = newLabel();
+	compareRax(_cases[middle].first);
+	jumpIf(0x04, _labels[_cases[middle].second]); // je
+	jumpIf(0x0F, labelHigh); // jg
+	switchSearch(_cases, _begin, middle, _labels, _labelDefault);
+	bind(labelHigh);
+	switchSearch(_cases, middle+1, _end, _labels, _labelDefault);
+}
+
+bool JitCompiler::statementSwitch(eci::interpreter::Switch* _element) {
+	enum eci::valueType type = eci::valueTypeVoid;
+	if (expression(_element->m_value, type) == false) {
+		return false;
+	}
+	if (    type == eci::valueTypeVoid
+	     || type >= eci::valueTypeFloat) {
+		return fail("switch on a value that is not an integer");
+	}
+	if (convert(type, eci::valueTypeInt64) == false) {
+		return false;
+	}
+	int32_t labelEnd = newLabel();
+	etk::Vector<int32_t> labels;
+	for (size_t iii=0; iii<_element->m_blocks.size(); ++iii) {
+		labels.pushBack(newLabel());
+	}
+	int32_t labelDefault = _element->m_default < 0 ? labelEnd : labels[_element->m_default];
+	if (_element->isDense() == true) {
+		// jump table: each entry is the offset of the block from the end of the entry
+		const etk::Vector<int32_t>& table = _element->getTable();
+		int64_t minimum = _element->getMinimum();
+		if (int64_t(int32_t(minimum)) == minimum) {
+			static const uint8_t data[] = {0x48, 0x2D}; // sub rax, imm32
+			emit(data, sizeof(data));
+			emit32(int32_t(minimum));
+		} else {
+			static const uint8_t data[] = {0x48, 0xB9}; // mov rcx, imm64
+			emit(data, sizeof(data));
+			emit64(minimum);
+			static const uint8_t sub[] = {0x48, 0x29, 0xC8}; // sub rax, rcx
+			emit(sub, sizeof(sub));
+		}
+		compareRax(table.size());
+		jumpIf(0x03, labelDefault); // jae (the unsigned compare check the two bounds)
+		int32_t labelTable = newLabel();
+		static const uint8_t table0[] = {0x48, 0x8D, 0x0D}; // lea rcx, [rip+disp32]
+		emit(table0, sizeof(table0));
+		m_patches.pushBack(etk::makePair(m_code.size(), labelTable));
+		emit32(0);
+		static const uint8_t dispatch[] = {0x48, 0x8D, 0x4C, 0x81, 0x04, // lea rcx, [rcx+rax*4+4]
+		                                   0x48, 0x63, 0x41, 0xFC, // movsxd rax, dword [rcx-4]
+		                                   0x48, 0x01, 0xC8, // add rax, rcx
+		                                   0xFF, 0xE0}; // jmp rax
+		emit(dispatch, sizeof(dispatch));
+		bind(labelTable);
+		for (auto &it : table) {
+			m_patches.pushBack(etk::makePair(m_code.size(), it < 0 ? labelEnd : labels[it]));
+			emit32(0);
+		}
+	} else {
+		switchSearch(_element->getSortedCases(), 0, _element->getSortedCases().size(), labels, labelDefault);
+	}
+	// "break" go to the end of the switch, "continue" to the current cycle
+	m_cycles.pushBack(etk::makePair(m_cycles.size() != 0 ? m_cycles.back().first : -1, labelEnd));
+	for (size_t iii=0; iii<_element->m_blocks.size(); ++iii) {
+		bind(labels[iii]);
+		if (block(_element->m_blocks[iii]) == false) {
+			return false;
+		}
+	}
+	m_cycles.popBack();
+	bind(labelEnd);
+	return true;
+}
+
+bool JitCompiler::expression(const ememory::SharedPtr<eci::interpreter::Element>& _element, enum eci::valueType& _type) {
+	if (_element == null) {
+		return fail("empty expression");
+	}
+	switch (_element->getTockenId()) {
+		case eci::interpreter::typeConstant: {
+			const eci::Value& value = static_cast<eci::interpreter::Constant*>(_element.get())->m_value;
+			if (isJitType(value.m_type) == false) {
+				return fail("unsupported constant type");
+			}
+			movRaxImmediate(eci::Jit::toRaw(value));
+			_type = value.m_type;
+			return true;
+		}
+		case eci::interpreter::typeVariable: {
+			int32_t slot = -1;
+			if (getLocalSlot(_element, slot) == false) {
+				return false;
+			}
+			loadSlot(slot);
+			_type = m_slotType[slot];
+			return true;
+		}
+		case eci::interpreter::typeCast: {
+			eci::interpreter::Cast* element = static_cast<eci::interpreter::Cast*>(_element.get());
+			enum eci::valueType type = eci::valueTypeVoid;
+			if (    expression(element->m_value, type) == false
+			     || convert(type, element->m_valueType) == false) {
+				return false;
+			}
+			_type = element->m_valueType;
+			return true;
+		}
+		case eci::interpreter::typeOperator:
+			return expressionOperator(static_cast<eci::interpreter::Operator*>(_element.get()), _type);
+		case eci::interpreter::typeFunctionCall:
+			return expressionCall(static_cast<eci::interpreter::FunctionCall*>(_element.get()), _type);
+		default:
+			break;
+	}
+	return fail("unsupported element");
+}
+
+bool JitCompiler::expressionOperator(eci::interpreter::Operator* _element, enum eci::valueType& _type) {
+	switch (_element->m_operatorId) {
+		case eci::operatorAnd:
+		case eci::operatorOr: {
+			int32_t labelShort = newLabel();
+			int32_t labelEnd = newLabel();
+			enum eci::valueType type = eci::valueTypeVoid;
+			if (    expression(_element->m_left, type) == false
+			     || convert(type, eci::valueTypeBool) == false) {
+				return false;
+			}
+			static const uint8_t test[] = {0x48, 0x85, 0xC0}; // test rax, rax
+			emit(test, sizeof(test));
+			jumpIf(_element->m_operatorId == eci::operatorAnd ? 0x04 : 0x05, labelShort); // je / jne
+			if (    expression(_element->m_right, type) == false
+			     || convert(type, eci::valueTypeBool) == false) {
+				return false;
+			}
+			jump(labelEnd);
+			bind(labelShort);
+			movRaxImmediate(_element->m_operatorId == eci::operatorAnd ? 0 : 1);
+			bind(labelEnd);
+			_type = eci::valueTypeBool;
+			return true;
+		}
+		case eci::operatorNot: {
+			enum eci::valueType type = eci::valueTypeVoid;
+			if (    expression(_element->m_right, type) == false
+			     || convert(type, eci::valueTypeBool) == false) {
+				return false;
+			}
+			static const uint8_t data[] = {0x83, 0xF0, 0x01}; // xor eax, 1
+			emit(data, sizeof(data));
+			_type = eci::valueTypeBool;
+			return true;
+		}
+		case eci::operatorAssign: {
+			int32_t slot = -1;
+			enum eci::valueType type = eci::valueTypeVoid;
+			if (    getLocalSlot(_element->m_left, slot) == false
+			     || expression(_element->m_right, type) == false
+			     || convert(type, m_slotType[slot]) == false) {
+				return false;
+			}
+			storeSlot(slot);
+			_type = m_slotType[slot];
+			return true;
+		}
+		case eci::operatorAssignAdd:
+		case eci::operatorAssignSub:
+		case eci::operatorAssignMul:
+		case eci::operatorAssignDiv:
+		case eci::operatorAssignMod: {
+			int32_t slot = -1;
+			enum eci::valueType type = eci::valueTypeVoid;
+			if (    getLocalSlot(_element->m_left, slot) == false
+			     || expression(_element->m_right, type) == false) {
+				return false;
+			}
+			enum eci::valueType common = eci::getCommonType(m_slotType[slot], type);
+			if (convert(type, common) == false) {
+				return false;
+			}
+			movRcxRax();
+			loadSlot(slot);
+			enum eci::valueType result = eci::valueTypeVoid;
+			if (    convert(m_slotType[slot], common) == false
+			     || binaryOperator(eci::getAssignOperator(_element->m_operatorId), common, result) == false
+			     || convert(result, m_slotType[slot]) == false) {
+				return false;
+			}
+			storeSlot(slot);
+			_type = m_slotType[slot];
+			return true;
+		}
+		case eci::operatorIncrement:
+		case eci::operatorDecrement: {
+			bool postfix = _element->m_left != null;
+			int32_t slot = -1;
+			if (getLocalSlot(postfix == true ? _element->m_left : _element->m_right, slot) == false) {
+				return false;
+			}
+			_type = m_slotType[slot];
+			bool increment = _element->m_operatorId == eci::operatorIncrement;
+			loadSlot(slot);
+			if (postfix == true) {
+				push();
+			}
+			if (_type == eci::valueTypeDouble) {
+				movRcxRax();
+				movRaxImmediate(eci::Jit::toRaw(eci::Value(1.0)));
+				static const uint8_t swap[] = {0x48, 0x91}; // xchg rax, rcx
+				emit(swap, sizeof(swap));
+				enum eci::valueType result = eci::valueTypeVoid;
+				if (binaryOperator(increment == true ? eci::operatorAdd : eci::operatorSub, _type, result) == false) {
+					return false;
+				}
+			} else if (    _type == eci::valueTypeInt32
+			            || _type == eci::valueTypeInt64) {
+				if (_type == eci::valueTypeInt64) {
+					emit(0x48);
+				}
+				emit(0x83); // add/sub eax, 1
+				emit(increment == true ? 0xC0 : 0xE8);
+				emit(0x01);
+				if (_type == eci::valueTypeInt32) {
+					signExtend32();
+				}
+			} else {
+				return fail("unsupported increment type");
+			}
+			storeSlot(slot);
+			if (postfix == true) {
+				popRax();
+			}
+			return true;
+		}
+		case eci::operatorSub:
+			if (_element->m_left == null) {
+				enum eci::valueType type = eci::valueTypeVoid;
+				if (expression(_element->m_right, type) == false) {
+					return false;
+				}
+				if (type == eci::valueTypeBool) {
+					// integer promotion
+					type = eci::valueTypeInt32;
+				}
+				if (type == eci::valueTypeDouble) {
+					static const uint8_t data[] = {0x48, 0x0F, 0xBA, 0xF8, 0x3F}; // btc rax, 63
+					emit(data, sizeof(data));
+				} else if (type == eci::valueTypeInt64) {
+					static const uint8_t data[] = {0x48, 0xF7, 0xD8}; // neg rax
+					emit(data, sizeof(data));
+				} else if (type == eci::valueTypeInt32) {
+					static const uint8_t data[] = {0xF7, 0xD8}; // neg eax
+					emit(data, sizeof(data));
+					signExtend32();
+				} else {
+					return fail("unsupported negation type");
+				}
+				_type = type;
+				return true;
+			}
+			break;
+		case eci::operatorNone:
+			return fail("unknow operator");
+		default:
+			break;
+	}
+	if (    _element->m_left == null
+	     || _element->m_right == null) {
+		return fail("unsupported unary operator");
+	}
+	enum eci::valueType typeLeft = eci::valueTypeVoid;
+	enum eci::valueType typeRight = eci::valueTypeVoid;
+	if (expression(_element->m_left, typeLeft) == false) {
+		return false;
+	}
+	push();
+	if (expression(_element->m_right, typeRight) == false) {
+		return false;
+	}
+	enum eci::valueType common = eci::getCommonType(typeLeft, typeRight);
+	if (convert(typeRight, common) == false) {
+		return false;
+	}
+	movRcxRax();
+	popRax();
+	if (convert(typeLeft, common) == false) {
+		return false;
+	}
+	return binaryOperator(_element->m_operatorId, common, _type);
+}
+
+void JitCompiler::nativeCall(const eci::NativeCall& _native) {
+	// the arguments are in the array on the machine stack: set them in the registers of the C convention
+	static const uint8_t integerRegister[][3] = {{0x48, 0x8B, 0xBC}, // mov rdi, [rsp+disp32]
+	                                             {0x48, 0x8B, 0xB4}, // mov rsi, [rsp+disp32]
+	                                             {0x48, 0x8B, 0x94}, // mov rdx, [rsp+disp32]
+	                                             {0x48, 0x8B, 0x8C}, // mov rcx, [rsp+disp32]
+	                                             {0x4C, 0x8B, 0x84}, // mov r8, [rsp+disp32]
+	                                             {0x4C, 0x8B, 0x8C}}; // mov r9, [rsp+disp32]
+	const etk::Vector<eci::NativeCall::Argument>& arguments = _native.getArguments();
+	for (size_t iii=0; iii<arguments.size(); ++iii) {
+		if (arguments[iii].m_float == false) {
+			emit(integerRegister[arguments[iii].m_register], 3);
+		} else {
+			static const uint8_t data[] = {0xF2, 0x0F, 0x10}; // movsd xmmN, [rsp+disp32]
+			emit(data, sizeof(data));
+			emit(0x84 | (arguments[iii].m_register << 3));
+		}
+		emit(0x24);
+		emit32(8*iii);
+	}
+	movRaxImmediate(reinterpret_cast<int64_t>(_native.getSymbol()));
+	static const uint8_t call[] = {0xFF, 0xD0}; // call rax
+	emit(call, sizeof(call));
+	// the high bits of a small return value are not set by the C function
+	switch (_native.getReturn()) {
+		case eci::valueTypeBool: {
+			static const uint8_t data[] = {0x0F, 0xB6, 0xC0}; // movzx eax, al
+			emit(data, sizeof(data));
+			break;
+		}
+		case eci::valueTypeInt32: {
+			static const uint8_t data[] = {0x48, 0x63, 0xC0}; // movsxd rax, eax
+			emit(data, sizeof(data));
+			break;
+		}
+		case eci::valueTypeDouble: {
+			static const uint8_t data[] = {0x66, 0x48, 0x0F, 0x7E, 0xC0}; // movq rax, xmm0
+			emit(data, sizeof(data));
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+bool JitCompiler::expressionCall(eci::interpreter::FunctionCall* _element, enum eci::valueType& _type) {
+	if (_element->m_functionId < 0) {
+		return fail("unresolved function");
+	}
+	const eci::Function* function = m_interpreter.getFunction(_element->m_functionId).get();
+	if (    function->getNative() != null
+	     && function->getNative()->isBuiltin() == true) {
+		return fail("call of a builtin function");
+	}
+	const etk::Vector<eci::Variable>& arguments = function->getArguments();
+	if (    arguments.size() != _element->m_arguments.size()
+	     || arguments.size() > size_t(eci::Jit::maxArgument)) {
+		return fail("unsupported call");
+	}
+	_type = eci::valueTypeVoid;
+	if (function->getReturn().size() != 0) {
+		_type = function->getReturn()[0].getValueType();
+		if (isJitType(_type) == false) {
+			return fail("unsupported return type of a called function");
+		}
+	}
+	// the arguments array is reserved on the machine stack (the call is aligned on 16 bytes)
+	int32_t nbSlot = arguments.size();
+	if (((m_depth + nbSlot) % 2) != 0) {
+		++nbSlot;
+	}
+	if (nbSlot != 0) {
+		static const uint8_t data[] = {0x48, 0x81, 0xEC}; // sub rsp, imm32
+		emit(data, sizeof(data));
+		emit32(8*nbSlot);
+		m_depth += nbSlot;
+	}
+	for (size_t iii=0; iii<arguments.size(); ++iii) {
+		enum eci::valueType type = eci::valueTypeVoid;
+		if (    isJitType(arguments[iii].getValueType()) == false
+		     || expression(_element->m_arguments[iii], type) == false
+		     || convert(type, arguments[iii].getValueType()) == false) {
+			return fail("unsupported argument of a called function");
+		}
+		static const uint8_t data[] = {0x48, 0x89, 0x84, 0x24}; // mov [rsp+disp32], rax
+		emit(data, sizeof(data));
+		emit32(8*iii);
+	}
+	if (function->getNative() != null) {
+		nativeCall(*function->getNative());
+	} else {
+		static const uint8_t data[] = {0x48, 0x89, 0xE7, // mov rdi, rsp
+		                               0x48, 0x8B, 0x75, 0xF8, // mov rsi, [rbp-8]
+		                               0x48, 0xBA}; // mov rdx, imm64
+		emit(data, sizeof(data));
+		emit64(reinterpret_cast<int64_t>(function));
+		// indirect call: the entry change when the called function is compiled
+		movRaxImmediate(reinterpret_cast<int64_t>(function->getJitEntryAddress()));
+		static const uint8_t call[] = {0xFF, 0x10}; // call [rax]
+		emit(call, sizeof(call));
+		emit(0x48); // mov rcx, imm64
+		emit(0xB9);
+		emit64(reinterpret_cast<int64_t>(m_interpreter.getAbortedAddress()));
+		static const uint8_t checkAbort[] = {0x80, 0x39, 0x00}; // cmp byte [rcx], 0
+		emit(checkAbort, sizeof(checkAbort));
+		jumpIf(0x5, m_labelAbort); // jne
+	}
+	if (nbSlot != 0) {
+		static const uint8_t data[] = {0x48, 0x81, 0xC4}; // add rsp, imm32
+		emit(data, sizeof(data));
+		emit32(8*nbSlot);
+		m_depth -= nbSlot;
+	}
+	return true;
+}
+
+#endif
+
+bool eci::Jit::compile(eci::Interpreter& _interpreter, const eci::Function& _function) {
+	#ifdef ECI_JIT_X86_64
+		if (_function.getBody() == null) {
+			_function.m_jitState = eci::jitStateFailed;
+			return false;
+		}
+		JitCompiler compiler(_interpreter, _function);
+		if (compiler.compile() == false) {
+			ECI_DEBUG("JIT: keep '" << _function.getName() << "' in the interpreter : " << compiler.getError());
+			_function.m_jitState = eci::jitStateFailed;
+			++m_nbFailed;
+			return false;
+		}
+		const etk::Vector<uint8_t>& code = compiler.getCode();
+		size_t size = (code.size() + 4095) & ~size_t(4095);
+		void* memory = mmap(null, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (memory == MAP_FAILED) {
+			ECI_ERROR("JIT: can not allocate executable memory");
+			_function.m_jitState = eci::jitStateFailed;
+			++m_nbFailed;
+			return false;
+		}
+		memcpy(memory, &code[0], code.size());
+		if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+			ECI_ERROR("JIT: can not set the memory executable");
+			munmap(memory, size);
+			_function.m_jitState = eci::jitStateFailed;
+			++m_nbFailed;
+			return false;
+		}
+		m_memory.pushBack(etk::makePair(memory, size));
+		_function.m_jitEntry = reinterpret_cast<eci::jitEntry>(memory);
+		_function.m_jitState = eci::jitStateCompiled;
+		++m_nbCompiled;
+		m_codeSize += code.size();
+		ECI_DEBUG("JIT: compile '" << _function.getName() << "' size=" << code.size());
+		return true;
+	#else
+		_function.m_jitState = eci::jitStateFailed;
+		return false;
+	#endif
+}
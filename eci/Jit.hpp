@@ -0,0 +1,117 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/Pair.hpp>
+#include <etk/Vector.hpp>
+#include <eci/Value.hpp>
+
+namespace eci {
+	class Interpreter;
+	class Function;
+	/**
+	 * @brief Native entry point of a function: the arguments and the return value are raw 64 bits values
+	 * (integer sign extended, bool 0/1, double bits).
+	 * @param[in] _arguments Arguments of the function (converted in the type of the arguments).
+	 * @param[in] _interpreter Interpreter that execute the function.
+	 * @param[in] _function Called function.
+	 * @return The raw return value.
+	 */
+	typedef int64_t (*jitEntry)(const int64_t* _arguments, eci::Interpreter* _interpreter, const eci::Function* _function);
+	/**
+	 * @brief State of the native code of a function.
+	 */
+	enum jitState {
+		jitStateNone, //!< not compiled (executed by the interpreter)
+		jitStateCompiled, //!< native code is used
+		jitStateFailed, //!< function can not be compiled (always executed by the interpreter)
+	};
+	/**
+	 * @brief Baseline JIT (x86-64 Linux only): when a function is called more than a threshold, its element tree
+	 * is compiled in machine code. Only the functions that use bool, int32, int64 and double locals, arithmetic,
+	 * branches, cycles and calls are compiled, an other function stay in the interpreter. A call to a function
+	 * that is not compiled go back in the interpreter.
+	 */
+	class Jit {
+		public:
+			static const int32_t maxArgument = 16; //!< Max number of argument of a compiled function.
+		private:
+			bool m_enable; //!< Compile the hot functions.
+			bool m_available; //!< The JIT can be enabled (not on the functions of a shared module).
+			int32_t m_threshold; //!< Number of call before the compilation.
+			etk::Vector<etk::Pair<void*, size_t>> m_memory; //!< Executable memory of the compiled functions.
+			size_t m_nbCompiled; //!< Number of compiled function.
+			size_t m_nbFailed; //!< Number of function that can not be compiled.
+			size_t m_codeSize; //!< Size of the generated code.
+		public:
+			Jit();
+			~Jit();
+			/**
+			 * @brief Check if the JIT is available on this platform.
+			 * @return true on x86-64 Linux.
+			 */
+			static bool isSupported();
+			void setEnable(bool _value) {
+				m_enable = _value && m_available;
+			}
+			/**
+			 * @brief Forbid the JIT (the native code and the call counters are in the functions shared with other interpreters).
+			 * @param[in] _value false to disable the JIT.
+			 */
+			void setAvailable(bool _value) {
+				m_available = _value;
+				m_enable = m_enable && m_available;
+			}
+			bool getAvailable() const {
+				return m_available;
+			}
+			bool getEnable() const {
+				return m_enable;
+			}
+			void setThreshold(int32_t _value) {
+				m_threshold = _value;
+			}
+			int32_t getThreshold() const {
+				return m_threshold;
+			}
+			size_t getNbCompiled() const {
+				return m_nbCompiled;
+			}
+			size_t getNbFailed() const {
+				return m_nbFailed;
+			}
+			size_t getCodeSize() const {
+				return m_codeSize;
+			}
+			/**
+			 * @brief Compile a function (the native entry of the function is updated).
+			 * @param[in] _interpreter Interpreter that own the function (used to get the called functions and the value stack
+			 * that count the calls of the native code).
+			 * @param[in] _function Function to compile.
+			 * @return true if the function is compiled.
+			 */
+			bool compile(eci::Interpreter& _interpreter, const eci::Function& _function);
+			/**
+			 * @brief Native entry of a function that is not compiled: execute it with the interpreter.
+			 */
+			static int64_t callInterpreter(const int64_t* _arguments, eci::Interpreter* _interpreter, const eci::Function* _function);
+			/**
+			 * @brief Get the raw 64 bits representation of a value.
+			 * @param[in] _value Value to convert.
+			 * @return The raw value.
+			 */
+			static int64_t toRaw(const eci::Value& _value);
+			/**
+			 * @brief Get a value from its raw 64 bits representation.
+			 * @param[in] _value Raw value.
+			 * @param[in] _type Type of the value.
+			 * @return The value.
+			 */
+			static eci::Value fromRaw(int64_t _value, enum eci::valueType _type);
+	};
+}
@@ -0,0 +1,657 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Kernel.hpp>
+#include <eci/Object.hpp>
+#include <eci/Class.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/Type.hpp>
+#include <eci/debug.hpp>
+#include <string.h>
+#include <stddef.h>
+#include <atomic>
+#include <algorithm>
+
+// The SSE2 and AVX2 versions are compiled with the target of their instruction set: the CPU is checked before their use.
+#if    defined(__x86_64__) \
+    && (    defined(__GNUC__) \
+         || defined(__clang__))
+	#define ECI_KERNEL_X86
+	#include <immintrin.h>
+#endif
+
+// The kernels read the payload of the values in the vector registers: 2 values in 128 bits (the type then the payload).
+static_assert(    sizeof(eci::Value) == 16
+              && offsetof(eci::Value, m_int64) == 8, "The kernels need a value of 16 bytes with the payload in the last 8 bytes");
+
+const char* const eci::Kernel::libraryName = "eci/kernel";
+
+static std::atomic<int32_t> g_level(-1); //!< Level selected by @ref eci::Kernel::setLevel (-1: supported level).
+
+namespace eci {
+	namespace kernel {
+		/**
+		 * @brief Operation of the kernels on 2 elements.
+		 */
+		enum operation {
+			operationAdd,
+			operationSub,
+			operationMul,
+			operationMin,
+			operationMax,
+			operationLess, //!< 1 or 0 (all the bits of the lane in the vector registers)
+		};
+		/**
+		 * @brief Get the payload of a value of the type of an array (no conversion).
+		 */
+		template<typename T> T getPayload(const eci::Value& _value);
+		template<> inline double getPayload<double>(const eci::Value& _value) {
+			return _value.m_double;
+		}
+		template<> inline float getPayload<float>(const eci::Value& _value) {
+			return _value.m_float;
+		}
+		template<> inline int32_t getPayload<int32_t>(const eci::Value& _value) {
+			return _value.m_int32;
+		}
+		template<> inline int64_t getPayload<int64_t>(const eci::Value& _value) {
+			return _value.m_int64;
+		}
+		/**
+		 * @brief Compute an operation on 2 elements (the integers wrap as the vector instructions and the script).
+		 */
+		template<typename T, enum operation OPERATION> inline T compute(T _left, T _right) {
+			switch (OPERATION) {
+				case operationAdd:  return eci::typeAdd<T>(_left, _right);
+				case operationSub:  return eci::typeSub<T>(_left, _right);
+				case operationMul:  return eci::typeMul<T>(_left, _right);
+				case operationMin:  return (_right < _left ? _right : _left);
+				case operationMax:  return (_left < _right ? _right : _left);
+				case operationLess: return T(_left < _right);
+			}
+			return T(0);
+		}
+		/**
+		 * @brief Kernels of a type of element for an instruction set.
+		 */
+		template<typename T> class Table {
+			public:
+				T (*m_sum)(const eci::Value*, size_t);
+				T (*m_dot)(const eci::Value*, const eci::Value*, size_t);
+				T (*m_min)(const eci::Value*, size_t);
+				T (*m_max)(const eci::Value*, size_t);
+				void (*m_add)(eci::Value*, const eci::Value*, const eci::Value*, size_t);
+				void (*m_sub)(eci::Value*, const eci::Value*, const eci::Value*, size_t);
+				void (*m_mul)(eci::Value*, const eci::Value*, const eci::Value*, size_t);
+				void (*m_scale)(eci::Value*, const eci::Value*, T, size_t);
+				int32_t (*m_countLess)(const eci::Value*, T, size_t);
+				void (*m_less)(eci::Value*, const eci::Value*, const eci::Value*, size_t);
+		};
+		namespace scalar {
+			/**
+			 * @brief Elements of a vector register (interface used by the loops, one element for the scalar version).
+			 */
+			template<typename T> class Vector {
+				public:
+					typedef T Type; //!< Register.
+					static const size_t size = 1; //!< Number of elements in a register.
+					static Type zero() {
+						return T(0);
+					}
+					static Type broadcast(T _value) {
+						return _value;
+					}
+					/**
+					 * @brief Read the payload of @ref size values (the order of the elements in the register is the order of @ref store).
+					 */
+					static Type load(const eci::Value* _values) {
+						return getPayload<T>(*_values);
+					}
+					/**
+					 * @brief Write @ref size values of the type T.
+					 */
+					static void store(eci::Value* _values, Type _value) {
+						*_values = eci::Value(_value);
+					}
+					/**
+					 * @brief Write @ref size bool values of a mask of operationLess.
+					 */
+					static void storeBool(eci::Value* _values, Type _mask) {
+						*_values = eci::Value(_mask != T(0));
+					}
+					/**
+					 * @brief Number of elements set in a mask of operationLess.
+					 */
+					static int32_t count(Type _mask) {
+						return (_mask != T(0) ? 1 : 0);
+					}
+					template<enum operation OPERATION> static Type compute(Type _left, Type _right) {
+						return eci::kernel::compute<T, OPERATION>(_left, _right);
+					}
+					static T sum(Type _value) {
+						return _value;
+					}
+					/**
+					 * @brief Compute operationMin or operationMax on the elements of the register.
+					 */
+					template<enum operation OPERATION> static T reduce(Type _value) {
+						return _value;
+					}
+			};
+			#include <eci/KernelLoop.hpp>
+		}
+		#ifdef ECI_KERNEL_X86
+			namespace sse2 {
+				/**
+				 * @brief Part of the register common to all the types: a value in each 64 bits lane (float and int
+				 * in the low 32 bits, the high 32 bits are 0).
+				 */
+				template<typename T> class Base {
+					public:
+						typedef __m128i Type;
+						static const size_t size = 2;
+						static Type zero() {
+							return _mm_setzero_si128();
+						}
+						static Type broadcast(T _value) {
+							return _mm_set1_epi64x(eci::Value(_value).m_int64);
+						}
+						static Type load(const eci::Value* _values) {
+							return _mm_unpackhi_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_values)),
+							                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(_values+1)));
+						}
+						static void storeType(eci::Value* _values, Type _value, enum eci::valueType _type) {
+							Type type = _mm_set1_epi64x(_type);
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(_values), _mm_unpacklo_epi64(type, _value));
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(_values+1), _mm_unpackhi_epi64(type, _value));
+						}
+						static void store(eci::Value* _values, Type _value) {
+							storeType(_values, _value, eci::Value(T(0)).m_type);
+						}
+						static void storeBool(eci::Value* _values, Type _mask) {
+							storeType(_values, _mm_and_si128(_mask, _mm_set1_epi64x(1)), eci::valueTypeBool);
+						}
+						static int32_t count(Type _mask) {
+							return __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(_mask)));
+						}
+						static void getLanes(Type _value, T* _lanes) {
+							int64_t raw[size];
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(raw), _value);
+							for (size_t iii=0; iii<size; ++iii) {
+								memcpy(&_lanes[iii], &raw[iii], sizeof(T));
+							}
+						}
+						/**
+						 * @brief Compute an operation lane by lane (no instruction for this type).
+						 */
+						template<enum operation OPERATION> static Type computeLanes(Type _left, Type _right) {
+							T left[size];
+							T right[size];
+							getLanes(_left, left);
+							getLanes(_right, right);
+							int64_t raw[size];
+							for (size_t iii=0; iii<size; ++iii) {
+								if (OPERATION == operationLess) {
+									raw[iii] = (left[iii] < right[iii] ? -1 : 0);
+								} else {
+									raw[iii] = eci::Value(eci::kernel::compute<T, OPERATION>(left[iii], right[iii])).m_int64;
+								}
+							}
+							return _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw));
+						}
+						static T sum(Type _value) {
+							T lanes[size];
+							getLanes(_value, lanes);
+							return eci::kernel::compute<T, operationAdd>(lanes[0], lanes[1]);
+						}
+						template<enum operation OPERATION> static T reduce(Type _value) {
+							T lanes[size];
+							getLanes(_value, lanes);
+							return eci::kernel::compute<T, OPERATION>(lanes[0], lanes[1]);
+						}
+						/**
+						 * @brief Copy the low 32 bits of each lane in its high 32 bits (mask of a 32 bits comparison).
+						 */
+						static Type spread(Type _mask) {
+							return _mm_shuffle_epi32(_mask, _MM_SHUFFLE(2, 2, 0, 0));
+						}
+						static Type select(Type _mask, Type _left, Type _right) {
+							return _mm_or_si128(_mm_and_si128(_mask, _left), _mm_andnot_si128(_mask, _right));
+						}
+				};
+				template<typename T> class Vector;
+				template<> class Vector<double> : public Base<double> {
+					public:
+						template<enum operation OPERATION> static Type compute(Type _left, Type _right) {
+							__m128d left = _mm_castsi128_pd(_left);
+							__m128d right = _mm_castsi128_pd(_right);
+							switch (OPERATION) {
+								case operationAdd:  return _mm_castpd_si128(_mm_add_pd(left, right));
+								case operationSub:  return _mm_castpd_si128(_mm_sub_pd(left, right));
+								case operationMul:  return _mm_castpd_si128(_mm_mul_pd(left, right));
+								case operationMin:  return _mm_castpd_si128(_mm_min_pd(left, right));
+								case operationMax:  return _mm_castpd_si128(_mm_max_pd(left, right));
+								case operationLess: return _mm_castpd_si128(_mm_cmplt_pd(left, right));
+							}
+							return _left;
+						}
+				};
+				template<> class Vector<float> : public Base<float> {
+					public:
+						template<enum operation OPERATION> static Type compute(Type _left, Type _right) {
+							__m128 left = _mm_castsi128_ps(_left);
+							__m128 right = _mm_castsi128_ps(_right);
+							switch (OPERATION) {
+								case operationAdd:  return _mm_castps_si128(_mm_add_ps(left, right));
+								case operationSub:  return _mm_castps_si128(_mm_sub_ps(left, right));
+								case operationMul:  return _mm_castps_si128(_mm_mul_ps(left, right));
+								case operationMin:  return _mm_castps_si128(_mm_min_ps(left, right));
+								case operationMax:  return _mm_castps_si128(_mm_max_ps(left, right));
+								case operationLess: return spread(_mm_castps_si128(_mm_cmplt_ps(left, right)));
+							}
+							return _left;
+						}
+				};
+				template<> class Vector<int32_t> : public Base<int32_t> {
+					public:
+						template<enum operation OPERATION> static Type compute(Type _left, Type _right) {
+							switch (OPERATION) {
+								case operationAdd:  return _mm_add_epi32(_left, _right);
+								case operationSub:  return _mm_sub_epi32(_left, _right);
+								// product of the low 32 bits in 64 bits: the high 32 bits are removed
+								case operationMul:  return _mm_and_si128(_mm_mul_epu32(_left, _right), _mm_set1_epi64x(0xFFFFFFFF));
+								case operationMin:  return select(_mm_cmplt_epi32(_left, _right), _left, _right);
+								case operationMax:  return select(_mm_cmpgt_epi32(_left, _right), _left, _right);
+								case operationLess: return spread(_mm_cmplt_epi32(_left, _right));
+							}
+							return _left;
+						}
+				};
+				template<> class Vector<int64_t> : public Base<int64_t> {
+					public:
+						template<enum operation OPERATION> static Type compute(Type _left, Type _right) {
+							switch (OPERATION) {
+								case operationAdd:  return _mm_add_epi64(_left, _right);
+								case operationSub:  return _mm_sub_epi64(_left, _right);
+								// no 64 bits product and comparison in SSE2
+								default:            return computeLanes<OPERATION>(_left, _right);
+							}
+						}
+				};
+				#include <eci/KernelLoop.hpp>
+			}
+			#if defined(__clang__)
+				#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+			#else
+				#pragma GCC push_options
+				#pragma GCC target("avx2")
+			#endif
+			namespace avx2 {
+				/**
+				 * @brief Same as the SSE2 version with 4 lanes (the elements are in the order 0, 2, 1, 3 in the register).
+				 */
+				template<typename T> class Base {
+					public:
+						typedef __m256i Type;
+						static const size_t size = 4;
+						static Type zero() {
+							return _mm256_setzero_si256();
+						}
+						static Type broadcast(T _value) {
+							return _mm256_set1_epi64x(eci::Value(_value).m_int64);
+						}
+						static Type load(const eci::Value* _values) {
+							return _mm256_unpackhi_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(_values)),
+							                             _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_values+2)));
+						}
+						static void storeType(eci::Value* _values, Type _value, enum eci::valueType _type) {
+							Type type = _mm256_set1_epi64x(_type);
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(_values), _mm256_unpacklo_epi64(type, _value));
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(_values+2), _mm256_unpackhi_epi64(type, _value));
+						}
+						static void store(eci::Value* _values, Type _value) {
+							storeType(_values, _value, eci::Value(T(0)).m_type);
+						}
+						static void storeBool(eci::Value* _values, Type _mask) {
+							storeType(_values, _mm256_and_si256(_mask, _mm256_set1_epi64x(1)), eci::valueTypeBool);
+						}
+						static int32_t count(Type _mask) {
+							return __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(_mask)));
+						}
+						static void getLanes(Type _value, T* _lanes) {
+							int64_t raw[size];
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(raw), _value);
+							for (size_t iii=0; iii<size; ++iii) {
+								memcpy(&_lanes[iii], &raw[iii], sizeof(T));
+							}
+						}
+						template<enum operation OPERATION> static Type computeLanes(Type _left, Type _right) {
+							T left[size];
+							T right[size];
+							getLanes(_left, left);
+							getLanes(_right, right);
+							int64_t raw[size];
+							for (size_t iii=0; iii<size; ++iii) {
+								raw[iii] = eci::Value(eci::kernel::compute<T, OPERATION>(left[iii], right[iii])).m_int64;
+							}
+							return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(raw));
+						}
+						static T sum(Type _value) {
+							T lanes[size];
+							getLanes(_value, lanes);
+							return eci::kernel::compute<T, operationAdd>(eci::kernel::compute<T, operationAdd>(lanes[0], lanes[1]),
+							                                             eci::kernel::compute<T, operationAdd>(lanes[2], lanes[3]));
+						}
+						template<enum operation OPERATION> static T reduce(Type _value) {
+							T lanes[size];
+							getLanes(_value, lanes);
+							return eci::kernel::compute<T, OPERATION>(eci::kernel::compute<T, OPERATION>(lanes[0], lanes[1]),
+							                                          eci::kernel::compute<T, OPERATION>(lanes[2], lanes[3]));
+						}
+						static Type spread(Type _mask) {
+							return _mm256_shuffle_epi32(_mask, _MM_SHUFFLE(2, 2, 0, 0));
+						}
+				};
+				template<typename T> class Vector;
+				template<> class Vector<double> : public Base<double> {
+					public:
+						template<enum operation OPERATION> static Type compute(Type _left, Type _right) {
+							__m256d left = _mm256_castsi256_pd(_left);
+							__m256d right = _mm256_castsi256_pd(_right);
+							switch (OPERATION) {
+								case operationAdd:  return _mm256_castpd_si256(_mm256_add_pd(left, right));
+								case operationSub:  return _mm256_castpd_si256(_mm256_sub_pd(left, right));
+								case operationMul:  return _mm256_castpd_si256(_mm256_mul_pd(left, right));
+								case operationMin:  return _mm256_castpd_si256(_mm256_min_pd(left, right));
+								case operationMax:  return _mm256_castpd_si256(_mm256_max_pd(left, right));
+								case operationLess: return _mm256_castpd_si256(_mm256_cmp_pd(left, right, _CMP_LT_OQ));
+							}
+							return _left;
+						}
+				};
+				template<> class Vector<float> : public Base<float> {
+					public:
+						template<enum operation OPERATION> static Type compute(Type _left, Type _right) {
+							__m256 left = _mm256_castsi256_ps(_left);
+							__m256 right = _mm256_castsi256_ps(_right);
+							switch (OPERATION) {
+								case operationAdd:  return _mm256_castps_si256(_mm256_add_ps(left, right));
+								case operationSub:  return _mm256_castps_si256(_mm256_sub_ps(left, right));
+								case operationMul:  return _mm256_castps_si256(_mm256_mul_ps(left, right));
+								case operationMin:  return _mm256_castps_si256(_mm256_min_ps(left, right));
+								case operationMax:  return _mm256_castps_si256(_mm256_max_ps(left, right));
+								case operationLess: return spread(_mm256_castps_si256(_mm256_cmp_ps(left, right, _CMP_LT_OQ)));
+							}
+							return _left;
+						}
+				};
+				template<> class Vector<int32_t> : public Base<int32_t> {
+					public:
+						template<enum operation OPERATION> static Type compute(Type _left, Type _right) {
+							switch (OPERATION) {
+								case operationAdd:  return _mm256_add_epi32(_left, _right);
+								case operationSub:  return _mm256_sub_epi32(_left, _right);
+								case operationMul:  return _mm256_and_si256(_mm256_mul_epu32(_left, _right), _mm256_set1_epi64x(0xFFFFFFFF));
+								case operationMin:  return _mm256_min_epi32(_left, _right);
+								case operationMax:  return _mm256_max_epi32(_left, _right);
+								case operationLess: return spread(_mm256_cmpgt_epi32(_right, _left));
+							}
+							return _left;
+						}
+				};
+				template<> class Vector<int64_t> : public Base<int64_t> {
+					public:
+						template<enum operation OPERATION> static Type compute(Type _left, Type _right) {
+							switch (OPERATION) {
+								case operationAdd:  return _mm256_add_epi64(_left, _right);
+								case operationSub:  return _mm256_sub_epi64(_left, _right);
+								// no 64 bits product in AVX2
+								case operationMul:  return computeLanes<OPERATION>(_left, _right);
+								case operationMin:  return _mm256_blendv_epi8(_left, _right, _mm256_cmpgt_epi64(_left, _right));
+								case operationMax:  return _mm256_blendv_epi8(_right, _left, _mm256_cmpgt_epi64(_left, _right));
+								case operationLess: return _mm256_cmpgt_epi64(_right, _left);
+							}
+							return _left;
+						}
+				};
+				#include <eci/KernelLoop.hpp>
+			}
+			#if defined(__clang__)
+				#pragma clang attribute pop
+			#else
+				#pragma GCC pop_options
+			#endif
+		#endif
+	}
+}
+
+/**
+ * @brief Get the kernels of a type for the current level.
+ */
+template<typename T> static const eci::kernel::Table<T>& getTable() {
+	static const eci::kernel::Table<T> scalar = eci::kernel::scalar::createTable<T>();
+	#ifdef ECI_KERNEL_X86
+		static const eci::kernel::Table<T> sse2 = eci::kernel::sse2::createTable<T>();
+		static const eci::kernel::Table<T> avx2 = eci::kernel::avx2::createTable<T>();
+		switch (eci::Kernel::getLevel()) {
+			case eci::kernelLevelScalar: return scalar;
+			case eci::kernelLevelSse2:   return sse2;
+			case eci::kernelLevelAvx2:   return avx2;
+		}
+	#endif
+	return scalar;
+}
+
+/**
+ * @brief Get the elements of an array argument of a kernel (a wrong argument abort the execution).
+ * @param[in] _interpreter Interpreter that execute the call.
+ * @param[in] _array Argument of the kernel.
+ * @param[in] _kernel Name of the kernel (for the error).
+ * @param[in,out] _size Number of elements (0: set, else the size expected).
+ * @return The first element (null if the argument is not an array of T or has not the expected size).
+ */
+template<typename T> static eci::Value* getElements(eci::Interpreter& _interpreter, const eci::Value& _array, const char* _kernel, size_t& _size) {
+	enum eci::valueType type = eci::Value(T(0)).m_type;
+	eci::Object* array = (_array.m_type == eci::valueTypeObject ? _array.m_object : null);
+	if (    array == null
+	     || array->m_fields == null
+	     || array->m_class->isArray() == false
+	     || array->m_class->getStride() != 1
+	     || array->m_class->getLayout()[0].m_valueType != type
+	     || array->m_class->getLayout()[0].m_class != null) {
+		ECI_ERROR("Kernel '" << _kernel << "' : an argument is not an array of " << eci::getValueTypeName(type));
+		_interpreter.abort();
+		return null;
+	}
+	if (_size == 0) {
+		_size = array->m_nbField;
+	} else if (_size != array->m_nbField) {
+		ECI_ERROR("Kernel '" << _kernel << "' : the arrays have not the same size (" << _size << " and " << array->m_nbField << ")");
+		_interpreter.abort();
+		return null;
+	}
+	return array->m_fields;
+}
+
+template<typename T> static eci::Value callSum(eci::Interpreter& _interpreter, const eci::Library&, const eci::Value* _arguments) {
+	size_t size = 0;
+	eci::Value* values = getElements<T>(_interpreter, _arguments[0], "sum", size);
+	if (values == null) {
+		return eci::Value(T(0));
+	}
+	return eci::Value(getTable<T>().m_sum(values, size));
+}
+
+template<typename T> static eci::Value callDot(eci::Interpreter& _interpreter, const eci::Library&, const eci::Value* _arguments) {
+	size_t size = 0;
+	eci::Value* left = getElements<T>(_interpreter, _arguments[0], "dot", size);
+	eci::Value* right = (left == null ? null : getElements<T>(_interpreter, _arguments[1], "dot", size));
+	if (right == null) {
+		return eci::Value(T(0));
+	}
+	return eci::Value(getTable<T>().m_dot(left, right, size));
+}
+
+template<typename T> static eci::Value callMin(eci::Interpreter& _interpreter, const eci::Library&, const eci::Value* _arguments) {
+	size_t size = 0;
+	eci::Value* values = getElements<T>(_interpreter, _arguments[0], "min", size);
+	if (    values == null
+	     || size == 0) {
+		return eci::Value(T(0));
+	}
+	return eci::Value(getTable<T>().m_min(values, size));
+}
+
+template<typename T> static eci::Value callMax(eci::Interpreter& _interpreter, const eci::Library&, const eci::Value* _arguments) {
+	size_t size = 0;
+	eci::Value* values = getElements<T>(_interpreter, _arguments[0], "max", size);
+	if (    values == null
+	     || size == 0) {
+		return eci::Value(T(0));
+	}
+	return eci::Value(getTable<T>().m_max(values, size));
+}
+
+/**
+ * @brief Call a kernel element by element: the arguments are the output then the 2 inputs (the size of the output is the size of the inputs).
+ */
+template<typename T, typename OUT> static eci::Value callApply(void (*_kernel)(eci::Value*, const eci::Value*, const eci::Value*, size_t),
+                                                               const char* _name,
+                                                               eci::Interpreter& _interpreter,
+                                                               const eci::Value* _arguments) {
+	size_t size = 0;
+	eci::Value* left = getElements<T>(_interpreter, _arguments[1], _name, size);
+	eci::Value* right = (left == null ? null : getElements<T>(_interpreter, _arguments[2], _name, size));
+	eci::Value* out = (right == null ? null : getElements<OUT>(_interpreter, _arguments[0], _name, size));
+	if (out != null) {
+		_kernel(out, left, right, size);
+	}
+	return eci::Value();
+}
+
+template<typename T> static eci::Value callAdd(eci::Interpreter& _interpreter, const eci::Library&, const eci::Value* _arguments) {
+	return callApply<T, T>(getTable<T>().m_add, "add", _interpreter, _arguments);
+}
+
+template<typename T> static eci::Value callSub(eci::Interpreter& _interpreter, const eci::Library&, const eci::Value* _arguments) {
+	return callApply<T, T>(getTable<T>().m_sub, "sub", _interpreter, _arguments);
+}
+
+template<typename T> static eci::Value callMul(eci::Interpreter& _interpreter, const eci::Library&, const eci::Value* _arguments) {
+	return callApply<T, T>(getTable<T>().m_mul, "mul", _interpreter, _arguments);
+}
+
+template<typename T> static eci::Value callLess(eci::Interpreter& _interpreter, const eci::Library&, const eci::Value* _arguments) {
+	// the bool array is not a kernel type: checked with its own type
+	return callApply<T, bool>(getTable<T>().m_less, "less", _interpreter, _arguments);
+}
+
+template<typename T> static eci::Value callScale(eci::Interpreter& _interpreter, const eci::Library&, const eci::Value* _arguments) {
+	size_t size = 0;
+	eci::Value* values = getElements<T>(_interpreter, _arguments[1], "scale", size);
+	eci::Value* out = (values == null ? null : getElements<T>(_interpreter, _arguments[0], "scale", size));
+	if (out != null) {
+		getTable<T>().m_scale(out, values, _arguments[2].get<T>(), size);
+	}
+	return eci::Value();
+}
+
+template<typename T> static eci::Value callCountLess(eci::Interpreter& _interpreter, const eci::Library&, const eci::Value* _arguments) {
+	size_t size = 0;
+	eci::Value* values = getElements<T>(_interpreter, _arguments[0], "countLess", size);
+	if (values == null) {
+		return eci::Value(int32_t(0));
+	}
+	return eci::Value(getTable<T>().m_countLess(values, _arguments[1].get<T>(), size));
+}
+
+template<typename T> static eci::Value callSort(eci::Interpreter& _interpreter, const eci::Library&, const eci::Value* _arguments) {
+	size_t size = 0;
+	eci::Value* values = getElements<T>(_interpreter, _arguments[0], "sort", size);
+	if (values == null) {
+		return eci::Value();
+	}
+	// the values have all the type of the array: sorted by their payload
+	std::sort(values, values+size, [](const eci::Value& _left, const eci::Value& _right) {
+		return eci::kernel::getPayload<T>(_left) < eci::kernel::getPayload<T>(_right);
+	});
+	return eci::Value();
+}
+
+eci::Kernel::Kernel() :
+  eci::Library(libraryName, true) {
+	addBuiltins<double>("Double");
+	addBuiltins<float>("Float");
+	addBuiltins<int32_t>("Int");
+	addBuiltins<int64_t>("Long");
+}
+
+eci::Kernel::~Kernel() {
+	
+}
+
+template<typename T> void eci::Kernel::addBuiltins(const etk::String& _suffix) {
+	addBuiltin("sum" + _suffix, &callSum<T>);
+	addBuiltin("dot" + _suffix, &callDot<T>);
+	addBuiltin("min" + _suffix, &callMin<T>);
+	addBuiltin("max" + _suffix, &callMax<T>);
+	addBuiltin("add" + _suffix, &callAdd<T>);
+	addBuiltin("sub" + _suffix, &callSub<T>);
+	addBuiltin("mul" + _suffix, &callMul<T>);
+	addBuiltin("scale" + _suffix, &callScale<T>);
+	addBuiltin("countLess" + _suffix, &callCountLess<T>);
+	addBuiltin("less" + _suffix, &callLess<T>);
+	addBuiltin("sort" + _suffix, &callSort<T>);
+}
+
+void eci::Kernel::addBuiltin(const etk::String& _name, eci::NativeCall::builtin _function) {
+	m_builtins.pushBack(etk::makePair(_name, _function));
+}
+
+eci::NativeCall::builtin eci::Kernel::getBuiltin(const etk::String& _name) const {
+	for (auto &it : m_builtins) {
+		if (it.first == _name) {
+			return it.second;
+		}
+	}
+	return null;
+}
+
+enum eci::kernelLevel eci::Kernel::getSupportedLevel() {
+	#ifdef ECI_KERNEL_X86
+		// SSE2 is part of x86-64
+		static const enum eci::kernelLevel level = (__builtin_cpu_supports("avx2") != 0 ? eci::kernelLevelAvx2 : eci::kernelLevelSse2);
+		return level;
+	#else
+		return eci::kernelLevelScalar;
+	#endif
+}
+
+enum eci::kernelLevel eci::Kernel::getLevel() {
+	int32_t level = g_level.load(std::memory_order_relaxed);
+	if (level < 0) {
+		return getSupportedLevel();
+	}
+	return eci::kernelLevel(level);
+}
+
+void eci::Kernel::setLevel(enum eci::kernelLevel _level) {
+	if (_level > getSupportedLevel()) {
+		ECI_WARNING("Kernel level '" << getLevelName(_level) << "' is not supported by the CPU : use '" << getLevelName(getSupportedLevel()) << "'");
+		_level = getSupportedLevel();
+	}
+	g_level.store(_level, std::memory_order_relaxed);
+}
+
+const char* eci::Kernel::getLevelName(enum eci::kernelLevel _level) {
+	switch (_level) {
+		case eci::kernelLevelScalar: return "scalar";
+		case eci::kernelLevelSse2:   return "sse2";
+		case eci::kernelLevelAvx2:   return "avx2";
+	}
+	return "?";
+}
+
@@ -0,0 +1,93 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/String.hpp>
+#include <etk/Vector.hpp>
+#include <etk/Pair.hpp>
+#include <eci/Library.hpp>
+
+namespace eci {
+	/**
+	 * @brief Instruction set of the kernels (each level can execute the previous ones).
+	 */
+	enum kernelLevel {
+		kernelLevelScalar, //!< one element at a time (all the platforms)
+		kernelLevelSse2, //!< 2 elements by instruction (x86-64)
+		kernelLevelAvx2, //!< 4 elements by instruction (x86-64 CPU with AVX2)
+	};
+	/**
+	 * @brief Builtin library "eci/kernel": native loops on the arrays of numbers, bound on their declarations as the
+	 * builtin functions of the interpreter. The kernels read and write the elements in place (no copy of the array) and process
+	 * several elements by instruction with the best instruction set of the CPU (detected at the first use).
+	 * The functions exist for the arrays of double (suffix "Double"), float ("Float"), int ("Int") and long ("Long"):
+	 * @code
+	 * #import <eci/kernel>
+	 * double sumDouble(double values[]);                       // sum of the elements
+	 * double dotDouble(double left[], double right[]);         // sum of the products of the elements
+	 * double minDouble(double values[]);                       // smallest element (0 for an empty array)
+	 * double maxDouble(double values[]);                       // biggest element (0 for an empty array)
+	 * void addDouble(double out[], double left[], double right[]); // out[i] = left[i] + right[i] (also subDouble, mulDouble)
+	 * void scaleDouble(double out[], double values[], double factor); // out[i] = values[i] * factor
+	 * int countLessDouble(double values[], double limit);      // number of elements < limit
+	 * void lessDouble(bool out[], double left[], double right[]); // out[i] = left[i] < right[i]
+	 * void sortDouble(double values[]);                        // sort the elements in increasing order
+	 * @endcode
+	 * The arrays of a call must have the same size (the output can be one of the inputs). The sum of the float
+	 * elements is computed in several partial sums: the rounding can differ of the loop of the script. The integers wrap
+	 * on overflow as in the script. A call with an argument that is not an array of the type or with arrays of different
+	 * sizes abort the execution.
+	 */
+	class Kernel : public eci::Library {
+		public:
+			static const char* const libraryName; //!< Name of the library in the "#import" directive.
+		private:
+			etk::Vector<etk::Pair<etk::String, eci::NativeCall::builtin>> m_builtins; //!< Kernels by name.
+		public:
+			Kernel();
+			virtual ~Kernel();
+			virtual bool isValid() const {
+				return true;
+			}
+			virtual eci::NativeCall::builtin getBuiltin(const etk::String& _name) const;
+			/**
+			 * @brief Get the best instruction set of the CPU.
+			 * @return The level detected on the CPU.
+			 */
+			static enum kernelLevel getSupportedLevel();
+			/**
+			 * @brief Get the instruction set used by the kernels.
+			 * @return The current level (the supported level by default).
+			 */
+			static enum kernelLevel getLevel();
+			/**
+			 * @brief Select the instruction set of the kernels (to compare the levels), set before the execution.
+			 * @param[in] _level New level (limited to the supported level).
+			 */
+			static void setLevel(enum kernelLevel _level);
+			/**
+			 * @brief Get the name of a level.
+			 * @param[in] _level Level of the kernels.
+			 * @return "scalar", "sse2" or "avx2".
+			 */
+			static const char* getLevelName(enum kernelLevel _level);
+		private:
+			/**
+			 * @brief Register the kernels of a type of element.
+			 * @param[in] _suffix Suffix of the names ("Double", "Int" ...).
+			 */
+			template<typename T> void addBuiltins(const etk::String& _suffix);
+			/**
+			 * @brief Register a kernel.
+			 * @param[in] _name Name of the function.
+			 * @param[in] _function Kernel.
+			 */
+			void addBuiltin(const etk::String& _name, eci::NativeCall::builtin _function);
+	};
+}
+
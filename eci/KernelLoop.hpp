@@ -0,0 +1,145 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+// No "#pragma once": the loops are included in the namespace of each instruction set of eci/Kernel.cpp, after the
+// class Vector<T> of this instruction set (see the scalar version for the interface).
+
+/**
+ * @brief Sum of the elements (2 partial sums to hide the latency of the addition).
+ */
+template<typename T> T sum(const eci::Value* _values, size_t _size) {
+	typedef Vector<T> V;
+	typename V::Type first = V::zero();
+	typename V::Type second = V::zero();
+	size_t iii = 0;
+	for (; iii+2*V::size <= _size; iii+=2*V::size) {
+		first = V::template compute<operationAdd>(first, V::load(_values+iii));
+		second = V::template compute<operationAdd>(second, V::load(_values+iii+V::size));
+	}
+	for (; iii+V::size <= _size; iii+=V::size) {
+		first = V::template compute<operationAdd>(first, V::load(_values+iii));
+	}
+	T out = V::sum(V::template compute<operationAdd>(first, second));
+	for (; iii<_size; ++iii) {
+		out = compute<T, operationAdd>(out, getPayload<T>(_values[iii]));
+	}
+	return out;
+}
+
+/**
+ * @brief Sum of the products of the elements.
+ */
+template<typename T> T dot(const eci::Value* _left, const eci::Value* _right, size_t _size) {
+	typedef Vector<T> V;
+	typename V::Type total = V::zero();
+	size_t iii = 0;
+	for (; iii+V::size <= _size; iii+=V::size) {
+		total = V::template compute<operationAdd>(total, V::template compute<operationMul>(V::load(_left+iii), V::load(_right+iii)));
+	}
+	T out = V::sum(total);
+	for (; iii<_size; ++iii) {
+		out = compute<T, operationAdd>(out, compute<T, operationMul>(getPayload<T>(_left[iii]), getPayload<T>(_right[iii])));
+	}
+	return out;
+}
+
+/**
+ * @brief Smallest or biggest element (the array is not empty).
+ */
+template<typename T, enum operation OPERATION> T extremum(const eci::Value* _values, size_t _size) {
+	typedef Vector<T> V;
+	typename V::Type total = V::broadcast(getPayload<T>(_values[0]));
+	size_t iii = 0;
+	for (; iii+V::size <= _size; iii+=V::size) {
+		total = V::template compute<OPERATION>(total, V::load(_values+iii));
+	}
+	T out = V::template reduce<OPERATION>(total);
+	for (; iii<_size; ++iii) {
+		out = compute<T, OPERATION>(out, getPayload<T>(_values[iii]));
+	}
+	return out;
+}
+
+/**
+ * @brief Element by element operation: _out[i] = _left[i] OPERATION _right[i].
+ */
+template<typename T, enum operation OPERATION> void apply(eci::Value* _out, const eci::Value* _left, const eci::Value* _right, size_t _size) {
+	typedef Vector<T> V;
+	size_t iii = 0;
+	for (; iii+V::size <= _size; iii+=V::size) {
+		V::store(_out+iii, V::template compute<OPERATION>(V::load(_left+iii), V::load(_right+iii)));
+	}
+	for (; iii<_size; ++iii) {
+		_out[iii] = eci::Value(compute<T, OPERATION>(getPayload<T>(_left[iii]), getPayload<T>(_right[iii])));
+	}
+}
+
+/**
+ * @brief Product of the elements by a value: _out[i] = _values[i] * _factor.
+ */
+template<typename T> void scale(eci::Value* _out, const eci::Value* _values, T _factor, size_t _size) {
+	typedef Vector<T> V;
+	typename V::Type factor = V::broadcast(_factor);
+	size_t iii = 0;
+	for (; iii+V::size <= _size; iii+=V::size) {
+		V::store(_out+iii, V::template compute<operationMul>(V::load(_values+iii), factor));
+	}
+	for (; iii<_size; ++iii) {
+		_out[iii] = eci::Value(compute<T, operationMul>(getPayload<T>(_values[iii]), _factor));
+	}
+}
+
+/**
+ * @brief Number of elements smaller than a value.
+ */
+template<typename T> int32_t countLess(const eci::Value* _values, T _limit, size_t _size) {
+	typedef Vector<T> V;
+	typename V::Type limit = V::broadcast(_limit);
+	int32_t out = 0;
+	size_t iii = 0;
+	for (; iii+V::size <= _size; iii+=V::size) {
+		out += V::count(V::template compute<operationLess>(V::load(_values+iii), limit));
+	}
+	for (; iii<_size; ++iii) {
+		if (getPayload<T>(_values[iii]) < _limit) {
+			++out;
+		}
+	}
+	return out;
+}
+
+/**
+ * @brief Element by element comparison: _out[i] = _left[i] < _right[i] (array of bool).
+ */
+template<typename T> void less(eci::Value* _out, const eci::Value* _left, const eci::Value* _right, size_t _size) {
+	typedef Vector<T> V;
+	size_t iii = 0;
+	for (; iii+V::size <= _size; iii+=V::size) {
+		V::storeBool(_out+iii, V::template compute<operationLess>(V::load(_left+iii), V::load(_right+iii)));
+	}
+	for (; iii<_size; ++iii) {
+		_out[iii] = eci::Value(getPayload<T>(_left[iii]) < getPayload<T>(_right[iii]));
+	}
+}
+
+/**
+ * @brief Get the kernels of a type for this instruction set.
+ */
+template<typename T> Table<T> createTable() {
+	Table<T> out;
+	out.m_sum = &sum<T>;
+	out.m_dot = &dot<T>;
+	out.m_min = &extremum<T, operationMin>;
+	out.m_max = &extremum<T, operationMax>;
+	out.m_add = &apply<T, operationAdd>;
+	out.m_sub = &apply<T, operationSub>;
+	out.m_mul = &apply<T, operationMul>;
+	out.m_scale = &scale<T>;
+	out.m_countLess = &countLess<T>;
+	out.m_less = &less<T>;
+	return out;
+}
+
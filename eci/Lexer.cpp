@@ -5,10 +5,14 @@
  */
 
 #include <memory>
+#include <thread>
+#include <atomic>
 #include <eci/Lexer.hpp>
 #include <eci/debug.hpp>
 
-eci::Lexer::Lexer() {
+eci::Lexer::Lexer() :
+  m_nbThread(etk::max(int32_t(std::thread::hardware_concurrency()), 1)),
+  m_chunkSize(1024*1024) {
 	
 }
 
@@ -53,10 +57,200 @@ void eci::Lexer::appendSubSection(int32_t _tokenIdParrent, int32_t _tokenId, int
 }
 
 
+void eci::Lexer::parseBase(const ememory::SharedPtr<eci::Lexer::Type>& _type,
+                           const etk::String& _data,
+                           int32_t _start,
+                           int32_t _stop,
+                           etk::Vector<ememory::SharedPtr<eci::LexerNode>>& _list) {
+	if (_list.size() == 0) {
+		_list = _type->parse(_data, _start, _stop);
+		return;
+	}
+	int32_t start = _start;
+	auto itList(_list.begin());
+	while (itList != _list.end()) {
+		if (*itList == null) {
+			ECI_TODO("remove null shared_ptr");
+			++itList;
+			continue;
+		}
+		if ((*itList)->getStartPos() == start) {
+			// nothing to do ..
+			start = (*itList)->getStopPos();
+			++itList;
+			continue;
+		}
+		etk::Vector<ememory::SharedPtr<eci::LexerNode>> res = _type->parse(_data, start, (*itList)->getStartPos());
+		// append it in the buffer:
+		for (auto &it: res) {
+			_list.insert(itList, it);
+			++itList;
+		}
+		start = (*itList)->getStopPos();
+		++itList;
+	}
+	// Do the last element :
+	if (start < _stop) {
+		etk::Vector<ememory::SharedPtr<eci::LexerNode>> res = _type->parse(_data, start, _stop);
+		for (auto &itRes : res) {
+			_list.pushBack(itRes);
+		}
+	}
+}
+
+etk::Vector<int32_t> eci::Lexer::findSplitPosition(const etk::String& _data, int32_t _chunkSize) {
+	// The simple tokens are searched in the order of the list: the multiline comments first (they can start
+	// in a string or in a line comment), then the line comments, then the preprocessor lines (they can start
+	// in a string). The other tokens contain a '\n' only after a '\' (string continued on the next line): the
+	// start of a line out of these 3 areas and not after a '\' is a safe split for all the tokens.
+	etk::Vector<int32_t> out;
+	out.pushBack(0);
+	const char* data = _data.c_str();
+	int32_t size = _data.size();
+	int32_t next = _chunkSize;
+	int32_t pos = 0;
+	while (pos < size) {
+		char value = data[pos];
+		if (    value == '/'
+		     && pos+1 < size
+		     && data[pos+1] == '*') {
+			pos += 2;
+			while (    pos < size
+			        && data[pos] != '\0'
+			        && (    data[pos] != '*'
+			             || pos+1 >= size
+			             || data[pos+1] != '/')) {
+				++pos;
+			}
+			pos += (pos < size && data[pos] == '\0') ? 1 : 2;
+			continue;
+		}
+		if (    value == '/'
+		     && pos+1 < size
+		     && data[pos+1] == '/') {
+			// stop on the end of line (not included) or on a multiline comment (even on "//*")
+			++pos;
+			while (    pos < size
+			        && data[pos] != '\n'
+			        && (    data[pos] != '/'
+			             || pos+1 >= size
+			             || data[pos+1] != '*')) {
+				++pos;
+			}
+			continue;
+		}
+		if (value == '#') {
+			// continue on the next line after a '\', stop on a comment
+			++pos;
+			while (pos < size) {
+				if (    data[pos] == '\n'
+				     && data[pos-1] != '\\') {
+					break;
+				}
+				if (    data[pos] == '/'
+				     && pos+1 < size
+				     && (    data[pos+1] == '*'
+				          || data[pos+1] == '/')) {
+					break;
+				}
+				++pos;
+			}
+			continue;
+		}
+		if (    value == '\n'
+		     && pos+1 >= next
+		     && pos+1 < size
+		     && (    pos == 0
+		          || data[pos-1] != '\\')) {
+			out.pushBack(pos+1);
+			next = pos+1+_chunkSize;
+		}
+		++pos;
+	}
+	out.pushBack(size);
+	return out;
+}
+
+size_t eci::Lexer::interpreteParallel(const etk::String& _data, etk::Vector<ememory::SharedPtr<eci::LexerNode>>& _list) {
+	// all the simple tokens before the first section (the sub tokens are searched in the sections, after)
+	etk::Vector<size_t> bases;
+	size_t nbBase = 0;
+	while (nbBase < m_searchList.size()) {
+		if (m_searchList[nbBase] != null) {
+			if (m_searchList[nbBase]->getType() == TYPE_BASE) {
+				bases.pushBack(nbBase);
+			} else if (m_searchList[nbBase]->isSubParse() == false) {
+				break;
+			}
+		}
+		++nbBase;
+	}
+	if (bases.size() == 0) {
+		return 0;
+	}
+	// more chunks than threads: the chunks do not have the same cost.
+	int32_t chunkSize = etk::max(m_chunkSize, int32_t(_data.size()/(4*m_nbThread)));
+	etk::Vector<int32_t> split = findSplitPosition(_data, chunkSize);
+	size_t nbChunk = split.size()-1;
+	if (nbChunk < 2) {
+		return 0;
+	}
+	int32_t nbThread = etk::min(m_nbThread, int32_t(nbChunk));
+	ECI_DEBUG("Parallel lexing: " << nbChunk << " chunks on " << nbThread << " threads");
+	etk::Vector<etk::Vector<ememory::SharedPtr<eci::LexerNode>>> result;
+	result.resize(nbChunk);
+	// a regex keep the state of the last search: each thread use its own copy.
+	etk::Vector<etk::Vector<ememory::SharedPtr<eci::Lexer::Type>>> searchList;
+	searchList.resize(nbThread);
+	for (auto &itThread : searchList) {
+		for (auto &it : bases) {
+			itThread.pushBack(ememory::makeShared<eci::Lexer::TypeBase>(m_searchList[it]->getTockenId(), m_searchList[it]->getValue()));
+		}
+	}
+	std::atomic<size_t> nextChunk(0);
+	etk::Vector<std::thread*> threads;
+	for (int32_t iii=0; iii<nbThread; ++iii) {
+		threads.pushBack(new std::thread([&, iii]() {
+			while (true) {
+				size_t chunk = nextChunk++;
+				if (chunk >= nbChunk) {
+					return;
+				}
+				for (auto &it : searchList[iii]) {
+					parseBase(it, _data, split[chunk], split[chunk+1], result[chunk]);
+				}
+			}
+		}));
+	}
+	for (auto &it : threads) {
+		it->join();
+		delete it;
+	}
+	// no token is across a split position: the lists are just appended.
+	size_t size = 0;
+	for (auto &it : result) {
+		size += it.size();
+	}
+	_list.clear();
+	_list.reserve(size);
+	for (auto &it : result) {
+		for (auto &itNode : it) {
+			_list.pushBack(itNode);
+		}
+	}
+	return nbBase;
+}
+
 eci::LexerResult eci::Lexer::interprete(const etk::String& _data) {
 	eci::LexerResult result(_data);
 	ECI_INFO("Parse : \n" << _data);
-	for (auto &it : m_searchList) {
+	size_t first = 0;
+	if (    m_nbThread > 1
+	     && _data.size() >= size_t(2*m_chunkSize)) {
+		first = interpreteParallel(_data, result.m_list);
+	}
+	for (size_t iii=first; iii<m_searchList.size(); ++iii) {
+		const ememory::SharedPtr<eci::Lexer::Type>& it = m_searchList[iii];
 		//ECI_INFO("Parse RegEx : " << it.first << " : " << it.second.getRegExDecorated());
 		if (it == null) {
 			continue;
@@ -65,51 +259,12 @@ eci::LexerResult eci::Lexer::interprete(const etk::String& _data) {
 			continue;
 		}
 		if (it->isSection() == false) {
-			if (result.m_list.size() == 0) {
-				result.m_list = it->parse(_data, 0, _data.size());
-			} else {
-				int32_t start = 0;
-				auto itList(result.m_list.begin());
-				while (itList != result.m_list.end()) {
-					if (*itList == null) {
-						ECI_TODO("remove null shared_ptr");
-						++itList;
-						continue;
-					}
-					if ((*itList)->getStartPos() == start) {
-						// nothing to do ..
-						start = (*itList)->getStopPos();
-						++itList;
-						continue;
-					}
-					etk::Vector<ememory::SharedPtr<eci::LexerNode>> res = it->parse(_data, start, (*itList)->getStartPos());
-					// append it in the buffer:
-					if (res.size() > 0) {
-						int32_t currentPos = etk::distance(result.m_list.begin(), itList) + res.size();
-						for (auto &it: res) {
-							result.m_list.insert(itList, it);
-							++itList;
-						}
-						/*
-						result.m_list.insert(itList, res.begin(), res.end());
-						itList = result.m_list.begin() + currentPos;
-						*/
-					}
-					start = (*itList)->getStopPos();
-					++itList;
-				}
-				// Do the last element :
-				if (start < _data.size()) {
-					etk::Vector<ememory::SharedPtr<eci::LexerNode>> res = it->parse(_data, start, _data.size());
-					for (auto &itRes : res) {
-						result.m_list.pushBack(itRes);
-					}
-				}
-			}
+			parseBase(it, _data, 0, _data.size(), result.m_list);
 		} else {
 			if (result.m_list.size() == 0) {
 				continue;
 			}
+			// the nesting of the sections is done on the full list (after the merge of the parallel lexing).
 			it->parseSection(result.m_list);
 		}
 	}
@@ -144,7 +299,12 @@ etk::Vector<ememory::SharedPtr<eci::LexerNode>> eci::Lexer::TypeBase::parse(cons
 	ECI_VERBOSE("parse : " << getValue());
 	while (true) {
 		if (m_regex.parse(_data, _start, _stop) == true) {
+			if (m_regex.stop() <= m_regex.start()) {
+				// empty match ==> nothing more to find
+				break;
+			}
 			result.pushBack(ememory::makeShared<eci::LexerNode>(m_tockenId, m_regex.start(), m_regex.stop()));
+			_start = m_regex.stop();
 		} else {
 			break;
 		}
@@ -166,9 +166,31 @@ namespace eci {
 					}
 			};
 			etk::Vector<ememory::SharedPtr<eci::Lexer::Type>> m_searchList;
+			int32_t m_nbThread; //!< Number of thread used on a big data (1 disable the parallel lexing).
+			int32_t m_chunkSize; //!< Minimal size of the data lexed by one thread.
 		public:
 			Lexer();
 			~Lexer();
+			/**
+			 * @brief Set the number of thread used to lex a big data (default: number of core).
+			 * @param[in] _value Number of thread (1 disable the parallel lexing).
+			 */
+			void setNbThread(int32_t _value) {
+				m_nbThread = etk::max(_value, 1);
+			}
+			int32_t getNbThread() const {
+				return m_nbThread;
+			}
+			/**
+			 * @brief Set the minimal size of a chunk: a data smaller than 2 chunks is lexed in the current thread.
+			 * @param[in] _value Size in byte.
+			 */
+			void setChunkSize(int32_t _value) {
+				m_chunkSize = etk::max(_value, 1);
+			}
+			int32_t getChunkSize() const {
+				return m_chunkSize;
+			}
 			/**
 			 * @brief Append a Token recognition.
 			 * @param[in] _tokenId Tocken id value.
@@ -201,5 +223,35 @@ namespace eci {
 			void appendSubSection(int32_t _tokenIdParrent, int32_t _tokenId, int32_t _tockenStart, int32_t _tockenStop, const etk::String& _type);
 			
 			LexerResult interprete(const etk::String& _data);
+			/**
+			 * @brief Find the positions where the data can be split: start of a line that is not in a multiline
+			 * comment or in a preprocessor line (no token can be across a split position).
+			 * @param[in] _data Data to split.
+			 * @param[in] _chunkSize Minimal distance between 2 split positions.
+			 * @return Sorted positions, the first is 0 and the last is the data size.
+			 */
+			static etk::Vector<int32_t> findSplitPosition(const etk::String& _data, int32_t _chunkSize);
+		private:
+			/**
+			 * @brief Apply a simple token recognition on the free areas of a range.
+			 * @param[in] _type Token recognition.
+			 * @param[in] _data Data to lex.
+			 * @param[in] _start Start of the range.
+			 * @param[in] _stop End of the range.
+			 * @param[in,out] _list Tokens already found in the range (sorted), the new tokens are inserted.
+			 */
+			static void parseBase(const ememory::SharedPtr<eci::Lexer::Type>& _type,
+			                      const etk::String& _data,
+			                      int32_t _start,
+			                      int32_t _stop,
+			                      etk::Vector<ememory::SharedPtr<eci::LexerNode>>& _list);
+			/**
+			 * @brief Apply all the simple token recognitions before the first section on chunks of the data in parallel
+			 * (the sub recognitions are applied in the sections).
+			 * @param[in] _data Data to lex.
+			 * @param[out] _list Tokens found (sorted).
+			 * @return Index of the first token recognition not applied (the next ones are applied on the full list).
+			 */
+			size_t interpreteParallel(const etk::String& _data, etk::Vector<ememory::SharedPtr<eci::LexerNode>>& _list);
 	};
 }
@@ -5,5 +5,326 @@
  */
 
 #include <eci/Library.hpp>
+#include <eci/Function.hpp>
+#include <eci/Stack.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/Jit.hpp>
 #include <eci/debug.hpp>
+#include <string.h>
+#ifndef _WIN32
+	#include <dlfcn.h>
+#endif
 
+// The integer and the float arguments are in 2 separate register sets: a C function is called with all the
+// registers set, the function read only the ones of its arguments.
+#if    defined(__x86_64__) \
+    && !defined(_WIN32)
+	#define ECI_NATIVE_CALL
+#endif
+
+#ifdef ECI_NATIVE_CALL
+
+typedef int64_t (*symbolInteger)(int64_t, int64_t, int64_t, int64_t, int64_t, int64_t,
+                                 double, double, double, double, double, double, double, double);
+typedef double (*symbolDouble)(int64_t, int64_t, int64_t, int64_t, int64_t, int64_t,
+                               double, double, double, double, double, double, double, double);
+typedef float (*symbolFloat)(int64_t, int64_t, int64_t, int64_t, int64_t, int64_t,
+                             double, double, double, double, double, double, double, double);
+
+/**
+ * @brief Call a C function that return void, a bool or an integer.
+ */
+static int64_t callInteger(void* _symbol, const int64_t* _integers, const double* _floats) {
+	return reinterpret_cast<symbolInteger>(_symbol)(_integers[0], _integers[1], _integers[2], _integers[3], _integers[4], _integers[5],
+	                                                _floats[0], _floats[1], _floats[2], _floats[3], _floats[4], _floats[5], _floats[6], _floats[7]);
+}
+
+/**
+ * @brief Call a C function that return a double (the raw value is the double bits).
+ */
+static int64_t callDouble(void* _symbol, const int64_t* _integers, const double* _floats) {
+	double ret = reinterpret_cast<symbolDouble>(_symbol)(_integers[0], _integers[1], _integers[2], _integers[3], _integers[4], _integers[5],
+	                                                     _floats[0], _floats[1], _floats[2], _floats[3], _floats[4], _floats[5], _floats[6], _floats[7]);
+	int64_t out;
+	memcpy(&out, &ret, sizeof(out));
+	return out;
+}
+
+/**
+ * @brief Call a C function that return a float (the raw value is the double bits).
+ */
+static int64_t callFloat(void* _symbol, const int64_t* _integers, const double* _floats) {
+	double ret = reinterpret_cast<symbolFloat>(_symbol)(_integers[0], _integers[1], _integers[2], _integers[3], _integers[4], _integers[5],
+	                                                    _floats[0], _floats[1], _floats[2], _floats[3], _floats[4], _floats[5], _floats[6], _floats[7]);
+	int64_t out;
+	memcpy(&out, &ret, sizeof(out));
+	return out;
+}
+
+#endif
+
+/**
+ * @brief Set a float argument: a float is in the low bits of the register.
+ */
+static void setFloat(double& _register, float _value) {
+	_register = 0.0;
+	memcpy(&_register, &_value, sizeof(_value));
+}
+
+/**
+ * @brief Copy the elements of an array in a buffer of their native type, or the buffer in the elements after the call.
+ * @param[in,out] _array Array (its elements are of the type T).
+ * @param[in,out] _buffer Native buffer (allocated by the copy in it).
+ * @param[in] _toNative true: copy the elements in the buffer, false: copy the buffer in the elements.
+ */
+template<typename T> static void copyElements(eci::Object& _array, etk::Vector<uint8_t>& _buffer, bool _toNative) {
+	if (_toNative == true) {
+		_buffer.resize(etk::max(_array.m_nbField, size_t(1)) * sizeof(T));
+		T* data = reinterpret_cast<T*>(&_buffer[0]);
+		for (size_t iii=0; iii<_array.m_nbField; ++iii) {
+			data[iii] = _array.m_fields[iii].get<T>();
+		}
+		return;
+	}
+	const T* data = reinterpret_cast<const T*>(&_buffer[0]);
+	for (size_t iii=0; iii<_array.m_nbField; ++iii) {
+		_array.m_fields[iii] = eci::Value(data[iii]);
+	}
+}
+
+static void copyArray(eci::Object& _array, enum eci::valueType _type, etk::Vector<uint8_t>& _buffer, bool _toNative) {
+	switch (_type) {
+		case eci::valueTypeBool:   copyElements<bool>(_array, _buffer, _toNative); break;
+		case eci::valueTypeInt8:   copyElements<int8_t>(_array, _buffer, _toNative); break;
+		case eci::valueTypeUInt8:  copyElements<uint8_t>(_array, _buffer, _toNative); break;
+		case eci::valueTypeInt16:  copyElements<int16_t>(_array, _buffer, _toNative); break;
+		case eci::valueTypeUInt16: copyElements<uint16_t>(_array, _buffer, _toNative); break;
+		case eci::valueTypeInt32:  copyElements<int32_t>(_array, _buffer, _toNative); break;
+		case eci::valueTypeUInt32: copyElements<uint32_t>(_array, _buffer, _toNative); break;
+		case eci::valueTypeInt64:  copyElements<int64_t>(_array, _buffer, _toNative); break;
+		case eci::valueTypeUInt64: copyElements<uint64_t>(_array, _buffer, _toNative); break;
+		case eci::valueTypeFloat:  copyElements<float>(_array, _buffer, _toNative); break;
+		case eci::valueTypeDouble: copyElements<double>(_array, _buffer, _toNative); break;
+		default: break;
+	}
+}
+
+eci::NativeCall::NativeCall() :
+  m_symbol(null),
+  m_return(eci::valueTypeVoid),
+  m_thunk(null),
+  m_builtin(null),
+  m_library(null) {
+	
+}
+
+bool eci::NativeCall::isSupported() {
+	#ifdef ECI_NATIVE_CALL
+		return true;
+	#else
+		return false;
+	#endif
+}
+
+bool eci::NativeCall::bind(void* _symbol, const eci::Function& _function, bool _arrayObject) {
+	#ifdef ECI_NATIVE_CALL
+		m_arguments.clear();
+		int32_t nbInteger = 0;
+		int32_t nbFloat = 0;
+		for (auto &it : _function.getArguments()) {
+			enum eci::valueType type = it.getValueType();
+			enum eci::valueType element = eci::valueTypeVoid;
+			if (    type == eci::valueTypeObject
+			     && it.getTypeName().endWith("[]") == true
+			     && _arrayObject == false) {
+				// an array of a native type is given as a pointer on a copy of its elements
+				element = eci::getValueType(etk::String(it.getTypeName(), 0, it.getTypeName().size()-2));
+				if (element == eci::valueTypeObject) {
+					element = eci::valueTypeVoid;
+				}
+			}
+			if (    type == eci::valueTypeVoid
+			     || (    type == eci::valueTypeObject
+			          && element == eci::valueTypeVoid
+			          && (    _arrayObject == false
+			               || it.getTypeName().endWith("[]") == false))) {
+				ECI_ERROR("Native function '" << _function.getName() << "' : argument '" << it.getName() << "' has an unsupported type '" << it.getTypeName() << "'");
+				return false;
+			}
+			if (element != eci::valueTypeVoid) {
+				m_arguments.pushBack(Argument(type, false, nbInteger++, element));
+			} else if (    type == eci::valueTypeFloat
+			     || type == eci::valueTypeDouble) {
+				m_arguments.pushBack(Argument(type, true, nbFloat++));
+			} else {
+				m_arguments.pushBack(Argument(type, false, nbInteger++));
+			}
+		}
+		if (    nbInteger > maxInteger
+		     || nbFloat > maxFloat) {
+			ECI_ERROR("Native function '" << _function.getName() << "' : too many arguments (max " << maxInteger << " integers and " << maxFloat << " floats)");
+			return false;
+		}
+		m_return = eci::valueTypeVoid;
+		if (_function.getReturn().size() != 0) {
+			m_return = _function.getReturn()[0].getValueType();
+		}
+		if (m_return == eci::valueTypeObject) {
+			ECI_ERROR("Native function '" << _function.getName() << "' : unsupported return type");
+			return false;
+		}
+		if (m_return == eci::valueTypeDouble) {
+			m_thunk = &callDouble;
+		} else if (m_return == eci::valueTypeFloat) {
+			m_thunk = &callFloat;
+		} else {
+			m_thunk = &callInteger;
+		}
+		m_symbol = _symbol;
+		return true;
+	#else
+		ECI_ERROR("Native function '" << _function.getName() << "' : native call is not supported on this platform");
+		return false;
+	#endif
+}
+
+bool eci::NativeCall::bindBuiltin(builtin _builtin, const eci::Library& _library, const eci::Function& _function) {
+	m_arguments.clear();
+	for (auto &it : _function.getArguments()) {
+		m_arguments.pushBack(Argument(it.getValueType()));
+	}
+	m_return = eci::valueTypeVoid;
+	if (_function.getReturn().size() != 0) {
+		m_return = _function.getReturn()[0].getValueType();
+	}
+	m_builtin = _builtin;
+	m_library = &_library;
+	return true;
+}
+
+eci::Value eci::NativeCall::convertReturn(int64_t _raw) const {
+	switch (m_return) {
+		case eci::valueTypeVoid:
+			return eci::Value();
+		case eci::valueTypeFloat:
+		case eci::valueTypeDouble: {
+			double value;
+			memcpy(&value, &_raw, sizeof(value));
+			return eci::Value(value).convert(m_return);
+		}
+		case eci::valueTypeBool:
+			// only the low byte is set by the function
+			return eci::Value((_raw & 0xFF) != 0);
+		default:
+			// the high bits of a small integer are not set by the function: the convertion truncate them.
+			return eci::Value(_raw).convert(m_return);
+	}
+}
+
+eci::Value eci::NativeCall::call(eci::Interpreter& _interpreter, size_t _base) const {
+	eci::Stack& stack = _interpreter.getStack();
+	if (m_builtin != null) {
+		// the arguments stay in the stack during the call: the objects are in the roots of the collector
+		return m_builtin(_interpreter, *m_library, m_arguments.size() == 0 ? null : &stack.get(_base)).convert(m_return);
+	}
+	int64_t integers[maxInteger] = {0};
+	double floats[maxFloat] = {0.0};
+	// the elements of the arrays are copied in native buffers (only when the function has array arguments)
+	etk::Vector<etk::Vector<uint8_t>> buffers;
+	// the arguments are already in the declared types: read directly in the stack
+	for (size_t iii=0; iii<m_arguments.size(); ++iii) {
+		const Argument& argument = m_arguments[iii];
+		const eci::Value& value = stack.get(_base+iii);
+		if (argument.m_type == eci::valueTypeObject) {
+			eci::Object* array = (value.m_type == eci::valueTypeObject ? value.m_object : null);
+			if (    array == null
+			     || argument.m_element == eci::valueTypeVoid) {
+				// function of the interpreter: the object itself
+				integers[argument.m_register] = reinterpret_cast<int64_t>(array);
+				continue;
+			}
+			if (    array->m_fields == null
+			     || array->m_class->isArray() == false
+			     || array->m_class->getStride() != 1
+			     || array->m_class->getLayout()[0].m_valueType != argument.m_element
+			     || array->m_class->getLayout()[0].m_class != null) {
+				ECI_ERROR("Native function : argument " << iii << " is not an array of " << eci::getValueTypeName(argument.m_element));
+				return eci::Value().convert(m_return);
+			}
+			buffers.resize(m_arguments.size());
+			copyArray(*array, argument.m_element, buffers[iii], true);
+			integers[argument.m_register] = reinterpret_cast<int64_t>(&buffers[iii][0]);
+		} else if (argument.m_float == false) {
+			integers[argument.m_register] = value.get<int64_t>();
+		} else if (argument.m_type == eci::valueTypeFloat) {
+			setFloat(floats[argument.m_register], value.get<float>());
+		} else {
+			floats[argument.m_register] = value.get<double>();
+		}
+	}
+	eci::Value ret = convertReturn(m_thunk(m_symbol, integers, floats));
+	// the function can modify the elements: they are copied back in the arrays
+	for (size_t iii=0; iii<buffers.size(); ++iii) {
+		if (buffers[iii].size() != 0) {
+			copyArray(*stack.get(_base+iii).m_object, m_arguments[iii].m_element, buffers[iii], false);
+		}
+	}
+	return ret;
+}
+
+int64_t eci::NativeCall::callJit(const int64_t* _arguments, eci::Interpreter* _interpreter, const eci::Function* _function) {
+	const eci::NativeCall& native = *_function->getNative();
+	int64_t integers[maxInteger] = {0};
+	double floats[maxFloat] = {0.0};
+	// the native code only call with bool, int32, int64 and double arguments (already extended on 64 bits)
+	for (size_t iii=0; iii<native.m_arguments.size(); ++iii) {
+		const Argument& argument = native.m_arguments[iii];
+		if (argument.m_float == false) {
+			integers[argument.m_register] = _arguments[iii];
+		} else {
+			memcpy(&floats[argument.m_register], &_arguments[iii], sizeof(double));
+		}
+	}
+	return eci::Jit::toRaw(native.convertReturn(native.m_thunk(native.m_symbol, integers, floats)));
+}
+
+eci::Library::Library(const etk::String& _name) :
+  m_name(_name),
+  m_handle(null),
+  m_builtin(false) {
+	#ifndef _WIN32
+		m_handle = dlopen(m_name.c_str(), RTLD_NOW | RTLD_LOCAL);
+		if (m_handle == null) {
+			ECI_ERROR("Can not load library '" << m_name << "' : " << dlerror());
+		}
+	#else
+		ECI_ERROR("Can not load library '" << m_name << "' : not supported on this platform");
+	#endif
+}
+
+eci::Library::Library(const etk::String& _name, bool _builtin) :
+  m_name(_name),
+  m_handle(null),
+  m_builtin(_builtin) {
+	
+}
+
+eci::Library::~Library() {
+	#ifndef _WIN32
+		if (m_handle != null) {
+			dlclose(m_handle);
+		}
+	#endif
+	m_handle = null;
+}
+
+void* eci::Library::getSymbol(const etk::String& _name) const {
+	if (m_handle == null) {
+		return null;
+	}
+	#ifndef _WIN32
+		return dlsym(m_handle, _name.c_str());
+	#else
+		return null;
+	#endif
+}
@@ -8,14 +8,174 @@
 
 #include <etk/types.hpp>
 #include <etk/String.hpp>
+#include <etk/Vector.hpp>
+#include <ememory/memory.hpp>
+#include <eci/Value.hpp>
 
 namespace eci {
+	class Interpreter;
+	class Function;
+	class Class;
+	class Library;
+	/**
+	 * @brief Call of a C function of a native library, bound once on a function declaration: the register of each
+	 * argument is computed at the bind, the call read the arguments directly in the value stack (no conversion object).
+	 * A builtin function of the interpreter (see @ref eci::Library::getBuiltin) is called with the values themselves.
+	 */
+	class NativeCall {
+		public:
+			static const int32_t maxInteger = 6; //!< Max number of integer arguments (passed in registers).
+			static const int32_t maxFloat = 8; //!< Max number of float/double arguments (passed in registers).
+			/**
+			 * @brief Generic call of the symbol: all the registers of the arguments are set (the unused ones are ignored by the function).
+			 */
+			typedef int64_t (*thunk)(void* _symbol, const int64_t* _integers, const double* _floats);
+			/**
+			 * @brief Builtin function: it get the values of the arguments (converted in the declared types, not converted for
+			 * an "auto" argument) and can create objects in the interpreter.
+			 */
+			typedef eci::Value (*builtin)(eci::Interpreter& _interpreter, const eci::Library& _library, const eci::Value* _arguments);
+			/**
+			 * @brief Position of an argument in the registers.
+			 */
+			class Argument {
+				public:
+					enum eci::valueType m_type; //!< Type of the argument.
+					bool m_float; //!< The argument is in a float register.
+					int32_t m_register; //!< Index in the integer or float registers.
+					enum eci::valueType m_element; //!< Type of the elements of an array argument (void for an other argument).
+					Argument(enum eci::valueType _type=eci::valueTypeVoid,
+					         bool _float=false,
+					         int32_t _register=0,
+					         enum eci::valueType _element=eci::valueTypeVoid) :
+					  m_type(_type),
+					  m_float(_float),
+					  m_register(_register),
+					  m_element(_element) {
+						
+					}
+			};
+		private:
+			void* m_symbol; //!< Address of the C function.
+			etk::Vector<Argument> m_arguments; //!< Registers of the arguments.
+			enum eci::valueType m_return; //!< Type returned by the C function.
+			thunk m_thunk; //!< Call selected with the return type.
+			builtin m_builtin; //!< Builtin function (null for a C function).
+			const eci::Library* m_library; //!< Library of the builtin function (owned by the interpreter).
+		public:
+			NativeCall();
+			/**
+			 * @brief Check if the native calls are available on this platform.
+			 * @return true on x86-64 (not Windows).
+			 */
+			static bool isSupported();
+			/**
+			 * @brief Bind a C function on a declaration.
+			 * @param[in] _symbol Address of the C function.
+			 * @param[in] _function Declaration of the function (bool, integer, float and double arguments and return only,
+			 *                      an array argument "xxx name[]" of a native type is given as a pointer on a copy of its
+			 *                      elements, copied back in the array after the call).
+			 * @param[in] _arrayObject The function is in the interpreter: an array argument is given as its eci::Object*.
+			 * @return true if the function can be called.
+			 */
+			bool bind(void* _symbol, const eci::Function& _function, bool _arrayObject);
+			/**
+			 * @brief Bind a builtin function on a declaration (all the types are accepted, "auto" for any value).
+			 * @param[in] _builtin Builtin function.
+			 * @param[in] _library Library of the function.
+			 * @param[in] _function Declaration of the function.
+			 * @return true if the function can be called.
+			 */
+			bool bindBuiltin(builtin _builtin, const eci::Library& _library, const eci::Function& _function);
+			/**
+			 * @brief Check if the function is a builtin of the interpreter (never called by the native code of the JIT).
+			 * @return true for a builtin function.
+			 */
+			bool isBuiltin() const {
+				return m_builtin != null;
+			}
+			void* getSymbol() const {
+				return m_symbol;
+			}
+			const etk::Vector<Argument>& getArguments() const {
+				return m_arguments;
+			}
+			enum eci::valueType getReturn() const {
+				return m_return;
+			}
+			/**
+			 * @brief Call the C function.
+			 * @param[in] _interpreter Interpreter that execute the call (value stack).
+			 * @param[in] _base Index of the first argument in the stack (arguments already in the declared types).
+			 * @return The value returned by the C function.
+			 */
+			eci::Value call(eci::Interpreter& _interpreter, size_t _base) const;
+			/**
+			 * @brief Native entry of a bound function (see @ref eci::jitEntry): called by the native code of the JIT.
+			 */
+			static int64_t callJit(const int64_t* _arguments, eci::Interpreter* _interpreter, const eci::Function* _function);
+		private:
+			eci::Value convertReturn(int64_t _raw) const;
+	};
+	/**
+	 * @brief Native shared library loaded by a "#import" directive (or builtin library of the interpreter, see @ref eci::Kernel
+	 * and @ref eci::Container).
+	 */
 	class Library {
 		public:
-			Library() {};
-			~Library() {};
+			/**
+			 * @brief Load a library.
+			 * @param[in] _name Name of the library ("libm.so.6", "./libkernel.so" ...), searched as dlopen do.
+			 */
+			Library(const etk::String& _name);
+			virtual ~Library();
+		protected:
+			/**
+			 * @brief Create a builtin library (nothing is loaded: the symbols are given by the child class).
+			 * @param[in] _name Name of the library.
+			 * @param[in] _builtin The symbols are functions of the interpreter (see @ref isBuiltin).
+			 */
+			Library(const etk::String& _name, bool _builtin);
 		protected:
 			etk::String m_name; //!< library name (just for debug)
+			void* m_handle; //!< Handle of the loaded library (null on error).
+			bool m_builtin; //!< Builtin library of the interpreter.
+			etk::Vector<ememory::SharedPtr<eci::Class>> m_classes; //!< Classes of a builtin library.
+		public:
+			const etk::String& getName() const {
+				return m_name;
+			}
+			virtual bool isValid() const {
+				return m_handle != null;
+			}
+			/**
+			 * @brief Check if the library is a builtin of the interpreter: its symbols get the arrays as eci::Object*.
+			 * @return true for a builtin library.
+			 */
+			bool isBuiltin() const {
+				return m_builtin;
+			}
+			/**
+			 * @brief Get the address of a symbol.
+			 * @param[in] _name Name of the symbol (C name).
+			 * @return The address or null if not found.
+			 */
+			virtual void* getSymbol(const etk::String& _name) const;
+			/**
+			 * @brief Get a builtin function (searched before the symbols).
+			 * @param[in] _name Name of the function.
+			 * @return The function or null if not found.
+			 */
+			virtual eci::NativeCall::builtin getBuiltin(const etk::String& _name) const {
+				return null;
+			}
+			/**
+			 * @brief Get the classes of the library (defined and added in the program by the import, before its files are linked).
+			 * @return The classes (a class can use the previous ones).
+			 */
+			const etk::Vector<ememory::SharedPtr<eci::Class>>& getClasses() const {
+				return m_classes;
+			}
 	};
 }
 
@@ -0,0 +1,45 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/Vector.hpp>
+#include <eci/Value.hpp>
+
+namespace eci {
+	class Class;
+	/**
+	 * @brief Instance of a class: the fields are stored with the layout of the class (see @ref eci::Class::getLayout).
+	 * The object and its fields are in one block of the heap of the interpreter (the fields are just after the object).
+	 */
+	class Object {
+		public:
+			const eci::Class* m_class; //!< Class of the instance.
+			eci::Value* m_fields; //!< Value of the fields (index is the offset of the field in the layout), null when the object is deleted.
+			size_t m_nbField; //!< Number of fields.
+			uint32_t m_mark; //!< Epoch of the last cycle of the collector that marked the object.
+			bool m_managed; //!< The block is released by the collector (see @ref eci::Collector).
+		public:
+			Object(const eci::Class* _class=null) :
+			  m_class(_class),
+			  m_fields(null),
+			  m_nbField(0),
+			  m_mark(0),
+			  m_managed(false) {
+				
+			}
+			~Object() {}
+			/**
+			 * @brief Get the size of the block of an object.
+			 * @param[in] _nbField Number of fields of the object.
+			 * @return Size in byte.
+			 */
+			static size_t getSize(size_t _nbField) {
+				return sizeof(eci::Object) + _nbField * sizeof(eci::Value);
+			}
+	};
+}
@@ -0,0 +1,811 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Optimizer.hpp>
+#include <eci/Resolver.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/Class.hpp>
+#include <eci/debug.hpp>
+
+eci::Optimizer::Optimizer() :
+  m_level(1),
+  m_profile(false),
+  m_nbElementBefore(0),
+  m_nbElementAfter(0),
+  m_nbFused(0),
+  m_nbCountedLoop(0),
+  m_nbTailCall(0),
+  m_nbScalar(0),
+  m_functionId(-1) {
+	
+}
+
+eci::Optimizer::~Optimizer() {
+	
+}
+
+/**
+ * @brief Check if an element is a constant.
+ * @param[in] _element Element to check.
+ * @return true if the element is a Constant.
+ */
+static bool isConstant(const ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	return    _element != null
+	       && _element->getTockenId() == eci::interpreter::typeConstant;
+}
+
+/**
+ * @brief Get the value of a constant element (the element must be a Constant).
+ * @param[in] _element Constant element.
+ * @return The value.
+ */
+static const eci::Value& getConstant(const ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	return static_cast<eci::interpreter::Constant*>(_element.get())->m_value;
+}
+
+void eci::Optimizer::optimize(const ememory::SharedPtr<eci::Function>& _function, int32_t _functionId) {
+	if (    m_level <= 0
+	     || _function == null
+	     || _function->getBody() == null) {
+		return;
+	}
+	// arguments are never known at this step
+	m_constLocals.clear();
+	m_nbElementBefore += count(_function->getBody());
+	replaceScalars(*_function);
+	optimizeBlock(*_function->getBody());
+	m_functionId = _functionId;
+	fuse(_function->getBody());
+	m_functionId = -1;
+	m_nbElementAfter += count(_function->getBody());
+}
+
+void eci::Optimizer::optimizeGlobal(const ememory::SharedPtr<eci::interpreter::Block>& _block) {
+	if (    m_level <= 0
+	     || _block == null) {
+		return;
+	}
+	m_constLocals.clear();
+	m_nbElementBefore += count(_block);
+	optimizeBlock(*_block);
+	fuse(_block);
+	m_nbElementAfter += count(_block);
+}
+
+/**
+ * @brief Get the class of the object created by a local declaration when the object can be replaced by its fields.
+ * @param[in] _element Declaration.
+ * @return The class ("Type xxx;" or "Type* xxx = new Type();" with only native fields) or null.
+ */
+static const eci::Class* getScalarClass(const eci::interpreter::VariableDeclaration& _element) {
+	const eci::Class* out = _element.m_class;
+	if (_element.m_init != null) {
+		if (    out != null
+		     || _element.m_init->getTockenId() != eci::interpreter::typeNew
+		     || static_cast<eci::interpreter::New*>(_element.m_init.get())->m_size != null) {
+			return null;
+		}
+		out = static_cast<eci::interpreter::New*>(_element.m_init.get())->m_class;
+	}
+	if (out == null) {
+		return null;
+	}
+	for (auto &it : out->getLayout()) {
+		if (it.m_class != null) {
+			// the object of a class field is an other block of the heap
+			return null;
+		}
+	}
+	return out;
+}
+
+/**
+ * @brief Find the local objects that escape the frame (escape analysis).
+ * @param[in] _element Element to parse.
+ * @param[in] _parent Element that contain _element (null for the body).
+ * @param[in,out] _classes Class of the object declared in each slot (null: no object declaration).
+ * @param[in,out] _escaped The object of each slot is used out of a field access or a delete (or the slot is not only used by objects of one class).
+ * A use after the delete, or a delete in a loop that does not declare the object, is an escape: the errors of the deleted objects are kept.
+ * @param[in,out] _deleted The object of each slot is deleted before the current element (in the order of the code).
+ * @param[in,out] _loops Number of loops around the declaration of each slot.
+ * @param[in] _loop Number of loops around _element.
+ */
+static void findEscape(const ememory::SharedPtr<eci::interpreter::Element>& _element,
+                       eci::interpreter::Element* _parent,
+                       etk::Vector<const eci::Class*>& _classes,
+                       etk::Vector<bool>& _escaped,
+                       etk::Vector<bool>& _deleted,
+                       etk::Vector<int32_t>& _loops,
+                       int32_t _loop) {
+	int32_t slot = -1;
+	if (_element->getTockenId() == eci::interpreter::typeVariableDeclaration) {
+		const eci::interpreter::VariableDeclaration* element = static_cast<const eci::interpreter::VariableDeclaration*>(_element.get());
+		if (element->m_global == false) {
+			slot = element->m_slot;
+		}
+	} else if (_element->getTockenId() == eci::interpreter::typeVariable) {
+		const eci::interpreter::Variable* element = static_cast<const eci::interpreter::Variable*>(_element.get());
+		if (element->m_global == false) {
+			slot = element->m_slot;
+		}
+	}
+	if (slot >= int32_t(_classes.size())) {
+		_classes.resize(slot+1, null);
+		_escaped.resize(slot+1, false);
+		_deleted.resize(slot+1, false);
+		_loops.resize(slot+1, 0);
+	}
+	if (_element->getTockenId() == eci::interpreter::typeVariableDeclaration) {
+		if (slot >= 0) {
+			// the slots are reused by the scopes: all the declarations of a slot must create an object of the same class
+			const eci::Class* type = getScalarClass(*static_cast<const eci::interpreter::VariableDeclaration*>(_element.get()));
+			if (    type == null
+			     || (    _classes[slot] != null
+			          && _classes[slot] != type)) {
+				_escaped[slot] = true;
+			} else {
+				_classes[slot] = type;
+			}
+			_deleted[slot] = false;
+			_loops[slot] = _loop;
+		}
+	} else if (    _element->getTockenId() == eci::interpreter::typeVariable
+	            && slot >= 0) {
+		// an access of a deleted object or a second delete stay in the interpreter (it report the error)
+		bool keep = false;
+		if (_deleted[slot] == true) {
+			_escaped[slot] = true;
+		} else if (    _parent != null
+		            && _parent->getTockenId() == eci::interpreter::typeMember) {
+			eci::interpreter::Member* parent = static_cast<eci::interpreter::Member*>(_parent);
+			keep =    _classes[slot] != null
+			       && _classes[slot]->findField(parent->m_name) >= 0;
+		} else if (    _parent != null
+		            && _parent->getTockenId() == eci::interpreter::typeDelete) {
+			// a loop that does not declare the object can delete it again
+			keep = _loops[slot] == _loop;
+			_deleted[slot] = true;
+		}
+		if (keep == false) {
+			_escaped[slot] = true;
+		}
+	}
+	etk::Vector<ememory::SharedPtr<eci::interpreter::Element>> children;
+	eci::interpreter::getChildren(_element, children);
+	for (auto &it : children) {
+		// the init of a "for" is executed once, the other parts of the loops are repeated
+		int32_t loop = _loop;
+		if (    _element->getTockenId() == eci::interpreter::typeWhile
+		     || (    _element->getTockenId() == eci::interpreter::typeFor
+		          && it != static_cast<const eci::interpreter::For*>(_element.get())->m_init)) {
+			++loop;
+		}
+		findEscape(it, _element.get(), _classes, _escaped, _deleted, _loops, loop);
+	}
+}
+
+/**
+ * @brief Get the first field slot of a variable replaced by its fields.
+ * @param[in] _element Element to check.
+ * @param[in] _fields First field slot of each slot (-1 if the object is kept).
+ * @return The first field slot or -1 if the element is not a replaced variable.
+ */
+static int32_t getScalarSlot(const ememory::SharedPtr<eci::interpreter::Element>& _element, const etk::Vector<int32_t>& _fields) {
+	if (    _element == null
+	     || _element->getTockenId() != eci::interpreter::typeVariable) {
+		return -1;
+	}
+	const eci::interpreter::Variable* element = static_cast<const eci::interpreter::Variable*>(_element.get());
+	if (    element->m_global == true
+	     || element->m_slot < 0
+	     || element->m_slot >= int32_t(_fields.size())) {
+		return -1;
+	}
+	return _fields[element->m_slot];
+}
+
+static void replaceScalar(ememory::SharedPtr<eci::interpreter::Element>& _element, const etk::Vector<const eci::Class*>& _classes, const etk::Vector<int32_t>& _fields);
+
+/**
+ * @brief Replace the accesses of the replaced objects in a block.
+ * @param[in] _block Block to update.
+ * @param[in] _classes Class of the object of each slot.
+ * @param[in] _fields First field slot of each slot (-1 if the object is kept).
+ */
+static void replaceScalar(eci::interpreter::Block& _block, const etk::Vector<const eci::Class*>& _classes, const etk::Vector<int32_t>& _fields) {
+	for (auto &it : _block.m_actions) {
+		replaceScalar(it, _classes, _fields);
+	}
+}
+
+/**
+ * @brief Replace the declarations, the field accesses and the deletes of the replaced objects.
+ * @param[in,out] _element Element to update.
+ * @param[in] _classes Class of the object of each slot.
+ * @param[in] _fields First field slot of each slot (-1 if the object is kept).
+ */
+static void replaceScalar(ememory::SharedPtr<eci::interpreter::Element>& _element, const etk::Vector<const eci::Class*>& _classes, const etk::Vector<int32_t>& _fields) {
+	if (_element == null) {
+		return;
+	}
+	switch (_element->getTockenId()) {
+		case eci::interpreter::typeBlock:
+			replaceScalar(*static_cast<eci::interpreter::Block*>(_element.get()), _classes, _fields);
+			break;
+		case eci::interpreter::typeVariableDeclaration: {
+			eci::interpreter::VariableDeclaration* element = static_cast<eci::interpreter::VariableDeclaration*>(_element.get());
+			if (    element->m_global == true
+			     || element->m_slot < 0
+			     || element->m_slot >= int32_t(_fields.size())
+			     || _fields[element->m_slot] < 0) {
+				replaceScalar(element->m_init, _classes, _fields);
+				break;
+			}
+			// one declaration per field: the fields get the initial value of a new object
+			ememory::SharedPtr<eci::interpreter::Block> block = ememory::makeShared<eci::interpreter::Block>();
+			const etk::Vector<eci::Class::Field>& layout = _classes[element->m_slot]->getLayout();
+			for (size_t iii=0; iii<layout.size(); ++iii) {
+				ememory::SharedPtr<eci::interpreter::VariableDeclaration> field = ememory::makeShared<eci::interpreter::VariableDeclaration>();
+				field->m_name = element->m_name + "." + layout[iii].m_name;
+				field->m_typeName = eci::getValueTypeName(layout[iii].m_valueType);
+				field->m_valueType = layout[iii].m_valueType;
+				field->m_slot = _fields[element->m_slot] + iii;
+				block->m_actions.pushBack(field);
+			}
+			_element = block;
+			break;
+		}
+		case eci::interpreter::typeCondition: {
+			eci::interpreter::Condition* element = static_cast<eci::interpreter::Condition*>(_element.get());
+			replaceScalar(element->m_condition, _classes, _fields);
+			replaceScalar(*element->m_block, _classes, _fields);
+			if (element->m_blockElse != null) {
+				replaceScalar(*element->m_blockElse, _classes, _fields);
+			}
+			break;
+		}
+		case eci::interpreter::typeFor: {
+			eci::interpreter::For* element = static_cast<eci::interpreter::For*>(_element.get());
+			replaceScalar(element->m_init, _classes, _fields);
+			replaceScalar(element->m_condition, _classes, _fields);
+			replaceScalar(element->m_increment, _classes, _fields);
+			replaceScalar(*element->m_block, _classes, _fields);
+			break;
+		}
+		case eci::interpreter::typeWhile: {
+			eci::interpreter::While* element = static_cast<eci::interpreter::While*>(_element.get());
+			replaceScalar(element->m_condition, _classes, _fields);
+			replaceScalar(element->m_action, _classes, _fields);
+			break;
+		}
+		case eci::interpreter::typeSwitch: {
+			eci::interpreter::Switch* element = static_cast<eci::interpreter::Switch*>(_element.get());
+			replaceScalar(element->m_value, _classes, _fields);
+			for (auto &it : element->m_blocks) {
+				replaceScalar(*it, _classes, _fields);
+			}
+			break;
+		}
+		case eci::interpreter::typeOperator: {
+			eci::interpreter::Operator* element = static_cast<eci::interpreter::Operator*>(_element.get());
+			replaceScalar(element->m_left, _classes, _fields);
+			replaceScalar(element->m_right, _classes, _fields);
+			break;
+		}
+		case eci::interpreter::typeFunctionCall:
+			for (auto &it : static_cast<eci::interpreter::FunctionCall*>(_element.get())->m_arguments) {
+				replaceScalar(it, _classes, _fields);
+			}
+			break;
+		case eci::interpreter::typeReturn:
+			replaceScalar(static_cast<eci::interpreter::Return*>(_element.get())->m_value, _classes, _fields);
+			break;
+		case eci::interpreter::typeCast:
+			replaceScalar(static_cast<eci::interpreter::Cast*>(_element.get())->m_value, _classes, _fields);
+			break;
+		case eci::interpreter::typeMember: {
+			eci::interpreter::Member* element = static_cast<eci::interpreter::Member*>(_element.get());
+			int32_t first = getScalarSlot(element->m_object, _fields);
+			if (first < 0) {
+				replaceScalar(element->m_object, _classes, _fields);
+				break;
+			}
+			const eci::interpreter::Variable* object = static_cast<const eci::interpreter::Variable*>(element->m_object.get());
+			ememory::SharedPtr<eci::interpreter::Variable> field = ememory::makeShared<eci::interpreter::Variable>(object->m_name + "." + element->m_name);
+			field->m_slot = first + _classes[object->m_slot]->findField(element->m_name);
+			_element = field;
+			break;
+		}
+		case eci::interpreter::typeDelete: {
+			eci::interpreter::Delete* element = static_cast<eci::interpreter::Delete*>(_element.get());
+			if (getScalarSlot(element->m_value, _fields) < 0) {
+				replaceScalar(element->m_value, _classes, _fields);
+				break;
+			}
+			// the object is never allocated
+			_element = ememory::makeShared<eci::interpreter::Block>();
+			break;
+		}
+		case eci::interpreter::typeNew:
+			replaceScalar(static_cast<eci::interpreter::New*>(_element.get())->m_size, _classes, _fields);
+			break;
+		case eci::interpreter::typeIndex: {
+			eci::interpreter::Index* element = static_cast<eci::interpreter::Index*>(_element.get());
+			replaceScalar(element->m_object, _classes, _fields);
+			replaceScalar(element->m_index, _classes, _fields);
+			break;
+		}
+		case eci::interpreter::typeMethodCall: {
+			eci::interpreter::MethodCall* element = static_cast<eci::interpreter::MethodCall*>(_element.get());
+			replaceScalar(element->m_object, _classes, _fields);
+			for (auto &it : element->m_arguments) {
+				replaceScalar(it, _classes, _fields);
+			}
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+void eci::Optimizer::replaceScalars(eci::Function& _function) {
+	etk::Vector<const eci::Class*> classes;
+	etk::Vector<bool> escaped;
+	etk::Vector<bool> deleted;
+	etk::Vector<int32_t> loops;
+	findEscape(_function.getBody(), null, classes, escaped, deleted, loops, 0);
+	etk::Vector<int32_t> fields;
+	fields.resize(classes.size(), -1);
+	int32_t frameSize = _function.getFrameSize();
+	bool replaced = false;
+	for (size_t iii=0; iii<classes.size(); ++iii) {
+		if (    classes[iii] == null
+		     || escaped[iii] == true) {
+			continue;
+		}
+		// the fields are new slots at the end of the frame
+		fields[iii] = frameSize;
+		frameSize += classes[iii]->getLayout().size();
+		replaced = true;
+		++m_nbScalar;
+	}
+	if (replaced == false) {
+		return;
+	}
+	_function.setFrameSize(frameSize);
+	replaceScalar(*_function.getBody(), classes, fields);
+}
+
+void eci::Optimizer::setConstValue(etk::Vector<eci::Value>& _list, int32_t _slot, const eci::Value& _value) {
+	if (_slot < 0) {
+		return;
+	}
+	if (_slot >= int32_t(_list.size())) {
+		_list.resize(_slot+1);
+	}
+	_list[_slot] = _value;
+}
+
+eci::Value eci::Optimizer::getConstValue(const etk::Vector<eci::Value>& _list, int32_t _slot) const {
+	if (    _slot < 0
+	     || _slot >= int32_t(_list.size())) {
+		return eci::Value();
+	}
+	return _list[_slot];
+}
+
+size_t eci::Optimizer::count(const ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	if (_element == null) {
+		return 0;
+	}
+	etk::Vector<ememory::SharedPtr<eci::interpreter::Element>> children;
+	eci::interpreter::getChildren(_element, children);
+	size_t out = 1;
+	for (auto &it : children) {
+		out += count(it);
+	}
+	return out;
+}
+
+void eci::Optimizer::fuse(const ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	if (_element == null) {
+		return;
+	}
+	if (_element->getTockenId() == eci::interpreter::typeOperator) {
+		eci::interpreter::Operator* element = static_cast<eci::interpreter::Operator*>(_element.get());
+		if (m_profile == true) {
+			element->m_fusion = eci::interpreter::fusionProfile;
+		} else if (element->fuse() != eci::interpreter::fusionNone) {
+			++m_nbFused;
+		}
+	} else if (_element->getTockenId() == eci::interpreter::typeFor) {
+		// the condition and the increment of a counted loop are not executed (no count in profile mode)
+		if (    m_profile == false
+		     && static_cast<eci::interpreter::For*>(_element.get())->findInduction() == true) {
+			++m_nbCountedLoop;
+		}
+	} else if (_element->getTockenId() == eci::interpreter::typeReturn) {
+		eci::interpreter::Return* element = static_cast<eci::interpreter::Return*>(_element.get());
+		if (    m_functionId >= 0
+		     && element->m_value != null
+		     && element->m_value->getTockenId() == eci::interpreter::typeFunctionCall
+		     && static_cast<eci::interpreter::FunctionCall*>(element->m_value.get())->m_functionId == m_functionId) {
+			element->m_tailCall = true;
+			++m_nbTailCall;
+		}
+	}
+	etk::Vector<ememory::SharedPtr<eci::interpreter::Element>> children;
+	eci::interpreter::getChildren(_element, children);
+	for (auto &it : children) {
+		fuse(it);
+	}
+}
+
+/**
+ * @brief Get the name of an operand in a profile shape.
+ * @param[in] _element Operand.
+ * @param[in] _depth Number of operator levels to describe.
+ * @return Name of the operand ("local", "constant", "(local + constant)" ...).
+ */
+static etk::String getOperandName(const ememory::SharedPtr<eci::interpreter::Element>& _element, int32_t _depth);
+
+/**
+ * @brief Get the shape of an operator site: its operator and the kind of its operands.
+ * @param[in] _element Operator.
+ * @param[in] _depth Number of operator levels to describe in the operands.
+ * @return The shape ("local < constant", "local = (local + constant)" ...).
+ */
+static etk::String getShape(const eci::interpreter::Operator& _element, int32_t _depth) {
+	if (_element.m_left == null) {
+		return _element.m_operator + getOperandName(_element.m_right, _depth);
+	}
+	if (_element.m_right == null) {
+		return getOperandName(_element.m_left, _depth) + _element.m_operator;
+	}
+	return getOperandName(_element.m_left, _depth) + " " + _element.m_operator + " " + getOperandName(_element.m_right, _depth);
+}
+
+static etk::String getOperandName(const ememory::SharedPtr<eci::interpreter::Element>& _element, int32_t _depth) {
+	switch (_element->getTockenId()) {
+		case eci::interpreter::typeVariable:
+			if (static_cast<eci::interpreter::Variable*>(_element.get())->m_global == true) {
+				return "global";
+			}
+			return "local";
+		case eci::interpreter::typeConstant:     return "constant";
+		case eci::interpreter::typeLiteral:      return "literal";
+		case eci::interpreter::typeFunctionCall: return "call";
+		case eci::interpreter::typeMethodCall:   return "method";
+		case eci::interpreter::typeMember:       return "member";
+		case eci::interpreter::typeCast:         return "cast";
+		case eci::interpreter::typeNew:          return "new";
+		case eci::interpreter::typeIndex:        return "index";
+		case eci::interpreter::typeOperator:
+			if (_depth <= 0) {
+				return "operator";
+			}
+			return "(" + getShape(*static_cast<eci::interpreter::Operator*>(_element.get()), _depth-1) + ")";
+		default:
+			break;
+	}
+	return "element";
+}
+
+/**
+ * @brief Add executions of a shape in the profile.
+ * @param[in,out] _shapes Number of executions of each shape.
+ * @param[in] _shape Shape of the site.
+ * @param[in] _count Number of executions.
+ */
+static void addShape(etk::Vector<etk::Pair<etk::String, size_t>>& _shapes, const etk::String& _shape, size_t _count) {
+	for (auto &it : _shapes) {
+		if (it.first == _shape) {
+			it.second += _count;
+			return;
+		}
+	}
+	_shapes.pushBack(etk::makePair(_shape, _count));
+}
+
+/**
+ * @brief Add the executions of the operator sites of a tree in the profile.
+ * @param[in] _element Root of the tree.
+ * @param[in,out] _shapes Number of executions of each shape.
+ */
+static void addProfile(const ememory::SharedPtr<eci::interpreter::Element>& _element, etk::Vector<etk::Pair<etk::String, size_t>>& _shapes) {
+	if (_element == null) {
+		return;
+	}
+	if (_element->getTockenId() == eci::interpreter::typeOperator) {
+		eci::interpreter::Operator* element = static_cast<eci::interpreter::Operator*>(_element.get());
+		if (element->m_nbExecution != 0) {
+			// pairs (operator and its operands) and triples (with the operators in the operands)
+			etk::String pair = getShape(*element, 0);
+			etk::String triple = getShape(*element, 1);
+			// the shapes of the existing superinstructions are marked
+			if (element->fuse() != eci::interpreter::fusionNone) {
+				pair += " *";
+			}
+			element->m_fusion = eci::interpreter::fusionProfile;
+			addShape(_shapes, pair, element->m_nbExecution);
+			if (triple != getShape(*element, 0)) {
+				addShape(_shapes, triple, element->m_nbExecution);
+			}
+		}
+	}
+	etk::Vector<ememory::SharedPtr<eci::interpreter::Element>> children;
+	eci::interpreter::getChildren(_element, children);
+	for (auto &it : children) {
+		addProfile(it, _shapes);
+	}
+}
+
+void eci::Optimizer::addProfileShapes(const eci::Interpreter& _interpreter, etk::Vector<etk::Pair<etk::String, size_t>>& _shapes) {
+	for (auto &it : _interpreter.getFiles()) {
+		addProfile(it->getInit(), _shapes);
+	}
+	for (size_t iii=0; iii<_interpreter.getNbFunction(); ++iii) {
+		addProfile(_interpreter.getFunction(iii)->getBody(), _shapes);
+	}
+}
+
+etk::String eci::Optimizer::getProfileShapes(etk::Vector<etk::Pair<etk::String, size_t>> _shapes) {
+	etk::String out;
+	while (_shapes.size() != 0) {
+		size_t best = 0;
+		for (size_t iii=1; iii<_shapes.size(); ++iii) {
+			if (_shapes[iii].second > _shapes[best].second) {
+				best = iii;
+			}
+		}
+		out += etk::toString(_shapes[best].second) + " " + _shapes[best].first + "\n";
+		_shapes.erase(best);
+	}
+	return out;
+}
+
+void eci::Optimizer::optimizeBlock(eci::interpreter::Block& _block) {
+	etk::Vector<ememory::SharedPtr<eci::interpreter::Element>> actions;
+	for (auto &it : _block.m_actions) {
+		ememory::SharedPtr<eci::interpreter::Element> element = optimizeElement(it);
+		if (element == null) {
+			continue;
+		}
+		int32_t type = element->getTockenId();
+		if (    type == eci::interpreter::typeConstant
+		     || type == eci::interpreter::typeLiteral
+		     || type == eci::interpreter::typeVariable) {
+			// statement without effect
+			continue;
+		}
+		if (type == eci::interpreter::typeBlock) {
+			// the slots are resolved: a sub-block is only a list of action
+			for (auto &itSub : static_cast<eci::interpreter::Block*>(element.get())->m_actions) {
+				actions.pushBack(itSub);
+			}
+		} else {
+			actions.pushBack(element);
+		}
+		if (    type == eci::interpreter::typeReturn
+		     || type == eci::interpreter::typeBreak
+		     || type == eci::interpreter::typeContinue) {
+			// the end of the block is never executed
+			break;
+		}
+	}
+	_block.m_actions = actions;
+}
+
+ememory::SharedPtr<eci::interpreter::Element> eci::Optimizer::optimizeElement(const ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	if (_element == null) {
+		return null;
+	}
+	switch (_element->getTockenId()) {
+		case eci::interpreter::typeBlock: {
+			optimizeBlock(*static_cast<eci::interpreter::Block*>(_element.get()));
+			return _element;
+		}
+		case eci::interpreter::typeVariable: {
+			ememory::SharedPtr<eci::interpreter::Variable> element = ememory::staticPointerCast<eci::interpreter::Variable>(_element);
+			eci::Value value;
+			if (element->m_global == true) {
+				value = getConstValue(m_constGlobals, element->m_slot);
+			} else {
+				value = getConstValue(m_constLocals, element->m_slot);
+			}
+			if (value.m_type == eci::valueTypeVoid) {
+				return _element;
+			}
+			return ememory::makeShared<eci::interpreter::Constant>(value);
+		}
+		case eci::interpreter::typeVariableDeclaration: {
+			ememory::SharedPtr<eci::interpreter::VariableDeclaration> element = ememory::staticPointerCast<eci::interpreter::VariableDeclaration>(_element);
+			element->m_init = optimizeElement(element->m_init);
+			// a new declaration always replace the previous variable of the slot
+			eci::Value value;
+			if (    element->m_const == true
+			     && isConstant(element->m_init) == true) {
+				value = getConstant(element->m_init).convert(element->m_valueType);
+			}
+			if (element->m_global == true) {
+				setConstValue(m_constGlobals, element->m_slot, value);
+			} else {
+				setConstValue(m_constLocals, element->m_slot, value);
+			}
+			return _element;
+		}
+		case eci::interpreter::typeCondition: {
+			ememory::SharedPtr<eci::interpreter::Condition> element = ememory::staticPointerCast<eci::interpreter::Condition>(_element);
+			element->m_condition = optimizeElement(element->m_condition);
+			if (isConstant(element->m_condition) == true) {
+				if (getConstant(element->m_condition).isTrue() == true) {
+					optimizeBlock(*element->m_block);
+					return element->m_block;
+				}
+				if (element->m_blockElse != null) {
+					optimizeBlock(*element->m_blockElse);
+					return element->m_blockElse;
+				}
+				return null;
+			}
+			optimizeBlock(*element->m_block);
+			if (element->m_blockElse != null) {
+				optimizeBlock(*element->m_blockElse);
+			}
+			return _element;
+		}
+		case eci::interpreter::typeFor: {
+			ememory::SharedPtr<eci::interpreter::For> element = ememory::staticPointerCast<eci::interpreter::For>(_element);
+			element->m_init = optimizeElement(element->m_init);
+			element->m_condition = optimizeElement(element->m_condition);
+			if (isConstant(element->m_condition) == true) {
+				if (getConstant(element->m_condition).isTrue() == false) {
+					// only the initialisation is executed
+					return element->m_init;
+				}
+				element->m_condition = null;
+			}
+			element->m_increment = optimizeElement(element->m_increment);
+			optimizeBlock(*element->m_block);
+			return _element;
+		}
+		case eci::interpreter::typeWhile: {
+			ememory::SharedPtr<eci::interpreter::While> element = ememory::staticPointerCast<eci::interpreter::While>(_element);
+			element->m_condition = optimizeElement(element->m_condition);
+			if (    element->m_conditionAtStart == true
+			     && isConstant(element->m_condition) == true
+			     && getConstant(element->m_condition).isTrue() == false) {
+				return null;
+			}
+			element->m_action = optimizeElement(element->m_action);
+			if (element->m_action == null) {
+				element->m_action = ememory::makeShared<eci::interpreter::Block>();
+			}
+			return _element;
+		}
+		case eci::interpreter::typeSwitch: {
+			ememory::SharedPtr<eci::interpreter::Switch> element = ememory::staticPointerCast<eci::interpreter::Switch>(_element);
+			element->m_value = optimizeElement(element->m_value);
+			// the blocks keep their index (the dispatch is already created)
+			for (auto &it : element->m_blocks) {
+				optimizeBlock(*it);
+			}
+			return _element;
+		}
+		case eci::interpreter::typeOperator:
+			return optimizeOperator(ememory::staticPointerCast<eci::interpreter::Operator>(_element));
+		case eci::interpreter::typeFunctionCall: {
+			ememory::SharedPtr<eci::interpreter::FunctionCall> element = ememory::staticPointerCast<eci::interpreter::FunctionCall>(_element);
+			for (auto &it : element->m_arguments) {
+				it = optimizeElement(it);
+			}
+			return _element;
+		}
+		case eci::interpreter::typeMember: {
+			ememory::SharedPtr<eci::interpreter::Member> element = ememory::staticPointerCast<eci::interpreter::Member>(_element);
+			element->m_object = optimizeElement(element->m_object);
+			return _element;
+		}
+		case eci::interpreter::typeMethodCall: {
+			ememory::SharedPtr<eci::interpreter::MethodCall> element = ememory::staticPointerCast<eci::interpreter::MethodCall>(_element);
+			element->m_object = optimizeElement(element->m_object);
+			for (auto &it : element->m_arguments) {
+				it = optimizeElement(it);
+			}
+			return _element;
+		}
+		case eci::interpreter::typeReturn: {
+			ememory::SharedPtr<eci::interpreter::Return> element = ememory::staticPointerCast<eci::interpreter::Return>(_element);
+			element->m_value = optimizeElement(element->m_value);
+			return _element;
+		}
+		case eci::interpreter::typeDelete: {
+			ememory::SharedPtr<eci::interpreter::Delete> element = ememory::staticPointerCast<eci::interpreter::Delete>(_element);
+			element->m_value = optimizeElement(element->m_value);
+			return _element;
+		}
+		case eci::interpreter::typeNew: {
+			ememory::SharedPtr<eci::interpreter::New> element = ememory::staticPointerCast<eci::interpreter::New>(_element);
+			element->m_size = optimizeElement(element->m_size);
+			return _element;
+		}
+		case eci::interpreter::typeIndex: {
+			ememory::SharedPtr<eci::interpreter::Index> element = ememory::staticPointerCast<eci::interpreter::Index>(_element);
+			element->m_object = optimizeElement(element->m_object);
+			element->m_index = optimizeElement(element->m_index);
+			return _element;
+		}
+		case eci::interpreter::typeCast: {
+			ememory::SharedPtr<eci::interpreter::Cast> element = ememory::staticPointerCast<eci::interpreter::Cast>(_element);
+			element->m_value = optimizeElement(element->m_value);
+			if (isConstant(element->m_value) == true) {
+				return ememory::makeShared<eci::interpreter::Constant>(getConstant(element->m_value).convert(element->m_valueType));
+			}
+			return _element;
+		}
+		default:
+			break;
+	}
+	return _element;
+}
+
+ememory::SharedPtr<eci::interpreter::Element> eci::Optimizer::optimizeOperator(const ememory::SharedPtr<eci::interpreter::Operator>& _element) {
+	ememory::SharedPtr<eci::interpreter::Element> destination = eci::Resolver::getAssignDestination(_element);
+	if (destination != null) {
+		// the modified variable is never replaced (only the value can be optimized)
+		if (_element->m_left != destination) {
+			_element->m_left = optimizeElement(_element->m_left);
+		}
+		if (_element->m_right != destination) {
+			_element->m_right = optimizeElement(_element->m_right);
+		}
+		return _element;
+	}
+	_element->m_left = optimizeElement(_element->m_left);
+	_element->m_right = optimizeElement(_element->m_right);
+	switch (_element->m_operatorId) {
+		case eci::operatorAnd:
+		case eci::operatorOr: {
+			if (isConstant(_element->m_left) == false) {
+				return _element;
+			}
+			bool left = getConstant(_element->m_left).isTrue();
+			if (left == (_element->m_operatorId == eci::operatorOr)) {
+				// short-circuit: the right value is never executed
+				return ememory::makeShared<eci::interpreter::Constant>(eci::Value(left));
+			}
+			if (isConstant(_element->m_right) == true) {
+				return ememory::makeShared<eci::interpreter::Constant>(eci::Value(getConstant(_element->m_right).isTrue()));
+			}
+			return _element;
+		}
+		case eci::operatorNone:
+			return _element;
+		default:
+			break;
+	}
+	if (_element->m_left == null) {
+		// prefix unary operator
+		if (isConstant(_element->m_right) == false) {
+			return _element;
+		}
+		return ememory::makeShared<eci::interpreter::Constant>(eci::callOperator(_element->m_operatorId, getConstant(_element->m_right)));
+	}
+	if (    isConstant(_element->m_left) == false
+	     || isConstant(_element->m_right) == false) {
+		return _element;
+	}
+	const eci::Value& left = getConstant(_element->m_left);
+	const eci::Value& right = getConstant(_element->m_right);
+	if (    (    _element->m_operatorId == eci::operatorDiv
+	          || _element->m_operatorId == eci::operatorMod)
+	     && eci::getCommonType(left.m_type, right.m_type) < eci::valueTypeFloat
+	     && right.isTrue() == false) {
+		// keep the error at the execution
+		return _element;
+	}
+	return ememory::makeShared<eci::interpreter::Constant>(eci::callOperator(_element->m_operatorId, left, right));
+}
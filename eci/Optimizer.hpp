@@ -0,0 +1,160 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/Vector.hpp>
+#include <etk/Pair.hpp>
+#include <eci/Function.hpp>
+#include <eci/interpreter/Element.hpp>
+
+namespace eci {
+	class Interpreter;
+	/**
+	 * @brief Optimization pass on the resolved element tree: fold the constant expressions
+	 * (with the native operators of the types), propagate the const variables and remove
+	 * the dead branches. It must run after the resolver (it use the slots).
+	 * Then the operator sites are fused in superinstructions (see @ref eci::interpreter::fusion), or prepared
+	 * to count their executions in profile mode (the most executed shapes are the candidates of new superinstructions).
+	 * Before these passes, the local objects that never leave the frame of a function are replaced by one local per field
+	 * (escape analysis and scalar replacement, see @ref replaceScalars): they are not allocated in the heap.
+	 */
+	class Optimizer {
+		private:
+			int32_t m_level; //!< Optimization level (0: disable, 1: scalar replacement, constant folding, dead code elimination and superinstructions).
+			bool m_profile; //!< Count the executions of the operator sites instead of fusing them.
+			etk::Vector<eci::Value> m_constLocals; //!< Value of the const local variable of each slot (void if unknow).
+			etk::Vector<eci::Value> m_constGlobals; //!< Value of the const global variable of each slot (void if unknow).
+			size_t m_nbElementBefore; //!< Number of element before the optimization (statistic).
+			size_t m_nbElementAfter; //!< Number of element after the optimization (statistic).
+			size_t m_nbFused; //!< Number of operator sites fused in a superinstruction (statistic).
+			size_t m_nbCountedLoop; //!< Number of cycles executed as counted loops (statistic).
+			size_t m_nbTailCall; //!< Number of recursive calls in tail position executed without new frame (statistic).
+			size_t m_nbScalar; //!< Number of local objects replaced by their fields (statistic).
+			int32_t m_functionId; //!< Index of the optimized function (target of the tail calls, -1 for the global initialisation).
+		public:
+			Optimizer();
+			~Optimizer();
+			/**
+			 * @brief Set the optimization level.
+			 * @param[in] _level New level (0 disable the optimizer).
+			 */
+			void setLevel(int32_t _level) {
+				m_level = _level;
+			}
+			/**
+			 * @brief Get the optimization level.
+			 * @return The current level.
+			 */
+			int32_t getLevel() const {
+				return m_level;
+			}
+			/**
+			 * @brief Select the profile mode: the operator sites of the next optimized code are not fused, their executions are counted.
+			 * @param[in] _value true to count the executions.
+			 */
+			void setProfile(bool _value) {
+				m_profile = _value;
+			}
+			bool getProfile() const {
+				return m_profile;
+			}
+			/**
+			 * @brief Get the number of element of all the optimized code before the optimization.
+			 * @return Number of element.
+			 */
+			size_t getNbElementBefore() const {
+				return m_nbElementBefore;
+			}
+			/**
+			 * @brief Get the number of element of all the optimized code after the optimization.
+			 * @return Number of element.
+			 */
+			size_t getNbElementAfter() const {
+				return m_nbElementAfter;
+			}
+			/**
+			 * @brief Get the number of operator sites fused in a superinstruction.
+			 * @return Number of site.
+			 */
+			size_t getNbFused() const {
+				return m_nbFused;
+			}
+			/**
+			 * @brief Get the number of "for" cycles executed with a native induction variable (see @ref eci::interpreter::For::findInduction).
+			 * @return Number of cycle.
+			 */
+			size_t getNbCountedLoop() const {
+				return m_nbCountedLoop;
+			}
+			/**
+			 * @brief Get the number of "return" of a call of the current function executed without new frame.
+			 * @return Number of tail call.
+			 */
+			size_t getNbTailCall() const {
+				return m_nbTailCall;
+			}
+			/**
+			 * @brief Get the number of local objects replaced by a local per field (never allocated in the heap).
+			 * @return Number of local object.
+			 */
+			size_t getNbScalar() const {
+				return m_nbScalar;
+			}
+			/**
+			 * @brief Optimize the body of a resolved function.
+			 * @param[in] _function Function to optimize.
+			 * @param[in] _functionId Index of the function in the interpreter (the recursive calls in tail position are
+			 *                        executed without new frame, -1 to keep them).
+			 */
+			void optimize(const ememory::SharedPtr<eci::Function>& _function, int32_t _functionId=-1);
+			/**
+			 * @brief Optimize the global initialisation of a file (the value of the const globals are kept for the functions).
+			 * @param[in] _block Initialisation block of the file.
+			 */
+			void optimizeGlobal(const ememory::SharedPtr<eci::interpreter::Block>& _block);
+			/**
+			 * @brief Count the elements of a tree.
+			 * @param[in] _element Root of the tree.
+			 * @return Number of element (0 if null).
+			 */
+			static size_t count(const ememory::SharedPtr<eci::interpreter::Element>& _element);
+			/**
+			 * @brief Add the executions of the operator sites optimized in profile mode, by shape: the kind of the operands
+			 * of the site ("local < constant") and of the operands of its operands ("local = (local + constant)").
+			 * @param[in] _interpreter Interpreter that executed the code.
+			 * @param[in,out] _shapes Number of executions of each shape.
+			 */
+			static void addProfileShapes(const eci::Interpreter& _interpreter, etk::Vector<etk::Pair<etk::String, size_t>>& _shapes);
+			/**
+			 * @brief Get the profile of the shapes as text.
+			 * @param[in] _shapes Number of executions of each shape.
+			 * @return One line per shape "count shape", the most executed first (a shape of a superinstruction is followed by "*").
+			 */
+			static etk::String getProfileShapes(etk::Vector<etk::Pair<etk::String, size_t>> _shapes);
+		private:
+			/**
+			 * @brief Replace the local objects that never escape the frame by a local per field. An object is replaced when it
+			 * is created by its declaration ("Type xxx;" or "Type* xxx = new Type();", with only native fields) and the variable
+			 * is only used to access a field ("xxx.yyy", "xxx->yyy") or to delete the object: a method call, an assignment,
+			 * a copy, an argument or a return of the variable keep the object in the heap (as an access after its delete, or a second delete,
+			 * to report their errors).
+			 * @param[in] _function Resolved function (the new locals are added at the end of its frame).
+			 */
+			void replaceScalars(eci::Function& _function);
+			/**
+			 * @brief Select the superinstructions of the operator sites of a tree.
+			 * @param[in] _element Root of the tree.
+			 */
+			void fuse(const ememory::SharedPtr<eci::interpreter::Element>& _element);
+			ememory::SharedPtr<eci::interpreter::Element> optimizeElement(const ememory::SharedPtr<eci::interpreter::Element>& _element);
+			ememory::SharedPtr<eci::interpreter::Element> optimizeOperator(const ememory::SharedPtr<eci::interpreter::Operator>& _element);
+			void optimizeBlock(eci::interpreter::Block& _block);
+			void setConstValue(etk::Vector<eci::Value>& _list, int32_t _slot, const eci::Value& _value);
+			eci::Value getConstValue(const etk::Vector<eci::Value>& _list, int32_t _slot) const;
+	};
+}
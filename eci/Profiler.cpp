@@ -0,0 +1,115 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Profiler.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/Stack.hpp>
+#include <eci/debug.hpp>
+#include <chrono>
+
+eci::Profiler::Profiler() :
+  m_pending(false),
+  m_running(false),
+  m_timer(null),
+  m_period(1000),
+  m_nbSample(0) {
+	m_nodes.pushBack(Node());
+}
+
+eci::Profiler::~Profiler() {
+	stop();
+}
+
+void eci::Profiler::start(int32_t _frequency) {
+	stop();
+	m_period = 1000000 / etk::max(_frequency, 1);
+	m_running = true;
+	m_timer = new std::thread([this]() {
+		while (m_running == true) {
+			std::this_thread::sleep_for(std::chrono::microseconds(m_period));
+			m_pending.store(true, std::memory_order_relaxed);
+		}
+	});
+}
+
+void eci::Profiler::stop() {
+	if (m_timer == null) {
+		return;
+	}
+	m_running = false;
+	m_timer->join();
+	delete m_timer;
+	m_timer = null;
+	m_pending = false;
+}
+
+void eci::Profiler::sample(const eci::Stack& _stack) {
+	m_pending.store(false, std::memory_order_relaxed);
+	size_t node = 0;
+	for (size_t iii=0; iii<_stack.getDepth(); ++iii) {
+		const eci::Function* function = _stack.getFrame(iii).m_function;
+		size_t child = 0;
+		for (auto &it : m_nodes[node].m_children) {
+			if (m_nodes[it].m_function == function) {
+				child = it;
+				break;
+			}
+		}
+		if (child == 0) {
+			child = m_nodes.size();
+			m_nodes.pushBack(Node(function));
+			m_nodes[node].m_children.pushBack(child);
+		}
+		node = child;
+	}
+	++m_nodes[node].m_count;
+	++m_nbSample;
+}
+
+/**
+ * @brief Get the name of a frame in the folded stacks.
+ * @param[in] _interpreter Interpreter that own the function.
+ * @param[in] _function Function of the frame (null for the global initialization).
+ * @return "function@file:line" (file and line are removed when unknown).
+ */
+static etk::String getFrameName(const eci::Interpreter& _interpreter, const eci::Function* _function) {
+	if (_function == null) {
+		return "<global>";
+	}
+	etk::String out = _function->getName();
+	for (auto &it : _interpreter.getFiles()) {
+		for (auto &it2 : it->getFunctions()) {
+			if (it2.get() == _function) {
+				out += "@" + it->getName();
+				break;
+			}
+		}
+	}
+	if (_function->getLine() > 0) {
+		out += ":" + etk::toString(_function->getLine());
+	}
+	return out;
+}
+
+void eci::Profiler::addFolded(const eci::Interpreter& _interpreter, size_t _node, const etk::String& _path, etk::String& _out) const {
+	for (auto &it : m_nodes[_node].m_children) {
+		etk::String path = getFrameName(_interpreter, m_nodes[it].m_function);
+		if (_path != "") {
+			path = _path + ";" + path;
+		}
+		if (m_nodes[it].m_count != 0) {
+			_out += path + " " + etk::toString(m_nodes[it].m_count) + "\n";
+		}
+		addFolded(_interpreter, it, path, _out);
+	}
+}
+
+etk::String eci::Profiler::getFolded(const eci::Interpreter& _interpreter) const {
+	etk::String out;
+	addFolded(_interpreter, 0, "", out);
+	return out;
+}
+
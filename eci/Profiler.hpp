@@ -0,0 +1,89 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/String.hpp>
+#include <etk/Vector.hpp>
+#include <thread>
+#include <atomic>
+
+namespace eci {
+	class Interpreter;
+	class Function;
+	class Stack;
+	/**
+	 * @brief Sampling profiler of the script functions: a timer thread request a sample at each period, the interpreter
+	 * record its call stack at the next safe point (call of a function, iteration of a loop). The stacks are counted in a
+	 * tree (no allocation when the stack has already been seen) and written as folded stacks (flame graph tools).
+	 * The functions compiled by the JIT have no safe point: their samples are recorded on the next interpreted call or loop.
+	 */
+	class Profiler {
+		private:
+			/**
+			 * @brief Call stack already seen.
+			 */
+			class Node {
+				public:
+					const eci::Function* m_function; //!< Function of the frame (null for the global initialization).
+					size_t m_count; //!< Number of samples with this frame on the top.
+					etk::Vector<size_t> m_children; //!< Index of the called frames.
+				public:
+					Node(const eci::Function* _function=null) :
+					  m_function(_function),
+					  m_count(0) {
+						
+					}
+			};
+			etk::Vector<Node> m_nodes; //!< Tree of the call stacks (the first node is the root).
+			std::atomic<bool> m_pending; //!< A sample is requested by the timer.
+			std::atomic<bool> m_running; //!< The timer is started.
+			std::thread* m_timer; //!< Thread that request the samples.
+			int64_t m_period; //!< Sampling period in microseconds.
+			size_t m_nbSample; //!< Number of recorded samples.
+		public:
+			Profiler();
+			~Profiler();
+			/**
+			 * @brief Start the sampling.
+			 * @param[in] _frequency Number of samples per second.
+			 */
+			void start(int32_t _frequency=1000);
+			/**
+			 * @brief Stop the sampling (the recorded samples are kept).
+			 */
+			void stop();
+			bool isRunning() const {
+				return m_running;
+			}
+			/**
+			 * @brief Check if a sample is requested (called at the safe points).
+			 * @return true if the stack must be recorded.
+			 */
+			bool isPending() const {
+				return m_pending.load(std::memory_order_relaxed);
+			}
+			/**
+			 * @brief Record the call stack.
+			 * @param[in] _stack Value stack of the interpreter (its frames are the call stack).
+			 */
+			void sample(const eci::Stack& _stack);
+			size_t getNbSample() const {
+				return m_nbSample;
+			}
+			/**
+			 * @brief Get the recorded stacks in the folded format: one line per stack "frame;frame;frame count",
+			 * a frame is "function@file:line".
+			 * @param[in] _interpreter Interpreter that own the functions (for the name of their files).
+			 * @return The folded stacks.
+			 */
+			etk::String getFolded(const eci::Interpreter& _interpreter) const;
+		private:
+			void addFolded(const eci::Interpreter& _interpreter, size_t _node, const etk::String& _path, etk::String& _out) const;
+	};
+}
+
@@ -0,0 +1,56 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Registry.hpp>
+#include <eci/debug.hpp>
+
+eci::Registry::Registry() :
+  m_optimizationLevel(1) {
+	
+}
+
+eci::Registry::~Registry() {
+	
+}
+
+ememory::SharedPtr<const eci::Interpreter> eci::Registry::getModule(const etk::Vector<etk::String>& _files) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (auto &it : m_modules) {
+		if (it.first == _files) {
+			return it.second;
+		}
+	}
+	// the other threads wait the end of the load (a program is loaded once)
+	ememory::SharedPtr<eci::Interpreter> module = ememory::makeShared<eci::Interpreter>();
+	module->setOptimizationLevel(m_optimizationLevel);
+	for (auto &it : _files) {
+		module->addFile(it);
+	}
+	if (module->freeze() == false) {
+		ECI_ERROR("Can not create the module of : " << _files);
+		return null;
+	}
+	m_modules.pushBack(etk::makePair(_files, ememory::SharedPtr<const eci::Interpreter>(module)));
+	return module;
+}
+
+ememory::SharedPtr<eci::Interpreter> eci::Registry::create(const etk::Vector<etk::String>& _files) {
+	ememory::SharedPtr<const eci::Interpreter> module = getModule(_files);
+	if (module == null) {
+		return null;
+	}
+	return ememory::makeShared<eci::Interpreter>(module);
+}
+
+size_t eci::Registry::getNbModule() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_modules.size();
+}
+
+void eci::Registry::clear() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_modules.clear();
+}
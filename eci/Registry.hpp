@@ -0,0 +1,60 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/String.hpp>
+#include <etk/Vector.hpp>
+#include <etk/Pair.hpp>
+#include <ememory/memory.hpp>
+#include <eci/Interpreter.hpp>
+#include <mutex>
+
+namespace eci {
+	/**
+	 * @brief Modules of the programs already loaded: a program (list of files) is read, parsed, compiled and initialized once,
+	 * then the interpreters created for it share its code (see @ref eci::Interpreter::freeze). Can be used by several threads.
+	 */
+	class Registry {
+		private:
+			std::mutex m_mutex; //!< Protect the list of modules.
+			etk::Vector<etk::Pair<etk::Vector<etk::String>, ememory::SharedPtr<const eci::Interpreter>>> m_modules; //!< Modules by list of files.
+			int32_t m_optimizationLevel; //!< Optimization level of the next loaded modules.
+		public:
+			Registry();
+			~Registry();
+			/**
+			 * @brief Set the optimization level of the next loaded modules.
+			 * @param[in] _level New level (0 disable the optimizer).
+			 */
+			void setOptimizationLevel(int32_t _level) {
+				m_optimizationLevel = _level;
+			}
+			/**
+			 * @brief Get the module of a program (loaded on the first request).
+			 * @param[in] _files Files of the program (in the load order).
+			 * @return The module or null if the program has errors.
+			 */
+			ememory::SharedPtr<const eci::Interpreter> getModule(const etk::Vector<etk::String>& _files);
+			/**
+			 * @brief Create an interpreter on the module of a program.
+			 * @param[in] _files Files of the program (in the load order).
+			 * @return The new interpreter or null if the program has errors.
+			 */
+			ememory::SharedPtr<eci::Interpreter> create(const etk::Vector<etk::String>& _files);
+			/**
+			 * @brief Get the number of loaded modules.
+			 * @return Number of module.
+			 */
+			size_t getNbModule();
+			/**
+			 * @brief Remove all the modules (the interpreters created on them keep their module).
+			 */
+			void clear();
+	};
+}
+
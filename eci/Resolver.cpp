@@ -0,0 +1,451 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Resolver.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/debug.hpp>
+
+/**
+ * @brief Compute a constant expression ("12", "-1", "'a'", "1 << 4" ...).
+ * @param[in] _element Expression.
+ * @return The Constant element of the value (null if the expression is not constant).
+ */
+static ememory::SharedPtr<eci::interpreter::Element> getConstantExpression(const ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	if (_element == null) {
+		return null;
+	}
+	if (_element->getTockenId() == eci::interpreter::typeConstant) {
+		return _element;
+	}
+	if (_element->getTockenId() == eci::interpreter::typeCast) {
+		eci::interpreter::Cast* element = static_cast<eci::interpreter::Cast*>(_element.get());
+		ememory::SharedPtr<eci::interpreter::Element> value = getConstantExpression(element->m_value);
+		if (value == null) {
+			return null;
+		}
+		return ememory::makeShared<eci::interpreter::Constant>(static_cast<eci::interpreter::Constant*>(value.get())->m_value.convert(element->m_valueType));
+	}
+	if (_element->getTockenId() != eci::interpreter::typeOperator) {
+		return null;
+	}
+	eci::interpreter::Operator* element = static_cast<eci::interpreter::Operator*>(_element.get());
+	if (    eci::Resolver::getAssignDestination(ememory::staticPointerCast<eci::interpreter::Operator>(_element)) != null
+	     || element->m_right == null) {
+		return null;
+	}
+	ememory::SharedPtr<eci::interpreter::Element> right = getConstantExpression(element->m_right);
+	if (right == null) {
+		return null;
+	}
+	const eci::Value& rightValue = static_cast<eci::interpreter::Constant*>(right.get())->m_value;
+	if (element->m_left == null) {
+		return ememory::makeShared<eci::interpreter::Constant>(eci::callOperator(element->m_operatorId, rightValue));
+	}
+	ememory::SharedPtr<eci::interpreter::Element> left = getConstantExpression(element->m_left);
+	if (    left == null
+	     || (    (    element->m_operatorId == eci::operatorDiv
+	               || element->m_operatorId == eci::operatorMod)
+	          && rightValue.isTrue() == false)) {
+		return null;
+	}
+	return ememory::makeShared<eci::interpreter::Constant>(eci::callOperator(element->m_operatorId, static_cast<eci::interpreter::Constant*>(left.get())->m_value, rightValue));
+}
+
+eci::Resolver::Resolver(eci::Interpreter& _interpreter) :
+  m_interpreter(_interpreter),
+  m_frameSize(0),
+  m_global(false),
+  m_class(null) {
+	
+}
+
+eci::Resolver::~Resolver() {
+	
+}
+
+bool eci::Resolver::resolve(const ememory::SharedPtr<eci::Function>& _function) {
+	if (    _function == null
+	     || _function->getBody() == null) {
+		return true;
+	}
+	m_global = false;
+	m_class = _function->getClass();
+	m_locals.clear();
+	m_scopes.clear();
+	m_frameSize = 0;
+	pushScope();
+	// arguments are the first slots of the frame:
+	for (auto &it : _function->getArguments()) {
+		if (declareLocal(it.getName(), it.getConst()) < 0) {
+			ECI_ERROR("Function '" << _function->getName() << "' has 2 arguments named '" << it.getName() << "'");
+			return false;
+		}
+	}
+	bool ret = resolveBlock(_function->getBody());
+	popScope();
+	m_class = null;
+	_function->setFrameSize(m_frameSize);
+	ECI_DEBUG("Resolve function '" << _function->getName() << "' frame size=" << m_frameSize);
+	return ret;
+}
+
+bool eci::Resolver::resolveGlobal(const ememory::SharedPtr<eci::interpreter::Block>& _block) {
+	if (_block == null) {
+		return true;
+	}
+	m_global = true;
+	m_class = null;
+	m_locals.clear();
+	m_scopes.clear();
+	m_frameSize = 0;
+	bool ret = true;
+	for (auto &it : _block->m_actions) {
+		if (resolveElement(it) == false) {
+			ret = false;
+		}
+	}
+	m_global = false;
+	return ret;
+}
+
+void eci::Resolver::pushScope() {
+	m_scopes.pushBack(m_locals.size());
+}
+
+void eci::Resolver::popScope() {
+	if (m_scopes.size() == 0) {
+		ECI_ERROR("pop a scope that does not exist");
+		return;
+	}
+	// the slots of the scope can be reused by the next declaration
+	m_locals.resize(m_scopes.back());
+	m_scopes.popBack();
+}
+
+int32_t eci::Resolver::declareLocal(const etk::String& _name, bool _const) {
+	size_t start = 0;
+	if (m_scopes.size() != 0) {
+		start = m_scopes.back();
+	}
+	for (size_t iii=start; iii<m_locals.size(); ++iii) {
+		if (    _name != ""
+		     && m_locals[iii].first == _name) {
+			return -1;
+		}
+	}
+	int32_t slot = m_locals.size();
+	m_locals.pushBack(etk::makePair(_name, slot));
+	m_localsConst.resize(m_locals.size());
+	m_localsConst[slot] = _const;
+	m_frameSize = etk::max(m_frameSize, slot+1);
+	return slot;
+}
+
+bool eci::Resolver::isLocalConst(int32_t _slot) const {
+	if (    _slot < 0
+	     || _slot >= int32_t(m_localsConst.size())) {
+		return false;
+	}
+	return m_localsConst[_slot];
+}
+
+ememory::SharedPtr<eci::interpreter::Element> eci::Resolver::getAssignDestination(const ememory::SharedPtr<eci::interpreter::Operator>& _element) {
+	switch (_element->m_operatorId) {
+		case eci::operatorAssign:
+		case eci::operatorAssignAdd:
+		case eci::operatorAssignSub:
+		case eci::operatorAssignMul:
+		case eci::operatorAssignDiv:
+		case eci::operatorAssignMod:
+			return _element->m_left;
+		case eci::operatorIncrement:
+		case eci::operatorDecrement:
+			if (_element->m_left != null) {
+				return _element->m_left;
+			}
+			return _element->m_right;
+		default:
+			break;
+	}
+	return null;
+}
+
+int32_t eci::Resolver::findLocal(const etk::String& _name) const {
+	for (int32_t iii=int32_t(m_locals.size())-1; iii>=0; --iii) {
+		if (m_locals[iii].first == _name) {
+			return m_locals[iii].second;
+		}
+	}
+	return -1;
+}
+
+ememory::SharedPtr<eci::interpreter::Element> eci::Resolver::getThis() {
+	ememory::SharedPtr<eci::interpreter::Variable> element = ememory::makeShared<eci::interpreter::Variable>("this");
+	element->m_global = false;
+	element->m_slot = findLocal("this");
+	return element;
+}
+
+bool eci::Resolver::resolveBlock(const ememory::SharedPtr<eci::interpreter::Block>& _block) {
+	if (_block == null) {
+		return true;
+	}
+	bool ret = true;
+	pushScope();
+	for (auto &it : _block->m_actions) {
+		if (resolveElement(it) == false) {
+			ret = false;
+		}
+	}
+	popScope();
+	return ret;
+}
+
+bool eci::Resolver::resolveElement(ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	if (_element == null) {
+		return true;
+	}
+	switch (_element->getTockenId()) {
+		case eci::interpreter::typeBlock:
+			return resolveBlock(ememory::staticPointerCast<eci::interpreter::Block>(_element));
+		case eci::interpreter::typeVariable: {
+			ememory::SharedPtr<eci::interpreter::Variable> element = ememory::staticPointerCast<eci::interpreter::Variable>(_element);
+			element->m_slot = findLocal(element->m_name);
+			if (element->m_slot >= 0) {
+				element->m_global = false;
+				return true;
+			}
+			if (    m_class != null
+			     && m_class->findField(element->m_name) >= 0) {
+				// field of the current object
+				ememory::SharedPtr<eci::interpreter::Member> member = ememory::makeShared<eci::interpreter::Member>(element->m_name);
+				member->m_object = getThis();
+				_element = member;
+				return true;
+			}
+			element->m_slot = m_interpreter.findGlobal(element->m_name);
+			if (element->m_slot >= 0) {
+				element->m_global = true;
+				return true;
+			}
+			ECI_ERROR("Unknow variable : '" << element->m_name << "'");
+			return false;
+		}
+		case eci::interpreter::typeVariableDeclaration: {
+			ememory::SharedPtr<eci::interpreter::VariableDeclaration> element = ememory::staticPointerCast<eci::interpreter::VariableDeclaration>(_element);
+			element->m_valueType = eci::getValueType(element->m_typeName);
+			if (    element->m_valueType == eci::valueTypeObject
+			     && element->m_typeName.endWith("[]") == true) {
+				// reference on an array (created by the initialisation)
+				if (m_interpreter.getArrayClass(etk::String(element->m_typeName, 0, element->m_typeName.size()-2)) == null) {
+					ECI_ERROR("Unknow type '" << element->m_typeName << "' for the variable '" << element->m_name << "'");
+					return false;
+				}
+			} else if (element->m_valueType == eci::valueTypeObject) {
+				bool isPointer = element->m_typeName.endWith("*");
+				const eci::Class* type = m_interpreter.findClass(isPointer == true ? etk::String(element->m_typeName, 0, element->m_typeName.size()-1) : element->m_typeName);
+				if (type == null) {
+					ECI_ERROR("Unknow type '" << element->m_typeName << "' for the variable '" << element->m_name << "'");
+					return false;
+				}
+				// a pointer is null until it is set (the object of a class variable is created with the variable)
+				element->m_class = isPointer == true ? null : type;
+			}
+			// the initialisation can not use the variable itself
+			if (resolveElement(element->m_init) == false) {
+				return false;
+			}
+			if (m_global == true) {
+				element->m_global = true;
+				element->m_slot = m_interpreter.findGlobal(element->m_name);
+				if (element->m_slot < 0) {
+					ECI_ERROR("Global variable not registered : '" << element->m_name << "'");
+					return false;
+				}
+				return true;
+			}
+			element->m_global = false;
+			element->m_slot = declareLocal(element->m_name, element->m_const);
+			if (element->m_slot < 0) {
+				ECI_ERROR("Variable already declared in this scope : '" << element->m_name << "'");
+				return false;
+			}
+			return true;
+		}
+		case eci::interpreter::typeCondition: {
+			ememory::SharedPtr<eci::interpreter::Condition> element = ememory::staticPointerCast<eci::interpreter::Condition>(_element);
+			return    resolveElement(element->m_condition) == true
+			       && resolveBlock(element->m_block) == true
+			       && resolveBlock(element->m_blockElse) == true;
+		}
+		case eci::interpreter::typeFor: {
+			ememory::SharedPtr<eci::interpreter::For> element = ememory::staticPointerCast<eci::interpreter::For>(_element);
+			// variable declared in the init are only visible in the cycle
+			pushScope();
+			bool ret =    resolveElement(element->m_init) == true
+			           && resolveElement(element->m_condition) == true
+			           && resolveElement(element->m_increment) == true
+			           && resolveBlock(element->m_block) == true;
+			popScope();
+			return ret;
+		}
+		case eci::interpreter::typeWhile: {
+			ememory::SharedPtr<eci::interpreter::While> element = ememory::staticPointerCast<eci::interpreter::While>(_element);
+			return    resolveElement(element->m_condition) == true
+			       && resolveElement(element->m_action) == true;
+		}
+		case eci::interpreter::typeOperator: {
+			ememory::SharedPtr<eci::interpreter::Operator> element = ememory::staticPointerCast<eci::interpreter::Operator>(_element);
+			if (    resolveElement(element->m_left) == false
+			     || resolveElement(element->m_right) == false) {
+				return false;
+			}
+			ememory::SharedPtr<eci::interpreter::Element> destination = getAssignDestination(element);
+			if (    destination != null
+			     && destination->getTockenId() == eci::interpreter::typeVariable) {
+				ememory::SharedPtr<eci::interpreter::Variable> variable = ememory::staticPointerCast<eci::interpreter::Variable>(destination);
+				bool isConst = false;
+				if (variable->m_global == true) {
+					isConst = m_interpreter.getGlobalDescriptor(variable->m_slot)->getConst();
+				} else {
+					isConst = isLocalConst(variable->m_slot);
+				}
+				if (isConst == true) {
+					ECI_ERROR("Assignment of read-only variable '" << variable->m_name << "'");
+					return false;
+				}
+			}
+			return true;
+		}
+		case eci::interpreter::typeFunctionCall: {
+			ememory::SharedPtr<eci::interpreter::FunctionCall> element = ememory::staticPointerCast<eci::interpreter::FunctionCall>(_element);
+			if (    m_class != null
+			     && m_class->findMethod(element->m_name) >= 0) {
+				// method of the current object
+				ememory::SharedPtr<eci::interpreter::MethodCall> method = ememory::makeShared<eci::interpreter::MethodCall>(element->m_name);
+				method->m_object = getThis();
+				method->m_arguments = element->m_arguments;
+				_element = method;
+				return resolveElement(_element);
+			}
+			element->m_functionId = m_interpreter.findFunction(element->m_name);
+			if (element->m_functionId < 0) {
+				ECI_ERROR("Unknow function : '" << element->m_name << "'");
+				return false;
+			}
+			size_t nbArgument = m_interpreter.getFunction(element->m_functionId)->getArguments().size();
+			if (nbArgument != element->m_arguments.size()) {
+				ECI_ERROR("Function '" << element->m_name << "' need " << nbArgument << " argument(s) and get " << element->m_arguments.size());
+				return false;
+			}
+			bool ret = true;
+			for (auto &it : element->m_arguments) {
+				if (resolveElement(it) == false) {
+					ret = false;
+				}
+			}
+			return ret;
+		}
+		case eci::interpreter::typeCast: {
+			ememory::SharedPtr<eci::interpreter::Cast> element = ememory::staticPointerCast<eci::interpreter::Cast>(_element);
+			element->m_valueType = eci::getValueType(element->m_typeName);
+			return resolveElement(element->m_value);
+		}
+		case eci::interpreter::typeMember: {
+			ememory::SharedPtr<eci::interpreter::Member> element = ememory::staticPointerCast<eci::interpreter::Member>(_element);
+			// the field is searched at the execution (it depend on the class of the object)
+			return resolveElement(element->m_object);
+		}
+		case eci::interpreter::typeMethodCall: {
+			ememory::SharedPtr<eci::interpreter::MethodCall> element = ememory::staticPointerCast<eci::interpreter::MethodCall>(_element);
+			bool ret = resolveElement(element->m_object);
+			for (auto &it : element->m_arguments) {
+				if (resolveElement(it) == false) {
+					ret = false;
+				}
+			}
+			return ret;
+		}
+		case eci::interpreter::typeReturn: {
+			ememory::SharedPtr<eci::interpreter::Return> element = ememory::staticPointerCast<eci::interpreter::Return>(_element);
+			return resolveElement(element->m_value);
+		}
+		case eci::interpreter::typeNew: {
+			ememory::SharedPtr<eci::interpreter::New> element = ememory::staticPointerCast<eci::interpreter::New>(_element);
+			if (element->m_size != null) {
+				element->m_class = m_interpreter.getArrayClass(element->m_className);
+				if (element->m_class == null) {
+					ECI_ERROR("Can not create an array of '" << element->m_className << "'");
+					return false;
+				}
+				return resolveElement(element->m_size);
+			}
+			element->m_class = m_interpreter.findClass(element->m_className);
+			if (    element->m_class == null
+			     || element->m_class->isArray() == true) {
+				ECI_ERROR("Unknow class '" << element->m_className << "' after 'new'");
+				return false;
+			}
+			return true;
+		}
+		case eci::interpreter::typeIndex: {
+			ememory::SharedPtr<eci::interpreter::Index> element = ememory::staticPointerCast<eci::interpreter::Index>(_element);
+			return    resolveElement(element->m_object) == true
+			       && resolveElement(element->m_index) == true;
+		}
+		case eci::interpreter::typeDelete: {
+			ememory::SharedPtr<eci::interpreter::Delete> element = ememory::staticPointerCast<eci::interpreter::Delete>(_element);
+			return resolveElement(element->m_value);
+		}
+		case eci::interpreter::typeSwitch: {
+			ememory::SharedPtr<eci::interpreter::Switch> element = ememory::staticPointerCast<eci::interpreter::Switch>(_element);
+			if (resolveElement(element->m_value) == false) {
+				return false;
+			}
+			for (auto &it : element->m_cases) {
+				if (resolveElement(it.m_value) == false) {
+					return false;
+				}
+				ememory::SharedPtr<eci::interpreter::Element> value = getConstantExpression(it.m_value);
+				if (value == null) {
+					ECI_ERROR("The value of a 'case' must be a constant expression");
+					return false;
+				}
+				it.m_value = value;
+			}
+			// all the blocks are in the scope of the switch (as the C++ labels)
+			bool ret = true;
+			pushScope();
+			for (auto &itBlock : element->m_blocks) {
+				for (auto &it : itBlock->m_actions) {
+					if (resolveElement(it) == false) {
+						ret = false;
+					}
+				}
+			}
+			popScope();
+			return    ret == true
+			       && element->prepare() == true;
+		}
+		case eci::interpreter::typeLiteral: {
+			ememory::SharedPtr<eci::interpreter::Literal> element = ememory::staticPointerCast<eci::interpreter::Literal>(_element);
+			if (m_interpreter.findClass("string") == null) {
+				ECI_ERROR("A string literal need the library : '#import <eci/container>'");
+				return false;
+			}
+			element->m_slot = m_interpreter.addLiteral(element->m_value);
+			return true;
+		}
+		case eci::interpreter::typeConstant:
+		case eci::interpreter::typeBreak:
+		case eci::interpreter::typeContinue:
+			return true;
+		default:
+			break;
+	}
+	ECI_ERROR("Can not resolve element type : " << _element->getTockenId());
+	return false;
+}
@@ -0,0 +1,66 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/Pair.hpp>
+#include <etk/Vector.hpp>
+#include <eci/Function.hpp>
+#include <eci/interpreter/Element.hpp>
+
+namespace eci {
+	class Interpreter;
+	/**
+	 * @brief Link step: transform all the names of the parsed elements in index.
+	 * Local variable get a slot in the frame of the function, global variable get
+	 * a slot in the global table of the interpreter and function call get the index
+	 * of the function. In a method, the fields and the methods used without object are
+	 * replaced by an access on "this". After this pass the execution only search the
+	 * members of an object by name (once per class, see @ref eci::InlineCache).
+	 */
+	class Resolver {
+		private:
+			eci::Interpreter& m_interpreter; //!< Interpreter that store the global table and the function list.
+			etk::Vector<etk::Pair<etk::String, int32_t>> m_locals; //!< All local variable visible at the current position (name, slot).
+			etk::Vector<bool> m_localsConst; //!< The local variable of each slot is const.
+			etk::Vector<size_t> m_scopes; //!< Size of m_locals at the start of each open scope.
+			int32_t m_frameSize; //!< Max number of slot used in the current function.
+			bool m_global; //!< Resolve the global initialisation (declaration are global).
+			const eci::Class* m_class; //!< Class of the resolved method (null for a function).
+		public:
+			Resolver(eci::Interpreter& _interpreter);
+			~Resolver();
+			/**
+			 * @brief Resolve the body of a function and set its frame size.
+			 * @param[in] _function Function to resolve.
+			 * @return true if all names are resolved.
+			 */
+			bool resolve(const ememory::SharedPtr<eci::Function>& _function);
+			/**
+			 * @brief Resolve the global initialisation of a file (declaration are set in the global table).
+			 * @param[in] _block Initialisation block of the file.
+			 * @return true if all names are resolved.
+			 */
+			bool resolveGlobal(const ememory::SharedPtr<eci::interpreter::Block>& _block);
+		private:
+			bool resolveElement(ememory::SharedPtr<eci::interpreter::Element>& _element);
+			bool resolveBlock(const ememory::SharedPtr<eci::interpreter::Block>& _block);
+			ememory::SharedPtr<eci::interpreter::Element> getThis();
+			void pushScope();
+			void popScope();
+			int32_t declareLocal(const etk::String& _name, bool _const=false);
+			int32_t findLocal(const etk::String& _name) const;
+			bool isLocalConst(int32_t _slot) const;
+		public:
+			/**
+			 * @brief Get the element modified by an operator.
+			 * @param[in] _element Operator element.
+			 * @return The modified element (null if the operator does not modify an element).
+			 */
+			static ememory::SharedPtr<eci::interpreter::Element> getAssignDestination(const ememory::SharedPtr<eci::interpreter::Operator>& _element);
+	};
+}
@@ -0,0 +1,924 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Snapshot.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/debug.hpp>
+#include <etk/Map.hpp>
+#include <stdio.h>
+#ifndef _WIN32
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+static const char* const imageMagic = "ECIIMAGE"; //!< First bytes of an image.
+static const size_t imageMagicSize = 8;
+static const size_t imageHeaderSize = imageMagicSize + 4 + 8; //!< Magic, version and checksum of the data.
+
+/**
+ * @brief Compute the checksum of the data of an image (FNV-1a): the content of a valid image is not checked again.
+ * @param[in] _data Data after the header.
+ * @param[in] _size Size of the data.
+ * @return The checksum.
+ */
+static uint64_t getChecksum(const uint8_t* _data, size_t _size) {
+	uint64_t out = 14695981039346656037ULL;
+	for (size_t iii=0; iii<_size; ++iii) {
+		out = (out ^ _data[iii]) * 1099511628211ULL;
+	}
+	return out;
+}
+
+/**
+ * @brief Serialize the program in a buffer (little endian, the pointers are replaced by indexes).
+ */
+class ImageWriter {
+	public:
+		etk::Vector<uint8_t> m_data; //!< Image.
+		etk::Map<const eci::Class*, int32_t> m_classIds; //!< Index of the classes.
+		etk::Map<const eci::Object*, int32_t> m_objectIds; //!< Index of the objects reachable from the global variables.
+		etk::Vector<const eci::Object*> m_objects; //!< Objects in the index order.
+		bool m_valid; //!< All the data can be stored.
+	public:
+		ImageWriter() :
+		  m_valid(true) {
+			
+		}
+		void addUInt64(uint64_t _value) {
+			for (int32_t iii=0; iii<8; ++iii) {
+				m_data.pushBack(uint8_t(_value >> (iii*8)));
+			}
+		}
+		void addInt32(int32_t _value) {
+			uint32_t value = uint32_t(_value);
+			for (int32_t iii=0; iii<4; ++iii) {
+				m_data.pushBack(uint8_t(value >> (iii*8)));
+			}
+		}
+		void addBool(bool _value) {
+			m_data.pushBack(_value == true ? 1 : 0);
+		}
+		void addString(const etk::String& _value) {
+			addInt32(_value.size());
+			for (size_t iii=0; iii<_value.size(); ++iii) {
+				m_data.pushBack(uint8_t(_value[iii]));
+			}
+		}
+		void addVariable(const eci::Variable& _value) {
+			addString(_value.getName());
+			addString(_value.getTypeName());
+			addBool(_value.getConst());
+			addInt32(_value.getVisibility());
+		}
+		void addClass(const eci::Class* _value) {
+			if (_value == null) {
+				addInt32(-1);
+				return;
+			}
+			if (m_classIds.exist(_value) == false) {
+				ECI_ERROR("Image: class '" << _value->getName() << "' is not registered");
+				m_valid = false;
+				addInt32(-1);
+				return;
+			}
+			addInt32(m_classIds[_value]);
+		}
+		/**
+		 * @brief Register an object and all the objects it references (breadth first: a long list does not use the native stack).
+		 * @param[in] _value Value to scan.
+		 */
+		void collect(const eci::Value& _value) {
+			size_t pos = m_objects.size();
+			collectObject(_value);
+			while (pos < m_objects.size()) {
+				const eci::Object* object = m_objects[pos++];
+				for (size_t iii=0; iii<object->m_nbField; ++iii) {
+					collectObject(object->m_fields[iii]);
+				}
+			}
+		}
+		void collectObject(const eci::Value& _value) {
+			if (    _value.m_type != eci::valueTypeObject
+			     || _value.m_object == null
+			     || _value.m_object->m_fields == null
+			     || m_objectIds.exist(_value.m_object) == true) {
+				return;
+			}
+			m_objectIds.add(_value.m_object, m_objects.size());
+			m_objects.pushBack(_value.m_object);
+		}
+		void addValue(const eci::Value& _value) {
+			addInt32(_value.m_type);
+			if (_value.m_type != eci::valueTypeObject) {
+				addUInt64(_value.m_uint64);
+				return;
+			}
+			// a deleted object become null
+			if (    _value.m_object == null
+			     || m_objectIds.exist(_value.m_object) == false) {
+				addInt32(-1);
+				return;
+			}
+			addInt32(m_objectIds[_value.m_object]);
+		}
+		void addElements(const etk::Vector<ememory::SharedPtr<eci::interpreter::Element>>& _value) {
+			addInt32(_value.size());
+			for (auto &it : _value) {
+				addElement(it);
+			}
+		}
+		void addElement(const ememory::SharedPtr<eci::interpreter::Element>& _value);
+};
+
+void ImageWriter::addElement(const ememory::SharedPtr<eci::interpreter::Element>& _value) {
+	if (_value == null) {
+		addInt32(-1);
+		return;
+	}
+	addInt32(_value->getTockenId());
+	switch (_value->getTockenId()) {
+		case eci::interpreter::typeBlock: {
+			eci::interpreter::Block* element = static_cast<eci::interpreter::Block*>(_value.get());
+			addElements(element->m_actions);
+			return;
+		}
+		case eci::interpreter::typeVariable: {
+			eci::interpreter::Variable* element = static_cast<eci::interpreter::Variable*>(_value.get());
+			addString(element->m_name);
+			addBool(element->m_global);
+			addInt32(element->m_slot);
+			return;
+		}
+		case eci::interpreter::typeVariableDeclaration: {
+			eci::interpreter::VariableDeclaration* element = static_cast<eci::interpreter::VariableDeclaration*>(_value.get());
+			addString(element->m_name);
+			addString(element->m_typeName);
+			addBool(element->m_const);
+			addInt32(element->m_valueType);
+			addClass(element->m_class);
+			addElement(element->m_init);
+			addBool(element->m_global);
+			addInt32(element->m_slot);
+			return;
+		}
+		case eci::interpreter::typeCondition: {
+			eci::interpreter::Condition* element = static_cast<eci::interpreter::Condition*>(_value.get());
+			addElement(element->m_condition);
+			addElement(element->m_block);
+			addElement(element->m_blockElse);
+			return;
+		}
+		case eci::interpreter::typeFor: {
+			eci::interpreter::For* element = static_cast<eci::interpreter::For*>(_value.get());
+			addElement(element->m_init);
+			addElement(element->m_condition);
+			addElement(element->m_increment);
+			addElement(element->m_block);
+			return;
+		}
+		case eci::interpreter::typeWhile: {
+			eci::interpreter::While* element = static_cast<eci::interpreter::While*>(_value.get());
+			addBool(element->m_conditionAtStart);
+			addElement(element->m_condition);
+			addElement(element->m_action);
+			return;
+		}
+		case eci::interpreter::typeOperator: {
+			eci::interpreter::Operator* element = static_cast<eci::interpreter::Operator*>(_value.get());
+			// the id is computed again from the name
+			addString(element->m_operator);
+			addElement(element->m_left);
+			addElement(element->m_right);
+			return;
+		}
+		case eci::interpreter::typeConstant: {
+			eci::interpreter::Constant* element = static_cast<eci::interpreter::Constant*>(_value.get());
+			if (    element->m_value.m_type == eci::valueTypeObject
+			     && element->m_value.m_object != null) {
+				ECI_ERROR("Image: constant object can not be stored");
+				m_valid = false;
+			}
+			addValue(element->m_value);
+			return;
+		}
+		case eci::interpreter::typeFunctionCall: {
+			eci::interpreter::FunctionCall* element = static_cast<eci::interpreter::FunctionCall*>(_value.get());
+			addString(element->m_name);
+			addElements(element->m_arguments);
+			addInt32(element->m_functionId);
+			return;
+		}
+		case eci::interpreter::typeReturn: {
+			eci::interpreter::Return* element = static_cast<eci::interpreter::Return*>(_value.get());
+			addElement(element->m_value);
+			addBool(element->m_tailCall);
+			return;
+		}
+		case eci::interpreter::typeBreak:
+		case eci::interpreter::typeContinue:
+			return;
+		case eci::interpreter::typeCast: {
+			eci::interpreter::Cast* element = static_cast<eci::interpreter::Cast*>(_value.get());
+			addString(element->m_typeName);
+			addInt32(element->m_valueType);
+			addElement(element->m_value);
+			return;
+		}
+		case eci::interpreter::typeMember: {
+			// the inline cache start empty
+			eci::interpreter::Member* element = static_cast<eci::interpreter::Member*>(_value.get());
+			addElement(element->m_object);
+			addString(element->m_name);
+			return;
+		}
+		case eci::interpreter::typeMethodCall: {
+			eci::interpreter::MethodCall* element = static_cast<eci::interpreter::MethodCall*>(_value.get());
+			addElement(element->m_object);
+			addString(element->m_name);
+			addElements(element->m_arguments);
+			return;
+		}
+		case eci::interpreter::typeNew: {
+			eci::interpreter::New* element = static_cast<eci::interpreter::New*>(_value.get());
+			addString(element->m_className);
+			addClass(element->m_class);
+			addElement(element->m_size);
+			return;
+		}
+		case eci::interpreter::typeIndex: {
+			eci::interpreter::Index* element = static_cast<eci::interpreter::Index*>(_value.get());
+			addElement(element->m_object);
+			addElement(element->m_index);
+			return;
+		}
+		case eci::interpreter::typeLiteral:
+			// the slot is given again by the interpreter that load the image
+			addString(static_cast<eci::interpreter::Literal*>(_value.get())->m_value);
+			return;
+		case eci::interpreter::typeDelete: {
+			eci::interpreter::Delete* element = static_cast<eci::interpreter::Delete*>(_value.get());
+			addElement(element->m_value);
+			return;
+		}
+		case eci::interpreter::typeSwitch: {
+			// the dispatch is created again from the labels
+			eci::interpreter::Switch* element = static_cast<eci::interpreter::Switch*>(_value.get());
+			addElement(element->m_value);
+			addInt32(element->m_blocks.size());
+			for (auto &it : element->m_blocks) {
+				addElement(it);
+			}
+			addInt32(element->m_cases.size());
+			for (auto &it : element->m_cases) {
+				addElement(it.m_value);
+				addInt32(it.m_block);
+			}
+			addInt32(element->m_default);
+			return;
+		}
+		default:
+			ECI_ERROR("Image: element " << _value->getTockenId() << " can not be stored");
+			m_valid = false;
+			return;
+	}
+}
+
+/**
+ * @brief Read an image (all the reads are checked: a truncated or corrupted image set the reader invalid).
+ */
+class ImageReader {
+	public:
+		const uint8_t* m_data; //!< Image.
+		size_t m_size; //!< Size of the image.
+		size_t m_pos; //!< Position of the next read.
+		bool m_valid; //!< No error since the start.
+		etk::Vector<eci::Class*> m_classes; //!< Classes by index.
+		etk::Vector<eci::Object*> m_objects; //!< Objects by index.
+		eci::Interpreter* m_interpreter; //!< Interpreter that load the image (slots of the literals).
+	public:
+		ImageReader(const uint8_t* _data, size_t _size, eci::Interpreter* _interpreter) :
+		  m_data(_data),
+		  m_size(_size),
+		  m_pos(0),
+		  m_valid(true),
+		  m_interpreter(_interpreter) {
+			
+		}
+		bool check(size_t _size) {
+			if (    m_valid == false
+			     || _size > m_size - m_pos) {
+				m_valid = false;
+				return false;
+			}
+			return true;
+		}
+		uint64_t getUInt64() {
+			if (check(8) == false) {
+				return 0;
+			}
+			uint64_t out = 0;
+			for (int32_t iii=0; iii<8; ++iii) {
+				out |= uint64_t(m_data[m_pos++]) << (iii*8);
+			}
+			return out;
+		}
+		int32_t getInt32() {
+			if (check(4) == false) {
+				return 0;
+			}
+			uint32_t out = 0;
+			for (int32_t iii=0; iii<4; ++iii) {
+				out |= uint32_t(m_data[m_pos++]) << (iii*8);
+			}
+			return int32_t(out);
+		}
+		/**
+		 * @brief Read a number of elements (each element use at least one byte: a bigger number is a corruption).
+		 */
+		size_t getCount() {
+			int32_t out = getInt32();
+			if (    out < 0
+			     || check(size_t(out)) == false) {
+				m_valid = false;
+				return 0;
+			}
+			return size_t(out);
+		}
+		bool getBool() {
+			if (check(1) == false) {
+				return false;
+			}
+			return m_data[m_pos++] != 0;
+		}
+		etk::String getString() {
+			size_t size = getCount();
+			if (size == 0) {
+				return "";
+			}
+			etk::String out;
+			for (size_t iii=0; iii<size; ++iii) {
+				out += char(m_data[m_pos++]);
+			}
+			return out;
+		}
+		enum eci::valueType getValueType() {
+			int32_t out = getInt32();
+			if (    out < eci::valueTypeVoid
+			     || out > eci::valueTypeObject) {
+				m_valid = false;
+				return eci::valueTypeVoid;
+			}
+			return eci::valueType(out);
+		}
+		eci::Variable getVariable() {
+			etk::String name = getString();
+			eci::Variable out(name, getString());
+			out.setConst(getBool());
+			out.setVisibility(eci::visibility(getInt32()));
+			return out;
+		}
+		eci::Class* getClass() {
+			int32_t id = getInt32();
+			if (id < 0) {
+				return null;
+			}
+			if (size_t(id) >= m_classes.size()) {
+				m_valid = false;
+				return null;
+			}
+			return m_classes[id];
+		}
+		eci::Value getValue() {
+			enum eci::valueType type = getValueType();
+			if (type != eci::valueTypeObject) {
+				eci::Value out;
+				out.m_type = type;
+				out.m_uint64 = getUInt64();
+				return out;
+			}
+			int32_t id = getInt32();
+			if (id < 0) {
+				return eci::Value(static_cast<eci::Object*>(null));
+			}
+			if (size_t(id) >= m_objects.size()) {
+				m_valid = false;
+				return eci::Value(static_cast<eci::Object*>(null));
+			}
+			return eci::Value(m_objects[id]);
+		}
+		void getElements(etk::Vector<ememory::SharedPtr<eci::interpreter::Element>>& _value) {
+			size_t size = getCount();
+			for (size_t iii=0; iii<size; ++iii) {
+				_value.pushBack(getElement());
+			}
+		}
+		ememory::SharedPtr<eci::interpreter::Block> getBlock() {
+			ememory::SharedPtr<eci::interpreter::Element> element = getElement();
+			if (element == null) {
+				return null;
+			}
+			if (element->getTockenId() != eci::interpreter::typeBlock) {
+				m_valid = false;
+				return null;
+			}
+			return ememory::staticPointerCast<eci::interpreter::Block>(element);
+		}
+		ememory::SharedPtr<eci::interpreter::Element> getElement();
+};
+
+ememory::SharedPtr<eci::interpreter::Element> ImageReader::getElement() {
+	int32_t type = getInt32();
+	if (    type < 0
+	     || m_valid == false) {
+		return null;
+	}
+	switch (type) {
+		case eci::interpreter::typeBlock: {
+			ememory::SharedPtr<eci::interpreter::Block> element = ememory::makeShared<eci::interpreter::Block>();
+			getElements(element->m_actions);
+			return element;
+		}
+		case eci::interpreter::typeVariable: {
+			ememory::SharedPtr<eci::interpreter::Variable> element = ememory::makeShared<eci::interpreter::Variable>(getString());
+			element->m_global = getBool();
+			element->m_slot = getInt32();
+			return element;
+		}
+		case eci::interpreter::typeVariableDeclaration: {
+			ememory::SharedPtr<eci::interpreter::VariableDeclaration> element = ememory::makeShared<eci::interpreter::VariableDeclaration>();
+			element->m_name = getString();
+			element->m_typeName = getString();
+			element->m_const = getBool();
+			element->m_valueType = getValueType();
+			element->m_class = getClass();
+			element->m_init = getElement();
+			element->m_global = getBool();
+			element->m_slot = getInt32();
+			return element;
+		}
+		case eci::interpreter::typeCondition: {
+			ememory::SharedPtr<eci::interpreter::Condition> element = ememory::makeShared<eci::interpreter::Condition>();
+			element->m_condition = getElement();
+			element->m_block = getBlock();
+			element->m_blockElse = getBlock();
+			return element;
+		}
+		case eci::interpreter::typeFor: {
+			ememory::SharedPtr<eci::interpreter::For> element = ememory::makeShared<eci::interpreter::For>();
+			element->m_init = getElement();
+			element->m_condition = getElement();
+			element->m_increment = getElement();
+			element->m_block = getBlock();
+			// the counted loop is selected again with the loaded elements
+			if (element->m_block != null) {
+				element->findInduction();
+			}
+			return element;
+		}
+		case eci::interpreter::typeWhile: {
+			ememory::SharedPtr<eci::interpreter::While> element = ememory::makeShared<eci::interpreter::While>();
+			element->m_conditionAtStart = getBool();
+			element->m_condition = getElement();
+			element->m_action = getElement();
+			return element;
+		}
+		case eci::interpreter::typeOperator: {
+			ememory::SharedPtr<eci::interpreter::Operator> element = ememory::makeShared<eci::interpreter::Operator>(getString());
+			element->m_left = getElement();
+			element->m_right = getElement();
+			// the superinstruction is selected again with the loaded operands
+			element->fuse();
+			return element;
+		}
+		case eci::interpreter::typeConstant:
+			return ememory::makeShared<eci::interpreter::Constant>(getValue());
+		case eci::interpreter::typeFunctionCall: {
+			ememory::SharedPtr<eci::interpreter::FunctionCall> element = ememory::makeShared<eci::interpreter::FunctionCall>(getString());
+			getElements(element->m_arguments);
+			element->m_functionId = getInt32();
+			return element;
+		}
+		case eci::interpreter::typeReturn: {
+			ememory::SharedPtr<eci::interpreter::Return> element = ememory::makeShared<eci::interpreter::Return>();
+			element->m_value = getElement();
+			element->m_tailCall = getBool();
+			if (    element->m_tailCall == true
+			     && (    element->m_value == null
+			          || element->m_value->getTockenId() != eci::interpreter::typeFunctionCall)) {
+				m_valid = false;
+				return null;
+			}
+			return element;
+		}
+		case eci::interpreter::typeBreak:
+			return ememory::makeShared<eci::interpreter::Break>();
+		case eci::interpreter::typeContinue:
+			return ememory::makeShared<eci::interpreter::Continue>();
+		case eci::interpreter::typeCast: {
+			ememory::SharedPtr<eci::interpreter::Cast> element = ememory::makeShared<eci::interpreter::Cast>(getString());
+			element->m_valueType = getValueType();
+			element->m_value = getElement();
+			return element;
+		}
+		case eci::interpreter::typeMember: {
+			ememory::SharedPtr<eci::interpreter::Element> object = getElement();
+			ememory::SharedPtr<eci::interpreter::Member> element = ememory::makeShared<eci::interpreter::Member>(getString());
+			element->m_object = object;
+			return element;
+		}
+		case eci::interpreter::typeMethodCall: {
+			ememory::SharedPtr<eci::interpreter::Element> object = getElement();
+			ememory::SharedPtr<eci::interpreter::MethodCall> element = ememory::makeShared<eci::interpreter::MethodCall>(getString());
+			element->m_object = object;
+			getElements(element->m_arguments);
+			return element;
+		}
+		case eci::interpreter::typeNew: {
+			ememory::SharedPtr<eci::interpreter::New> element = ememory::makeShared<eci::interpreter::New>(getString());
+			element->m_class = getClass();
+			element->m_size = getElement();
+			return element;
+		}
+		case eci::interpreter::typeIndex: {
+			ememory::SharedPtr<eci::interpreter::Index> element = ememory::makeShared<eci::interpreter::Index>();
+			element->m_object = getElement();
+			element->m_index = getElement();
+			return element;
+		}
+		case eci::interpreter::typeLiteral: {
+			ememory::SharedPtr<eci::interpreter::Literal> element = ememory::makeShared<eci::interpreter::Literal>(getString());
+			element->m_slot = m_interpreter->addLiteral(element->m_value);
+			return element;
+		}
+		case eci::interpreter::typeDelete: {
+			ememory::SharedPtr<eci::interpreter::Delete> element = ememory::makeShared<eci::interpreter::Delete>();
+			element->m_value = getElement();
+			return element;
+		}
+		case eci::interpreter::typeSwitch: {
+			ememory::SharedPtr<eci::interpreter::Switch> element = ememory::makeShared<eci::interpreter::Switch>();
+			element->m_value = getElement();
+			size_t nbBlock = getCount();
+			for (size_t iii=0; iii<nbBlock; ++iii) {
+				ememory::SharedPtr<eci::interpreter::Block> block = getBlock();
+				if (block == null) {
+					m_valid = false;
+					return null;
+				}
+				element->m_blocks.pushBack(block);
+			}
+			size_t nbCase = getCount();
+			for (size_t iii=0; iii<nbCase; ++iii) {
+				ememory::SharedPtr<eci::interpreter::Element> value = getElement();
+				element->m_cases.pushBack(eci::interpreter::Switch::Case(value, getInt32()));
+			}
+			element->m_default = getInt32();
+			for (auto &it : element->m_cases) {
+				if (    it.m_block < 0
+				     || size_t(it.m_block) >= nbBlock) {
+					m_valid = false;
+				}
+			}
+			if (    element->m_value == null
+			     || element->m_default < -1
+			     || element->m_default >= int32_t(nbBlock)
+			     || m_valid == false
+			     || element->prepare() == false) {
+				m_valid = false;
+				return null;
+			}
+			return element;
+		}
+		default:
+			m_valid = false;
+			return null;
+	}
+}
+
+bool eci::Snapshot::save(const eci::Interpreter& _interpreter, const etk::String& _filename) {
+	if (_interpreter.m_frozen == false) {
+		ECI_ERROR("Image: the program must be a module (bodies compiled and globals initialized) : '" << _filename << "'");
+		return false;
+	}
+	ImageWriter writer;
+	for (size_t iii=0; iii<imageMagicSize; ++iii) {
+		writer.m_data.pushBack(uint8_t(imageMagic[iii]));
+	}
+	writer.addInt32(eci::Snapshot::version);
+	// set when all the data are written
+	writer.addUInt64(0);
+	writer.addInt32(_interpreter.m_libraries.size());
+	for (auto &it : _interpreter.m_libraries) {
+		writer.addString(it->getName());
+	}
+	writer.addInt32(_interpreter.m_files.size());
+	for (auto &it : _interpreter.m_files) {
+		writer.addString(it->getName());
+		writer.addInt32(it->getImports().size());
+		for (auto &it2 : it->getImports()) {
+			writer.addString(it2);
+		}
+	}
+	// all the classes and functions are created before their content (they reference each other)
+	writer.addInt32(_interpreter.m_classes.size());
+	for (size_t iii=0; iii<_interpreter.m_classes.size(); ++iii) {
+		writer.m_classIds.add(_interpreter.m_classes[iii].get(), iii);
+		writer.addString(_interpreter.m_classes[iii]->getName());
+	}
+	writer.addInt32(_interpreter.m_functions.size());
+	for (auto &it : _interpreter.m_functions) {
+		writer.addString(it->getName());
+		writer.addInt32(it->getLine());
+		writer.addBool(it->getConst());
+		writer.addBool(it->getStatic());
+		writer.addInt32(it->getVisibility());
+		writer.addInt32(it->getReturn().size());
+		for (auto &it2 : it->getReturn()) {
+			writer.addVariable(it2);
+		}
+		writer.addInt32(it->getArguments().size());
+		for (auto &it2 : it->getArguments()) {
+			writer.addVariable(it2);
+		}
+		writer.addInt32(it->getFrameSize());
+		writer.addClass(it->getClass());
+		writer.addElement(it->getBody());
+	}
+	for (auto &it : _interpreter.m_classes) {
+		writer.addString(it->getParentName());
+		writer.addString(it->getElementTypeName());
+		writer.addInt32(it->getFields().size());
+		for (auto &it2 : it->getFields()) {
+			writer.addVariable(it2);
+		}
+		// the methods are found by name when the class is defined
+		writer.addInt32(it->getMethods().size());
+		for (auto &it2 : it->getMethods()) {
+			writer.addInt32(_interpreter.findFunction(it2->getName()));
+		}
+	}
+	writer.addInt32(_interpreter.m_globals.size());
+	for (auto &it : _interpreter.m_globals) {
+		writer.addVariable(*it);
+	}
+	for (auto &it : _interpreter.m_globalValues) {
+		writer.collect(it);
+	}
+	writer.addInt32(writer.m_objects.size());
+	for (auto &it : writer.m_objects) {
+		writer.addClass(it->m_class);
+		writer.addInt32(it->m_nbField);
+	}
+	for (auto &it : writer.m_objects) {
+		for (size_t iii=0; iii<it->m_nbField; ++iii) {
+			writer.addValue(it->m_fields[iii]);
+		}
+	}
+	for (auto &it : _interpreter.m_globalValues) {
+		writer.addValue(it);
+	}
+	if (writer.m_valid == false) {
+		ECI_ERROR("Image: the program can not be stored : '" << _filename << "'");
+		return false;
+	}
+	uint64_t checksum = getChecksum(&writer.m_data[imageHeaderSize], writer.m_data.size() - imageHeaderSize);
+	for (int32_t iii=0; iii<8; ++iii) {
+		writer.m_data[imageHeaderSize-8+iii] = uint8_t(checksum >> (iii*8));
+	}
+	FILE* file = fopen(_filename.c_str(), "wb");
+	if (file == null) {
+		ECI_ERROR("Image: can not open file : '" << _filename << "'");
+		return false;
+	}
+	bool ret = fwrite(&writer.m_data[0], 1, writer.m_data.size(), file) == writer.m_data.size();
+	if (fclose(file) != 0) {
+		ret = false;
+	}
+	if (ret == false) {
+		ECI_ERROR("Image: can not write file : '" << _filename << "'");
+		return false;
+	}
+	ECI_DEBUG("Image: write " << writer.m_data.size() << " bytes (" << writer.m_objects.size() << " objects) in '" << _filename << "'");
+	return true;
+}
+
+bool eci::Snapshot::load(eci::Interpreter& _interpreter, const etk::String& _filename) {
+	if (    _interpreter.m_files.size() != 0
+	     || _interpreter.m_functions.size() != 0
+	     || _interpreter.m_globals.size() != 0
+	     || _interpreter.m_classes.size() != 0) {
+		ECI_ERROR("Image: the interpreter already has a program : '" << _filename << "'");
+		return false;
+	}
+	#ifndef _WIN32
+		int fd = open(_filename.c_str(), O_RDONLY);
+		if (fd < 0) {
+			ECI_ERROR("Image: can not open file : '" << _filename << "'");
+			return false;
+		}
+		struct stat info;
+		if (    fstat(fd, &info) != 0
+		     || info.st_size == 0) {
+			ECI_ERROR("Image: can not read file : '" << _filename << "'");
+			close(fd);
+			return false;
+		}
+		// the pages are read on demand (no copy of the file)
+		void* data = mmap(null, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (data == MAP_FAILED) {
+			ECI_ERROR("Image: can not map file : '" << _filename << "'");
+			return false;
+		}
+		bool ret = loadData(_interpreter, static_cast<const uint8_t*>(data), info.st_size);
+		munmap(data, info.st_size);
+	#else
+		etk::Vector<uint8_t> data;
+		FILE* file = fopen(_filename.c_str(), "rb");
+		if (file == null) {
+			ECI_ERROR("Image: can not open file : '" << _filename << "'");
+			return false;
+		}
+		uint8_t buffer[4096];
+		size_t size;
+		while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+			for (size_t iii=0; iii<size; ++iii) {
+				data.pushBack(buffer[iii]);
+			}
+		}
+		fclose(file);
+		bool ret = loadData(_interpreter, data.size() == 0 ? null : &data[0], data.size());
+	#endif
+	if (ret == false) {
+		ECI_ERROR("Image: corrupted or incompatible file : '" << _filename << "'");
+		// nothing of the image can be used
+		_interpreter.m_files.clear();
+		_interpreter.m_functions.clear();
+		_interpreter.m_globals.clear();
+		_interpreter.m_globalValues.clear();
+		_interpreter.m_classes.clear();
+		_interpreter.m_libraries.clear();
+		_interpreter.m_literals.clear();
+		_interpreter.m_literalValues.clear();
+		return false;
+	}
+	return true;
+}
+
+bool eci::Snapshot::loadData(eci::Interpreter& _interpreter, const uint8_t* _data, size_t _size) {
+	ImageReader reader(_data, _size, &_interpreter);
+	if (reader.check(imageHeaderSize) == false) {
+		return false;
+	}
+	for (size_t iii=0; iii<imageMagicSize; ++iii) {
+		if (reader.m_data[iii] != uint8_t(imageMagic[iii])) {
+			return false;
+		}
+	}
+	reader.m_pos = imageMagicSize;
+	if (uint32_t(reader.getInt32()) != eci::Snapshot::version) {
+		return false;
+	}
+	uint64_t checksum = reader.getUInt64();
+	if (    reader.m_valid == false
+	     || checksum != getChecksum(&_data[imageHeaderSize], _size - imageHeaderSize)) {
+		return false;
+	}
+	size_t nbLibrary = reader.getCount();
+	for (size_t iii=0; iii<nbLibrary; ++iii) {
+		if (_interpreter.addLibrary(reader.getString()) == false) {
+			return false;
+		}
+	}
+	size_t nbFile = reader.getCount();
+	for (size_t iii=0; iii<nbFile; ++iii) {
+		etk::String name = reader.getString();
+		etk::Vector<etk::String> imports;
+		size_t nbImport = reader.getCount();
+		for (size_t jjj=0; jjj<nbImport; ++jjj) {
+			imports.pushBack(reader.getString());
+		}
+		_interpreter.m_files.pushBack(ememory::makeShared<eci::File>(name, imports));
+	}
+	// the classes of the libraries are created by the import: the image use them (same index as the other classes)
+	size_t nbLibraryClass = _interpreter.m_classes.size();
+	etk::Vector<bool> libraryClasses;
+	size_t nbClass = reader.getCount();
+	for (size_t iii=0; iii<nbClass; ++iii) {
+		etk::String name = reader.getString();
+		eci::Class* type = null;
+		for (size_t jjj=0; jjj<nbLibraryClass; ++jjj) {
+			if (_interpreter.m_classes[jjj]->getName() == name) {
+				type = _interpreter.m_classes[jjj].get();
+			}
+		}
+		libraryClasses.pushBack(type != null);
+		if (type == null) {
+			_interpreter.m_classes.pushBack(ememory::makeShared<eci::Class>(name));
+			type = _interpreter.m_classes.back().get();
+		}
+		reader.m_classes.pushBack(type);
+	}
+	size_t nbFunction = reader.getCount();
+	for (size_t iii=0; iii<nbFunction; ++iii) {
+		ememory::SharedPtr<eci::Function> function = ememory::makeShared<eci::Function>();
+		function->setName(reader.getString());
+		function->setLine(reader.getInt32());
+		function->setConst(reader.getBool());
+		function->setStatic(reader.getBool());
+		function->setVisibility(eci::visibility(reader.getInt32()));
+		size_t nbReturn = reader.getCount();
+		for (size_t jjj=0; jjj<nbReturn; ++jjj) {
+			function->addReturn(reader.getVariable());
+		}
+		size_t nbArgument = reader.getCount();
+		for (size_t jjj=0; jjj<nbArgument; ++jjj) {
+			function->addArgument(reader.getVariable());
+		}
+		function->setFrameSize(reader.getInt32());
+		function->setClass(reader.getClass());
+		function->setBody(reader.getBlock());
+		_interpreter.m_functions.pushBack(function);
+	}
+	if (reader.m_valid == false) {
+		return false;
+	}
+	for (size_t jjj=0; jjj<reader.m_classes.size(); ++jjj) {
+		// the description of a class of a library is read and ignored (already defined)
+		ememory::SharedPtr<eci::Class> ignored;
+		eci::Class* it = reader.m_classes[jjj];
+		if (libraryClasses[jjj] == true) {
+			ignored = ememory::makeShared<eci::Class>();
+			it = ignored.get();
+		}
+		it->setParentName(reader.getString());
+		it->setElementTypeName(reader.getString());
+		size_t nbField = reader.getCount();
+		for (size_t iii=0; iii<nbField; ++iii) {
+			it->addField(reader.getVariable());
+		}
+		size_t nbMethod = reader.getCount();
+		for (size_t iii=0; iii<nbMethod; ++iii) {
+			int32_t id = reader.getInt32();
+			if (    id < 0
+			     || size_t(id) >= _interpreter.m_functions.size()) {
+				return false;
+			}
+			it->addMethod(_interpreter.m_functions[id]);
+		}
+		// the parents are before their children in the list
+		if (    reader.m_valid == false
+		     || (    libraryClasses[jjj] == false
+		          && it->define(_interpreter) == false)) {
+			return false;
+		}
+	}
+	for (auto &it : _interpreter.m_functions) {
+		if (_interpreter.bindNative(it) == false) {
+			return false;
+		}
+	}
+	size_t nbGlobal = reader.getCount();
+	for (size_t iii=0; iii<nbGlobal; ++iii) {
+		_interpreter.m_globals.pushBack(ememory::makeShared<eci::Variable>(reader.getVariable()));
+	}
+	size_t nbObject = reader.getCount();
+	for (size_t iii=0; iii<nbObject; ++iii) {
+		const eci::Class* type = reader.getClass();
+		int32_t nbField = reader.getInt32();
+		if (    type == null
+		     || nbField < 0
+		     || (    type->isArray() == false
+		          && size_t(nbField) != type->getLayout().size())
+		     || (    type->isArray() == true
+		          && size_t(nbField) % type->getStride() != 0)) {
+			return false;
+		}
+		eci::Object* object = _interpreter.allocateBlock(type, nbField);
+		if (object == null) {
+			return false;
+		}
+		reader.m_objects.pushBack(object);
+	}
+	for (auto &it : reader.m_objects) {
+		for (size_t iii=0; iii<it->m_nbField; ++iii) {
+			it->m_fields[iii] = reader.getValue();
+		}
+	}
+	for (size_t iii=0; iii<nbGlobal; ++iii) {
+		_interpreter.m_globalValues.pushBack(reader.getValue());
+	}
+	if (    reader.m_valid == false
+	     || reader.m_pos != reader.m_size) {
+		return false;
+	}
+	_interpreter.m_valid = true;
+	_interpreter.m_globalInitialized = true;
+	return true;
+}
+
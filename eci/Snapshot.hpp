@@ -0,0 +1,43 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/String.hpp>
+
+namespace eci {
+	class Interpreter;
+	/**
+	 * @brief Image of an initialized program: a new process start on it without reading, parsing, compiling and
+	 * initializing the files. The image contains the imported libraries, the classes, the compiled functions, the global
+	 * variables and the objects they reference. It is relocatable: the pointers (class, function, object) are stored as
+	 * indexes and the libraries are loaded again (the C functions are bound on the new addresses).
+	 * The sources, the JIT code and the statistics are not stored. A modified or truncated image is rejected (checksum).
+	 */
+	class Snapshot {
+		public:
+			static const uint32_t version = 5; //!< Version of the format (an image of an other version is rejected).
+			/**
+			 * @brief Write the image of a program.
+			 * @param[in] _interpreter Module of the program (see @ref eci::Interpreter::freeze): all the bodies are compiled and the global variables initialized.
+			 * @param[in] _filename File to write.
+			 * @return true if the image has been written.
+			 */
+			static bool save(const eci::Interpreter& _interpreter, const etk::String& _filename);
+			/**
+			 * @brief Load the image of a program in an interpreter (the file is mapped in memory during the load).
+			 * The interpreter can execute the program immediately (the global variables are not initialized again).
+			 * @param[in,out] _interpreter Empty interpreter (configured before: the objects are created in its heap).
+			 * @param[in] _filename Image to read.
+			 * @return true if the program has been loaded.
+			 */
+			static bool load(eci::Interpreter& _interpreter, const etk::String& _filename);
+		private:
+			static bool loadData(eci::Interpreter& _interpreter, const uint8_t* _data, size_t _size);
+	};
+}
+
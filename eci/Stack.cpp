@@ -0,0 +1,67 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Stack.hpp>
+#include <eci/debug.hpp>
+#if defined(__linux__)
+	#include <pthread.h>
+#endif
+
+static const uintptr_t nativeMargin = 256*1024; //!< Native stack kept for the code called by the last frame (library, collector ...).
+static const uintptr_t nativeDefaultSize = 1024*1024; //!< Size of the native stack when it can not be measured (the smallest usual default).
+
+eci::Stack::Stack() :
+  m_top(0),
+  m_depth(0),
+  m_maxDepth(10000),
+  m_nbCall(0),
+  m_nativeLimit(0),
+  m_nbAllocation(0) {
+	m_values.resize(1024);
+	m_nbAllocation++;
+}
+
+eci::Stack::~Stack() {
+	
+}
+
+void eci::Stack::grow() {
+	size_t newSize = m_values.size()*2;
+	while (newSize < m_top) {
+		newSize *= 2;
+	}
+	ECI_DEBUG("Value stack grow : " << m_values.size() << " ==> " << newSize);
+	m_values.resize(newSize);
+	m_nbAllocation++;
+}
+
+uintptr_t eci::Stack::getNativeLimit(uintptr_t _position) {
+	// measured once by thread (an interpreter can be used by several threads, one at a time)
+	static thread_local uintptr_t low = 0;
+	#if defined(__linux__)
+		if (low == 0) {
+			pthread_attr_t attributes;
+			if (pthread_getattr_np(pthread_self(), &attributes) == 0) {
+				void* address = null;
+				size_t size = 0;
+				if (pthread_attr_getstack(&attributes, &address, &size) == 0) {
+					low = reinterpret_cast<uintptr_t>(address);
+				}
+				pthread_attr_destroy(&attributes);
+			}
+		}
+	#endif
+	uintptr_t out = low;
+	if (    out == 0
+	     || out >= _position) {
+		out = _position > nativeDefaultSize ? _position - nativeDefaultSize : 0;
+	}
+	if (_position - out <= 2*nativeMargin) {
+		// very small stack: half of the remaining size
+		return out + (_position - out) / 2;
+	}
+	return out + nativeMargin;
+}
@@ -0,0 +1,229 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/Vector.hpp>
+#include <ememory/memory.hpp>
+#include <eci/Value.hpp>
+
+namespace eci {
+	class Interpreter;
+	class Function;
+	class Stack;
+	/**
+	 * @brief State of the execution of a frame (how the current block is left).
+	 */
+	enum frameState {
+		frameStateNormal, //!< continue the execution
+		frameStateReturn, //!< a "return" has been executed
+		frameStateBreak, //!< a "break" has been executed
+		frameStateContinue, //!< a "continue" has been executed
+		frameStateTailCall, //!< a "return" of a call of the current function has set the new arguments (the body is executed again)
+		frameStateAbort, //!< the execution of the program is aborted (see @ref eci::Interpreter::abort)
+	};
+	/**
+	 * @brief Execution context of a function. The frames are never allocated in the call, they come from the pool of the stack.
+	 */
+	class Frame {
+		public:
+			eci::Interpreter* m_interpreter; //!< Interpreter that execute the frame.
+			eci::Stack* m_stack; //!< Value stack that store the slots.
+			const eci::Function* m_function; //!< Function executed (null for the global initialisation).
+			size_t m_base; //!< Index of the first slot of the frame in the stack (first argument).
+			enum frameState m_state; //!< Execution state.
+			eci::Value m_return; //!< Return register.
+		public:
+			Frame() :
+			  m_interpreter(null),
+			  m_stack(null),
+			  m_function(null),
+			  m_base(0),
+			  m_state(eci::frameStateNormal) {
+				
+			}
+			/**
+			 * @brief Get a local slot of the frame.
+			 * @param[in] _slot Slot of the variable (set by the resolver).
+			 * @return Reference on the value (invalid after the next call, the stack can grow).
+			 */
+			eci::Value& local(int32_t _slot);
+	};
+	/**
+	 * @brief Contiguous value stack of an interpreter: a call reserve a window of slots
+	 * (arguments first then locals) on the top of the stack, and get a frame from the pool.
+	 * When the stack reach its working size, calls do not allocate anymore.
+	 */
+	class Stack {
+		private:
+			etk::Vector<eci::Value> m_values; //!< All the slots.
+			size_t m_top; //!< First unused slot.
+			etk::Vector<ememory::SharedPtr<eci::Frame>> m_frames; //!< Pool of frames (index is the call depth).
+			size_t m_depth; //!< Number of active frames.
+			size_t m_maxDepth; //!< Max call depth (size of the pool of frames).
+			size_t m_nbCall; //!< Number of active calls: the frames and the calls of the native code of the JIT (they have no frame).
+			uintptr_t m_nativeLimit; //!< Lowest address of the native stack where a call can start (set by the first call, see @ref getNativeLimit).
+			size_t m_nbAllocation; //!< Number of allocation done by the stack (values and frames).
+		public:
+			Stack();
+			~Stack();
+			/**
+			 * @brief Get a slot of the stack.
+			 * @param[in] _index Index in the stack.
+			 * @return Reference on the value.
+			 */
+			eci::Value& get(size_t _index) {
+				return m_values[_index];
+			}
+			/**
+			 * @brief Reserve a window of slots on the top of the stack.
+			 * @param[in] _size Number of slot.
+			 * @return Index of the first slot of the window.
+			 */
+			size_t reserve(size_t _size) {
+				size_t base = m_top;
+				m_top += _size;
+				if (m_top > m_values.size()) {
+					grow();
+				}
+				// an old value of the slots can reference a released object (the slots are roots of the collector)
+				for (size_t iii=base; iii<m_top; ++iii) {
+					m_values[iii] = eci::Value();
+				}
+				return base;
+			}
+			/**
+			 * @brief Release a window of slots (and all the slots over it).
+			 * @param[in] _base Index of the first slot of the window.
+			 */
+			void release(size_t _base) {
+				m_top = _base;
+			}
+			/**
+			 * @brief Get a frame from the pool. A call of the interpreter is a recursion of the native code: the frame is refused
+			 * when the native stack of the thread is nearly full, whatever the depth (the size of a call depend on the build).
+			 * @return The new current frame (null if the max depth is reached).
+			 */
+			eci::Frame* pushFrame() {
+				uintptr_t position = getNativePosition();
+				if (m_nbCall == 0) {
+					m_nativeLimit = getNativeLimit(position);
+				} else if (    position < m_nativeLimit
+				            || m_nbCall >= m_maxDepth) {
+					return null;
+				}
+				if (m_depth >= m_frames.size()) {
+					m_frames.pushBack(ememory::makeShared<eci::Frame>());
+					m_nbAllocation++;
+				}
+				++m_nbCall;
+				return m_frames[m_depth++].get();
+			}
+			/**
+			 * @brief Give back the current frame to the pool.
+			 */
+			void popFrame() {
+				m_depth--;
+				m_nbCall--;
+			}
+			/**
+			 * @brief Prepare a call of the native code of the JIT from the interpreter: the first call of the thread set the limit
+			 * of the native stack (the native code check it and count its calls, see @ref getNativeLimitAddress).
+			 */
+			void startNative() {
+				if (m_nbCall == 0) {
+					m_nativeLimit = getNativeLimit(getNativePosition());
+				}
+			}
+			/**
+			 * @brief Get the address of the limit of the native stack (the native code of the JIT compare its stack pointer with it).
+			 * @return Address of the limit.
+			 */
+			const uintptr_t* getNativeLimitAddress() const {
+				return &m_nativeLimit;
+			}
+			/**
+			 * @brief Get the address of the number of active calls (the native code of the JIT count its calls in it).
+			 * @return Address of the counter.
+			 */
+			size_t* getNbCallAddress() {
+				return &m_nbCall;
+			}
+			/**
+			 * @brief Get the address of the max call depth (the native code of the JIT compare the number of calls with it).
+			 * @return Address of the max depth.
+			 */
+			const size_t* getMaxDepthAddress() const {
+				return &m_maxDepth;
+			}
+			/**
+			 * @brief Get the first unused slot.
+			 * @return Number of slots used by the active calls.
+			 */
+			size_t getTop() const {
+				return m_top;
+			}
+			/**
+			 * @brief Get the number of active frames.
+			 * @return The call depth.
+			 */
+			size_t getDepth() const {
+				return m_depth;
+			}
+			/**
+			 * @brief Get an active frame.
+			 * @param[in] _depth Depth of the frame (0 is the first call).
+			 * @return The frame.
+			 */
+			const eci::Frame& getFrame(size_t _depth) const {
+				return *m_frames[_depth];
+			}
+			eci::Frame& getFrame(size_t _depth) {
+				return *m_frames[_depth];
+			}
+			/**
+			 * @brief Set the max call depth.
+			 * @param[in] _value New max depth.
+			 */
+			void setMaxDepth(size_t _value) {
+				m_maxDepth = _value;
+			}
+			/**
+			 * @brief Get the number of allocation done by the stack since its creation.
+			 * @return Number of allocation (value growth and new frames).
+			 */
+			size_t getNbAllocation() const {
+				return m_nbAllocation;
+			}
+			/**
+			 * @brief Get the number of slot allocated.
+			 * @return Capacity of the stack.
+			 */
+			size_t getCapacity() const {
+				return m_values.size();
+			}
+		private:
+			void grow();
+			static uintptr_t getNativePosition() {
+				#if defined(__GNUC__)
+					return reinterpret_cast<uintptr_t>(__builtin_frame_address(0));
+				#else
+					char marker;
+					return reinterpret_cast<uintptr_t>(&marker);
+				#endif
+			}
+			/**
+			 * @brief Get the lowest address of the native stack usable by the calls (the stack grow down).
+			 * @param[in] _position Current position in the native stack.
+			 * @return The end of the stack of the thread plus a margin for the native functions called by the last frame.
+			 */
+			static uintptr_t getNativeLimit(uintptr_t _position);
+	};
+	inline eci::Value& Frame::local(int32_t _slot) {
+		return m_stack->get(m_base + _slot);
+	}
+}
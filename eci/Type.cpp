@@ -8,3 +8,170 @@
 #include <eci/Type.hpp>
 #include <eci/debug.hpp>
 
+
+enum eci::operatorId eci::getOperatorId(const etk::String& _value) {
+	if (_value == "+") { return eci::operatorAdd; }
+	if (_value == "-") { return eci::operatorSub; }
+	if (_value == "*") { return eci::operatorMul; }
+	if (_value == "/") { return eci::operatorDiv; }
+	if (_value == "%") { return eci::operatorMod; }
+	if (_value == "<") { return eci::operatorLess; }
+	if (_value == "<=") { return eci::operatorLessEqual; }
+	if (_value == ">") { return eci::operatorGreater; }
+	if (_value == ">=") { return eci::operatorGreaterEqual; }
+	if (_value == "==") { return eci::operatorEqual; }
+	if (_value == "!=") { return eci::operatorNotEqual; }
+	if (_value == "&") { return eci::operatorBinaryAnd; }
+	if (_value == "&&") { return eci::operatorAnd; }
+	if (_value == "||") { return eci::operatorOr; }
+	if (_value == "=") { return eci::operatorAssign; }
+	if (_value == "+=") { return eci::operatorAssignAdd; }
+	if (_value == "-=") { return eci::operatorAssignSub; }
+	if (_value == "*=") { return eci::operatorAssignMul; }
+	if (_value == "/=") { return eci::operatorAssignDiv; }
+	if (_value == "%=") { return eci::operatorAssignMod; }
+	if (_value == "++") { return eci::operatorIncrement; }
+	if (_value == "--") { return eci::operatorDecrement; }
+	if (_value == "!") { return eci::operatorNot; }
+	return eci::operatorNone;
+}
+
+enum eci::operatorId eci::getAssignOperator(enum eci::operatorId _operator) {
+	switch (_operator) {
+		case eci::operatorAssignAdd: return eci::operatorAdd;
+		case eci::operatorAssignSub: return eci::operatorSub;
+		case eci::operatorAssignMul: return eci::operatorMul;
+		case eci::operatorAssignDiv: return eci::operatorDiv;
+		case eci::operatorAssignMod: return eci::operatorMod;
+		default:
+			break;
+	}
+	return eci::operatorNone;
+}
+
+enum eci::valueType eci::getCommonType(enum eci::valueType _left, enum eci::valueType _right) {
+	if (    _left == eci::valueTypeObject
+	     || _right == eci::valueTypeObject) {
+		// no arithmetic on the objects
+		return eci::valueTypeObject;
+	}
+	if (    _left == eci::valueTypeDouble
+	     || _right == eci::valueTypeDouble) {
+		return eci::valueTypeDouble;
+	}
+	if (    _left == eci::valueTypeFloat
+	     || _right == eci::valueTypeFloat) {
+		return eci::valueTypeFloat;
+	}
+	// integer promotion:
+	if (_left < eci::valueTypeInt32) {
+		_left = eci::valueTypeInt32;
+	}
+	if (_right < eci::valueTypeInt32) {
+		_right = eci::valueTypeInt32;
+	}
+	// the enum is ordered with the conversion rank
+	return etk::max(_left, _right);
+}
+
+eci::Value eci::callOperator(enum eci::operatorId _operator, const eci::Value& _left, const eci::Value& _right) {
+	if (    _left.m_type == eci::valueTypeVoid
+	     || _right.m_type == eci::valueTypeVoid) {
+		ECI_ERROR("Call operator with a void value");
+	}
+	switch (eci::getCommonType(_left.m_type, _right.m_type)) {
+		case eci::valueTypeInt32:  return eci::TypeBase<int32_t>::callOperator(_operator, _left.get<int32_t>(), _right.get<int32_t>());
+		case eci::valueTypeUInt32: return eci::TypeBase<uint32_t>::callOperator(_operator, _left.get<uint32_t>(), _right.get<uint32_t>());
+		case eci::valueTypeInt64:  return eci::TypeBase<int64_t>::callOperator(_operator, _left.get<int64_t>(), _right.get<int64_t>());
+		case eci::valueTypeUInt64: return eci::TypeBase<uint64_t>::callOperator(_operator, _left.get<uint64_t>(), _right.get<uint64_t>());
+		case eci::valueTypeFloat:  return eci::TypeBase<float>::callOperator(_operator, _left.get<float>(), _right.get<float>());
+		case eci::valueTypeDouble: return eci::TypeBase<double>::callOperator(_operator, _left.get<double>(), _right.get<double>());
+		default:
+			break;
+	}
+	ECI_ERROR("Can not call operator on : " << _left.toString() << " and " << _right.toString());
+	return eci::Value();
+}
+
+/**
+ * @brief Binary operator on 2 values of the type T (the value is read without conversion).
+ */
+template<typename T, enum eci::operatorId OPERATOR>
+static bool quickOperation(const eci::Value& _left, const eci::Value& _right, eci::Value& _out) {
+	const enum eci::valueType type = eci::Value(T()).m_type;
+	if (    _left.m_type != type
+	     || _right.m_type != type) {
+		return false;
+	}
+	_out = eci::TypeBase<T>::callOperator(OPERATOR, _left.get<T>(), _right.get<T>());
+	return true;
+}
+
+template<typename T>
+static eci::quickOperator selectQuickOperator(enum eci::operatorId _operator) {
+	switch (_operator) {
+		case eci::operatorAdd:          return &quickOperation<T, eci::operatorAdd>;
+		case eci::operatorSub:          return &quickOperation<T, eci::operatorSub>;
+		case eci::operatorMul:          return &quickOperation<T, eci::operatorMul>;
+		case eci::operatorDiv:          return &quickOperation<T, eci::operatorDiv>;
+		case eci::operatorMod:          return &quickOperation<T, eci::operatorMod>;
+		case eci::operatorLess:         return &quickOperation<T, eci::operatorLess>;
+		case eci::operatorLessEqual:    return &quickOperation<T, eci::operatorLessEqual>;
+		case eci::operatorGreater:      return &quickOperation<T, eci::operatorGreater>;
+		case eci::operatorGreaterEqual: return &quickOperation<T, eci::operatorGreaterEqual>;
+		case eci::operatorEqual:        return &quickOperation<T, eci::operatorEqual>;
+		case eci::operatorNotEqual:     return &quickOperation<T, eci::operatorNotEqual>;
+		default:
+			break;
+	}
+	return null;
+}
+
+eci::quickOperator eci::getQuickOperator(enum eci::operatorId _operator, enum eci::valueType _left, enum eci::valueType _right) {
+	if (_left != _right) {
+		// the mixed operations stay in the generic version (conversion)
+		return null;
+	}
+	if (    _operator == eci::operatorMod
+	     && (    _left == eci::valueTypeFloat
+	          || _left == eci::valueTypeDouble)) {
+		return null;
+	}
+	switch (_left) {
+		case eci::valueTypeInt32:  return selectQuickOperator<int32_t>(_operator);
+		case eci::valueTypeUInt32: return selectQuickOperator<uint32_t>(_operator);
+		case eci::valueTypeInt64:  return selectQuickOperator<int64_t>(_operator);
+		case eci::valueTypeUInt64: return selectQuickOperator<uint64_t>(_operator);
+		case eci::valueTypeFloat:  return selectQuickOperator<float>(_operator);
+		case eci::valueTypeDouble: return selectQuickOperator<double>(_operator);
+		default:
+			break;
+	}
+	return null;
+}
+
+eci::Value eci::callOperator(enum eci::operatorId _operator, const eci::Value& _value) {
+	if (    _operator == eci::operatorSub
+	     && _value.m_type != eci::valueTypeVoid
+	     && _value.m_type < eci::valueTypeInt32) {
+		// integer promotion
+		return eci::TypeBase<int32_t>::callOperator(_operator, _value.get<int32_t>());
+	}
+	switch (_value.m_type) {
+		case eci::valueTypeBool:   return eci::TypeBase<bool>::callOperator(_operator, _value.m_bool);
+		case eci::valueTypeInt8:   return eci::TypeBase<int8_t>::callOperator(_operator, _value.m_int8);
+		case eci::valueTypeUInt8:  return eci::TypeBase<uint8_t>::callOperator(_operator, _value.m_uint8);
+		case eci::valueTypeInt16:  return eci::TypeBase<int16_t>::callOperator(_operator, _value.m_int16);
+		case eci::valueTypeUInt16: return eci::TypeBase<uint16_t>::callOperator(_operator, _value.m_uint16);
+		case eci::valueTypeInt32:  return eci::TypeBase<int32_t>::callOperator(_operator, _value.m_int32);
+		case eci::valueTypeUInt32: return eci::TypeBase<uint32_t>::callOperator(_operator, _value.m_uint32);
+		case eci::valueTypeInt64:  return eci::TypeBase<int64_t>::callOperator(_operator, _value.m_int64);
+		case eci::valueTypeUInt64: return eci::TypeBase<uint64_t>::callOperator(_operator, _value.m_uint64);
+		case eci::valueTypeFloat:  return eci::TypeBase<float>::callOperator(_operator, _value.m_float);
+		case eci::valueTypeDouble: return eci::TypeBase<double>::callOperator(_operator, _value.m_double);
+		default:
+			break;
+	}
+	ECI_ERROR("Can not call unary operator on : " << _value.toString());
+	return eci::Value();
+}
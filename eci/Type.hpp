@@ -10,8 +10,89 @@
 #include <etk/Map.hpp>
 #include <ememory/memory.hpp>
 #include <eci/debug.hpp>
+#include <eci/Value.hpp>
+#include <type_traits>
 
 namespace eci {
+	/**
+	 * @brief List of all operator that can be applied on the native types.
+	 */
+	enum operatorId {
+		operatorNone, //!< not an operator
+		operatorAdd, //!< "+"
+		operatorSub, //!< "-"
+		operatorMul, //!< "*"
+		operatorDiv, //!< "/"
+		operatorMod, //!< "%"
+		operatorLess, //!< "<"
+		operatorLessEqual, //!< "<="
+		operatorGreater, //!< ">"
+		operatorGreaterEqual, //!< ">="
+		operatorEqual, //!< "=="
+		operatorNotEqual, //!< "!="
+		operatorBinaryAnd, //!< "&"
+		operatorAnd, //!< "&&"
+		operatorOr, //!< "||"
+		operatorAssign, //!< "="
+		operatorAssignAdd, //!< "+="
+		operatorAssignSub, //!< "-="
+		operatorAssignMul, //!< "*="
+		operatorAssignDiv, //!< "/="
+		operatorAssignMod, //!< "%="
+		operatorIncrement, //!< "++"
+		operatorDecrement, //!< "--"
+		operatorNot, //!< "!"
+	};
+	/**
+	 * @brief Get the operator id of an operator string.
+	 * @param[in] _value Operator string ("+", "+=" ...).
+	 * @return The operator id (operatorNone if unknow).
+	 */
+	enum operatorId getOperatorId(const etk::String& _value);
+	/**
+	 * @brief Get the operator used by an assignation operator ("+=" ==> "+").
+	 * @param[in] _operator Assignation operator.
+	 * @return The operator (operatorNone for "=").
+	 */
+	enum operatorId getAssignOperator(enum operatorId _operator);
+	/**
+	 * @brief Call a binary operator on 2 values with the C conversion rules (the common type is used).
+	 * @param[in] _operator Operator to call.
+	 * @param[in] _left Left value.
+	 * @param[in] _right Right value.
+	 * @return The result value.
+	 */
+	eci::Value callOperator(enum eci::operatorId _operator, const eci::Value& _left, const eci::Value& _right);
+	/**
+	 * @brief Call an unary operator on a value ("-", "!").
+	 * @param[in] _operator Operator to call.
+	 * @param[in] _value Value.
+	 * @return The result value.
+	 */
+	eci::Value callOperator(enum eci::operatorId _operator, const eci::Value& _value);
+	/**
+	 * @brief Get the common type of a binary operation (C usual arithmetic conversions).
+	 * @param[in] _left Type of the left value.
+	 * @param[in] _right Type of the right value.
+	 * @return The type used to compute the operation.
+	 */
+	enum eci::valueType getCommonType(enum eci::valueType _left, enum eci::valueType _right);
+	/**
+	 * @brief Operator specialized for the types of its operands (the types are checked, no conversion).
+	 * @param[in] _left Left value.
+	 * @param[in] _right Right value.
+	 * @param[out] _out Result value.
+	 * @return false if the types of the values are not the specialized types (nothing is computed).
+	 */
+	typedef bool (*quickOperator)(const eci::Value& _left, const eci::Value& _right, eci::Value& _out);
+	/**
+	 * @brief Get the specialized version of a binary operator.
+	 * @param[in] _operator Operator to call.
+	 * @param[in] _left Type of the left value.
+	 * @param[in] _right Type of the right value.
+	 * @return The specialized operator or null if these types have no specialized version.
+	 */
+	eci::quickOperator getQuickOperator(enum eci::operatorId _operator, enum eci::valueType _left, enum eci::valueType _right);
 	class Variable;
 	class Type : public ememory::EnableSharedFromThis<eci::Type> {
 		protected:
@@ -62,12 +143,154 @@ namespace eci {
 		
 	};
 	
-	template<typename T> class TypeBase : public Type {
-		
+	/**
+	 * @brief Type of the arithmetic of a native type: the integers are computed in an unsigned type (at least 32 bits, no
+	 * promotion in int) then converted back, the overflow wrap as the hardware (no undefined behavior).
+	 */
+	template<typename T, bool SMALL = (sizeof(T) < sizeof(uint32_t))> struct TypeArithmetic {
+		typedef uint32_t Type;
 	};
-	
-	template<> class TypeBase<int32_t> {
-		
+	//! @not_in_doc
+	template<typename T> struct TypeArithmetic<T, false> {
+		typedef typename std::make_unsigned<T>::type Type;
+	};
+	//! @not_in_doc
+	template<> struct TypeArithmetic<float, false> {
+		typedef float Type;
+	};
+	//! @not_in_doc
+	template<> struct TypeArithmetic<double, false> {
+		typedef double Type;
+	};
+	//! @not_in_doc
+	template<typename T> inline T typeAdd(T _left, T _right) {
+		typedef typename TypeArithmetic<T>::Type U;
+		return T(U(_left) + U(_right));
+	}
+	//! @not_in_doc
+	template<typename T> inline T typeSub(T _left, T _right) {
+		typedef typename TypeArithmetic<T>::Type U;
+		return T(U(_left) - U(_right));
+	}
+	//! @not_in_doc
+	template<typename T> inline T typeMul(T _left, T _right) {
+		typedef typename TypeArithmetic<T>::Type U;
+		return T(U(_left) * U(_right));
+	}
+	//! @not_in_doc
+	template<typename T> inline T typeNegate(T _value) {
+		typedef typename TypeArithmetic<T>::Type U;
+		return T(-U(_value));
+	}
+	//! @not_in_doc
+	template<typename T> inline T typeDivide(T _left, T _right) {
+		if (_right == 0) {
+			ECI_ERROR("Divide by 0");
+			return T(0);
+		}
+		// the minimum divided by -1 does not fit in the type (trap of the CPU): the result wrap
+		if (    std::is_signed<T>::value == true
+		     && _right == T(-1)) {
+			return typeNegate<T>(_left);
+		}
+		return _left / _right;
+	}
+	//! @not_in_doc
+	template<> inline float typeDivide<float>(float _left, float _right) {
+		return _left / _right;
+	}
+	//! @not_in_doc
+	template<> inline double typeDivide<double>(double _left, double _right) {
+		return _left / _right;
+	}
+	//! @not_in_doc
+	template<typename T> inline eci::Value typeModulo(T _left, T _right) {
+		if (_right == 0) {
+			ECI_ERROR("Modulo by 0");
+			return eci::Value(T(0));
+		}
+		if (    std::is_signed<T>::value == true
+		     && _right == T(-1)) {
+			return eci::Value(T(0));
+		}
+		return eci::Value(T(_left % _right));
+	}
+	//! @not_in_doc
+	template<> inline eci::Value typeModulo<float>(float _left, float _right) {
+		ECI_ERROR("Can not call operator '%' on float");
+		return eci::Value();
+	}
+	//! @not_in_doc
+	template<> inline eci::Value typeModulo<double>(double _left, double _right) {
+		ECI_ERROR("Can not call operator '%' on double");
+		return eci::Value();
+	}
+	//! @not_in_doc
+	template<typename T> inline eci::Value typeBinaryAnd(T _left, T _right) {
+		return eci::Value(T(_left & _right));
+	}
+	//! @not_in_doc
+	template<> inline eci::Value typeBinaryAnd<float>(float _left, float _right) {
+		ECI_ERROR("Can not call operator '&' on float");
+		return eci::Value();
+	}
+	//! @not_in_doc
+	template<> inline eci::Value typeBinaryAnd<double>(double _left, double _right) {
+		ECI_ERROR("Can not call operator '&' on double");
+		return eci::Value();
+	}
+	/**
+	 * @brief Native type: all the operator are the C operator of the type T.
+	 */
+	template<typename T> class TypeBase : public Type {
+		public:
+			/**
+			 * @brief Call a binary operator (the 2 values are already in the type T).
+			 * @param[in] _operator Operator to call.
+			 * @param[in] _left Left value.
+			 * @param[in] _right Right value.
+			 * @return The result value.
+			 */
+			static eci::Value callOperator(enum eci::operatorId _operator, T _left, T _right) {
+				switch (_operator) {
+					case eci::operatorAdd:          return eci::Value(typeAdd<T>(_left, _right));
+					case eci::operatorSub:          return eci::Value(typeSub<T>(_left, _right));
+					case eci::operatorMul:          return eci::Value(typeMul<T>(_left, _right));
+					case eci::operatorDiv:          return eci::Value(typeDivide<T>(_left, _right));
+					case eci::operatorMod:          return typeModulo<T>(_left, _right);
+					case eci::operatorLess:         return eci::Value(_left < _right);
+					case eci::operatorLessEqual:    return eci::Value(_left <= _right);
+					case eci::operatorGreater:      return eci::Value(_left > _right);
+					case eci::operatorGreaterEqual: return eci::Value(_left >= _right);
+					case eci::operatorEqual:        return eci::Value(_left == _right);
+					case eci::operatorNotEqual:     return eci::Value(_left != _right);
+					case eci::operatorBinaryAnd:    return typeBinaryAnd<T>(_left, _right);
+					case eci::operatorAnd:          return eci::Value(_left != T(0) && _right != T(0));
+					case eci::operatorOr:           return eci::Value(_left != T(0) || _right != T(0));
+					default:
+						break;
+				}
+				ECI_ERROR("call unknow operator : '" << int32_t(_operator) << "'");
+				return eci::Value();
+			}
+			/**
+			 * @brief Call an unary operator.
+			 * @param[in] _operator Operator to call.
+			 * @param[in] _value Value.
+			 * @return The result value.
+			 */
+			static eci::Value callOperator(enum eci::operatorId _operator, T _value) {
+				switch (_operator) {
+					case eci::operatorSub:       return eci::Value(typeNegate<T>(_value));
+					case eci::operatorNot:       return eci::Value(_value == T(0));
+					case eci::operatorIncrement: return eci::Value(typeAdd<T>(_value, T(1)));
+					case eci::operatorDecrement: return eci::Value(typeSub<T>(_value, T(1)));
+					default:
+						break;
+				}
+				ECI_ERROR("call unknow unary operator : '" << int32_t(_operator) << "'");
+				return eci::Value();
+			}
 	};
 }
 
@@ -0,0 +1,96 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <eci/Value.hpp>
+#include <eci/Type.hpp>
+#include <atomic>
+
+namespace eci {
+	/**
+	 * @brief Type feedback of an operator site ("a + b", "i < n", "sum += x"): the types of the operands are recorded
+	 * on each generic execution, and when the same types are seen @ref stableCount times the site is quickened: it call
+	 * the operator specialized for these types (see @ref eci::getQuickOperator). The specialized operator check the
+	 * types (guard): when they change the site go back in the generic version and record again. A site that change
+	 * too often (more than @ref maxDeoptimization times) stay generic.
+	 * The code of a module is executed by several threads: the specialized operator is published with one atomic
+	 * store (a reader see the old or the new one, both check the types), the counters are only an heuristic.
+	 */
+	class TypeFeedback {
+		public:
+			static const int32_t stableCount = 8; //!< Number of executions with the same types before the quickening.
+			static const int32_t maxDeoptimization = 4; //!< Number of type changes before the site stay generic.
+		private:
+			std::atomic<eci::quickOperator> m_quick; //!< Specialized operator (null: generic version).
+			std::atomic<int32_t> m_types; //!< Last types seen (left | right << 8).
+			std::atomic<int32_t> m_count; //!< Number of consecutive executions with these types.
+			std::atomic<int32_t> m_nbDeoptimization; //!< Number of time the specialized operator has been removed.
+		public:
+			TypeFeedback() :
+			  m_quick(null),
+			  m_types(-1),
+			  m_count(0),
+			  m_nbDeoptimization(0) {
+				
+			}
+			/**
+			 * @brief Execute the specialized operator of the site.
+			 * @param[in] _left Left value.
+			 * @param[in] _right Right value.
+			 * @param[out] _out Result value.
+			 * @return false if the site is not quickened or the types are not the specialized ones (call the generic version and @ref record).
+			 */
+			bool execute(const eci::Value& _left, const eci::Value& _right, eci::Value& _out) const {
+				eci::quickOperator quick = m_quick.load(std::memory_order_relaxed);
+				return    quick != null
+				       && quick(_left, _right, _out) == true;
+			}
+			/**
+			 * @brief Record the types of a generic execution.
+			 * @param[in] _operator Operator of the site.
+			 * @param[in] _left Left value.
+			 * @param[in] _right Right value.
+			 */
+			void record(enum eci::operatorId _operator, const eci::Value& _left, const eci::Value& _right) {
+				if (m_nbDeoptimization.load(std::memory_order_relaxed) >= maxDeoptimization) {
+					return;
+				}
+				if (m_quick.load(std::memory_order_relaxed) != null) {
+					// the guard failed: the types have changed
+					m_quick.store(null, std::memory_order_relaxed);
+					m_nbDeoptimization.store(m_nbDeoptimization.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+					m_count.store(0, std::memory_order_relaxed);
+				}
+				int32_t types = int32_t(_left.m_type) | (int32_t(_right.m_type) << 8);
+				if (m_types.load(std::memory_order_relaxed) != types) {
+					m_types.store(types, std::memory_order_relaxed);
+					m_count.store(1, std::memory_order_relaxed);
+					return;
+				}
+				int32_t count = m_count.load(std::memory_order_relaxed) + 1;
+				m_count.store(count, std::memory_order_relaxed);
+				if (count >= stableCount) {
+					eci::quickOperator quick = eci::getQuickOperator(_operator, _left.m_type, _right.m_type);
+					if (quick == null) {
+						// no specialized version for these types
+						m_nbDeoptimization.store(maxDeoptimization, std::memory_order_relaxed);
+						return;
+					}
+					m_quick.store(quick, std::memory_order_relaxed);
+				}
+			}
+			/**
+			 * @brief Check if the site call a specialized operator.
+			 * @return true if the site is quickened.
+			 */
+			bool isQuickened() const {
+				return m_quick.load(std::memory_order_relaxed) != null;
+			}
+	};
+}
+
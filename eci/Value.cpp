@@ -0,0 +1,114 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/Value.hpp>
+#include <eci/debug.hpp>
+
+enum eci::valueType eci::getValueType(const etk::String& _value) {
+	if (    _value == "void"
+	     || _value == "auto") {
+		return eci::valueTypeVoid;
+	} else if (    _value == "int"
+	            || _value == "int32_t"
+	            || _value == "signed"
+	            || _value == "signed int") {
+		return eci::valueTypeInt32;
+	} else if (    _value == "unsigned"
+	            || _value == "unsigned int"
+	            || _value == "uint32_t") {
+		return eci::valueTypeUInt32;
+	} else if (    _value == "short"
+	            || _value == "short int"
+	            || _value == "int16_t"
+	            || _value == "signed short") {
+		return eci::valueTypeInt16;
+	} else if (    _value == "unsigned short"
+	            || _value == "uint16_t") {
+		return eci::valueTypeUInt16;
+	} else if (    _value == "char"
+	            || _value == "int8_t"
+	            || _value == "signed char") {
+		return eci::valueTypeInt8;
+	} else if (    _value == "unsigned char"
+	            || _value == "uint8_t") {
+		return eci::valueTypeUInt8;
+	} else if (    _value == "long"
+	            || _value == "long int"
+	            || _value == "long long"
+	            || _value == "int64_t"
+	            || _value == "signed long") {
+		return eci::valueTypeInt64;
+	} else if (    _value == "unsigned long"
+	            || _value == "unsigned long long"
+	            || _value == "uint64_t"
+	            || _value == "size_t") {
+		return eci::valueTypeUInt64;
+	} else if (_value == "bool") {
+		return eci::valueTypeBool;
+	} else if (_value == "float") {
+		return eci::valueTypeFloat;
+	} else if (_value == "double") {
+		return eci::valueTypeDouble;
+	}
+	// not a native type: the class is checked by the resolver
+	return eci::valueTypeObject;
+}
+
+const char* eci::getValueTypeName(enum eci::valueType _type) {
+	switch (_type) {
+		case eci::valueTypeVoid:   return "void";
+		case eci::valueTypeBool:   return "bool";
+		case eci::valueTypeInt8:   return "int8_t";
+		case eci::valueTypeUInt8:  return "uint8_t";
+		case eci::valueTypeInt16:  return "int16_t";
+		case eci::valueTypeUInt16: return "uint16_t";
+		case eci::valueTypeInt32:  return "int32_t";
+		case eci::valueTypeUInt32: return "uint32_t";
+		case eci::valueTypeInt64:  return "int64_t";
+		case eci::valueTypeUInt64: return "uint64_t";
+		case eci::valueTypeFloat:  return "float";
+		case eci::valueTypeDouble: return "double";
+		case eci::valueTypeObject: return "object";
+	}
+	return "???";
+}
+
+eci::Value eci::Value::convert(enum eci::valueType _type) const {
+	if (    _type == m_type
+	     || _type == eci::valueTypeVoid) {
+		return *this;
+	}
+	switch (_type) {
+		case eci::valueTypeVoid:   return *this;
+		case eci::valueTypeBool:   return eci::Value(isTrue());
+		case eci::valueTypeInt8:   return eci::Value(get<int8_t>());
+		case eci::valueTypeUInt8:  return eci::Value(get<uint8_t>());
+		case eci::valueTypeInt16:  return eci::Value(get<int16_t>());
+		case eci::valueTypeUInt16: return eci::Value(get<uint16_t>());
+		case eci::valueTypeInt32:  return eci::Value(get<int32_t>());
+		case eci::valueTypeUInt32: return eci::Value(get<uint32_t>());
+		case eci::valueTypeInt64:  return eci::Value(get<int64_t>());
+		case eci::valueTypeUInt64: return eci::Value(get<uint64_t>());
+		case eci::valueTypeFloat:  return eci::Value(get<float>());
+		case eci::valueTypeDouble: return eci::Value(get<double>());
+		case eci::valueTypeObject: return eci::Value(static_cast<eci::Object*>(null));
+	}
+	return *this;
+}
+
+etk::String eci::Value::toString() const {
+	etk::String out = etk::String(eci::getValueTypeName(m_type)) + "(";
+	switch (m_type) {
+		case eci::valueTypeVoid:   break;
+		case eci::valueTypeBool:   out += (m_bool == true ? "true" : "false"); break;
+		case eci::valueTypeFloat:
+		case eci::valueTypeDouble: out += etk::toString(get<double>()); break;
+		case eci::valueTypeUInt64: out += etk::toString(m_uint64); break;
+		case eci::valueTypeObject: out += etk::toString(uint64_t(m_object)); break;
+		default:                   out += etk::toString(get<int64_t>()); break;
+	}
+	return out + ")";
+}
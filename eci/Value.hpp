@@ -7,16 +7,116 @@
 #pragma once
 
 #include <etk/types.hpp>
-#include <eci/Type.hpp>
-#include <ememory/memory.hpp>
 
 namespace eci {
-	class Value : public ememory::EnableSharedFromThis<Value>{
+	class Object;
+	/**
+	 * @brief Native type stored in a value (order is the C conversion rank).
+	 */
+	enum valueType {
+		valueTypeVoid, //!< no value
+		valueTypeBool, //!< bool
+		valueTypeInt8, //!< char, int8_t
+		valueTypeUInt8, //!< unsigned char, uint8_t
+		valueTypeInt16, //!< short, int16_t
+		valueTypeUInt16, //!< unsigned short, uint16_t
+		valueTypeInt32, //!< int, int32_t
+		valueTypeUInt32, //!< unsigned int, uint32_t
+		valueTypeInt64, //!< long, int64_t
+		valueTypeUInt64, //!< unsigned long, uint64_t, size_t
+		valueTypeFloat, //!< float
+		valueTypeDouble, //!< double
+		valueTypeObject, //!< instance of a class (reference on the object)
+	};
+	/**
+	 * @brief Get the value type of a type name.
+	 * @param[in] _typeName Name of the type ("int", "unsigned int", "auto" ...).
+	 * @return The type (valueTypeVoid for "void" or "auto", valueTypeObject for a class name).
+	 */
+	enum valueType getValueType(const etk::String& _typeName);
+	/**
+	 * @brief Get the name of a value type (for debug).
+	 * @param[in] _type Type of the value.
+	 * @return Name of the type.
+	 */
+	const char* getValueTypeName(enum valueType _type);
+	/**
+	 * @brief A value in the interpreter, stored by copy (no allocation): it is the element of the value stack.
+	 */
+	class Value {
+		public:
+			enum eci::valueType m_type; //!< Type of the value.
+			union {
+				bool m_bool;
+				int8_t m_int8;
+				uint8_t m_uint8;
+				int16_t m_int16;
+				uint16_t m_uint16;
+				int32_t m_int32;
+				uint32_t m_uint32;
+				int64_t m_int64;
+				uint64_t m_uint64;
+				float m_float;
+				double m_double;
+				eci::Object* m_object;
+			};
 		public:
-			Value() {};
-			~Value() {};
-		protected:
-			
+			Value() : m_type(eci::valueTypeVoid), m_uint64(0) {}
+			Value(bool _value) : m_type(eci::valueTypeBool), m_uint64(0) { m_bool = _value; }
+			Value(int8_t _value) : m_type(eci::valueTypeInt8), m_uint64(0) { m_int8 = _value; }
+			Value(uint8_t _value) : m_type(eci::valueTypeUInt8), m_uint64(0) { m_uint8 = _value; }
+			Value(int16_t _value) : m_type(eci::valueTypeInt16), m_uint64(0) { m_int16 = _value; }
+			Value(uint16_t _value) : m_type(eci::valueTypeUInt16), m_uint64(0) { m_uint16 = _value; }
+			Value(int32_t _value) : m_type(eci::valueTypeInt32), m_uint64(0) { m_int32 = _value; }
+			Value(uint32_t _value) : m_type(eci::valueTypeUInt32), m_uint64(0) { m_uint32 = _value; }
+			Value(int64_t _value) : m_type(eci::valueTypeInt64), m_int64(_value) {}
+			Value(uint64_t _value) : m_type(eci::valueTypeUInt64), m_uint64(_value) {}
+			Value(float _value) : m_type(eci::valueTypeFloat), m_uint64(0) { m_float = _value; }
+			Value(double _value) : m_type(eci::valueTypeDouble), m_double(_value) {}
+			Value(eci::Object* _value) : m_type(eci::valueTypeObject), m_uint64(0) { m_object = _value; }
+			/**
+			 * @brief Get the value in a specific native type (C cast).
+			 * @return The converted value.
+			 */
+			template<typename T> T get() const {
+				switch (m_type) {
+					case eci::valueTypeVoid:   return T(0);
+					case eci::valueTypeBool:   return T(m_bool);
+					case eci::valueTypeInt8:   return T(m_int8);
+					case eci::valueTypeUInt8:  return T(m_uint8);
+					case eci::valueTypeInt16:  return T(m_int16);
+					case eci::valueTypeUInt16: return T(m_uint16);
+					case eci::valueTypeInt32:  return T(m_int32);
+					case eci::valueTypeUInt32: return T(m_uint32);
+					case eci::valueTypeInt64:  return T(m_int64);
+					case eci::valueTypeUInt64: return T(m_uint64);
+					case eci::valueTypeFloat:  return T(m_float);
+					case eci::valueTypeDouble: return T(m_double);
+					case eci::valueTypeObject: return T(0);
+				}
+				return T(0);
+			}
+			/**
+			 * @brief Check if the value is true (C condition).
+			 * @return true if the value is not 0.
+			 */
+			bool isTrue() const {
+				switch (m_type) {
+					case eci::valueTypeFloat:  return m_float != 0.0f;
+					case eci::valueTypeDouble: return m_double != 0.0;
+					default:                   return m_uint64 != 0;
+				}
+			}
+			/**
+			 * @brief Convert the value in an other type (C cast).
+			 * @param[in] _type New type of the value (valueTypeVoid keep the current type).
+			 * @return The converted value.
+			 */
+			eci::Value convert(enum eci::valueType _type) const;
+			/**
+			 * @brief Get a printable version of the value (for debug).
+			 * @return The value and its type.
+			 */
+			etk::String toString() const;
 	};
 }
-
@@ -10,10 +10,22 @@
 
 eci::Variable::Variable() :
   m_visibility(eci::visibilityPublic),
-  m_const(false) {
+  m_const(false),
+  m_valueType(eci::valueTypeVoid) {
 	
 }
 
+eci::Variable::Variable(const etk::String& _name, const etk::String& _typeName) :
+  m_visibility(eci::visibilityPublic),
+  m_const(false),
+  m_name(_name),
+  m_typeName(_typeName),
+  m_valueType(eci::valueTypeVoid) {
+	if (m_typeName != "") {
+		m_valueType = eci::getValueType(m_typeName);
+	}
+}
+
 eci::Variable::~Variable() {
 	
-}
\ No newline at end of file
+}
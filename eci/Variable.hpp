@@ -16,11 +16,39 @@ namespace eci {
 	class Variable : public ememory::EnableSharedFromThis<Variable> {
 		public:
 			Variable();
+			Variable(const etk::String& _name, const etk::String& _typeName);
 			virtual ~Variable();
 		private:
 			enum eci::visibility m_visibility;
 			bool m_const;
 			etk::String m_name;
+			etk::String m_typeName; //!< Name of the type as written in the file.
+			enum eci::valueType m_valueType; //!< Native type of the variable.
 			ememory::SharedPtr<eci::Type> m_type;
+		public:
+			const etk::String& getName() const {
+				return m_name;
+			}
+			void setName(const etk::String& _name) {
+				m_name = _name;
+			}
+			const etk::String& getTypeName() const {
+				return m_typeName;
+			}
+			enum eci::valueType getValueType() const {
+				return m_valueType;
+			}
+			bool getConst() const {
+				return m_const;
+			}
+			void setConst(bool _value) {
+				m_const = _value;
+			}
+			enum eci::visibility getVisibility() const {
+				return m_visibility;
+			}
+			void setVisibility(enum eci::visibility _value) {
+				m_visibility = _value;
+			}
 	};
 }
@@ -10,3 +10,13 @@ int32_t eci::getLogId() {
 	static int32_t g_val = elog::registerInstance("eci");
 	return g_val;
 }
+
+static thread_local int64_t g_nbError = 0; //!< number of error messages of the thread
+
+void eci::addError() {
+	++g_nbError;
+}
+
+int64_t eci::getNbError() {
+	return g_nbError;
+}
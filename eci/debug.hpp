@@ -10,12 +10,21 @@
 
 namespace eci {
 	int32_t getLogId();
+	/**
+	 * @brief Count an error message of the current thread.
+	 */
+	void addError();
+	/**
+	 * @brief Get the number of error messages of the current thread (the error tests check that an error is reported).
+	 * @return Number of error since the start of the thread.
+	 */
+	int64_t getNbError();
 };
 #define ECI_BASE(info,data) ELOG_BASE(eci::getLogId(),info,data)
 
 #define ECI_PRINT(data)         ECI_BASE(-1, data)
 #define ECI_CRITICAL(data)      ECI_BASE(1, data)
-#define ECI_ERROR(data)         ECI_BASE(2, data)
+#define ECI_ERROR(data)         do { eci::addError(); ECI_BASE(2, data); } while (false)
 #define ECI_WARNING(data)       ECI_BASE(3, data)
 #ifdef DEBUG
 	#define ECI_INFO(data)          ECI_BASE(4, data)
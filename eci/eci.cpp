@@ -9,20 +9,996 @@
 #include <eci/lang/ParserCpp.hpp>
 #include <etk/os/FSNode.hpp>
 #include <eci/Interpreter.hpp>
+#include <eci/Registry.hpp>
+#include <eci/Snapshot.hpp>
+#include <eci/Batch.hpp>
+#include <eci/Kernel.hpp>
+#include <eci/Handle.hpp>
 #include <etk/etk.hpp>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+static bool g_displayTime = false; //!< display the execution time of each file
+static bool g_displayStat = false; //!< display the statistic of the interpreter of each file
+static int32_t g_optimizationLevel = 1; //!< optimization level of the interpreter
+static bool g_jit = false; //!< compile the hot functions in native code
+static bool g_eager = false; //!< parse all the function bodies at the load
+static bool g_collector = false; //!< release the unreachable objects with the garbage collector
+static int32_t g_collectorBudget = 500; //!< max duration of a step of the garbage collector (in microseconds)
+static int32_t g_isolates = 0; //!< run each file in 1 to N isolated interpreters on as many threads (0: normal run)
+static bool g_module = false; //!< load each file once in a module shared by its interpreters
+static eci::Registry g_registry; //!< modules of the files (when g_module is set)
+static bool g_saveImage = false; //!< write the image of each file after its initialization instead of executing it
+static bool g_image = false; //!< the input files are images (written by g_saveImage)
+static etk::String g_profile; //!< file of the folded stacks of the sampling profiler ("": no profiling)
+static int32_t g_profileRate = 1000; //!< number of samples per second of the profiler
+static etk::String g_operatorProfile; //!< file of the executions of the operator shapes ("": superinstructions are used)
+static etk::Vector<etk::Pair<etk::String, size_t>> g_operatorShapes; //!< executions of the operator shapes of all the files
+static etk::String g_batch; //!< function executed on columns of generated values after the "main" ("": no batch)
+static int32_t g_batchSize = 1000000; //!< number of rows of the batch
+static int32_t g_lexerThread = 0; //!< number of thread of the lexer (0: number of core)
+static int32_t g_lexerChunk = 0; //!< minimal size of the data lexed by one thread (0: default of the lexer)
+
+/**
+ * @brief Apply the options of the command line on an interpreter.
+ * @param[in] _interpreter Interpreter to configure.
+ */
+static void configure(eci::Interpreter& _interpreter) {
+	_interpreter.setOptimizationLevel(g_optimizationLevel);
+	_interpreter.getJit().setEnable(g_jit);
+	_interpreter.setLazyCompilation(g_eager == false);
+	_interpreter.getCollector().setEnable(g_collector);
+	_interpreter.getCollector().setBudget(g_collectorBudget);
+	_interpreter.setOperatorProfile(g_operatorProfile != "");
+	if (g_lexerThread > 0) {
+		_interpreter.getLexer()->setNbThread(g_lexerThread);
+	}
+	if (g_lexerChunk > 0) {
+		_interpreter.getLexer()->setChunkSize(g_lexerChunk);
+	}
+}
+
+/**
+ * @brief Create an interpreter that execute a file (on the shared module of the file when g_module is set).
+ * @param[in] _filename File to execute (image file when g_image is set).
+ * @return The interpreter (null if the module can not be created).
+ */
+static ememory::SharedPtr<eci::Interpreter> load(const etk::String& _filename) {
+	ememory::SharedPtr<eci::Interpreter> out;
+	if (g_image == true) {
+		out = ememory::makeShared<eci::Interpreter>();
+		configure(*out);
+		if (eci::Snapshot::load(*out, _filename) == false) {
+			return null;
+		}
+		return out;
+	}
+	if (g_module == true) {
+		etk::Vector<etk::String> files;
+		files.pushBack(_filename);
+		out = g_registry.create(files);
+		if (out == null) {
+			return null;
+		}
+		configure(*out);
+		return out;
+	}
+	out = ememory::makeShared<eci::Interpreter>();
+	configure(*out);
+	out->addFile(_filename);
+	return out;
+}
+
+/**
+ * @brief Check if all the brackets of an interactive input are closed (the input continue on the next line).
+ * @param[in] _data Input data.
+ * @return true if the input can be compiled.
+ */
+static bool isComplete(const etk::String& _data) {
+	int32_t level = 0;
+	char quote = '\0';
+	for (size_t iii=0; iii<_data.size(); ++iii) {
+		char value = _data[iii];
+		if (quote != '\0') {
+			if (value == '\\') {
+				++iii;
+			} else if (value == quote) {
+				quote = '\0';
+			}
+			continue;
+		}
+		if (    value == '"'
+		     || value == '\'') {
+			quote = value;
+		} else if (    value == '/'
+		            && iii+1 < _data.size()
+		            && _data[iii+1] == '/') {
+			while (    iii < _data.size()
+			        && _data[iii] != '\n') {
+				++iii;
+			}
+		} else if (    value == '('
+		            || value == '{'
+		            || value == '[') {
+			++level;
+		} else if (    value == ')'
+		            || value == '}'
+		            || value == ']') {
+			--level;
+		}
+	}
+	return level <= 0;
+}
+
+/**
+ * @brief Get the next word of an interactive input.
+ * @param[in] _data Input data.
+ * @param[in,out] _pos Position in the data (set after the word).
+ * @return The word (empty if the data does not continue with a name).
+ */
+static etk::String getWord(const etk::String& _data, size_t& _pos) {
+	while (    _pos < _data.size()
+	        && (    _data[_pos] == ' '
+	             || _data[_pos] == '\t'
+	             || _data[_pos] == '\n')) {
+		++_pos;
+	}
+	size_t start = _pos;
+	while (    _pos < _data.size()
+	        && (    (_data[_pos] >= 'a' && _data[_pos] <= 'z')
+	             || (_data[_pos] >= 'A' && _data[_pos] <= 'Z')
+	             || (_data[_pos] >= '0' && _data[_pos] <= '9')
+	             || _data[_pos] == '_'
+	             || _data[_pos] == ':')) {
+		++_pos;
+	}
+	return etk::String(_data, start, _pos-start);
+}
+
+/**
+ * @brief Check if an interactive input is a global declaration (class, function, global variable ...)
+ * or a statement that is executed immediately.
+ * @param[in] _interpreter Interpreter that know the classes.
+ * @param[in] _data Input data.
+ * @return true for a declaration.
+ */
+static bool isDeclaration(const eci::Interpreter& _interpreter, const etk::String& _data) {
+	size_t pos = 0;
+	etk::String word = getWord(_data, pos);
+	if (    word == ""
+	     && pos < _data.size()) {
+		return _data[pos] == '#';
+	}
+	if (    word == "class"
+	     || word == "struct"
+	     || word == "enum"
+	     || word == "typedef") {
+		return true;
+	}
+	while (    word == "static"
+	        || word == "const"
+	        || word == "inline"
+	        || word == "extern"
+	        || word == "unsigned"
+	        || word == "signed") {
+		size_t next = pos;
+		etk::String nextWord = getWord(_data, next);
+		if (nextWord == "") {
+			break;
+		}
+		if (    (    word == "unsigned"
+		          || word == "signed")
+		     && eci::getValueType(word + " " + nextWord) == eci::valueTypeObject) {
+			// "unsigned x": the qualifier is the type and the next word is the name
+			break;
+		}
+		word = nextWord;
+		pos = next;
+	}
+	if (    word != "auto"
+	     && word != "void"
+	     && eci::getValueType(word) == eci::valueTypeObject
+	     && _interpreter.findClass(word) == null) {
+		return false;
+	}
+	// a type followed by a name
+	while (    pos < _data.size()
+	        && (    _data[pos] == ' '
+	             || _data[pos] == '\t'
+	             || _data[pos] == '*'
+	             || _data[pos] == '&')) {
+		++pos;
+	}
+	return getWord(_data, pos) != "";
+}
+
+/**
+ * @brief Check if a line of an interactive input is only a comment.
+ * @param[in] _line Line to check.
+ * @return true for a line comment or a comment closed on the same line.
+ */
+static bool isComment(const etk::String& _line) {
+	size_t pos = 0;
+	while (    pos < _line.size()
+	        && (    _line[pos] == ' '
+	             || _line[pos] == '\t')) {
+		++pos;
+	}
+	etk::String line(_line, pos, _line.size()-pos);
+	return    line.startWith("//") == true
+	       || (    line.startWith("/*") == true
+	            && line.endWith("*/") == true);
+}
+
+/**
+ * @brief Execute the inputs of the interactive mode: a declaration is added to the program, a statement or an expression
+ * is executed immediately (an expression display its value).
+ * @param[in] _input Inputs (read line by line).
+ * @param[in] _prompt Display the prompts (the inputs are typed by the user).
+ * @param[out] _result Value of the last input that has a value.
+ * @return Number of inputs that can not be compiled or executed.
+ */
+static int32_t runInputs(std::istream& _input, bool _prompt, eci::Value& _result) {
+	eci::Interpreter virtualMachine;
+	configure(virtualMachine);
+	bool displayTime = g_displayTime;
+	int32_t id = 0;
+	int32_t nbFail = 0;
+	etk::String data;
+	auto prompt = [&](const char* _value) {
+		if (_prompt == true) {
+			std::cout << _value << std::flush;
+		}
+	};
+	prompt("eci> ");
+	std::string line;
+	while (std::getline(_input, line)) {
+		etk::String command = etk::String(line.c_str());
+		if (    command == ":q"
+		     || command == ":quit") {
+			break;
+		}
+		// a pending input (bracket not closed) is dropped by an empty line or ":cancel"
+		if (    command == ":cancel"
+		     || (    command == ""
+		          && data != "")) {
+			if (data != "") {
+				ECI_PRINT("input cancelled");
+			}
+			data = "";
+			prompt("eci> ");
+			continue;
+		}
+		if (data == "") {
+			if (command == ":time") {
+				displayTime = !displayTime;
+				ECI_PRINT("time display " << (displayTime == true ? "on" : "off"));
+				prompt("eci> ");
+				continue;
+			} else if (command == ":help") {
+				ECI_PRINT("Enter a declaration (function, class, global variable), a statement or an expression.");
+				ECI_PRINT("    :time    Display the lex, parse, link and execution time of each input");
+				ECI_PRINT("    :cancel  Drop the pending input (an empty line too)");
+				ECI_PRINT("    :quit    Exit");
+				prompt("eci> ");
+				continue;
+			} else if (isComment(command) == true) {
+				prompt("eci> ");
+				continue;
+			}
+		}
+		data += line.c_str();
+		data += "\n";
+		if (isComplete(data) == false) {
+			prompt("...> ");
+			continue;
+		}
+		// remove the end spaces
+		size_t size = data.size();
+		while (    size > 0
+		        && (    data[size-1] == '\n'
+		             || data[size-1] == ' '
+		             || data[size-1] == '\t')) {
+			--size;
+		}
+		data = etk::String(data, 0, size);
+		if (data != "") {
+			// a statement or an expression is compiled in a function that is called immediately.
+			etk::String functionName;
+			etk::String source = data;
+			if (isDeclaration(virtualMachine, data) == false) {
+				functionName = "__repl_" + etk::toString(id++);
+				if (    data[data.size()-1] == ';'
+				     || data[data.size()-1] == '}') {
+					source = "auto " + functionName + "() {\n" + data + "\n}\n";
+				} else {
+					source = "auto " + functionName + "() {\nreturn " + data + ";\n}\n";
+				}
+			}
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			bool ret = virtualMachine.addSource("<input>", source);
+			std::chrono::steady_clock::time_point loadTime = std::chrono::steady_clock::now();
+			int64_t timeLex = 0;
+			int64_t timeParse = 0;
+			if (ret == true) {
+				timeLex = virtualMachine.getLastFile().getTimeLex();
+				timeParse = virtualMachine.getLastFile().getTimeParse();
+			}
+			if (    ret == true
+			     && functionName != "") {
+				eci::Value result;
+				ret = virtualMachine.call(functionName, result);
+				if (    ret == true
+				     && result.m_type != eci::valueTypeVoid) {
+					ECI_PRINT(result.toString());
+					_result = result;
+				}
+			}
+			if (ret == false) {
+				++nbFail;
+			}
+			std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+			if (displayTime == true) {
+				int64_t timeLoad = std::chrono::duration_cast<std::chrono::microseconds>(loadTime-startTime).count();
+				ECI_PRINT("lex=" << timeLex << "us"
+				          << " parse=" << timeParse << "us"
+				          << " link=" << etk::max(timeLoad-timeLex-timeParse, int64_t(0)) << "us"
+				          << " execute=" << std::chrono::duration_cast<std::chrono::microseconds>(stopTime-loadTime).count() << "us");
+			}
+		}
+		data = "";
+		prompt("eci> ");
+	}
+	if (_prompt == true) {
+		std::cout << std::endl;
+	}
+	return nbFail;
+}
 
 void run_interactive() {
-	ECI_CRITICAL("TODO ... create interactive interface");
+	eci::Value result;
+	runInputs(std::cin, true, result);
 }
 
+/**
+ * @brief Execute a file of interactive inputs (a test of the folder "repl"): all the inputs must be compiled and executed,
+ * and the value of the last input that has a value must be 0.
+ * @param[in] _filename File of the inputs.
+ * @return true if the test passed.
+ */
+static bool run_repl(const etk::String& _filename) {
+	std::ifstream input(_filename.c_str());
+	if (input.is_open() == false) {
+		ECI_ERROR("Test '" << _filename << "' can not be opened");
+		return false;
+	}
+	eci::Value result;
+	int32_t nbFail = runInputs(input, false, result);
+	if (nbFail != 0) {
+		ECI_ERROR("Test '" << _filename << "' has " << nbFail << " input(s) in error");
+		return false;
+	}
+	if (    result.m_type == eci::valueTypeVoid
+	     || result.isTrue() == true) {
+		ECI_ERROR("Test '" << _filename << "' return " << result.toString());
+		return false;
+	}
+	return true;
+}
+
+
 bool run_test(const etk::String& _filename) {
+	int64_t timeModule = 0;
+	if (g_module == true) {
+		// the first request load the module, the load time of the interpreter is its creation on the module
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		etk::Vector<etk::String> files;
+		files.pushBack(_filename);
+		g_registry.getModule(files);
+		timeModule = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-startTime).count();
+	}
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	ememory::SharedPtr<eci::Interpreter> virtualMachinePtr = load(_filename);
+	if (virtualMachinePtr == null) {
+		ECI_ERROR("Test '" << _filename << "' can not be loaded");
+		return false;
+	}
+	eci::Interpreter& virtualMachine = *virtualMachinePtr;
+	if (g_profile != "") {
+		virtualMachine.getProfiler().start(g_profileRate);
+	}
+	std::chrono::steady_clock::time_point loadTime = std::chrono::steady_clock::now();
+	bool ret = virtualMachine.main();
+	std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+	if (g_profile != "") {
+		virtualMachine.getProfiler().stop();
+		// the stacks of all the files are in the same output
+		FILE* file = fopen(g_profile.c_str(), "a");
+		if (file == null) {
+			ECI_ERROR("Can not write the profile : '" << g_profile << "'");
+		} else {
+			etk::String folded = virtualMachine.getProfiler().getFolded(virtualMachine);
+			fwrite(folded.c_str(), 1, folded.size(), file);
+			fclose(file);
+		}
+		ECI_PRINT(_filename << " : profile samples=" << virtualMachine.getProfiler().getNbSample());
+	}
+	if (g_operatorProfile != "") {
+		eci::Optimizer::addProfileShapes(virtualMachine, g_operatorShapes);
+	}
+	// a test is OK when "main" return 0 (or does not exist)
+	if (    ret == true
+	     && virtualMachine.getReturnValue().m_type != eci::valueTypeVoid
+	     && virtualMachine.getReturnValue().isTrue() == true) {
+		ECI_ERROR("Test '" << _filename << "' return " << virtualMachine.getReturnValue().toString());
+		ret = false;
+	}
+	if (g_displayTime == true) {
+		ECI_PRINT(_filename << (g_module == true ? " : module=" + etk::toString(timeModule) + "us" : etk::String(" :"))
+		                    << " load=" << std::chrono::duration_cast<std::chrono::microseconds>(loadTime-startTime).count() << "us"
+		                    << " execute=" << std::chrono::duration_cast<std::chrono::microseconds>(stopTime-loadTime).count() << "us");
+	}
+	if (g_displayStat == true) {
+		ECI_PRINT(_filename << " : stack allocation=" << virtualMachine.getStack().getNbAllocation()
+		                    << " stack capacity=" << virtualMachine.getStack().getCapacity()
+		                    << " elements=" << virtualMachine.getOptimizer().getNbElementBefore()
+		                    << " optimized=" << virtualMachine.getOptimizer().getNbElementAfter()
+		                    << " fused=" << virtualMachine.getOptimizer().getNbFused()
+		                    << " counted loops=" << virtualMachine.getOptimizer().getNbCountedLoop()
+		                    << " tail calls=" << virtualMachine.getOptimizer().getNbTailCall()
+		                    << " scalar objects=" << virtualMachine.getOptimizer().getNbScalar()
+		                    << " objects=" << virtualMachine.getNbObject()
+		                    << " heap used=" << virtualMachine.getHeap().getSizeUsed()
+		                    << " heap reserved=" << virtualMachine.getHeap().getSizeReserved()
+		                    << " heap free=" << virtualMachine.getHeap().getSizeFree()
+		                    << " fragmentation=" << int32_t(virtualMachine.getHeap().getFragmentation()*100.0) << "%"
+		                    << " gc cycles=" << virtualMachine.getCollector().getNbCycle()
+		                    << " gc collected=" << virtualMachine.getCollector().getNbCollected()
+		                    << " gc pause max=" << virtualMachine.getCollector().getPauseMax() << "us"
+		                    << " gc pause histogram=" << virtualMachine.getCollector().getHistogram(0)
+		                    << "/" << virtualMachine.getCollector().getHistogram(1)
+		                    << "/" << virtualMachine.getCollector().getHistogram(2)
+		                    << "/" << virtualMachine.getCollector().getHistogram(3)
+		                    << "/" << virtualMachine.getCollector().getHistogram(4)
+		                    << " inline cache miss=" << virtualMachine.getNbCacheMiss()
+		                    << " jit=" << virtualMachine.getJit().getNbCompiled() << "/" << virtualMachine.getJit().getNbFailed()
+		                    << " jit code=" << virtualMachine.getJit().getCodeSize()
+		                    << " functions=" << virtualMachine.getNbFunctionCompiled() << "/" << virtualMachine.getNbFunction());
+	}
+	return ret;
+}
+
+/**
+ * @brief Load and execute a file in isolated interpreters: one interpreter by thread, nothing is shared between them.
+ * @param[in] _filename File to execute.
+ * @param[in] _nbIsolate Number of interpreters (and threads).
+ * @param[out] _duration Time to load and execute all the interpreters in microseconds.
+ * @return true if all the interpreters executed the file without error.
+ */
+static bool run_isolates(const etk::String& _filename, int32_t _nbIsolate, int64_t& _duration) {
+	std::atomic<int32_t> nbFail(0);
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	etk::Vector<std::thread*> threads;
+	for (int32_t iii=0; iii<_nbIsolate; ++iii) {
+		threads.pushBack(new std::thread([&]() {
+			ememory::SharedPtr<eci::Interpreter> virtualMachine = load(_filename);
+			if (    virtualMachine == null
+			     || virtualMachine->main() == false
+			     || (    virtualMachine->getReturnValue().m_type != eci::valueTypeVoid
+			          && virtualMachine->getReturnValue().isTrue() == true)) {
+				++nbFail;
+			}
+		}));
+	}
+	for (auto &it : threads) {
+		it->join();
+		delete it;
+	}
+	_duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-startTime).count();
+	return nbFail == 0;
+}
+
+/**
+ * @brief Measure the scaling of the isolates on a file: 1, 2, 4 ... N interpreters on as many threads
+ * (the throughput is linear when the time stay the same).
+ * @param[in] _filename File to execute.
+ * @return true if all the executions passed.
+ */
+static bool run_scaling(const etk::String& _filename) {
+	bool ret = true;
+	if (g_module == true) {
+		// the load of the module is not measured
+		etk::Vector<etk::String> files;
+		files.pushBack(_filename);
+		g_registry.getModule(files);
+	}
+	double reference = 0.0;
+	int32_t nbIsolate = 1;
+	while (true) {
+		int64_t duration = 0;
+		if (run_isolates(_filename, nbIsolate, duration) == false) {
+			ECI_ERROR("Test '" << _filename << "' failed in " << nbIsolate << " isolate(s)");
+			ret = false;
+		}
+		double throughput = double(nbIsolate) * 1000000.0 / double(etk::max(duration, int64_t(1)));
+		if (nbIsolate == 1) {
+			reference = throughput;
+		}
+		ECI_PRINT(_filename << " : isolates=" << nbIsolate
+		                    << " time=" << duration << "us"
+		                    << " throughput=" << int64_t(throughput) << " run/s"
+		                    << " scaling=" << int32_t(throughput * 100.0 / reference) / 100.0);
+		if (nbIsolate >= g_isolates) {
+			break;
+		}
+		// the last measure is done with the requested number
+		nbIsolate = etk::min(nbIsolate*2, g_isolates);
+	}
+	return ret;
+}
+
+/**
+ * @brief Load and initialize a file, then write its image in "<file>.img".
+ * @param[in] _filename File to load.
+ * @return true if the image has been written.
+ */
+static bool run_save(const etk::String& _filename) {
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
 	eci::Interpreter virtualMachine;
+	configure(virtualMachine);
 	virtualMachine.addFile(_filename);
-	
-	virtualMachine.main();
+	// compile all the bodies and initialize the global variables
+	if (virtualMachine.freeze() == false) {
+		ECI_ERROR("Test '" << _filename << "' can not be loaded");
+		return false;
+	}
+	std::chrono::steady_clock::time_point loadTime = std::chrono::steady_clock::now();
+	bool ret = eci::Snapshot::save(virtualMachine, _filename + ".img");
+	std::chrono::steady_clock::time_point stopTime = std::chrono::steady_clock::now();
+	if (g_displayTime == true) {
+		ECI_PRINT(_filename << " : load=" << std::chrono::duration_cast<std::chrono::microseconds>(loadTime-startTime).count() << "us"
+		                    << " save=" << std::chrono::duration_cast<std::chrono::microseconds>(stopTime-loadTime).count() << "us");
+	}
+	return ret;
+}
+
+/**
+ * @brief Execute a function of a file on columns of generated values: compare the call of each row
+ * with the batch execution row by row and with the vectorized batch execution.
+ * @param[in] _filename File to execute (its "main" is called first to initialize the program).
+ * @return true if the results are the same for all the executions.
+ */
+static bool run_batch(const etk::String& _filename) {
+	ememory::SharedPtr<eci::Interpreter> virtualMachinePtr = load(_filename);
+	if (    virtualMachinePtr == null
+	     || virtualMachinePtr->main() == false) {
+		ECI_ERROR("Test '" << _filename << "' can not be loaded");
+		return false;
+	}
+	eci::Interpreter& virtualMachine = *virtualMachinePtr;
+	eci::Batch batch(virtualMachine, g_batch);
+	if (batch.isValid() == false) {
+		return false;
+	}
+	const eci::Function& function = *virtualMachine.getFunction(virtualMachine.findFunction(g_batch));
+	size_t nbRow = etk::max(g_batchSize, 1);
+	// the columns are stored in 64 bits slots (large enough for all the native types)
+	etk::Vector<etk::Vector<uint64_t>> data;
+	etk::Vector<eci::Column> inputs;
+	data.resize(function.getArguments().size());
+	for (size_t iii=0; iii<function.getArguments().size(); ++iii) {
+		data[iii].resize(nbRow);
+		inputs.pushBack(eci::Column(function.getArguments()[iii].getValueType(), &data[iii][0], nbRow));
+		for (size_t row=0; row<nbRow; ++row) {
+			inputs.back().set(row, eci::Value(double((row*(iii+3)) % 1000) * 0.25 + 1.0));
+		}
+	}
+	enum eci::valueType type = function.getReturn()[0].getValueType();
+	etk::Vector<uint64_t> reference;
+	reference.resize(nbRow);
+	eci::Column referenceColumn(type, &reference[0], nbRow);
+	// one call per row (as an embedding application without batch)
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	eci::Stack& stack = virtualMachine.getStack();
+	for (size_t row=0; row<nbRow; ++row) {
+		size_t base = stack.reserve(function.getFrameSize());
+		for (size_t iii=0; iii<inputs.size(); ++iii) {
+			stack.get(base+iii) = inputs[iii].get(row);
+		}
+		referenceColumn.set(row, function.call(virtualMachine, base));
+		stack.release(base);
+	}
+	if (virtualMachine.isAborted() == true) {
+		ECI_ERROR("Test '" << _filename << "' batch '" << g_batch << "' is aborted");
+		return false;
+	}
+	int64_t timeCall = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-startTime).count();
+	etk::Vector<uint64_t> result;
+	result.resize(nbRow);
+	eci::Column output(type, &result[0], nbRow);
+	bool ret = true;
+	etk::String times = " call=" + etk::toString(timeCall) + "us";
+	for (int32_t vectorize=0; vectorize<2; ++vectorize) {
+		batch.setVectorize(vectorize == 1);
+		if (    vectorize == 1
+		     && batch.isVectorized() == false) {
+			times += " vectorized=none";
+			break;
+		}
+		startTime = std::chrono::steady_clock::now();
+		if (batch.run(inputs, output) == false) {
+			return false;
+		}
+		int64_t timeBatch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-startTime).count();
+		times += (vectorize == 1 ? " vectorized=" : " batch=") + etk::toString(timeBatch) + "us";
+		for (size_t row=0; row<nbRow; ++row) {
+			double expected = referenceColumn.get(row).get<double>();
+			double value = output.get(row).get<double>();
+			if (fabs(value - expected) > 1e-9 * etk::max(fabs(expected), 1.0)) {
+				ECI_ERROR("Test '" << _filename << "' batch '" << g_batch << "' row " << row << " return " << output.get(row).toString()
+				          << " for " << referenceColumn.get(row).toString());
+				ret = false;
+				break;
+			}
+		}
+	}
+	ECI_PRINT(_filename << " : batch '" << g_batch << "' rows=" << nbRow << times);
+	return ret;
+}
+
+/**
+ * @brief Get the folder of a test: the tests of the folders "error", "handle", "lexer", "profile", "region" and "repl" are executed in their own mode.
+ * @param[in] _filename File of the test.
+ * @return Name of the folder of the file ("" if none).
+ */
+static etk::String getTestFolder(const etk::String& _filename) {
+	size_t end = _filename.size();
+	while (    end > 0
+	        && _filename[end-1] != '/') {
+		--end;
+	}
+	if (end == 0) {
+		return "";
+	}
+	--end;
+	size_t start = end;
+	while (    start > 0
+	        && _filename[start-1] != '/') {
+		--start;
+	}
+	return etk::String(_filename, start, end-start);
+}
+
+/**
+ * @brief Execute an error test: the interpreter must report an error and the program must fail (it can not be loaded,
+ * its execution is aborted or its "main" return a value that is not 0).
+ * @param[in] _filename File to execute.
+ * @return true if the error has been detected.
+ */
+static bool run_error(const etk::String& _filename) {
+	int64_t nbError = eci::getNbError();
+	ememory::SharedPtr<eci::Interpreter> virtualMachine = load(_filename);
+	bool failed = (    virtualMachine == null
+	                || virtualMachine->main() == false
+	                || (    virtualMachine->getReturnValue().m_type != eci::valueTypeVoid
+	                     && virtualMachine->getReturnValue().isTrue() == true));
+	if (    failed == false
+	     || eci::getNbError() == nbError) {
+		ECI_ERROR("Test '" << _filename << "' does not report its error");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Execute a handle test: the functions "add", "scale", "count" and "reset" are called from the host with typed
+ * handles, and the bind of a handle with a wrong signature must fail.
+ * @param[in] _filename File to execute.
+ * @return true if the calls return the expected values and the wrong binds are refused.
+ */
+static bool run_handle(const etk::String& _filename) {
+	ememory::SharedPtr<eci::Interpreter> virtualMachine = load(_filename);
+	if (    virtualMachine == null
+	     || virtualMachine->main() == false) {
+		ECI_ERROR("Test '" << _filename << "' can not be executed");
+		return false;
+	}
+	eci::Handle<int32_t, int32_t, int32_t> add(*virtualMachine, "add");
+	eci::Handle<double, double, int32_t> scale(*virtualMachine, "scale");
+	eci::Handle<int32_t> count(*virtualMachine, "count");
+	eci::Handle<void> reset(*virtualMachine, "reset");
+	if (    add.isValid() == false
+	     || scale.isValid() == false
+	     || count.isValid() == false
+	     || reset.isValid() == false) {
+		ECI_ERROR("Test '" << _filename << "' can not bind its functions");
+		return false;
+	}
+	if (    add(40, 2) != 42
+	     || add.call(-7, 3) != -4
+	     || scale(2.5, 4) != 10.0) {
+		ECI_ERROR("Test '" << _filename << "' returns a wrong value from a handle");
+		return false;
+	}
+	count();
+	count();
+	reset();
+	if (count() != 1) {
+		ECI_ERROR("Test '" << _filename << "' does not keep the globals between the calls of the handles");
+		return false;
+	}
+	// wrong argument type, wrong return type, wrong number of argument and unknown function
+	eci::Handle<int32_t, double, int32_t> wrongArgument(*virtualMachine, "add");
+	eci::Handle<double, int32_t, int32_t> wrongReturn(*virtualMachine, "add");
+	eci::Handle<int32_t, int32_t> wrongNumber(*virtualMachine, "add");
+	eci::Handle<int32_t> unknown(*virtualMachine, "unknownFunction");
+	if (    wrongArgument.isValid() == true
+	     || wrongReturn.isValid() == true
+	     || wrongNumber.isValid() == true
+	     || unknown.isValid() == true) {
+		ECI_ERROR("Test '" << _filename << "' binds a function with a wrong signature");
+		return false;
+	}
+	// a call of a handle that is not bound does nothing
+	if (wrongArgument(1.5, 2) != 0) {
+		ECI_ERROR("Test '" << _filename << "' calls a handle that is not bound");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Check if a frame of the folded stacks is named by a function of the program.
+ * @param[in] _interpreter Interpreter that executed the program.
+ * @param[in] _frame Name of the frame ("function@file:line").
+ * @return true if a function of a file has this name.
+ */
+static bool isKnownFrame(const eci::Interpreter& _interpreter, const etk::String& _frame) {
+	if (_frame == "<global>") {
+		return true;
+	}
+	for (auto &it : _interpreter.getFiles()) {
+		for (auto &it2 : it->getFunctions()) {
+			etk::String name = it2->getName() + "@" + it->getName();
+			if (it2->getLine() > 0) {
+				name += ":" + etk::toString(it2->getLine());
+			}
+			if (name == _frame) {
+				return true;
+			}
+		}
+	}
 	return false;
 }
 
+/**
+ * @brief Execute a profile test with the sampling profiler: the program must pass, samples must be recorded in the called
+ * functions and all the frames of the folded stacks must be named by a function of the program.
+ * @param[in] _filename File to execute.
+ * @return true if the profile is correct.
+ */
+static bool run_profile(const etk::String& _filename) {
+	ememory::SharedPtr<eci::Interpreter> virtualMachine = load(_filename);
+	if (virtualMachine == null) {
+		ECI_ERROR("Test '" << _filename << "' can not be loaded");
+		return false;
+	}
+	virtualMachine->getProfiler().start(10000);
+	bool ret = virtualMachine->main();
+	virtualMachine->getProfiler().stop();
+	if (    ret == false
+	     || (    virtualMachine->getReturnValue().m_type != eci::valueTypeVoid
+	          && virtualMachine->getReturnValue().isTrue() == true)) {
+		ECI_ERROR("Test '" << _filename << "' failed with the profiler");
+		return false;
+	}
+	if (virtualMachine->getProfiler().getNbSample() == 0) {
+		ECI_ERROR("Test '" << _filename << "' has no profile sample");
+		return false;
+	}
+	// one line per stack: "frame;frame;frame count"
+	etk::String folded = virtualMachine->getProfiler().getFolded(*virtualMachine);
+	size_t depthMax = 0;
+	size_t depth = 1;
+	size_t start = 0;
+	for (size_t iii=0; iii<folded.size(); ++iii) {
+		if (    folded[iii] != ';'
+		     && folded[iii] != ' ') {
+			continue;
+		}
+		etk::String frame(folded, start, iii-start);
+		if (isKnownFrame(*virtualMachine, frame) == false) {
+			ECI_ERROR("Test '" << _filename << "' has an unknown frame in its profile : '" << frame << "'");
+			return false;
+		}
+		if (folded[iii] == ';') {
+			++depth;
+		} else {
+			depthMax = etk::max(depthMax, depth);
+			depth = 1;
+			while (    iii < folded.size()
+			        && folded[iii] != '\n') {
+				++iii;
+			}
+		}
+		start = iii+1;
+	}
+	if (depthMax < 2) {
+		ECI_ERROR("Test '" << _filename << "' has no profile sample in a called function");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Check if two lexings give the same tokens.
+ * @param[in] _left First list of tokens.
+ * @param[in] _right Second list of tokens.
+ * @return true if the tokens (and the tokens of their sections) are the same.
+ */
+static bool isSameLexing(const etk::Vector<ememory::SharedPtr<eci::LexerNode>>& _left, const etk::Vector<ememory::SharedPtr<eci::LexerNode>>& _right) {
+	if (_left.size() != _right.size()) {
+		return false;
+	}
+	for (size_t iii=0; iii<_left.size(); ++iii) {
+		if (    _left[iii] == null
+		     || _right[iii] == null) {
+			if (_left[iii] != _right[iii]) {
+				return false;
+			}
+			continue;
+		}
+		if (    _left[iii]->getTockenId() != _right[iii]->getTockenId()
+		     || _left[iii]->getStartPos() != _right[iii]->getStartPos()
+		     || _left[iii]->getStopPos() != _right[iii]->getStopPos()
+		     || _left[iii]->isNodeContainer() != _right[iii]->isNodeContainer()) {
+			return false;
+		}
+		if (    _left[iii]->isNodeContainer() == true
+		     && isSameLexing(static_cast<const eci::LexerNodeContainer*>(_left[iii].get())->m_list,
+		                     static_cast<const eci::LexerNodeContainer*>(_right[iii].get())->m_list) == false) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Execute a lexer test with the parallel lexer forced on all the lines: the tokens must be the tokens of the
+ * sequential lexer, then the program is executed (its "main" must return 0).
+ * @param[in] _filename File to execute.
+ * @return true if the lexings are the same and the program passed.
+ */
+static bool run_lexer(const etk::String& _filename) {
+	ememory::SharedPtr<eci::Interpreter> virtualMachine = ememory::makeShared<eci::Interpreter>();
+	configure(*virtualMachine);
+	const ememory::SharedPtr<eci::Lexer>& lexer = virtualMachine->getLexer();
+	etk::String data = etk::FSNodeReadAllData(_filename);
+	lexer->setNbThread(1);
+	eci::LexerResult reference = lexer->interprete(data);
+	// more threads than the lines: a chunk by line
+	lexer->setNbThread(64);
+	lexer->setChunkSize(1);
+	eci::LexerResult result = lexer->interprete(data);
+	if (isSameLexing(reference.m_list, result.m_list) == false) {
+		ECI_ERROR("Test '" << _filename << "' is not lexed as the sequential lexer by the parallel lexer");
+		return false;
+	}
+	virtualMachine->addFile(_filename);
+	if (    virtualMachine->main() == false
+	     || (    virtualMachine->getReturnValue().m_type != eci::valueTypeVoid
+	          && virtualMachine->getReturnValue().isTrue() == true)) {
+		ECI_ERROR("Test '" << _filename << "' failed with the parallel lexer");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Call a function of a region test in a region of the heap, then close the region.
+ * @param[in] _interpreter Interpreter of the test.
+ * @param[in] _name Name of the function (it must return 0).
+ * @param[out] _reset true if the region has been reset.
+ * @return true if the function returned 0.
+ */
+static bool callInRegion(eci::Interpreter& _interpreter, const etk::String& _name, bool& _reset) {
+	eci::Value result;
+	_interpreter.getHeap().beginRegion();
+	bool ret = _interpreter.call(_name, result);
+	if (_interpreter.getCollector().getEnable() == true) {
+		// the deleted objects are released by the collector
+		_interpreter.getCollector().collect(_interpreter);
+	}
+	_reset = _interpreter.getHeap().endRegion();
+	return    ret == true
+	       && (    result.m_type == eci::valueTypeVoid
+	            || result.isTrue() == false);
+}
+
+/**
+ * @brief Execute a region test: the function "request" is called several times, each call in a region that must be reset
+ * when it is closed, then the function "keep" store an object in a global in a region that must not be reset, the
+ * function "check" read and delete this object and the next region must be reset.
+ * @param[in] _filename File to execute.
+ * @return true if the regions are reset only when they are not used.
+ */
+static bool run_region(const etk::String& _filename) {
+	ememory::SharedPtr<eci::Interpreter> virtualMachine = load(_filename);
+	if (    virtualMachine == null
+	     || virtualMachine->main() == false) {
+		ECI_ERROR("Test '" << _filename << "' can not be executed");
+		return false;
+	}
+	eci::Heap& heap = virtualMachine->getHeap();
+	size_t nbReset = heap.getNbRegionReset();
+	bool reset = false;
+	for (int32_t iii=0; iii<10; ++iii) {
+		if (    callInRegion(*virtualMachine, "request", reset) == false
+		     || reset == false) {
+			ECI_ERROR("Test '" << _filename << "' request " << iii << " failed or its region is not reset");
+			return false;
+		}
+	}
+	if (    callInRegion(*virtualMachine, "keep", reset) == false
+	     || reset == true
+	     || heap.getNbRegionBlock() == 0) {
+		ECI_ERROR("Test '" << _filename << "' reset a region with an object still used");
+		return false;
+	}
+	if (    callInRegion(*virtualMachine, "check", reset) == false
+	     || reset == false
+	     || heap.getNbRegionBlock() != 0
+	     || heap.getNbRegionReset() != nbReset + 11) {
+		ECI_ERROR("Test '" << _filename << "' lost the object kept in the region or does not reset the region after its release");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Execute a file with the mode selected in the command line.
+ * @param[in] _filename File to execute.
+ * @return true if the test passed.
+ */
+static bool run_file(const etk::String& _filename) {
+	etk::String folder = getTestFolder(_filename);
+	if (folder == "error") {
+		// executed in all the modes (no image, no isolate, no batch)
+		return run_error(_filename);
+	}
+	if (folder == "handle") {
+		return run_handle(_filename);
+	}
+	if (folder == "lexer") {
+		return run_lexer(_filename);
+	}
+	if (folder == "profile") {
+		return run_profile(_filename);
+	}
+	if (folder == "region") {
+		return run_region(_filename);
+	}
+	if (folder == "repl") {
+		return run_repl(_filename);
+	}
+	if (g_saveImage == true) {
+		return run_save(_filename);
+	}
+	if (g_isolates > 0) {
+		return run_scaling(_filename);
+	}
+	if (g_batch != "") {
+		return run_batch(_filename);
+	}
+	return run_test(_filename);
+}
+
 void run_test(const etk::Vector<etk::String>& _listFileToTest) {
 	
 	int32_t test_num = 1;
@@ -35,21 +1011,21 @@ void run_test(const etk::Vector<etk::String>& _listFileToTest) {
 			etk::Vector<etk::String> list;
 			node.folderGetRecursiveFiles(list, false);
 			for (auto &it2 : list) {
-				if (run_test(it2)) {
+				if (run_file(it2)) {
 					passed++;
 				}
 				count++;
 				test_num++;
 			}
 		} else if (type == etk::typeNode_file) {
-			if (run_test(it)) {
+			if (run_file(it)) {
 				passed++;
 			}
 			count++;
 			test_num++;
 		}
 	}
-	ECI_INFO("Done. " << count << " tests, " << passed << " pass, " << count-passed << " fail");
+	ECI_PRINT("Done. " << count << " tests, " << passed << " pass, " << count-passed << " fail");
 }
 
 
@@ -62,14 +1038,101 @@ int main(int _argc, const char** _argv) {
 		if (    data == "-h"
 		     || data == "--help") {
 			ECI_PRINT("Help : ");
-			ECI_PRINT("    ./xxx [options]");
-			ECI_PRINT("        No option for now");
+			ECI_PRINT("    ./xxx [options] file/folder ...");
+			ECI_PRINT("    ./xxx [options]                (interactive mode, ':help' for the commands)");
+			ECI_PRINT("    A test pass when its 'main' return 0, the tests of a folder 'error' must report an error and fail");
+			ECI_PRINT("        --time  Display the load and execution time of each file (of each input in interactive mode)");
+			ECI_PRINT("        --stat  Display the statistic of the interpreter of each file");
+			ECI_PRINT("        -O0     Disable the optimizer");
+			ECI_PRINT("        -O1     Constant folding, dead code elimination, superinstructions, counted loops, tail calls and local objects in slots (default)");
+			ECI_PRINT("        --jit   Compile the hot functions in native code (x86-64 Linux only)");
+			ECI_PRINT("        --eager Parse all the function bodies at the load (default: on the first call)");
+			ECI_PRINT("        --gc    Release the unreachable objects with the incremental garbage collector");
+			ECI_PRINT("        --gc-budget=xxx Max duration of a step of the garbage collector in microseconds (default 500)");
+			ECI_PRINT("                The pause histogram of '--stat' count the steps < 10us, < 100us, < 1ms, < 10ms and >= 10ms");
+			ECI_PRINT("        --isolates=xxx Run each file in 1, 2, 4 ... xxx isolated interpreters on as many threads (throughput scaling)");
+			ECI_PRINT("        --module Load each file once in a module shared by its interpreters (no JIT on the shared code)");
+			ECI_PRINT("        --save-image Initialize each file and write its image in 'xxx.img' (the file is not executed)");
+			ECI_PRINT("        --image The files are images: start on the initialized program (no parse, no compilation, no global initialization)");
+			ECI_PRINT("        --profile=xxx Sample the call stacks of the execution and write them in the file xxx (folded stacks for the flame graph tools)");
+			ECI_PRINT("        --profile-rate=xxx Number of samples per second of the profiler (default 1000)");
+			ECI_PRINT("        --operator-profile=xxx Count the executions of the operator sites (no superinstruction) and write them by shape in the file xxx");
+			ECI_PRINT("        --batch=xxx Execute the function xxx on columns of values after the 'main' (call per row against batch execution)");
+			ECI_PRINT("        --batch-size=xxx Number of rows of the batch (default 1000000)");
+			ECI_PRINT("        --lexer-thread=xxx Number of thread of the lexer on a big file (default: number of core, 1 disable the parallel lexing)");
+			ECI_PRINT("        --lexer-chunk=xxx Minimal size in byte of the part of a file lexed by one thread (default 1048576, not on the modules)");
+			ECI_PRINT("        --kernel=xxx Instruction set of the kernels of '#import <eci/kernel>': scalar, sse2 or avx2 (default: the best of the CPU)");
 			exit(0);
+		} else if (data == "--time") {
+			g_displayTime = true;
+		} else if (data == "--stat") {
+			g_displayStat = true;
+		} else if (data == "-O0") {
+			g_optimizationLevel = 0;
+		} else if (data == "-O1") {
+			g_optimizationLevel = 1;
+		} else if (data == "--eager") {
+			g_eager = true;
+		} else if (data == "--gc") {
+			g_collector = true;
+		} else if (data.startWith("--gc-budget=") == true) {
+			g_collectorBudget = atoi(data.c_str() + 12);
+		} else if (data == "--module") {
+			g_module = true;
+		} else if (data == "--save-image") {
+			g_saveImage = true;
+		} else if (data == "--image") {
+			g_image = true;
+		} else if (data.startWith("--profile=") == true) {
+			g_profile = etk::String(data, 10, data.size()-10);
+		} else if (data.startWith("--profile-rate=") == true) {
+			g_profileRate = atoi(data.c_str() + 15);
+		} else if (data.startWith("--operator-profile=") == true) {
+			g_operatorProfile = etk::String(data, 19, data.size()-19);
+		} else if (data.startWith("--batch=") == true) {
+			g_batch = etk::String(data, 8, data.size()-8);
+		} else if (data.startWith("--batch-size=") == true) {
+			g_batchSize = atoi(data.c_str() + 13);
+		} else if (data.startWith("--lexer-thread=") == true) {
+			g_lexerThread = atoi(data.c_str() + 15);
+		} else if (data.startWith("--lexer-chunk=") == true) {
+			g_lexerChunk = atoi(data.c_str() + 14);
+		} else if (data.startWith("--kernel=") == true) {
+			etk::String level(data, 9, data.size()-9);
+			if (level == "scalar") {
+				eci::Kernel::setLevel(eci::kernelLevelScalar);
+			} else if (level == "sse2") {
+				eci::Kernel::setLevel(eci::kernelLevelSse2);
+			} else if (level == "avx2") {
+				eci::Kernel::setLevel(eci::kernelLevelAvx2);
+			} else {
+				ECI_WARNING("Unknow kernel level '" << level << "'");
+			}
+		} else if (data.startWith("--isolates=") == true) {
+			g_isolates = atoi(data.c_str() + 11);
+		} else if (data == "--jit") {
+			if (eci::Jit::isSupported() == false) {
+				ECI_WARNING("JIT is not supported on this platform");
+			}
+			g_jit = true;
 		} else if (    data.startWith("--elog-") == false
 		            && data.startWith("--etk-") == false) {
 			listFileToTest.pushBack(data);
 		}
 	}
+	if (    g_image == true
+	     && g_module == true) {
+		ECI_WARNING("The images are not loaded in modules: '--module' is ignored");
+		g_module = false;
+	}
+	if (g_profile != "") {
+		// the output is appended by each file
+		FILE* file = fopen(g_profile.c_str(), "w");
+		if (file != null) {
+			fclose(file);
+		}
+	}
+	g_registry.setOptimizationLevel(g_optimizationLevel);
 	ECI_INFO("input elements: " << listFileToTest);
 	// Cocal parse :
 	if (listFileToTest.size() == 0) {
@@ -77,6 +1140,16 @@ int main(int _argc, const char** _argv) {
 	} else {
 		run_test(listFileToTest);
 	}
+	if (g_operatorProfile != "") {
+		FILE* file = fopen(g_operatorProfile.c_str(), "w");
+		if (file == null) {
+			ECI_ERROR("Can not write the operator profile : '" << g_operatorProfile << "'");
+		} else {
+			etk::String shapes = eci::Optimizer::getProfileShapes(g_operatorShapes);
+			fwrite(shapes.c_str(), 1, shapes.size(), file);
+			fclose(file);
+		}
+	}
 	
 	return 0;
 }
\ No newline at end of file
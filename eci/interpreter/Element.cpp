@@ -0,0 +1,968 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#include <eci/interpreter/Element.hpp>
+#include <eci/Interpreter.hpp>
+#include <eci/Stack.hpp>
+#include <eci/Object.hpp>
+#include <eci/Class.hpp>
+#include <eci/Resolver.hpp>
+#include <eci/debug.hpp>
+
+void eci::interpreter::getChildren(const ememory::SharedPtr<eci::interpreter::Element>& _element, etk::Vector<ememory::SharedPtr<eci::interpreter::Element>>& _children) {
+	auto add = [&](const ememory::SharedPtr<eci::interpreter::Element>& _child) {
+		if (_child != null) {
+			_children.pushBack(_child);
+		}
+	};
+	switch (_element->getTockenId()) {
+		case eci::interpreter::typeBlock:
+			for (auto &it : static_cast<eci::interpreter::Block*>(_element.get())->m_actions) {
+				add(it);
+			}
+			break;
+		case eci::interpreter::typeVariableDeclaration:
+			add(static_cast<eci::interpreter::VariableDeclaration*>(_element.get())->m_init);
+			break;
+		case eci::interpreter::typeCondition: {
+			eci::interpreter::Condition* element = static_cast<eci::interpreter::Condition*>(_element.get());
+			add(element->m_condition);
+			add(element->m_block);
+			add(element->m_blockElse);
+			break;
+		}
+		case eci::interpreter::typeFor: {
+			eci::interpreter::For* element = static_cast<eci::interpreter::For*>(_element.get());
+			add(element->m_init);
+			add(element->m_condition);
+			add(element->m_increment);
+			add(element->m_block);
+			break;
+		}
+		case eci::interpreter::typeWhile: {
+			eci::interpreter::While* element = static_cast<eci::interpreter::While*>(_element.get());
+			add(element->m_condition);
+			add(element->m_action);
+			break;
+		}
+		case eci::interpreter::typeSwitch: {
+			eci::interpreter::Switch* element = static_cast<eci::interpreter::Switch*>(_element.get());
+			add(element->m_value);
+			for (auto &it : element->m_blocks) {
+				add(it);
+			}
+			break;
+		}
+		case eci::interpreter::typeOperator: {
+			eci::interpreter::Operator* element = static_cast<eci::interpreter::Operator*>(_element.get());
+			add(element->m_left);
+			add(element->m_right);
+			break;
+		}
+		case eci::interpreter::typeFunctionCall:
+			for (auto &it : static_cast<eci::interpreter::FunctionCall*>(_element.get())->m_arguments) {
+				add(it);
+			}
+			break;
+		case eci::interpreter::typeReturn:
+			add(static_cast<eci::interpreter::Return*>(_element.get())->m_value);
+			break;
+		case eci::interpreter::typeCast:
+			add(static_cast<eci::interpreter::Cast*>(_element.get())->m_value);
+			break;
+		case eci::interpreter::typeMember:
+			add(static_cast<eci::interpreter::Member*>(_element.get())->m_object);
+			break;
+		case eci::interpreter::typeDelete:
+			add(static_cast<eci::interpreter::Delete*>(_element.get())->m_value);
+			break;
+		case eci::interpreter::typeNew:
+			add(static_cast<eci::interpreter::New*>(_element.get())->m_size);
+			break;
+		case eci::interpreter::typeIndex: {
+			eci::interpreter::Index* element = static_cast<eci::interpreter::Index*>(_element.get());
+			add(element->m_object);
+			add(element->m_index);
+			break;
+		}
+		case eci::interpreter::typeMethodCall: {
+			eci::interpreter::MethodCall* element = static_cast<eci::interpreter::MethodCall*>(_element.get());
+			add(element->m_object);
+			for (auto &it : element->m_arguments) {
+				add(it);
+			}
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+eci::Value eci::interpreter::Element::execute(eci::Frame& _frame) {
+	return eci::Value();
+}
+
+eci::Value eci::interpreter::Block::execute(eci::Frame& _frame) {
+	for (auto &it : m_actions) {
+		it->execute(_frame);
+		if (_frame.m_state != eci::frameStateNormal) {
+			break;
+		}
+	}
+	return eci::Value();
+}
+
+eci::Value eci::interpreter::Variable::execute(eci::Frame& _frame) {
+	if (m_global == true) {
+		return _frame.m_interpreter->getGlobal(m_slot);
+	}
+	return _frame.local(m_slot);
+}
+
+eci::Value eci::interpreter::VariableDeclaration::execute(eci::Frame& _frame) {
+	eci::Value value;
+	if (m_init != null) {
+		value = m_init->execute(_frame);
+	}
+	if (    m_init == null
+	     && m_class != null) {
+		// declaration of an instance
+		value = eci::Value(_frame.m_interpreter->createObject(m_class));
+	}
+	value = value.convert(m_valueType);
+	if (m_global == true) {
+		_frame.m_interpreter->getGlobal(m_slot) = value;
+	} else {
+		_frame.local(m_slot) = value;
+	}
+	return value;
+}
+
+eci::Value eci::interpreter::Condition::execute(eci::Frame& _frame) {
+	if (m_condition->execute(_frame).isTrue() == true) {
+		m_block->execute(_frame);
+	} else if (m_blockElse != null) {
+		m_blockElse->execute(_frame);
+	}
+	return eci::Value();
+}
+
+/**
+ * @brief Update the state of the frame at the end of a cycle iteration.
+ * @param[in] _frame Frame of the function.
+ * @return true if the cycle must stop.
+ */
+static bool cycleEnd(eci::Frame& _frame) {
+	switch (_frame.m_state) {
+		case eci::frameStateNormal:
+			return false;
+		case eci::frameStateContinue:
+			_frame.m_state = eci::frameStateNormal;
+			return false;
+		case eci::frameStateBreak:
+			_frame.m_state = eci::frameStateNormal;
+			return true;
+		case eci::frameStateReturn:
+		case eci::frameStateTailCall:
+		case eci::frameStateAbort:
+			return true;
+	}
+	return true;
+}
+
+/**
+ * @brief Execute a counted loop with the induction variable in a native integer (see @ref eci::interpreter::For::findInduction).
+ * @param[in] _element Counted loop (the initialisation is executed).
+ * @param[in] _frame Frame of the function.
+ * @return false if the bound can not be compared in the type of the induction variable (the loop must be executed by its elements).
+ */
+template<typename T>
+static bool executeCounted(eci::interpreter::For& _element, eci::Frame& _frame) {
+	enum eci::valueType type = _frame.local(_element.m_induction).m_type;
+	eci::Value bound = _element.m_boundSlot >= 0 ? _frame.local(_element.m_boundSlot) : _element.m_bound;
+	if (eci::getCommonType(type, bound.m_type) != type) {
+		return false;
+	}
+	T counter = _frame.local(_element.m_induction).get<T>();
+	T limit = bound.get<T>();
+	while (true) {
+		if (_element.m_boundSlot >= 0) {
+			// the block can modify the bound (not its type)
+			limit = _frame.local(_element.m_boundSlot).get<T>();
+		}
+		bool condition = false;
+		switch (_element.m_compare) {
+			case eci::operatorLess:         condition = counter < limit; break;
+			case eci::operatorLessEqual:    condition = counter <= limit; break;
+			case eci::operatorGreater:      condition = counter > limit; break;
+			case eci::operatorGreaterEqual: condition = counter >= limit; break;
+			default:                        condition = counter != limit; break;
+		}
+		if (condition == false) {
+			break;
+		}
+		_element.m_block->execute(_frame);
+		if (cycleEnd(_frame) == true) {
+			break;
+		}
+		// safe point of the profiler
+		if (_frame.m_interpreter->getProfiler().isPending() == true) {
+			_frame.m_interpreter->getProfiler().sample(*_frame.m_stack);
+		}
+		// C overflow of the type (computed in unsigned)
+		counter = T(uint64_t(counter) + uint64_t(_element.m_step));
+		_frame.local(_element.m_induction) = eci::Value(counter);
+	}
+	return true;
+}
+
+eci::Value eci::interpreter::For::execute(eci::Frame& _frame) {
+	if (m_init != null) {
+		m_init->execute(_frame);
+	}
+	if (m_induction >= 0) {
+		bool done = false;
+		switch (_frame.local(m_induction).m_type) {
+			case eci::valueTypeInt32:  done = executeCounted<int32_t>(*this, _frame); break;
+			case eci::valueTypeUInt32: done = executeCounted<uint32_t>(*this, _frame); break;
+			case eci::valueTypeInt64:  done = executeCounted<int64_t>(*this, _frame); break;
+			case eci::valueTypeUInt64: done = executeCounted<uint64_t>(*this, _frame); break;
+			default: break;
+		}
+		if (done == true) {
+			return eci::Value();
+		}
+	}
+	while (true) {
+		if (    m_condition != null
+		     && m_condition->execute(_frame).isTrue() == false) {
+			break;
+		}
+		m_block->execute(_frame);
+		if (cycleEnd(_frame) == true) {
+			break;
+		}
+		// safe point of the profiler
+		if (_frame.m_interpreter->getProfiler().isPending() == true) {
+			_frame.m_interpreter->getProfiler().sample(*_frame.m_stack);
+		}
+		if (m_increment != null) {
+			m_increment->execute(_frame);
+		}
+	}
+	return eci::Value();
+}
+
+eci::Value eci::interpreter::While::execute(eci::Frame& _frame) {
+	if (    m_conditionAtStart == true
+	     && m_condition->execute(_frame).isTrue() == false) {
+		return eci::Value();
+	}
+	do {
+		m_action->execute(_frame);
+		if (cycleEnd(_frame) == true) {
+			break;
+		}
+		if (_frame.m_interpreter->getProfiler().isPending() == true) {
+			_frame.m_interpreter->getProfiler().sample(*_frame.m_stack);
+		}
+	} while (m_condition->execute(_frame).isTrue() == true);
+	return eci::Value();
+}
+
+bool eci::interpreter::Switch::prepare() {
+	m_table.clear();
+	m_sorted.clear();
+	for (auto &it : m_cases) {
+		if (    it.m_value == null
+		     || it.m_value->getTockenId() != eci::interpreter::typeConstant) {
+			ECI_ERROR("The value of a 'case' must be a constant");
+			return false;
+		}
+		const eci::Value& value = static_cast<eci::interpreter::Constant*>(it.m_value.get())->m_value;
+		if (    value.m_type == eci::valueTypeVoid
+		     || value.m_type >= eci::valueTypeFloat) {
+			ECI_ERROR("The value of a 'case' must be an integer : " << value.toString());
+			return false;
+		}
+		// insertion in the sorted list (the labels are checked once)
+		etk::Pair<int64_t, int32_t> label(value.get<int64_t>(), it.m_block);
+		size_t pos = m_sorted.size();
+		while (    pos > 0
+		        && m_sorted[pos-1].first >= label.first) {
+			--pos;
+		}
+		if (    pos < m_sorted.size()
+		     && m_sorted[pos].first == label.first) {
+			ECI_ERROR("Duplicate 'case' value : " << label.first);
+			return false;
+		}
+		m_sorted.insert(pos, label);
+	}
+	if (m_sorted.size() == 0) {
+		return true;
+	}
+	m_minimum = m_sorted.front().first;
+	// the range is computed in unsigned: the labels can use all the int64 values
+	uint64_t range = uint64_t(m_sorted.back().first) - uint64_t(m_minimum);
+	if (    range < uint64_t(maxTableSize)
+	     && range < uint64_t(tableDensity) * m_sorted.size()) {
+		m_table.resize(range+1, m_default);
+		for (auto &it : m_sorted) {
+			m_table[uint64_t(it.first) - uint64_t(m_minimum)] = it.second;
+		}
+	}
+	return true;
+}
+
+int32_t eci::interpreter::Switch::select(int64_t _value) const {
+	if (m_table.size() != 0) {
+		// one unsigned compare check the two bounds
+		uint64_t index = uint64_t(_value) - uint64_t(m_minimum);
+		if (index < m_table.size()) {
+			return m_table[index];
+		}
+		return m_default;
+	}
+	size_t low = 0;
+	size_t high = m_sorted.size();
+	while (low < high) {
+		size_t middle = (low + high) / 2;
+		if (m_sorted[middle].first < _value) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	if (    low < m_sorted.size()
+	     && m_sorted[low].first == _value) {
+		return m_sorted[low].second;
+	}
+	return m_default;
+}
+
+eci::Value eci::interpreter::Switch::execute(eci::Frame& _frame) {
+	eci::Value value = m_value->execute(_frame);
+	if (    value.m_type == eci::valueTypeVoid
+	     || value.m_type >= eci::valueTypeFloat) {
+		ECI_ERROR("The value of a 'switch' must be an integer : " << value.toString());
+		return eci::Value();
+	}
+	int32_t block = select(value.get<int64_t>());
+	if (block < 0) {
+		return eci::Value();
+	}
+	// the next blocks are executed until a "break" (fall through)
+	for (size_t iii=block; iii<m_blocks.size(); ++iii) {
+		m_blocks[iii]->execute(_frame);
+		if (_frame.m_state == eci::frameStateBreak) {
+			_frame.m_state = eci::frameStateNormal;
+			break;
+		}
+		if (_frame.m_state != eci::frameStateNormal) {
+			break;
+		}
+	}
+	return eci::Value();
+}
+
+/**
+ * @brief Get the reference on the slot of a variable element.
+ * @param[in] _frame Frame of the function.
+ * @param[in] _element Variable element.
+ * @return Pointer on the value (null if the element is not a variable).
+ */
+static eci::Value* getReference(eci::Frame& _frame, const ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	if (_element->getTockenId() == eci::interpreter::typeMember) {
+		return static_cast<eci::interpreter::Member*>(_element.get())->getReference(_frame);
+	}
+	if (_element->getTockenId() == eci::interpreter::typeIndex) {
+		return static_cast<eci::interpreter::Index*>(_element.get())->getReference(_frame);
+	}
+	if (_element->getTockenId() != eci::interpreter::typeVariable) {
+		ECI_ERROR("Can not assign a value on an element that is not a variable");
+		return null;
+	}
+	eci::interpreter::Variable* variable = static_cast<eci::interpreter::Variable*>(_element.get());
+	if (variable->m_global == true) {
+		return &_frame.m_interpreter->getGlobal(variable->m_slot);
+	}
+	return &_frame.local(variable->m_slot);
+}
+
+/**
+ * @brief Store a value in a slot with the type of the slot (C assignation).
+ * @param[in] _slot Slot that receive the value.
+ * @param[in] _value New value.
+ * @return The stored value.
+ */
+static const eci::Value& assign(eci::Value& _slot, const eci::Value& _value) {
+	_slot = _value.convert(_slot.m_type);
+	return _slot;
+}
+
+/**
+ * @brief Check if an element is a local variable.
+ * @param[in] _element Element to check.
+ * @return true if the element is a Variable in a slot of the frame.
+ */
+static bool isLocal(const ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	return    _element != null
+	       && _element->getTockenId() == eci::interpreter::typeVariable
+	       && static_cast<eci::interpreter::Variable*>(_element.get())->m_global == false;
+}
+
+/**
+ * @brief Get the slot of a local variable element (the element must be a local Variable).
+ * @param[in] _element Variable element.
+ * @return The slot in the frame.
+ */
+static int32_t getSlot(const ememory::SharedPtr<eci::interpreter::Element>& _element) {
+	return static_cast<eci::interpreter::Variable*>(_element.get())->m_slot;
+}
+
+/**
+ * @brief Check if a tree modify a local variable.
+ * @param[in] _element Root of the tree.
+ * @param[in] _slot Slot of the local variable.
+ * @return true if an operator assign the variable.
+ */
+static bool isModified(const ememory::SharedPtr<eci::interpreter::Element>& _element, int32_t _slot) {
+	if (_element->getTockenId() == eci::interpreter::typeOperator) {
+		ememory::SharedPtr<eci::interpreter::Element> destination = eci::Resolver::getAssignDestination(ememory::staticPointerCast<eci::interpreter::Operator>(_element));
+		if (    isLocal(destination) == true
+		     && getSlot(destination) == _slot) {
+			return true;
+		}
+	}
+	etk::Vector<ememory::SharedPtr<eci::interpreter::Element>> children;
+	eci::interpreter::getChildren(_element, children);
+	for (auto &it : children) {
+		if (isModified(it, _slot) == true) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool eci::interpreter::For::findInduction() {
+	m_induction = -1;
+	if (    m_condition == null
+	     || m_increment == null
+	     || m_block == null
+	     || m_condition->getTockenId() != eci::interpreter::typeOperator
+	     || m_increment->getTockenId() != eci::interpreter::typeOperator) {
+		return false;
+	}
+	eci::interpreter::Operator* condition = static_cast<eci::interpreter::Operator*>(m_condition.get());
+	switch (condition->m_operatorId) {
+		case eci::operatorLess:
+		case eci::operatorLessEqual:
+		case eci::operatorGreater:
+		case eci::operatorGreaterEqual:
+		case eci::operatorNotEqual:
+			break;
+		default:
+			return false;
+	}
+	if (isLocal(condition->m_left) == false) {
+		return false;
+	}
+	int32_t slot = getSlot(condition->m_left);
+	int32_t boundSlot = -1;
+	eci::Value bound;
+	if (isLocal(condition->m_right) == true) {
+		boundSlot = getSlot(condition->m_right);
+		if (boundSlot == slot) {
+			return false;
+		}
+	} else if (    condition->m_right != null
+	            && condition->m_right->getTockenId() == eci::interpreter::typeConstant) {
+		bound = static_cast<eci::interpreter::Constant*>(condition->m_right.get())->m_value;
+		if (    bound.m_type == eci::valueTypeVoid
+		     || bound.m_type >= eci::valueTypeFloat) {
+			return false;
+		}
+	} else {
+		return false;
+	}
+	eci::interpreter::Operator* increment = static_cast<eci::interpreter::Operator*>(m_increment.get());
+	ememory::SharedPtr<eci::interpreter::Element> target;
+	int64_t step = 0;
+	switch (increment->m_operatorId) {
+		case eci::operatorIncrement:
+		case eci::operatorDecrement:
+			target = increment->m_left != null ? increment->m_left : increment->m_right;
+			step = increment->m_operatorId == eci::operatorIncrement ? 1 : -1;
+			break;
+		case eci::operatorAssignAdd:
+		case eci::operatorAssignSub: {
+			target = increment->m_left;
+			if (    increment->m_right == null
+			     || increment->m_right->getTockenId() != eci::interpreter::typeConstant) {
+				return false;
+			}
+			const eci::Value& value = static_cast<eci::interpreter::Constant*>(increment->m_right.get())->m_value;
+			if (    value.m_type == eci::valueTypeVoid
+			     || value.m_type >= eci::valueTypeFloat) {
+				return false;
+			}
+			step = value.get<int64_t>();
+			if (increment->m_operatorId == eci::operatorAssignSub) {
+				step = int64_t(uint64_t(0) - uint64_t(step));
+			}
+			break;
+		}
+		default:
+			return false;
+	}
+	if (    isLocal(target) == false
+	     || getSlot(target) != slot
+	     || isModified(m_block, slot) == true) {
+		return false;
+	}
+	m_induction = slot;
+	m_compare = condition->m_operatorId;
+	m_boundSlot = boundSlot;
+	m_bound = bound;
+	m_step = step;
+	return true;
+}
+
+enum eci::interpreter::fusion eci::interpreter::Operator::fuse() {
+	m_fusion = eci::interpreter::fusionNone;
+	switch (m_operatorId) {
+		case eci::operatorAssign:
+		case eci::operatorAssignAdd:
+		case eci::operatorAssignSub:
+		case eci::operatorAssignMul:
+		case eci::operatorAssignDiv:
+		case eci::operatorAssignMod:
+			if (isLocal(m_left) == true) {
+				m_fusion = eci::interpreter::fusionAssignLocal;
+			}
+			return m_fusion;
+		case eci::operatorIncrement:
+		case eci::operatorDecrement:
+			if (isLocal(m_left != null ? m_left : m_right) == true) {
+				m_fusion = eci::interpreter::fusionIncrementLocal;
+			}
+			return m_fusion;
+		case eci::operatorAnd:
+		case eci::operatorOr:
+		case eci::operatorNot:
+		case eci::operatorNone:
+			// short-circuit and unary operators
+			return m_fusion;
+		default:
+			break;
+	}
+	if (    m_left == null
+	     || m_right == null) {
+		return m_fusion;
+	}
+	if (m_right->getTockenId() == eci::interpreter::typeConstant) {
+		if (isLocal(m_left) == true) {
+			m_fusion = eci::interpreter::fusionLocalConstant;
+		} else {
+			m_fusion = eci::interpreter::fusionElementConstant;
+		}
+	} else if (    isLocal(m_left) == true
+	            && isLocal(m_right) == true) {
+		m_fusion = eci::interpreter::fusionLocalLocal;
+	}
+	return m_fusion;
+}
+
+eci::Value eci::interpreter::Operator::executeBinary(const eci::Value& _left, const eci::Value& _right) {
+	eci::Value result;
+	if (m_feedback.execute(_left, _right, result) == true) {
+		return result;
+	}
+	m_feedback.record(m_operatorId, _left, _right);
+	return eci::callOperator(m_operatorId, _left, _right);
+}
+
+eci::Value eci::interpreter::Operator::execute(eci::Frame& _frame) {
+	switch (m_fusion) {
+		case eci::interpreter::fusionLocalLocal:
+			return executeBinary(_frame.local(getSlot(m_left)), _frame.local(getSlot(m_right)));
+		case eci::interpreter::fusionLocalConstant:
+			return executeBinary(_frame.local(getSlot(m_left)), static_cast<eci::interpreter::Constant*>(m_right.get())->m_value);
+		case eci::interpreter::fusionElementConstant: {
+			eci::Value left = m_left->execute(_frame);
+			return executeBinary(left, static_cast<eci::interpreter::Constant*>(m_right.get())->m_value);
+		}
+		case eci::interpreter::fusionAssignLocal: {
+			eci::Value value = m_right->execute(_frame);
+			// the slot is get after the value: a call can move the stack.
+			eci::Value& slot = _frame.local(getSlot(m_left));
+			if (m_operatorId == eci::operatorAssign) {
+				if (value.m_type == eci::valueTypeObject) {
+					_frame.m_interpreter->getCollector().barrier(value);
+				}
+				return assign(slot, value);
+			}
+			enum eci::operatorId operatorId = eci::getAssignOperator(m_operatorId);
+			eci::Value result;
+			if (m_feedback.execute(slot, value, result) == false) {
+				m_feedback.record(operatorId, slot, value);
+				result = eci::callOperator(operatorId, slot, value);
+			}
+			return assign(slot, result);
+		}
+		case eci::interpreter::fusionIncrementLocal: {
+			eci::Value& slot = _frame.local(getSlot(m_left != null ? m_left : m_right));
+			eci::Value out = slot;
+			if (slot.m_type == eci::valueTypeInt32) {
+				// same result as the operator of the type (computed in unsigned: no overflow)
+				slot.m_int32 = int32_t(uint32_t(slot.m_int32) + (m_operatorId == eci::operatorIncrement ? 1u : uint32_t(-1)));
+			} else {
+				assign(slot, eci::callOperator(m_operatorId, slot));
+			}
+			if (m_left != null) {
+				// postfix
+				return out;
+			}
+			return slot;
+		}
+		case eci::interpreter::fusionProfile:
+			++m_nbExecution;
+			break;
+		default:
+			break;
+	}
+	return executeGeneric(_frame);
+}
+
+eci::Value eci::interpreter::Operator::executeGeneric(eci::Frame& _frame) {
+	switch (m_operatorId) {
+		case eci::operatorAnd:
+			if (m_left->execute(_frame).isTrue() == false) {
+				return eci::Value(false);
+			}
+			return eci::Value(m_right->execute(_frame).isTrue());
+		case eci::operatorOr:
+			if (m_left->execute(_frame).isTrue() == true) {
+				return eci::Value(true);
+			}
+			return eci::Value(m_right->execute(_frame).isTrue());
+		case eci::operatorAssign: {
+			// the right value is computed before getting the slot: a call can move the stack.
+			eci::Value value = m_right->execute(_frame);
+			if (value.m_type != eci::valueTypeObject) {
+				eci::Value* slot = getReference(_frame, m_left);
+				if (slot == null) {
+					return eci::Value();
+				}
+				return assign(*slot, value);
+			}
+			// the object is in a slot while the left side is computed: it is a root for a collection started by a call.
+			eci::Stack& stack = *_frame.m_stack;
+			size_t tmp = stack.reserve(1);
+			stack.get(tmp) = value;
+			eci::Value* slot = getReference(_frame, m_left);
+			stack.release(tmp);
+			if (slot == null) {
+				return eci::Value();
+			}
+			_frame.m_interpreter->getCollector().barrier(value);
+			return assign(*slot, value);
+		}
+		case eci::operatorAssignAdd:
+		case eci::operatorAssignSub:
+		case eci::operatorAssignMul:
+		case eci::operatorAssignDiv:
+		case eci::operatorAssignMod: {
+			eci::Value value = m_right->execute(_frame);
+			eci::Value* slot = getReference(_frame, m_left);
+			if (slot == null) {
+				return eci::Value();
+			}
+			eci::Value result;
+			if (m_feedback.execute(*slot, value, result) == false) {
+				m_feedback.record(eci::getAssignOperator(m_operatorId), *slot, value);
+				result = eci::callOperator(eci::getAssignOperator(m_operatorId), *slot, value);
+			}
+			return assign(*slot, result);
+		}
+		case eci::operatorIncrement:
+		case eci::operatorDecrement: {
+			if (m_left != null) {
+				// postfix
+				eci::Value* slot = getReference(_frame, m_left);
+				if (slot == null) {
+					return eci::Value();
+				}
+				eci::Value out = *slot;
+				assign(*slot, eci::callOperator(m_operatorId, *slot));
+				return out;
+			}
+			eci::Value* slot = getReference(_frame, m_right);
+			if (slot == null) {
+				return eci::Value();
+			}
+			return assign(*slot, eci::callOperator(m_operatorId, *slot));
+		}
+		case eci::operatorNot:
+			return eci::callOperator(m_operatorId, m_right->execute(_frame));
+		case eci::operatorSub:
+			if (m_left == null) {
+				return eci::callOperator(m_operatorId, m_right->execute(_frame));
+			}
+			break;
+		case eci::operatorNone:
+			ECI_ERROR("Unknow operator : '" << m_operator << "'");
+			return eci::Value();
+		default:
+			break;
+	}
+	eci::Value left = m_left->execute(_frame);
+	return executeBinary(left, m_right->execute(_frame));
+}
+
+eci::Value eci::interpreter::Constant::execute(eci::Frame& _frame) {
+	return m_value;
+}
+
+eci::Value eci::interpreter::Literal::execute(eci::Frame& _frame) {
+	return _frame.m_interpreter->getLiteral(m_slot);
+}
+
+eci::Value eci::interpreter::FunctionCall::execute(eci::Frame& _frame) {
+	const eci::Function& function = *_frame.m_interpreter->getFunction(m_functionId);
+	eci::Stack& stack = *_frame.m_stack;
+	// the window of the callee is reserved before the arguments: a call in an argument use the slots over it.
+	size_t base = stack.reserve(function.getFrameSize());
+	const etk::Vector<eci::Variable>& arguments = function.getArguments();
+	for (size_t iii=0; iii<m_arguments.size(); ++iii) {
+		eci::Value value = m_arguments[iii]->execute(_frame);
+		stack.get(base+iii) = value.convert(arguments[iii].getValueType());
+	}
+	eci::Value ret = function.call(*_frame.m_interpreter, base);
+	stack.release(base);
+	return ret;
+}
+
+eci::Value eci::interpreter::Return::execute(eci::Frame& _frame) {
+	if (m_tailCall == true) {
+		eci::interpreter::FunctionCall* call = static_cast<eci::interpreter::FunctionCall*>(m_value.get());
+		const etk::Vector<eci::Variable>& arguments = _frame.m_function->getArguments();
+		eci::Stack& stack = *_frame.m_stack;
+		// all the new arguments are computed before the current ones are replaced
+		size_t base = stack.reserve(arguments.size());
+		for (size_t iii=0; iii<arguments.size(); ++iii) {
+			eci::Value value = call->m_arguments[iii]->execute(_frame);
+			stack.get(base+iii) = value.convert(arguments[iii].getValueType());
+		}
+		for (size_t iii=0; iii<arguments.size(); ++iii) {
+			_frame.local(iii) = stack.get(base+iii);
+		}
+		stack.release(base);
+		// the locals start cleared as in a new call
+		for (size_t iii=arguments.size(); iii<size_t(_frame.m_function->getFrameSize()); ++iii) {
+			_frame.local(iii) = eci::Value();
+		}
+		_frame.m_state = eci::frameStateTailCall;
+		return eci::Value();
+	}
+	if (m_value != null) {
+		_frame.m_return = m_value->execute(_frame);
+	}
+	_frame.m_state = eci::frameStateReturn;
+	return eci::Value();
+}
+
+eci::Value eci::interpreter::Break::execute(eci::Frame& _frame) {
+	_frame.m_state = eci::frameStateBreak;
+	return eci::Value();
+}
+
+eci::Value eci::interpreter::Continue::execute(eci::Frame& _frame) {
+	_frame.m_state = eci::frameStateContinue;
+	return eci::Value();
+}
+
+eci::Value eci::interpreter::Cast::execute(eci::Frame& _frame) {
+	return m_value->execute(_frame).convert(m_valueType);
+}
+
+/**
+ * @brief Get the object referenced by a value.
+ * @param[in] _value Value of the object.
+ * @return The object (null on error).
+ */
+static eci::Object* getObject(const eci::Value& _value) {
+	if (_value.m_type != eci::valueTypeObject) {
+		ECI_ERROR("Access a member of a value that is not an object : " << _value.toString());
+		return null;
+	}
+	if (_value.m_object == null) {
+		ECI_ERROR("Access a member of a null object");
+		return null;
+	}
+	if (_value.m_object->m_fields == null) {
+		ECI_ERROR("Access a member of a deleted object");
+		return null;
+	}
+	return _value.m_object;
+}
+
+eci::Value* eci::interpreter::Member::getReference(eci::Frame& _frame) {
+	eci::Object* object = null;
+	size_t first = 0;
+	if (m_object->getTockenId() == eci::interpreter::typeIndex) {
+		object = static_cast<eci::interpreter::Index*>(m_object.get())->getElement(_frame, first);
+		if (    object != null
+		     && object->m_class->isStructureArray() == false) {
+			// array of pointers: field of the pointed object
+			object = getObject(object->m_fields[first]);
+			first = 0;
+		}
+		// else field of an element of an array of structures (the cache is on the class of the array)
+	} else {
+		object = getObject(m_object->execute(_frame));
+	}
+	if (object == null) {
+		return null;
+	}
+	int32_t offset = m_cache.find(object->m_class);
+	if (offset < 0) {
+		if (    object->m_class->isArray() == true
+		     && m_object->getTockenId() != eci::interpreter::typeIndex) {
+			ECI_ERROR("Access the field '" << m_name << "' of an array without index");
+			return null;
+		}
+		offset = object->m_class->findField(m_name);
+		if (offset < 0) {
+			ECI_ERROR("Class '" << object->m_class->getName() << "' has no field '" << m_name << "'");
+			return null;
+		}
+		m_cache.add(object->m_class, offset);
+		_frame.m_interpreter->addCacheMiss();
+	}
+	return &object->m_fields[first + offset];
+}
+
+eci::Value eci::interpreter::Member::execute(eci::Frame& _frame) {
+	eci::Value* value = getReference(_frame);
+	if (value == null) {
+		return eci::Value();
+	}
+	return *value;
+}
+
+eci::Value eci::interpreter::MethodCall::execute(eci::Frame& _frame) {
+	eci::Value self = m_object->execute(_frame);
+	eci::Object* object = getObject(self);
+	if (object == null) {
+		return eci::Value();
+	}
+	int32_t functionId = m_cache.find(object->m_class);
+	if (functionId < 0) {
+		functionId = object->m_class->findMethod(m_name);
+		if (functionId < 0) {
+			ECI_ERROR("Class '" << object->m_class->getName() << "' has no method '" << m_name << "'");
+			return eci::Value();
+		}
+		size_t nbArgument = _frame.m_interpreter->getFunction(functionId)->getArguments().size()-1;
+		if (nbArgument != m_arguments.size()) {
+			ECI_ERROR("Method '" << m_name << "' need " << nbArgument << " argument(s) and get " << m_arguments.size());
+			return eci::Value();
+		}
+		m_cache.add(object->m_class, functionId);
+		_frame.m_interpreter->addCacheMiss();
+	}
+	const eci::Function& function = *_frame.m_interpreter->getFunction(functionId);
+	eci::Stack& stack = *_frame.m_stack;
+	size_t base = stack.reserve(function.getFrameSize());
+	// the object is the first argument ("this")
+	stack.get(base) = self;
+	const etk::Vector<eci::Variable>& arguments = function.getArguments();
+	for (size_t iii=0; iii<m_arguments.size(); ++iii) {
+		eci::Value value = m_arguments[iii]->execute(_frame);
+		stack.get(base+iii+1) = value.convert(arguments[iii+1].getValueType());
+	}
+	eci::Value ret = function.call(*_frame.m_interpreter, base);
+	stack.release(base);
+	return ret;
+}
+
+eci::Value eci::interpreter::New::execute(eci::Frame& _frame) {
+	if (m_size == null) {
+		return eci::Value(_frame.m_interpreter->createObject(m_class));
+	}
+	eci::Value size = m_size->execute(_frame);
+	if (    size.m_type <= eci::valueTypeBool
+	     || size.m_type >= eci::valueTypeFloat
+	     || size.get<int64_t>() < 0) {
+		ECI_ERROR("The size of an array must be a positive integer : " << size.toString());
+		return eci::Value(static_cast<eci::Object*>(null));
+	}
+	return eci::Value(_frame.m_interpreter->createArray(m_class, size.get<uint64_t>()));
+}
+
+eci::Object* eci::interpreter::Index::getElement(eci::Frame& _frame, size_t& _first) {
+	eci::Value array = m_object->execute(_frame);
+	if (    array.m_type != eci::valueTypeObject
+	     || array.m_object == null
+	     || array.m_object->m_fields == null
+	     || array.m_object->m_class->isArray() == false) {
+		ECI_ERROR("Access an element of a value that is not an array : " << array.toString());
+		return null;
+	}
+	eci::Value index = m_index->execute(_frame);
+	if (    index.m_type <= eci::valueTypeBool
+	     || index.m_type >= eci::valueTypeFloat) {
+		ECI_ERROR("The index of an array must be an integer : " << index.toString());
+		return null;
+	}
+	eci::Object* object = array.m_object;
+	size_t stride = object->m_class->getStride();
+	// a negative index is a big unsigned value
+	uint64_t position = index.get<uint64_t>();
+	if (position >= object->m_nbField / stride) {
+		ECI_ERROR("Index " << index.toString() << " out of the array (size " << object->m_nbField / stride << ")");
+		return null;
+	}
+	_first = position * stride;
+	return object;
+}
+
+eci::Value* eci::interpreter::Index::getReference(eci::Frame& _frame) {
+	size_t first = 0;
+	eci::Object* object = getElement(_frame, first);
+	if (object == null) {
+		return null;
+	}
+	if (object->m_class->isStructureArray() == true) {
+		ECI_ERROR("An element of an array of structures is not a value (access one of its fields)");
+		return null;
+	}
+	return &object->m_fields[first];
+}
+
+eci::Value eci::interpreter::Index::execute(eci::Frame& _frame) {
+	eci::Value* value = getReference(_frame);
+	if (value == null) {
+		return eci::Value();
+	}
+	return *value;
+}
+
+eci::Value eci::interpreter::Delete::execute(eci::Frame& _frame) {
+	eci::Value value = m_value->execute(_frame);
+	if (value.isTrue() == false) {
+		// delete a null pointer does nothing
+		return eci::Value();
+	}
+	if (value.m_type != eci::valueTypeObject) {
+		ECI_ERROR("Delete a value that is not an object : " << value.toString());
+		return eci::Value();
+	}
+	_frame.m_interpreter->destroyObject(value.m_object);
+	return eci::Value();
+}
@@ -0,0 +1,534 @@
+/**
+ * @author Edouard DUPIN
+ * @copyright 2014, Edouard DUPIN, all right reserved
+ * @license MPL-2 (see license file)
+ */
+
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/Vector.hpp>
+#include <etk/Pair.hpp>
+#include <ememory/memory.hpp>
+#include <eci/Value.hpp>
+#include <eci/Type.hpp>
+#include <eci/InlineCache.hpp>
+#include <eci/TypeFeedback.hpp>
+
+namespace eci {
+	class Frame;
+	class Class;
+	namespace interpreter {
+		enum type {
+			typeBlock, //!< block area definition
+			typeType, //!< type definition
+			typeVariable, //!< new variable use
+			typeVariableDeclaration, //!< new variable definition
+			typeFunction, //!< function definition
+			typeClass, //!< Class definition
+			typeNamespace, //!< Namespace definition
+			typeCondition, //!< Classicle condition (with else)
+			typeFor, //!< classicle C cycle (init, inc, condition)
+			typeWhile, //!< Call a cycle (option action previous condition or condition previous action)
+			typeOperator, //!< Call operator "xx" ex : "*" "++" "=" "=="
+			typeConstant, //!< Constant value (number, boolean ...)
+			typeFunctionCall, //!< Call a function "xxx(...)"
+			typeReturn, //!< return from the current function
+			typeBreak, //!< break the current cycle
+			typeContinue, //!< continue the current cycle
+			typeCast, //!< Cast a value in an other type "(xxx)yyy"
+			typeMember, //!< Field of an object "xxx.yyy"
+			typeMethodCall, //!< Call a method of an object "xxx.yyy(...)"
+			typeNew, //!< Create an object "new xxx"
+			typeDelete, //!< Release an object "delete xxx"
+			typeSwitch, //!< Select the actions of a label "switch (xxx) { case yyy: ... }"
+			typeIndex, //!< Element of an array "xxx[yyy]"
+			typeLiteral, //!< Constant string "xxx" (object of the interpreter)
+			typeReserveId = 5000,
+		};
+		class Element : public ememory::EnableSharedFromThis<Element> {
+			protected:
+				int32_t m_tockenId;
+			public:
+				int32_t getTockenId() {
+					return m_tockenId;
+				}
+			public:
+				Element(int32_t _tockenId=-1) :
+				  m_tockenId(_tockenId) {
+					
+				}
+				virtual ~Element() {}
+				/**
+				 * @brief Execute the element.
+				 * @param[in] _frame Frame of the function that execute the element.
+				 * @return The value of the element (void value for an action).
+				 */
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		class Block : public Element {
+			public:
+				etk::Vector<ememory::SharedPtr<Element>> m_actions;
+			public:
+				Block() :
+				  Element(interpreter::typeBlock) {
+					
+				}
+				virtual ~Block() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		class Type : public Element {
+			protected:
+			
+			public:
+				Type() :
+				  Element(interpreter::typeType) {
+					
+				}
+				virtual ~Type() {}
+		};
+		class Variable : public Element {
+			public:
+				etk::String m_name; //!< Name of the variable (only used by the resolver).
+				bool m_global; //!< The slot is in the global table (not in the current frame).
+				int32_t m_slot; //!< Slot of the variable (set by the resolver, -1 if unresolved).
+			public:
+				Variable(const etk::String& _name="") :
+				  Element(interpreter::typeVariable),
+				  m_name(_name),
+				  m_global(false),
+				  m_slot(-1) {
+					
+				}
+				virtual ~Variable() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		class VariableDeclaration : public Element {
+			public:
+				etk::String m_name; //!< Name of the new variable.
+				etk::String m_typeName; //!< Name of the type ("int", "unsigned int", "auto" ...).
+				bool m_const; //!< The variable is declared const.
+				enum eci::valueType m_valueType; //!< Type of the variable (set by the resolver, void for "auto").
+				const eci::Class* m_class; //!< Class of the variable (set by the resolver, null for a native type).
+				ememory::SharedPtr<Element> m_init; //!< Initialisation value (can be null).
+				bool m_global; //!< The slot is in the global table (not in the current frame).
+				int32_t m_slot; //!< Slot of the variable (set by the resolver, -1 if unresolved).
+			public:
+				VariableDeclaration() :
+				  Element(interpreter::typeVariableDeclaration),
+				  m_const(false),
+				  m_valueType(eci::valueTypeVoid),
+				  m_class(null),
+				  m_global(false),
+				  m_slot(-1) {
+					
+				}
+				virtual ~VariableDeclaration() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		class Function : public Element {
+			protected:
+			
+			public:
+				Function() :
+				  Element(interpreter::typeFunction) {
+					
+				}
+				virtual ~Function() {}
+		};
+		class Class : public Element {
+			protected:
+			
+			public:
+				Class() :
+				  Element(interpreter::typeClass) {
+					
+				}
+				virtual ~Class() {}
+		};
+		class Namespace : public Element {
+			protected:
+			
+			public:
+				Namespace() :
+				  Element(interpreter::typeNamespace) {
+					
+				}
+				virtual ~Namespace() {}
+		};
+		class Condition : public Element {
+			public:
+				ememory::SharedPtr<Element> m_condition;
+				ememory::SharedPtr<Block> m_block;
+				ememory::SharedPtr<Block> m_blockElse;
+			public:
+				Condition() :
+				  Element(interpreter::typeCondition) {
+					
+				}
+				virtual ~Condition() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		
+		};
+		class For : public Element {
+			public:
+				ememory::SharedPtr<Element> m_init;
+				ememory::SharedPtr<Element> m_condition;
+				ememory::SharedPtr<Element> m_increment;
+				ememory::SharedPtr<Block> m_block;
+				// counted loop (see @ref findInduction)
+				int32_t m_induction; //!< Slot of the local induction variable (-1: the condition and the increment are executed).
+				enum eci::operatorId m_compare; //!< Compare of the induction variable with the bound.
+				int32_t m_boundSlot; //!< Slot of the local bound (-1: the bound is m_bound).
+				eci::Value m_bound; //!< Constant bound.
+				int64_t m_step; //!< Value added to the induction variable by the increment.
+			public:
+				For() :
+				  Element(interpreter::typeFor),
+				  m_induction(-1),
+				  m_compare(eci::operatorNone),
+				  m_boundSlot(-1),
+				  m_step(0) {
+					
+				}
+				virtual ~For() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+				/**
+				 * @brief Select the counted loop execution (must be called when the elements are final): the condition is
+				 * "local op bound" (op: <, <=, >, >= or !=, bound: local or integer constant), the increment add an integer constant
+				 * to the local ("++i", "i--", "i += 2" ...) and the block never modify it. When the local and the bound have the
+				 * same integer type at the start of the loop, the induction variable is kept in a native integer: the condition
+				 * and the increment are not executed as elements (the local is only written for the block).
+				 * @return true if the loop is a counted loop.
+				 */
+				bool findInduction();
+		
+		};
+		class While : public Element {
+			public:
+				bool m_conditionAtStart;
+				ememory::SharedPtr<Element> m_condition;
+				ememory::SharedPtr<Element> m_action;
+			public:
+				While() :
+				  Element(interpreter::typeWhile),
+				  m_conditionAtStart(true) {
+					
+				}
+				virtual ~While() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		/**
+		 * @brief "switch (xxx) { case yyy: ... default: ... }": the actions are split in blocks at each label position and the
+		 * execution start at the block of the selected label (the next blocks are executed until a "break").
+		 * The labels are integer constants: when they are dense the block is read in a table indexed by the value (O(1)),
+		 * else it is searched in the sorted labels (O(log n)), the labels are never compared one by one.
+		 */
+		class Switch : public Element {
+			public:
+				static const int64_t tableDensity = 2; //!< The table is used when it has at most this number of entries per label.
+				static const int64_t maxTableSize = 4096; //!< Max number of entries of the table.
+				/**
+				 * @brief Label "case yyy:" of the switch.
+				 */
+				class Case {
+					public:
+						ememory::SharedPtr<Element> m_value; //!< Value of the label (a Constant after the resolution).
+						int32_t m_block; //!< Index of the first block executed for this label.
+					public:
+						Case(const ememory::SharedPtr<Element>& _value=null, int32_t _block=0) :
+						  m_value(_value),
+						  m_block(_block) {
+							
+						}
+				};
+			public:
+				ememory::SharedPtr<Element> m_value; //!< Selection value (an integer).
+				etk::Vector<ememory::SharedPtr<Block>> m_blocks; //!< Actions after each label position (in the declaration order).
+				etk::Vector<Case> m_cases; //!< Labels "case yyy:" in the declaration order.
+				int32_t m_default; //!< Block of the label "default:" (-1 if there is no default label).
+			private:
+				int64_t m_minimum; //!< Value of the first entry of the table.
+				etk::Vector<int32_t> m_table; //!< Block of each value from m_minimum (empty when the labels are sparse).
+				etk::Vector<etk::Pair<int64_t, int32_t>> m_sorted; //!< Value and block of the labels sorted by value.
+			public:
+				Switch() :
+				  Element(interpreter::typeSwitch),
+				  m_default(-1),
+				  m_minimum(0) {
+					
+				}
+				virtual ~Switch() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+				/**
+				 * @brief Create the dispatch of the labels (must be called when all the label values are Constant).
+				 * @return false if a label is not an integer constant or is used twice.
+				 */
+				bool prepare();
+				/**
+				 * @brief Get the block selected by a value.
+				 * @param[in] _value Value of the switch.
+				 * @return Index of the first executed block (-1 if no block is executed).
+				 */
+				int32_t select(int64_t _value) const;
+				/**
+				 * @brief Check if the labels are selected with a table.
+				 * @return true if the table is used, false if the labels are searched.
+				 */
+				bool isDense() const {
+					return m_table.size() != 0;
+				}
+				/**
+				 * @brief Get the labels sorted by value.
+				 * @return The value and the block of each label.
+				 */
+				const etk::Vector<etk::Pair<int64_t, int32_t>>& getSortedCases() const {
+					return m_sorted;
+				}
+				/**
+				 * @brief Get the value of the first entry of the table.
+				 * @return The smaller label value.
+				 */
+				int64_t getMinimum() const {
+					return m_minimum;
+				}
+				/**
+				 * @brief Get the table of the dense labels.
+				 * @return The block of each value from @ref getMinimum (the default block for a value without label).
+				 */
+				const etk::Vector<int32_t>& getTable() const {
+					return m_table;
+				}
+		};
+		/**
+		 * @brief Superinstruction of an operator site (selected by the optimizer): the fused operands are read
+		 * directly in their slot or in the constant, without the execution of their element.
+		 */
+		enum fusion {
+			fusionNone, //!< the operands are executed
+			fusionLocalLocal, //!< "local op local"
+			fusionLocalConstant, //!< "local op constant"
+			fusionElementConstant, //!< "xxx op constant" (the left operand is executed)
+			fusionAssignLocal, //!< "local = xxx" and "local op= xxx"
+			fusionIncrementLocal, //!< "++local", "local++", "--local" and "local--"
+			fusionProfile, //!< the operands are executed and the executions are counted (see @ref eci::Optimizer::setProfile)
+		};
+		class Operator : public Element {
+			public:
+				etk::String m_operator;
+				enum eci::operatorId m_operatorId; //!< Id of the operator (no string compare at the execution).
+				ememory::SharedPtr<Element> m_left; //!< left operand (null for a prefix unary operator).
+				ememory::SharedPtr<Element> m_right; //!< right operand (null for a postfix unary operator).
+				eci::TypeFeedback m_feedback; //!< Types of the operands seen on this site (binary and compound assignment operators).
+				enum fusion m_fusion; //!< Superinstruction of the site.
+				size_t m_nbExecution; //!< Number of executions (only counted with fusionProfile).
+			public:
+				Operator(const etk::String& _operator="") :
+				  Element(interpreter::typeOperator),
+				  m_operator(_operator),
+				  m_operatorId(eci::getOperatorId(_operator)),
+				  m_fusion(interpreter::fusionNone),
+				  m_nbExecution(0) {
+					
+				}
+				virtual ~Operator() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+				/**
+				 * @brief Select the superinstruction of the site with its operands (must be called when the operands are final).
+				 * @return The selected superinstruction (fusionNone if the operands can not be fused).
+				 */
+				enum fusion fuse();
+			private:
+				eci::Value executeBinary(const eci::Value& _left, const eci::Value& _right);
+				eci::Value executeGeneric(eci::Frame& _frame);
+		};
+		class Constant : public Element {
+			public:
+				eci::Value m_value; //!< Value of the constant.
+			public:
+				Constant(const eci::Value& _value=eci::Value()) :
+				  Element(interpreter::typeConstant),
+				  m_value(_value) {
+					
+				}
+				virtual ~Constant() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		/**
+		 * @brief Constant string "xxx": the string is an object of each interpreter (see @ref eci::Interpreter::getLiteral),
+		 * created at the first execution and interned (the literals with the same text are the same object).
+		 */
+		class Literal : public Element {
+			public:
+				etk::String m_value; //!< Text of the string (escape sequences replaced).
+				int32_t m_slot; //!< Slot of the literal in the interpreter (set by the resolver, -1 if unresolved).
+			public:
+				Literal(const etk::String& _value="") :
+				  Element(interpreter::typeLiteral),
+				  m_value(_value),
+				  m_slot(-1) {
+					
+				}
+				virtual ~Literal() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		class FunctionCall : public Element {
+			public:
+				etk::String m_name; //!< Name of the function (only used by the resolver).
+				etk::Vector<ememory::SharedPtr<Element>> m_arguments; //!< Argument list.
+				int32_t m_functionId; //!< Index of the function in the interpreter (set by the resolver, -1 if unresolved).
+			public:
+				FunctionCall(const etk::String& _name="") :
+				  Element(interpreter::typeFunctionCall),
+				  m_name(_name),
+				  m_functionId(-1) {
+					
+				}
+				virtual ~FunctionCall() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		class Return : public Element {
+			public:
+				ememory::SharedPtr<Element> m_value; //!< returned value (can be null).
+				bool m_tailCall; //!< The value is a call of the current function (set by the optimizer): the arguments replace the ones of the frame and the body is executed again, without new frame.
+			public:
+				Return() :
+				  Element(interpreter::typeReturn),
+				  m_tailCall(false) {
+					
+				}
+				virtual ~Return() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		class Break : public Element {
+			public:
+				Break() :
+				  Element(interpreter::typeBreak) {
+					
+				}
+				virtual ~Break() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		class Continue : public Element {
+			public:
+				Continue() :
+				  Element(interpreter::typeContinue) {
+					
+				}
+				virtual ~Continue() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		class Cast : public Element {
+			public:
+				etk::String m_typeName; //!< Name of the destination type.
+				enum eci::valueType m_valueType; //!< Destination type (set by the resolver).
+				ememory::SharedPtr<Element> m_value; //!< Value to convert.
+			public:
+				Cast(const etk::String& _typeName="") :
+				  Element(interpreter::typeCast),
+				  m_typeName(_typeName),
+				  m_valueType(eci::valueTypeVoid) {
+					
+				}
+				virtual ~Cast() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		class Member : public Element {
+			public:
+				ememory::SharedPtr<Element> m_object; //!< Object that own the field.
+				etk::String m_name; //!< Name of the field.
+				eci::InlineCache m_cache; //!< Offset of the field for the classes seen on this access.
+			public:
+				Member(const etk::String& _name="") :
+				  Element(interpreter::typeMember),
+				  m_name(_name) {
+					
+				}
+				virtual ~Member() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+				/**
+				 * @brief Get the field of the object.
+				 * @param[in] _frame Frame of the function that execute the element.
+				 * @return Pointer on the value of the field (null on error).
+				 */
+				eci::Value* getReference(eci::Frame& _frame);
+		};
+		class MethodCall : public Element {
+			public:
+				ememory::SharedPtr<Element> m_object; //!< Object on which the method is called.
+				etk::String m_name; //!< Name of the method.
+				etk::Vector<ememory::SharedPtr<Element>> m_arguments; //!< Argument list (without the object).
+				eci::InlineCache m_cache; //!< Index of the function for the classes seen on this call.
+			public:
+				MethodCall(const etk::String& _name="") :
+				  Element(interpreter::typeMethodCall),
+				  m_name(_name) {
+					
+				}
+				virtual ~MethodCall() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		class New : public Element {
+			public:
+				etk::String m_className; //!< Name of the class (only used by the resolver), type of the elements for an array.
+				const eci::Class* m_class; //!< Class of the object (set by the resolver), class "xxx[]" for an array.
+				ememory::SharedPtr<Element> m_size; //!< Number of elements of an array "new xxx[yyy]" (null for an object).
+			public:
+				New(const etk::String& _className="") :
+				  Element(interpreter::typeNew),
+				  m_className(_className),
+				  m_class(null) {
+					
+				}
+				virtual ~New() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		/**
+		 * @brief Element of an array "xxx[yyy]": a native element is a value ("values[i] += 2"), the element of an
+		 * array of structures is only used by a field access ("points[i].x"): the field is read at the offset
+		 * i * stride + offset of the field, in the block of the array (see @ref eci::Class::isArray).
+		 */
+		class Index : public Element {
+			public:
+				ememory::SharedPtr<Element> m_object; //!< Array.
+				ememory::SharedPtr<Element> m_index; //!< Index of the element (integer).
+			public:
+				Index() :
+				  Element(interpreter::typeIndex) {
+					
+				}
+				virtual ~Index() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+				/**
+				 * @brief Get the native element of the array.
+				 * @param[in] _frame Frame of the function that execute the element.
+				 * @return Pointer on the value of the element (null on error).
+				 */
+				eci::Value* getReference(eci::Frame& _frame);
+				/**
+				 * @brief Get the position of the element in the array (for a field access).
+				 * @param[in] _frame Frame of the function that execute the element.
+				 * @param[out] _first Index of the first field of the element in the fields of the array.
+				 * @return The array (null on error).
+				 */
+				eci::Object* getElement(eci::Frame& _frame, size_t& _first);
+		};
+		class Delete : public Element {
+			public:
+				ememory::SharedPtr<Element> m_value; //!< Object to release.
+			public:
+				Delete() :
+				  Element(interpreter::typeDelete) {
+					
+				}
+				virtual ~Delete() {}
+				virtual eci::Value execute(eci::Frame& _frame);
+		};
+		/**
+		 * @brief Get the sub-elements of an element.
+		 * @param[in] _element Element to parse.
+		 * @param[out] _children List of the sub-elements (not null).
+		 */
+		void getChildren(const ememory::SharedPtr<Element>& _element, etk::Vector<ememory::SharedPtr<Element>>& _children);
+	}
+}
@@ -5,50 +5,64 @@
  */
 
 #include <eci/lang/ParserCpp.hpp>
+#include <eci/Container.hpp>
 #include <eci/debug.hpp>
+#include <chrono>
 
 
-eci::ParserCpp::ParserCpp() {
-	m_lexer.append(tokenCppCommentMultiline, "/\\*(.|\\r|\\n)*?(\\*/|\\0)");
-	m_lexer.append(tokenCppCommentSingleLine, "//.*");
-	m_lexer.append(tokenCppPreProcessor, "#(.|\\\\[\\\\\\n])*");
-	m_lexer.appendSub(tokenCppPreProcessor, tokenCppPreProcessorIf, "\\bif\\b");
-	m_lexer.appendSub(tokenCppPreProcessor, tokenCppPreProcessorElse, "\\belse\\b");
-	m_lexer.appendSub(tokenCppPreProcessor, tokenCppPreProcessorEndif, "\\bendif\\b");
-	m_lexer.appendSub(tokenCppPreProcessor, tokenCppPreProcessorIfdef, "\\bifdef\\b");
-	m_lexer.appendSub(tokenCppPreProcessor, tokenCppPreProcessorIfndef, "\\bifndef\\b");
-	m_lexer.appendSub(tokenCppPreProcessor, tokenCppPreProcessorDefine, "\\bdefine\\b");
-	m_lexer.appendSub(tokenCppPreProcessor, tokenCppPreProcessorWarning, "\\bwarning\\b");
-	m_lexer.appendSub(tokenCppPreProcessor, tokenCppPreProcessorError, "\\berror\\b");
-	m_lexer.appendSub(tokenCppPreProcessor, tokenCppPreProcessorInclude, "\\binclude\\b");
-	m_lexer.appendSub(tokenCppPreProcessor, tokenCppPreProcessorImport, "\\bimport\\b"); // specific to c++ interpreted
+eci::ParserCpp::ParserCpp(const ememory::SharedPtr<eci::Lexer>& _lexer) :
+  m_lexer(_lexer),
+  m_timeLex(0),
+  m_timeParse(0) {
+	if (m_lexer == null) {
+		m_lexer = createLexer();
+	}
+}
+
+ememory::SharedPtr<eci::Lexer> eci::ParserCpp::createLexer() {
+	ememory::SharedPtr<eci::Lexer> lexer = ememory::makeShared<eci::Lexer>();
+	lexer->append(tokenCppCommentMultiline, "/\\*(.|\\r|\\n)*?(\\*/|\\0)");
+	lexer->append(tokenCppCommentSingleLine, "//.*");
+	lexer->append(tokenCppPreProcessor, "#(.|\\\\[\\\\\\n])*");
+	lexer->appendSub(tokenCppPreProcessor, tokenCppPreProcessorIf, "\\bif\\b");
+	lexer->appendSub(tokenCppPreProcessor, tokenCppPreProcessorElse, "\\belse\\b");
+	lexer->appendSub(tokenCppPreProcessor, tokenCppPreProcessorEndif, "\\bendif\\b");
+	lexer->appendSub(tokenCppPreProcessor, tokenCppPreProcessorIfdef, "\\bifdef\\b");
+	lexer->appendSub(tokenCppPreProcessor, tokenCppPreProcessorIfndef, "\\bifndef\\b");
+	lexer->appendSub(tokenCppPreProcessor, tokenCppPreProcessorDefine, "\\bdefine\\b");
+	lexer->appendSub(tokenCppPreProcessor, tokenCppPreProcessorWarning, "\\bwarning\\b");
+	lexer->appendSub(tokenCppPreProcessor, tokenCppPreProcessorError, "\\berror\\b");
+	lexer->appendSub(tokenCppPreProcessor, tokenCppPreProcessorInclude, "\\binclude\\b");
+	lexer->appendSub(tokenCppPreProcessor, tokenCppPreProcessorImport, "\\bimport\\b"); // specific to c++ interpreted
 	//m_lexer.appendSubSection(tokenCppPreProcessor, tokenCppPreProcessorSectionPthese, "\\(", "\\)");
-	m_lexer.append(tokenCppStringDoubleQuote, "\"(.|\\\\[\\\\\"])*?\"");
-	m_lexer.append(tokenCppStringSimpleQuote, "'\\?.'");
-	m_lexer.append(tokenCppBraceIn, "\\{");
-	m_lexer.append(tokenCppBraceOut, "\\}");
-	m_lexer.append(tokenCppPtheseIn, "\\(");
-	m_lexer.append(tokenCppPtheseOut, "\\)");
-	m_lexer.append(tokenCppHookIn, "\\[");
-	m_lexer.append(tokenCppHookOut, "\\]");
-	m_lexer.append(tokenCppBranch, "\\b(return|goto|if|else|case|default|break|continue|while|do|for)\\b");
-	m_lexer.append(tokenCppSystem, "\\b(new|delete|try|catch)\\b");
-	m_lexer.append(tokenCppType, "\\b(bool|char(16_t|32_t)?|double|float|u?int(8|16|32|64|128)?(_t)?|long|short|signed|size_t|unsigned|void)\\b");
-	m_lexer.append(tokenCppVisibility, "\\b(inline|const|virtual|private|public|protected|friend|const|extern|register|static|volatile)\\b");
-	m_lexer.append(tokenCppContener, "\\b(class|namespace|struct|union|enum)\\b");
-	m_lexer.append(tokenCppTypeDef, "\\btypedef\\b");
-	m_lexer.append(tokenCppAuto, "\\bauto\\b");
-	m_lexer.append(tokenCppNullptr, "\\b(NULL|null)\\b");
-	m_lexer.append(tokenCppSystemDefine, "\\b__(LINE|DATA|FILE|func|TIME|STDC)__\\b");
-	m_lexer.append(tokenCppNumericValue, "\\b(((0(x|X)[0-9a-fA-F]*)|(\\d+\\.?\\d*|\\.\\d+)((e|E)(\\+|\\-)?\\d+)?)(L|l|UL|ul|u|U|F|f)?)\\b");
-	m_lexer.append(tokenCppBoolean, "\\b(true|false)\\b");
-	m_lexer.append(tokenCppCondition, "==|>=|<=|!=|<|>|&&|\\|\\|");
-	m_lexer.append(tokenCppAssignation, "(\\+=|-=|\\*=|/=|=|\\*|/|--|-|\\+\\+|\\+|&)");
-	m_lexer.append(tokenCppString, "\\w+");
-	m_lexer.append(tokenCppSeparator, "(;|,|::|:)");
-	m_lexer.appendSection(tokenCppSectionBrace, tokenCppBraceIn, tokenCppBraceOut, "{}");
-	m_lexer.appendSection(tokenCppSectionPthese, tokenCppPtheseIn, tokenCppPtheseOut, "()");
-	m_lexer.appendSection(tokenCppSectionHook, tokenCppHookIn, tokenCppHookOut, "[]");
+	lexer->append(tokenCppStringDoubleQuote, "\"(.|\\\\[\\\\\"\\n])*?\"");
+	lexer->append(tokenCppStringSimpleQuote, "'(\\\\.|[^\\\\'])'");
+	lexer->append(tokenCppBraceIn, "\\{");
+	lexer->append(tokenCppBraceOut, "\\}");
+	lexer->append(tokenCppPtheseIn, "\\(");
+	lexer->append(tokenCppPtheseOut, "\\)");
+	lexer->append(tokenCppHookIn, "\\[");
+	lexer->append(tokenCppHookOut, "\\]");
+	lexer->append(tokenCppBranch, "\\b(return|goto|if|else|switch|case|default|break|continue|while|do|for)\\b");
+	lexer->append(tokenCppSystem, "\\b(new|delete|try|catch)\\b");
+	lexer->append(tokenCppType, "\\b(bool|char(16_t|32_t)?|double|float|u?int(8|16|32|64|128)?(_t)?|long|short|signed|size_t|unsigned|void)\\b");
+	lexer->append(tokenCppVisibility, "\\b(inline|const|virtual|private|public|protected|friend|const|extern|register|static|volatile)\\b");
+	lexer->append(tokenCppContener, "\\b(class|namespace|struct|union|enum)\\b");
+	lexer->append(tokenCppTypeDef, "\\btypedef\\b");
+	lexer->append(tokenCppAuto, "\\bauto\\b");
+	lexer->append(tokenCppNullptr, "\\b(NULL|null)\\b");
+	lexer->append(tokenCppSystemDefine, "\\b__(LINE|DATA|FILE|func|TIME|STDC)__\\b");
+	lexer->append(tokenCppNumericValue, "\\b(((0(x|X)[0-9a-fA-F]*)|(\\d+\\.?\\d*|\\.\\d+)((e|E)(\\+|\\-)?\\d+)?)(L|l|UL|ul|u|U|F|f)?)\\b");
+	lexer->append(tokenCppBoolean, "\\b(true|false)\\b");
+	lexer->append(tokenCppMember, "\\.|->");
+	lexer->append(tokenCppCondition, "==|>=|<=|!=|<|>|&&|\\|\\|");
+	lexer->append(tokenCppAssignation, "(\\+=|-=|\\*=|/=|%=|=|\\*|/|%|--|-|\\+\\+|\\+|&|!)");
+	lexer->append(tokenCppString, "\\w+");
+	lexer->append(tokenCppSeparator, "(;|,|::|:)");
+	lexer->appendSection(tokenCppSectionBrace, tokenCppBraceIn, tokenCppBraceOut, "{}");
+	lexer->appendSection(tokenCppSectionPthese, tokenCppPtheseIn, tokenCppPtheseOut, "()");
+	lexer->appendSection(tokenCppSectionHook, tokenCppHookIn, tokenCppHookOut, "[]");
+	return lexer;
 }
 
 eci::ParserCpp::~ParserCpp() {
@@ -73,12 +87,23 @@ static void printNode(const etk::String& _data, const etk::Vector<ememory::Share
 	}
 }
 
-bool eci::ParserCpp::parse(const etk::String& _data) {
-	m_result = m_lexer.interprete(_data);
+eci::ParserCppBody::ParserCppBody(const ememory::SharedPtr<eci::ParserCpp>& _parser, const ememory::SharedPtr<eci::LexerNode>& _node) :
+  m_parser(_parser),
+  m_node(_node) {
 	
-	// TODO: Agregate type
-	// TODO: Agregate Action
-	// TODO: Agregate Function
+}
+
+ememory::SharedPtr<eci::interpreter::Block> eci::ParserCppBody::parse() {
+	return m_parser->parseBlock(m_node);
+}
+
+bool eci::ParserCpp::parse(const etk::String& _data) {
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	m_data = _data;
+	m_lineStart.clear();
+	m_result = m_lexer->interprete(_data);
+	std::chrono::steady_clock::time_point lexTime = std::chrono::steady_clock::now();
+	m_timeLex = std::chrono::duration_cast<std::chrono::microseconds>(lexTime-startTime).count();
 	
 	ECI_INFO("find :");
 	printNode(_data, m_result.m_list);
@@ -87,6 +112,1209 @@ bool eci::ParserCpp::parse(const etk::String& _data) {
 		ECI_INFO("    start=" << it->getStartPos() << " stop=" << it->getStopPos() << " data='" <<etk::String(_data, it->getStartPos(), it->getStopPos()-it->getStartPos()) << "'" );
 	}
 	*/
+	m_listFunction.clear();
+	m_listClass.clear();
+	m_listClassName.clear();
+	m_listVariable.clear();
+	m_listImport.clear();
+	m_init = ememory::makeShared<eci::interpreter::Block>();
+	NodeList nodes;
+	for (auto &it : m_result.m_list) {
+		if (    it != null
+		     && it->getTockenId() == tokenCppPreProcessor) {
+			if (parseImport(it) == false) {
+				return false;
+			}
+			continue;
+		}
+		if (    it == null
+		     || it->getTockenId() == tokenCppCommentMultiline
+		     || it->getTockenId() == tokenCppCommentSingleLine) {
+			continue;
+		}
+		nodes.pushBack(it);
+	}
+	bool ret = parseGlobal(nodes);
+	m_timeParse = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-lexTime).count();
+	return ret;
+}
+
+etk::String eci::ParserCpp::getValue(const ememory::SharedPtr<eci::LexerNode>& _node) const {
+	return etk::String(m_data, _node->getStartPos(), _node->getStopPos()-_node->getStartPos());
+}
+
+int32_t eci::ParserCpp::getLine(const ememory::SharedPtr<eci::LexerNode>& _node) const {
+	if (m_lineStart.size() == 0) {
+		m_lineStart.pushBack(0);
+		for (size_t iii=0; iii<m_data.size(); ++iii) {
+			if (m_data[iii] == '\n') {
+				m_lineStart.pushBack(iii+1);
+			}
+		}
+	}
+	// number of lines started before the node
+	size_t low = 0;
+	size_t high = m_lineStart.size();
+	while (low < high) {
+		size_t middle = (low + high) / 2;
+		if (m_lineStart[middle] <= _node->getStartPos()) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return etk::max(int32_t(low), 1);
+}
+
+bool eci::ParserCpp::parseImport(const ememory::SharedPtr<eci::LexerNode>& _node) {
+	// other directives are ignored
+	etk::String value = getValue(_node);
+	size_t pos = 1;
+	while (    pos < value.size()
+	        && (    value[pos] == ' '
+	             || value[pos] == '\t')) {
+		++pos;
+	}
+	if (etk::String(value, pos, 6) != "import") {
+		return true;
+	}
+	// #import "libxxx.so" or #import <libxxx.so>
+	pos += 6;
+	while (    pos < value.size()
+	        && value[pos] != '"'
+	        && value[pos] != '<') {
+		++pos;
+	}
+	if (pos >= value.size()) {
+		ECI_ERROR("line " << getLine(_node) << " : Need a library name after '#import'");
+		return false;
+	}
+	char endChar = value[pos] == '<' ? '>' : '"';
+	size_t start = ++pos;
+	while (    pos < value.size()
+	        && value[pos] != endChar) {
+		++pos;
+	}
+	if (    pos >= value.size()
+	     || pos == start) {
+		ECI_ERROR("line " << getLine(_node) << " : Wrong library name after '#import'");
+		return false;
+	}
+	m_listImport.pushBack(etk::String(value, start, pos-start));
+	if (m_listImport.back() == eci::Container::libraryName) {
+		// the classes of the builtin library are used as types in the declarations
+		for (auto &it : eci::Container::getClassNames()) {
+			addClassName(it);
+		}
+	}
+	return true;
+}
+
+bool eci::ParserCpp::isToken(const NodeList& _nodes, size_t _pos, int32_t _tockenId, const etk::String& _value) const {
+	if (_pos >= _nodes.size()) {
+		return false;
+	}
+	if (_nodes[_pos]->getTockenId() != _tockenId) {
+		return false;
+	}
+	if (_value == "") {
+		return true;
+	}
+	return getValue(_nodes[_pos]) == _value;
+}
+
+eci::ParserCpp::NodeList eci::ParserCpp::getUsefullNode(const ememory::SharedPtr<eci::LexerNode>& _node) const {
+	NodeList out;
+	ememory::SharedPtr<eci::LexerNodeContainer> sec = ememory::dynamicPointerCast<eci::LexerNodeContainer>(_node);
+	if (sec == null) {
+		return out;
+	}
+	for (auto &it : sec->m_list) {
+		if (    it == null
+		     || it->getTockenId() == tokenCppCommentMultiline
+		     || it->getTockenId() == tokenCppCommentSingleLine) {
+			continue;
+		}
+		out.pushBack(it);
+	}
+	return out;
+}
+
+bool eci::ParserCpp::isClassName(const etk::String& _name) const {
+	for (auto &it : m_listClassName) {
+		if (it == _name) {
+			return true;
+		}
+	}
+	for (auto &it : m_listExternClassName) {
+		if (it == _name) {
+			return true;
+		}
+	}
 	return false;
 }
 
+bool eci::ParserCpp::parseGlobal(const NodeList& _nodes) {
+	size_t pos = 0;
+	while (pos < _nodes.size()) {
+		if (isToken(_nodes, pos, tokenCppSeparator, ";") == true) {
+			++pos;
+			continue;
+		}
+		if (    isToken(_nodes, pos, tokenCppContener, "class") == true
+		     || isToken(_nodes, pos, tokenCppContener, "struct") == true) {
+			if (parseClass(_nodes, pos) == false) {
+				return false;
+			}
+			continue;
+		}
+		bool isConst = false;
+		bool isStatic = false;
+		while (isToken(_nodes, pos, tokenCppVisibility) == true) {
+			etk::String value = getValue(_nodes[pos]);
+			if (value == "const") {
+				isConst = true;
+			} else if (value == "static") {
+				isStatic = true;
+			}
+			++pos;
+		}
+		etk::String typeName = parseTypeName(_nodes, pos);
+		if (typeName == "") {
+			ECI_ERROR("line " << getLine(_nodes[etk::min(pos, _nodes.size()-1)]) << " : Can not parse global element (need a type)");
+			return false;
+		}
+		if (isToken(_nodes, pos, tokenCppString) == false) {
+			ECI_ERROR("line " << getLine(_nodes[etk::min(pos, _nodes.size()-1)]) << " : Need a name after the type '" << typeName << "'");
+			return false;
+		}
+		if (isToken(_nodes, pos+1, tokenCppSectionPthese) == false) {
+			if (parseDeclaration(_nodes, pos, typeName, isConst, m_init, true) == false) {
+				return false;
+			}
+			continue;
+		}
+		// this is a function
+		ememory::SharedPtr<eci::Function> function = ememory::makeShared<eci::Function>();
+		function->setName(getValue(_nodes[pos]));
+		function->setLine(getLine(_nodes[pos]));
+		function->setStatic(isStatic);
+		if (typeName != "void") {
+			function->addReturn(eci::Variable("", typeName));
+		}
+		++pos;
+		if (parseFunctionBody(_nodes, pos, function) == false) {
+			return false;
+		}
+		m_listFunction.pushBack(function);
+	}
+	return true;
+}
+
+bool eci::ParserCpp::parseFunctionBody(const NodeList& _nodes, size_t& _pos, const ememory::SharedPtr<eci::Function>& _function) {
+	if (parseArguments(_nodes[_pos], _function) == false) {
+		return false;
+	}
+	++_pos;
+	if (isToken(_nodes, _pos, tokenCppVisibility, "const") == true) {
+		_function->setConst(true);
+		++_pos;
+	}
+	if (isToken(_nodes, _pos, tokenCppSectionBrace) == true) {
+		// the body is parsed on the first call: the frame contain only the arguments until it is resolved.
+		_function->setLazyBody(ememory::makeShared<eci::ParserCppBody>(sharedFromThis(), _nodes[_pos]));
+		_function->setFrameSize(_function->getArguments().size());
+		++_pos;
+	} else if (isToken(_nodes, _pos, tokenCppSeparator, ";") == true) {
+		++_pos;
+	} else {
+		ECI_ERROR("line " << getLine(_nodes[_pos-1]) << " : Function '" << _function->getName() << "' need a body or a ';'");
+		return false;
+	}
+	return true;
+}
+
+bool eci::ParserCpp::parseClass(const NodeList& _nodes, size_t& _pos) {
+	bool isStruct = getValue(_nodes[_pos]) == "struct";
+	++_pos;
+	if (isToken(_nodes, _pos, tokenCppString) == false) {
+		ECI_ERROR("line " << getLine(_nodes[_pos-1]) << " : Need a name after 'class'");
+		return false;
+	}
+	ememory::SharedPtr<eci::Class> element = ememory::makeShared<eci::Class>(getValue(_nodes[_pos]));
+	if (isClassName(element->getName()) == true) {
+		ECI_ERROR("line " << getLine(_nodes[_pos]) << " : Class '" << element->getName() << "' already defined");
+		return false;
+	}
+	++_pos;
+	if (isToken(_nodes, _pos, tokenCppSeparator, ":") == true) {
+		++_pos;
+		if (isToken(_nodes, _pos, tokenCppVisibility) == true) {
+			++_pos;
+		}
+		if (    isToken(_nodes, _pos, tokenCppString) == false
+		     || isClassName(getValue(_nodes[_pos])) == false) {
+			ECI_ERROR("line " << getLine(_nodes[_pos-1]) << " : Class '" << element->getName() << "' need a known parent class");
+			return false;
+		}
+		element->setParentName(getValue(_nodes[_pos]));
+		++_pos;
+	}
+	if (isToken(_nodes, _pos, tokenCppSectionBrace) == false) {
+		ECI_ERROR("line " << getLine(_nodes[_pos-1]) << " : Class '" << element->getName() << "' need a body '{...}'");
+		return false;
+	}
+	// the class can be used in its own methods
+	m_listClassName.pushBack(element->getName());
+	NodeList nodes = getUsefullNode(_nodes[_pos]);
+	++_pos;
+	enum eci::visibility visibility = eci::visibilityPrivate;
+	if (isStruct == true) {
+		visibility = eci::visibilityPublic;
+	}
+	size_t pos = 0;
+	while (pos < nodes.size()) {
+		if (isToken(nodes, pos, tokenCppSeparator, ";") == true) {
+			++pos;
+			continue;
+		}
+		if (    isToken(nodes, pos, tokenCppVisibility) == true
+		     && isToken(nodes, pos+1, tokenCppSeparator, ":") == true) {
+			etk::String value = getValue(nodes[pos]);
+			if (value == "public") {
+				visibility = eci::visibilityPublic;
+			} else if (value == "protected") {
+				visibility = eci::visibilityProtected;
+			} else {
+				visibility = eci::visibilityPrivate;
+			}
+			pos += 2;
+			continue;
+		}
+		bool isConst = false;
+		while (isToken(nodes, pos, tokenCppVisibility) == true) {
+			etk::String value = getValue(nodes[pos]);
+			if (value == "const") {
+				isConst = true;
+			} else if (value == "static") {
+				ECI_ERROR("line " << getLine(nodes[pos]) << " : Static member is not supported");
+				return false;
+			}
+			// "virtual" is implicit: the method is always searched in the class of the object
+			++pos;
+		}
+		etk::String typeName = parseTypeName(nodes, pos);
+		if (typeName == "") {
+			ECI_ERROR("line " << getLine(nodes[etk::min(pos, nodes.size()-1)]) << " : Can not parse the member of the class '" << element->getName() << "' (need a type)");
+			return false;
+		}
+		if (isToken(nodes, pos, tokenCppString) == false) {
+			// constructor, destructor and operator are not supported
+			ECI_ERROR("line " << getLine(nodes[etk::min(pos, nodes.size()-1)]) << " : Need a member name after '" << typeName << "'");
+			return false;
+		}
+		if (isToken(nodes, pos+1, tokenCppSectionPthese) == true) {
+			// method: the object is the first argument
+			ememory::SharedPtr<eci::Function> function = ememory::makeShared<eci::Function>();
+			function->setName(element->getName() + "::" + getValue(nodes[pos]));
+			function->setLine(getLine(nodes[pos]));
+			function->setVisibility(visibility);
+			function->setClass(element.get());
+			if (typeName != "void") {
+				function->addReturn(eci::Variable("", typeName));
+			}
+			function->addArgument(eci::Variable("this", element->getName()));
+			++pos;
+			if (parseFunctionBody(nodes, pos, function) == false) {
+				return false;
+			}
+			element->addMethod(function);
+			m_listFunction.pushBack(function);
+			continue;
+		}
+		while (true) {
+			if (isToken(nodes, pos, tokenCppString) == false) {
+				ECI_ERROR("line " << getLine(nodes[etk::min(pos, nodes.size()-1)]) << " : Need a field name after ','");
+				return false;
+			}
+			eci::Variable field(getValue(nodes[pos]), typeName);
+			field.setConst(isConst);
+			field.setVisibility(visibility);
+			element->addField(field);
+			++pos;
+			if (isToken(nodes, pos, tokenCppSeparator, ",") == true) {
+				++pos;
+				continue;
+			}
+			if (isToken(nodes, pos, tokenCppSeparator, ";") == true) {
+				++pos;
+				break;
+			}
+			ECI_ERROR("line " << getLine(nodes[pos-1]) << " : Need ';' after the field '" << field.getName() << "' (initialisation is not supported)");
+			return false;
+		}
+	}
+	if (isToken(_nodes, _pos, tokenCppSeparator, ";") == false) {
+		ECI_ERROR("line " << getLine(_nodes[_pos-1]) << " : Need ';' after the class '" << element->getName() << "'");
+		return false;
+	}
+	++_pos;
+	m_listClass.pushBack(element);
+	return true;
+}
+
+etk::String eci::ParserCpp::parseTypeName(const NodeList& _nodes, size_t& _pos) {
+	if (isToken(_nodes, _pos, tokenCppAuto) == true) {
+		++_pos;
+		return "auto";
+	}
+	if (    isToken(_nodes, _pos, tokenCppString) == true
+	     && isClassName(getValue(_nodes[_pos])) == true) {
+		etk::String out = getValue(_nodes[_pos]);
+		++_pos;
+		// the objects are always references: a "Class*" is only not created with the variable (null)
+		if (isToken(_nodes, _pos, tokenCppAssignation, "*") == true) {
+			out += "*";
+			++_pos;
+		}
+		return out;
+	}
+	etk::String out;
+	while (isToken(_nodes, _pos, tokenCppType) == true) {
+		if (out != "") {
+			out += " ";
+		}
+		out += getValue(_nodes[_pos]);
+		++_pos;
+	}
+	return out;
+}
+
+bool eci::ParserCpp::parseArguments(const ememory::SharedPtr<eci::LexerNode>& _node, const ememory::SharedPtr<eci::Function>& _function) {
+	NodeList nodes = getUsefullNode(_node);
+	if (    nodes.size() == 1
+	     && isToken(nodes, 0, tokenCppType, "void") == true) {
+		return true;
+	}
+	size_t pos = 0;
+	while (pos < nodes.size()) {
+		bool isConst = false;
+		while (isToken(nodes, pos, tokenCppVisibility) == true) {
+			if (getValue(nodes[pos]) == "const") {
+				isConst = true;
+			}
+			++pos;
+		}
+		etk::String typeName = parseTypeName(nodes, pos);
+		if (typeName == "") {
+			ECI_ERROR("line " << getLine(_node) << " : Function '" << _function->getName() << "' argument without type");
+			return false;
+		}
+		etk::String name;
+		if (isToken(nodes, pos, tokenCppString) == true) {
+			name = getValue(nodes[pos]);
+			++pos;
+		}
+		if (isToken(nodes, pos, tokenCppSectionHook) == true) {
+			// reference on an array of any size
+			typeName += "[]";
+			++pos;
+		}
+		eci::Variable argument(name, typeName);
+		argument.setConst(isConst);
+		_function->addArgument(argument);
+		if (pos >= nodes.size()) {
+			break;
+		}
+		if (isToken(nodes, pos, tokenCppSeparator, ",") == false) {
+			ECI_ERROR("line " << getLine(nodes[pos]) << " : Function '" << _function->getName() << "' wrong argument separator");
+			return false;
+		}
+		++pos;
+	}
+	return true;
+}
+
+bool eci::ParserCpp::parseDeclaration(const NodeList& _nodes,
+                                      size_t& _pos,
+                                      const etk::String& _typeName,
+                                      bool _const,
+                                      const ememory::SharedPtr<eci::interpreter::Block>& _block,
+                                      bool _global) {
+	while (true) {
+		if (isToken(_nodes, _pos, tokenCppString) == false) {
+			ECI_ERROR("line " << getLine(_nodes[etk::min(_pos, _nodes.size()-1)]) << " : Need a variable name after '" << _typeName << "'");
+			return false;
+		}
+		ememory::SharedPtr<eci::interpreter::VariableDeclaration> declaration = ememory::makeShared<eci::interpreter::VariableDeclaration>();
+		declaration->m_name = getValue(_nodes[_pos]);
+		declaration->m_typeName = _typeName;
+		declaration->m_const = _const;
+		++_pos;
+		if (isToken(_nodes, _pos, tokenCppSectionHook) == true) {
+			// array "xxx name[size]": a reference on a new array (same as "xxx name[] = new xxx[size]")
+			declaration->m_typeName = _typeName + "[]";
+			NodeList nodes = getUsefullNode(_nodes[_pos]);
+			if (nodes.size() != 0) {
+				size_t pos = 0;
+				ememory::SharedPtr<eci::interpreter::New> array = ememory::makeShared<eci::interpreter::New>(_typeName);
+				array->m_size = parseExpression(nodes, pos);
+				if (array->m_size == null) {
+					return false;
+				}
+				if (pos != nodes.size()) {
+					ECI_ERROR("line " << getLine(nodes[pos]) << " : Unexpected element in the size of the array '" << declaration->m_name << "'");
+					return false;
+				}
+				declaration->m_init = array;
+			}
+			++_pos;
+		}
+		if (isToken(_nodes, _pos, tokenCppAssignation, "=") == true) {
+			if (declaration->m_init != null) {
+				ECI_ERROR("line " << getLine(_nodes[_pos]) << " : The array '" << declaration->m_name << "' can not be initialized (the elements are 0)");
+				return false;
+			}
+			++_pos;
+			declaration->m_init = parseExpression(_nodes, _pos);
+			if (declaration->m_init == null) {
+				return false;
+			}
+		}
+		_block->m_actions.pushBack(declaration);
+		if (_global == true) {
+			ememory::SharedPtr<eci::Variable> variable = ememory::makeShared<eci::Variable>(declaration->m_name, declaration->m_typeName);
+			variable->setConst(_const);
+			m_listVariable.pushBack(variable);
+		}
+		if (isToken(_nodes, _pos, tokenCppSeparator, ",") == true) {
+			++_pos;
+			continue;
+		}
+		if (isToken(_nodes, _pos, tokenCppSeparator, ";") == true) {
+			++_pos;
+			return true;
+		}
+		ECI_ERROR("line " << getLine(_nodes[_pos-1]) << " : Need ';' after the declaration of '" << declaration->m_name << "'");
+		return false;
+	}
+	return false;
+}
+
+ememory::SharedPtr<eci::interpreter::Block> eci::ParserCpp::parseBlock(const ememory::SharedPtr<eci::LexerNode>& _node) {
+	ememory::SharedPtr<eci::interpreter::Block> block = ememory::makeShared<eci::interpreter::Block>();
+	NodeList nodes = getUsefullNode(_node);
+	size_t pos = 0;
+	while (pos < nodes.size()) {
+		if (parseStatement(nodes, pos, block) == false) {
+			return null;
+		}
+	}
+	return block;
+}
+
+ememory::SharedPtr<eci::interpreter::Block> eci::ParserCpp::parseSubBlock(const NodeList& _nodes, size_t& _pos) {
+	if (isToken(_nodes, _pos, tokenCppSectionBrace) == true) {
+		++_pos;
+		return parseBlock(_nodes[_pos-1]);
+	}
+	ememory::SharedPtr<eci::interpreter::Block> block = ememory::makeShared<eci::interpreter::Block>();
+	if (_pos >= _nodes.size()) {
+		ECI_ERROR("line " << getLine(_nodes.back()) << " : Need an action");
+		return null;
+	}
+	if (parseStatement(_nodes, _pos, block) == false) {
+		return null;
+	}
+	return block;
+}
+
+ememory::SharedPtr<eci::interpreter::Element> eci::ParserCpp::parseCondition(const NodeList& _nodes, size_t& _pos) {
+	if (isToken(_nodes, _pos, tokenCppSectionPthese) == false) {
+		ECI_ERROR("line " << getLine(_nodes[_pos-1]) << " : Need a condition '(...)'");
+		return null;
+	}
+	NodeList nodes = getUsefullNode(_nodes[_pos]);
+	size_t pos = 0;
+	ememory::SharedPtr<eci::interpreter::Element> out = parseExpression(nodes, pos);
+	if (    out != null
+	     && pos != nodes.size()) {
+		ECI_ERROR("line " << getLine(nodes[pos]) << " : Unexpected element in the condition");
+		return null;
+	}
+	++_pos;
+	return out;
+}
+
+ememory::SharedPtr<eci::interpreter::Element> eci::ParserCpp::parseFor(const NodeList& _nodes, size_t& _pos) {
+	if (isToken(_nodes, _pos, tokenCppSectionPthese) == false) {
+		ECI_ERROR("line " << getLine(_nodes[_pos-1]) << " : Need a 'for (...;...;...)'");
+		return null;
+	}
+	NodeList nodes = getUsefullNode(_nodes[_pos]);
+	++_pos;
+	ememory::SharedPtr<eci::interpreter::For> element = ememory::makeShared<eci::interpreter::For>();
+	size_t pos = 0;
+	// Initialisation:
+	if (isToken(nodes, pos, tokenCppSeparator, ";") == true) {
+		++pos;
+	} else {
+		ememory::SharedPtr<eci::interpreter::Block> init = ememory::makeShared<eci::interpreter::Block>();
+		if (parseStatement(nodes, pos, init) == false) {
+			return null;
+		}
+		if (init->m_actions.size() == 1) {
+			element->m_init = init->m_actions[0];
+		} else {
+			element->m_init = init;
+		}
+	}
+	// Condition:
+	if (isToken(nodes, pos, tokenCppSeparator, ";") == false) {
+		element->m_condition = parseExpression(nodes, pos);
+		if (element->m_condition == null) {
+			return null;
+		}
+	}
+	if (isToken(nodes, pos, tokenCppSeparator, ";") == false) {
+		ECI_ERROR("line " << getLine(_nodes[_pos-1]) << " : Need a ';' after the 'for' condition");
+		return null;
+	}
+	++pos;
+	// Increment:
+	if (pos < nodes.size()) {
+		element->m_increment = parseExpression(nodes, pos);
+		if (element->m_increment == null) {
+			return null;
+		}
+		if (pos != nodes.size()) {
+			ECI_ERROR("line " << getLine(nodes[pos]) << " : Unexpected element in the 'for' increment");
+			return null;
+		}
+	}
+	element->m_block = parseSubBlock(_nodes, _pos);
+	if (element->m_block == null) {
+		return null;
+	}
+	return element;
+}
+
+ememory::SharedPtr<eci::interpreter::Element> eci::ParserCpp::parseSwitch(const NodeList& _nodes, size_t& _pos) {
+	ememory::SharedPtr<eci::interpreter::Switch> element = ememory::makeShared<eci::interpreter::Switch>();
+	element->m_value = parseCondition(_nodes, _pos);
+	if (element->m_value == null) {
+		return null;
+	}
+	if (isToken(_nodes, _pos, tokenCppSectionBrace) == false) {
+		ECI_ERROR("line " << getLine(_nodes[_pos-1]) << " : Need '{...}' after 'switch (...)'");
+		return null;
+	}
+	NodeList nodes = getUsefullNode(_nodes[_pos]);
+	++_pos;
+	size_t pos = 0;
+	// a new block is started at each label that follow an action
+	ememory::SharedPtr<eci::interpreter::Block> block;
+	while (pos < nodes.size()) {
+		bool isCase = isToken(nodes, pos, tokenCppBranch, "case");
+		if (    isCase == true
+		     || isToken(nodes, pos, tokenCppBranch, "default") == true) {
+			int32_t line = getLine(nodes[pos]);
+			++pos;
+			if (    block == null
+			     || block->m_actions.size() != 0) {
+				block = ememory::makeShared<eci::interpreter::Block>();
+				element->m_blocks.pushBack(block);
+			}
+			if (isCase == true) {
+				ememory::SharedPtr<eci::interpreter::Element> value = parseExpression(nodes, pos);
+				if (value == null) {
+					return null;
+				}
+				element->m_cases.pushBack(eci::interpreter::Switch::Case(value, element->m_blocks.size()-1));
+			} else {
+				if (element->m_default >= 0) {
+					ECI_ERROR("line " << line << " : Multiple 'default' in the 'switch'");
+					return null;
+				}
+				element->m_default = element->m_blocks.size()-1;
+			}
+			if (isToken(nodes, pos, tokenCppSeparator, ":") == false) {
+				ECI_ERROR("line " << line << " : Need ':' after the label");
+				return null;
+			}
+			++pos;
+			continue;
+		}
+		if (block == null) {
+			ECI_ERROR("line " << getLine(nodes[pos]) << " : Need a label 'case' or 'default' in the 'switch'");
+			return null;
+		}
+		if (parseStatement(nodes, pos, block) == false) {
+			return null;
+		}
+	}
+	return element;
+}
+
+bool eci::ParserCpp::parseStatement(const NodeList& _nodes, size_t& _pos, const ememory::SharedPtr<eci::interpreter::Block>& _block) {
+	ememory::SharedPtr<eci::LexerNode> node = _nodes[_pos];
+	switch (node->getTockenId()) {
+		case tokenCppSectionBrace: {
+			ememory::SharedPtr<eci::interpreter::Block> block = parseBlock(node);
+			if (block == null) {
+				return false;
+			}
+			_block->m_actions.pushBack(block);
+			++_pos;
+			return true;
+		}
+		case tokenCppSeparator:
+			if (getValue(node) == ";") {
+				++_pos;
+				return true;
+			}
+			break;
+		case tokenCppString:
+			if (    isClassName(getValue(node)) == false
+			     || (    isToken(_nodes, _pos+1, tokenCppString) == false
+			          && (    isToken(_nodes, _pos+1, tokenCppAssignation, "*") == false
+			               || isToken(_nodes, _pos+2, tokenCppString) == false))) {
+				// not a declaration
+				break;
+			}
+			// a class name followed by a variable name: declaration of an instance
+			[[fallthrough]];
+		case tokenCppType:
+		case tokenCppAuto:
+		case tokenCppVisibility: {
+			bool isConst = false;
+			while (isToken(_nodes, _pos, tokenCppVisibility) == true) {
+				if (getValue(_nodes[_pos]) == "const") {
+					isConst = true;
+				}
+				++_pos;
+			}
+			etk::String typeName = parseTypeName(_nodes, _pos);
+			if (typeName == "") {
+				ECI_ERROR("line " << getLine(node) << " : Need a type for the declaration");
+				return false;
+			}
+			return parseDeclaration(_nodes, _pos, typeName, isConst, _block, false);
+		}
+		case tokenCppSystem:
+			if (getValue(node) == "delete") {
+				++_pos;
+				ememory::SharedPtr<eci::interpreter::Delete> element = ememory::makeShared<eci::interpreter::Delete>();
+				element->m_value = parseExpression(_nodes, _pos);
+				if (element->m_value == null) {
+					return false;
+				}
+				if (isToken(_nodes, _pos, tokenCppSeparator, ";") == false) {
+					ECI_ERROR("line " << getLine(node) << " : Need ';' after 'delete'");
+					return false;
+				}
+				++_pos;
+				_block->m_actions.pushBack(element);
+				return true;
+			}
+			break;
+		case tokenCppBranch: {
+			etk::String value = getValue(node);
+			++_pos;
+			if (value == "if") {
+				ememory::SharedPtr<eci::interpreter::Condition> element = ememory::makeShared<eci::interpreter::Condition>();
+				element->m_condition = parseCondition(_nodes, _pos);
+				if (element->m_condition == null) {
+					return false;
+				}
+				element->m_block = parseSubBlock(_nodes, _pos);
+				if (element->m_block == null) {
+					return false;
+				}
+				if (isToken(_nodes, _pos, tokenCppBranch, "else") == true) {
+					++_pos;
+					element->m_blockElse = parseSubBlock(_nodes, _pos);
+					if (element->m_blockElse == null) {
+						return false;
+					}
+				}
+				_block->m_actions.pushBack(element);
+				return true;
+			} else if (value == "while") {
+				ememory::SharedPtr<eci::interpreter::While> element = ememory::makeShared<eci::interpreter::While>();
+				element->m_condition = parseCondition(_nodes, _pos);
+				if (element->m_condition == null) {
+					return false;
+				}
+				element->m_action = parseSubBlock(_nodes, _pos);
+				if (element->m_action == null) {
+					return false;
+				}
+				_block->m_actions.pushBack(element);
+				return true;
+			} else if (value == "do") {
+				ememory::SharedPtr<eci::interpreter::While> element = ememory::makeShared<eci::interpreter::While>();
+				element->m_conditionAtStart = false;
+				element->m_action = parseSubBlock(_nodes, _pos);
+				if (element->m_action == null) {
+					return false;
+				}
+				if (isToken(_nodes, _pos, tokenCppBranch, "while") == false) {
+					ECI_ERROR("line " << getLine(node) << " : 'do' without 'while'");
+					return false;
+				}
+				++_pos;
+				element->m_condition = parseCondition(_nodes, _pos);
+				if (element->m_condition == null) {
+					return false;
+				}
+				if (isToken(_nodes, _pos, tokenCppSeparator, ";") == false) {
+					ECI_ERROR("line " << getLine(node) << " : Need ';' after 'do ... while (...)'");
+					return false;
+				}
+				++_pos;
+				_block->m_actions.pushBack(element);
+				return true;
+			} else if (value == "for") {
+				ememory::SharedPtr<eci::interpreter::Element> element = parseFor(_nodes, _pos);
+				if (element == null) {
+					return false;
+				}
+				_block->m_actions.pushBack(element);
+				return true;
+			} else if (value == "switch") {
+				ememory::SharedPtr<eci::interpreter::Element> element = parseSwitch(_nodes, _pos);
+				if (element == null) {
+					return false;
+				}
+				_block->m_actions.pushBack(element);
+				return true;
+			} else if (value == "return") {
+				ememory::SharedPtr<eci::interpreter::Return> element = ememory::makeShared<eci::interpreter::Return>();
+				if (isToken(_nodes, _pos, tokenCppSeparator, ";") == false) {
+					element->m_value = parseExpression(_nodes, _pos);
+					if (element->m_value == null) {
+						return false;
+					}
+				}
+				if (isToken(_nodes, _pos, tokenCppSeparator, ";") == false) {
+					ECI_ERROR("line " << getLine(node) << " : Need ';' after 'return'");
+					return false;
+				}
+				++_pos;
+				_block->m_actions.pushBack(element);
+				return true;
+			} else if (    value == "break"
+			            || value == "continue") {
+				if (isToken(_nodes, _pos, tokenCppSeparator, ";") == false) {
+					ECI_ERROR("line " << getLine(node) << " : Need ';' after '" << value << "'");
+					return false;
+				}
+				++_pos;
+				if (value == "break") {
+					_block->m_actions.pushBack(ememory::makeShared<eci::interpreter::Break>());
+				} else {
+					_block->m_actions.pushBack(ememory::makeShared<eci::interpreter::Continue>());
+				}
+				return true;
+			}
+			ECI_ERROR("line " << getLine(node) << " : Branch '" << value << "' is not supported");
+			return false;
+		}
+		default:
+			break;
+	}
+	ememory::SharedPtr<eci::interpreter::Element> element = parseExpression(_nodes, _pos);
+	if (element == null) {
+		return false;
+	}
+	if (isToken(_nodes, _pos, tokenCppSeparator, ";") == false) {
+		ECI_ERROR("line " << getLine(node) << " : Need ';' at the end of the action");
+		return false;
+	}
+	++_pos;
+	_block->m_actions.pushBack(element);
+	return true;
+}
+
+/**
+ * @brief Get the value of a numeric constant with the C rules (suffix and size of the number select the type).
+ * @param[in] _value String of the number.
+ * @return The value.
+ */
+static eci::Value getNumericValue(const etk::String& _value) {
+	bool isHexa =    _value.size() > 1
+	              && _value[0] == '0'
+	              && (    _value[1] == 'x'
+	                   || _value[1] == 'X');
+	bool isFloating = false;
+	bool isUnsigned = false;
+	bool isLong = false;
+	bool isFloat = false;
+	for (size_t iii=0; iii<_value.size(); ++iii) {
+		char val = _value[iii];
+		if (val == '.') {
+			isFloating = true;
+		} else if (    isHexa == false
+		            && (    val == 'e'
+		                 || val == 'E')) {
+			isFloating = true;
+		} else if (    val == 'u'
+		            || val == 'U') {
+			isUnsigned = true;
+		} else if (    val == 'l'
+		            || val == 'L') {
+			isLong = true;
+		} else if (    isHexa == false
+		            && (    val == 'f'
+		                 || val == 'F')) {
+			isFloat = true;
+		}
+	}
+	if (    isFloating == true
+	     || isFloat == true) {
+		double value = strtod(_value.c_str(), null);
+		if (isFloat == true) {
+			return eci::Value(float(value));
+		}
+		return eci::Value(value);
+	}
+	uint64_t value = strtoull(_value.c_str(), null, 0);
+	if (isUnsigned == true) {
+		if (    isLong == true
+		     || value > 0xFFFFFFFFLL) {
+			return eci::Value(value);
+		}
+		return eci::Value(uint32_t(value));
+	}
+	if (    isLong == true
+	     || value > 0x7FFFFFFFLL) {
+		return eci::Value(int64_t(value));
+	}
+	return eci::Value(int32_t(value));
+}
+
+/**
+ * @brief Get the priority of a binary operator (C order).
+ * @param[in] _value Operator string.
+ * @return priority of the operator (-1 if it is not a binary operator).
+ */
+static int32_t getPriority(const etk::String& _value) {
+	if (    _value == "*"
+	     || _value == "/"
+	     || _value == "%") {
+		return 10;
+	}
+	if (    _value == "+"
+	     || _value == "-") {
+		return 9;
+	}
+	if (    _value == "<"
+	     || _value == "<="
+	     || _value == ">"
+	     || _value == ">=") {
+		return 7;
+	}
+	if (    _value == "=="
+	     || _value == "!=") {
+		return 6;
+	}
+	if (_value == "&") {
+		return 5;
+	}
+	if (_value == "&&") {
+		return 4;
+	}
+	if (_value == "||") {
+		return 3;
+	}
+	if (    _value == "="
+	     || _value == "+="
+	     || _value == "-="
+	     || _value == "*="
+	     || _value == "/="
+	     || _value == "%=") {
+		return 1;
+	}
+	return -1;
+}
+
+ememory::SharedPtr<eci::interpreter::Element> eci::ParserCpp::parseExpression(const NodeList& _nodes, size_t& _pos, int32_t _minPriority) {
+	ememory::SharedPtr<eci::interpreter::Element> left = parseUnary(_nodes, _pos);
+	if (left == null) {
+		return null;
+	}
+	while (    isToken(_nodes, _pos, tokenCppCondition) == true
+	        || isToken(_nodes, _pos, tokenCppAssignation) == true) {
+		etk::String value = getValue(_nodes[_pos]);
+		int32_t priority = getPriority(value);
+		if (    priority < 0
+		     || priority < _minPriority) {
+			break;
+		}
+		++_pos;
+		ememory::SharedPtr<eci::interpreter::Element> right;
+		if (priority == 1) {
+			// assignation is right associative
+			right = parseExpression(_nodes, _pos, priority);
+		} else {
+			right = parseExpression(_nodes, _pos, priority+1);
+		}
+		if (right == null) {
+			return null;
+		}
+		ememory::SharedPtr<eci::interpreter::Operator> element = ememory::makeShared<eci::interpreter::Operator>(value);
+		element->m_left = left;
+		element->m_right = right;
+		left = element;
+	}
+	return left;
+}
+
+ememory::SharedPtr<eci::interpreter::Element> eci::ParserCpp::parseUnary(const NodeList& _nodes, size_t& _pos) {
+	if (isToken(_nodes, _pos, tokenCppAssignation) == true) {
+		etk::String value = getValue(_nodes[_pos]);
+		if (    value == "-"
+		     || value == "!"
+		     || value == "++"
+		     || value == "--") {
+			++_pos;
+			ememory::SharedPtr<eci::interpreter::Element> operand = parseUnary(_nodes, _pos);
+			if (operand == null) {
+				return null;
+			}
+			ememory::SharedPtr<eci::interpreter::Operator> element = ememory::makeShared<eci::interpreter::Operator>(value);
+			element->m_right = operand;
+			return element;
+		}
+		if (value == "+") {
+			++_pos;
+			return parseUnary(_nodes, _pos);
+		}
+	}
+	if (isToken(_nodes, _pos, tokenCppSectionPthese) == true) {
+		// check if it is a cast "(type)value"
+		NodeList nodes = getUsefullNode(_nodes[_pos]);
+		size_t pos = 0;
+		etk::String typeName = parseTypeName(nodes, pos);
+		if (    typeName != ""
+		     && pos == nodes.size()) {
+			++_pos;
+			ememory::SharedPtr<eci::interpreter::Cast> element = ememory::makeShared<eci::interpreter::Cast>(typeName);
+			element->m_value = parseUnary(_nodes, _pos);
+			if (element->m_value == null) {
+				return null;
+			}
+			return element;
+		}
+	}
+	ememory::SharedPtr<eci::interpreter::Element> element = parsePrimary(_nodes, _pos);
+	if (element == null) {
+		return null;
+	}
+	while (true) {
+		if (isToken(_nodes, _pos, tokenCppSectionHook) == true) {
+			ememory::SharedPtr<eci::interpreter::Index> tmp = ememory::makeShared<eci::interpreter::Index>();
+			tmp->m_object = element;
+			NodeList nodes = getUsefullNode(_nodes[_pos]);
+			size_t pos = 0;
+			tmp->m_index = parseExpression(nodes, pos);
+			if (tmp->m_index == null) {
+				return null;
+			}
+			if (pos != nodes.size()) {
+				ECI_ERROR("line " << getLine(nodes[pos]) << " : Unexpected element in '[...]'");
+				return null;
+			}
+			++_pos;
+			element = tmp;
+			continue;
+		}
+		if (isToken(_nodes, _pos, tokenCppMember) == false) {
+			break;
+		}
+		++_pos;
+		if (isToken(_nodes, _pos, tokenCppString) == false) {
+			ECI_ERROR("line " << getLine(_nodes[_pos-1]) << " : Need a member name after '" << getValue(_nodes[_pos-1]) << "'");
+			return null;
+		}
+		etk::String name = getValue(_nodes[_pos]);
+		++_pos;
+		if (isToken(_nodes, _pos, tokenCppSectionPthese) == true) {
+			ememory::SharedPtr<eci::interpreter::MethodCall> tmp = ememory::makeShared<eci::interpreter::MethodCall>(name);
+			tmp->m_object = element;
+			if (parseCallArguments(_nodes[_pos], name, tmp->m_arguments) == false) {
+				return null;
+			}
+			++_pos;
+			element = tmp;
+		} else {
+			ememory::SharedPtr<eci::interpreter::Member> tmp = ememory::makeShared<eci::interpreter::Member>(name);
+			tmp->m_object = element;
+			element = tmp;
+		}
+	}
+	while (    isToken(_nodes, _pos, tokenCppAssignation, "++") == true
+	        || isToken(_nodes, _pos, tokenCppAssignation, "--") == true) {
+		ememory::SharedPtr<eci::interpreter::Operator> tmp = ememory::makeShared<eci::interpreter::Operator>(getValue(_nodes[_pos]));
+		tmp->m_left = element;
+		element = tmp;
+		++_pos;
+	}
+	return element;
+}
+
+ememory::SharedPtr<eci::interpreter::Element> eci::ParserCpp::parsePrimary(const NodeList& _nodes, size_t& _pos) {
+	if (_pos >= _nodes.size()) {
+		if (_nodes.size() != 0) {
+			ECI_ERROR("line " << getLine(_nodes.back()) << " : Need an element at the end of the expression");
+		} else {
+			ECI_ERROR("Need an element in an empty expression");
+		}
+		return null;
+	}
+	ememory::SharedPtr<eci::LexerNode> node = _nodes[_pos];
+	switch (node->getTockenId()) {
+		case tokenCppNumericValue:
+			++_pos;
+			return ememory::makeShared<eci::interpreter::Constant>(getNumericValue(getValue(node)));
+		case tokenCppBoolean:
+			++_pos;
+			return ememory::makeShared<eci::interpreter::Constant>(eci::Value(getValue(node) == "true"));
+		case tokenCppNullptr:
+			++_pos;
+			return ememory::makeShared<eci::interpreter::Constant>(eci::Value(int64_t(0)));
+		case tokenCppStringSimpleQuote: {
+			++_pos;
+			etk::String value = getValue(node);
+			if (value[1] != '\\') {
+				return ememory::makeShared<eci::interpreter::Constant>(eci::Value(int8_t(value[1])));
+			}
+			switch (value[2]) {
+				case 'n':  return ememory::makeShared<eci::interpreter::Constant>(eci::Value(int8_t('\n')));
+				case 'r':  return ememory::makeShared<eci::interpreter::Constant>(eci::Value(int8_t('\r')));
+				case 't':  return ememory::makeShared<eci::interpreter::Constant>(eci::Value(int8_t('\t')));
+				case '0':  return ememory::makeShared<eci::interpreter::Constant>(eci::Value(int8_t('\0')));
+				default:   return ememory::makeShared<eci::interpreter::Constant>(eci::Value(int8_t(value[2])));
+			}
+		}
+		case tokenCppStringDoubleQuote: {
+			++_pos;
+			etk::String value = getValue(node);
+			ememory::SharedPtr<eci::interpreter::Literal> element = ememory::makeShared<eci::interpreter::Literal>();
+			for (size_t iii=1; iii+1<value.size(); ++iii) {
+				if (    value[iii] != '\\'
+				     || iii+2 >= value.size()) {
+					element->m_value += value[iii];
+					continue;
+				}
+				++iii;
+				switch (value[iii]) {
+					case 'n':  element->m_value += '\n'; break;
+					case 'r':  element->m_value += '\r'; break;
+					case 't':  element->m_value += '\t'; break;
+					case '0':  element->m_value += '\0'; break;
+					case '\n': break; // the string continue on the next line
+					default:   element->m_value += value[iii]; break;
+				}
+			}
+			return element;
+		}
+		case tokenCppString: {
+			etk::String name = getValue(node);
+			++_pos;
+			if (isToken(_nodes, _pos, tokenCppSectionPthese) == false) {
+				return ememory::makeShared<eci::interpreter::Variable>(name);
+			}
+			ememory::SharedPtr<eci::interpreter::FunctionCall> element = ememory::makeShared<eci::interpreter::FunctionCall>(name);
+			if (parseCallArguments(_nodes[_pos], name, element->m_arguments) == false) {
+				return null;
+			}
+			++_pos;
+			return element;
+		}
+		case tokenCppSystem: {
+			if (getValue(node) != "new") {
+				break;
+			}
+			++_pos;
+			etk::String typeName;
+			if (isToken(_nodes, _pos, tokenCppString) == true) {
+				typeName = getValue(_nodes[_pos]);
+				++_pos;
+			} else {
+				// only an array of a native type "new int[size]"
+				typeName = parseTypeName(_nodes, _pos);
+			}
+			if (typeName == "") {
+				ECI_ERROR("line " << getLine(node) << " : Need a class name after 'new'");
+				return null;
+			}
+			ememory::SharedPtr<eci::interpreter::New> element = ememory::makeShared<eci::interpreter::New>(typeName);
+			if (isToken(_nodes, _pos, tokenCppSectionHook) == true) {
+				NodeList nodes = getUsefullNode(_nodes[_pos]);
+				size_t pos = 0;
+				element->m_size = parseExpression(nodes, pos);
+				if (element->m_size == null) {
+					return null;
+				}
+				if (pos != nodes.size()) {
+					ECI_ERROR("line " << getLine(nodes[pos]) << " : Unexpected element in the size of the array");
+					return null;
+				}
+				++_pos;
+				return element;
+			}
+			// no constructor: only "new Class" and "new Class()"
+			if (isToken(_nodes, _pos, tokenCppSectionPthese) == true) {
+				if (getUsefullNode(_nodes[_pos]).size() != 0) {
+					ECI_ERROR("line " << getLine(node) << " : Constructor with arguments is not supported");
+					return null;
+				}
+				++_pos;
+			}
+			return element;
+		}
+		case tokenCppSectionPthese: {
+			NodeList nodes = getUsefullNode(node);
+			size_t pos = 0;
+			ememory::SharedPtr<eci::interpreter::Element> element = parseExpression(nodes, pos);
+			if (element == null) {
+				return null;
+			}
+			if (pos != nodes.size()) {
+				ECI_ERROR("line " << getLine(nodes[pos]) << " : Unexpected element in '(...)'");
+				return null;
+			}
+			++_pos;
+			return element;
+		}
+		default:
+			break;
+	}
+	ECI_ERROR("line " << getLine(node) << " : Unexpected element '" << getValue(node) << "'");
+	return null;
+}
+
+bool eci::ParserCpp::parseCallArguments(const ememory::SharedPtr<eci::LexerNode>& _node,
+                                        const etk::String& _name,
+                                        etk::Vector<ememory::SharedPtr<eci::interpreter::Element>>& _arguments) {
+	NodeList nodes = getUsefullNode(_node);
+	size_t pos = 0;
+	while (pos < nodes.size()) {
+		ememory::SharedPtr<eci::interpreter::Element> argument = parseExpression(nodes, pos);
+		if (argument == null) {
+			return false;
+		}
+		_arguments.pushBack(argument);
+		if (pos >= nodes.size()) {
+			break;
+		}
+		if (isToken(nodes, pos, tokenCppSeparator, ",") == false) {
+			ECI_ERROR("line " << getLine(nodes[pos]) << " : Wrong separator in the call of '" << _name << "'");
+			return false;
+		}
+		++pos;
+	}
+	return true;
+}
@@ -9,6 +9,9 @@
 #include <etk/types.hpp>
 #include <eci/Lexer.hpp>
 #include <eci/Interpreter.hpp>
+#include <eci/Function.hpp>
+#include <eci/Variable.hpp>
+#include <eci/Class.hpp>
 
 namespace eci {
 	
@@ -54,14 +57,80 @@ namespace eci {
 		tokenCppAssignation,
 		tokenCppString,
 		tokenCppSeparator,
+		tokenCppMember,
 	};
-	class ParserCpp {
+	class ParserCpp;
+	/**
+	 * @brief Body of a function kept as its section "{...}" until the first call.
+	 */
+	class ParserCppBody : public eci::LazyBody {
+		private:
+			ememory::SharedPtr<eci::ParserCpp> m_parser; //!< Parser of the file (data and class names).
+			ememory::SharedPtr<eci::LexerNode> m_node; //!< Section of the body.
 		public:
-			eci::Lexer m_lexer;
+			ParserCppBody(const ememory::SharedPtr<eci::ParserCpp>& _parser, const ememory::SharedPtr<eci::LexerNode>& _node);
+			virtual ememory::SharedPtr<eci::interpreter::Block> parse();
+	};
+	class ParserCpp : public ememory::EnableSharedFromThis<ParserCpp> {
+		friend class eci::ParserCppBody;
+		public:
+			ememory::SharedPtr<eci::Lexer> m_lexer; //!< Lexer (can be shared between the parsers: the regular expressions are compiled once).
 			eci::LexerResult m_result;
+			etk::Vector<ememory::SharedPtr<eci::Function>> m_listFunction; //!< all function found in the data (and the methods of the classes)
+			etk::Vector<ememory::SharedPtr<eci::Class>> m_listClass; //!< all class found in the data
+			etk::Vector<ememory::SharedPtr<eci::Variable>> m_listVariable; //!< all global variable found in the data
+			ememory::SharedPtr<eci::interpreter::Block> m_init; //!< global variable initialisation actions
+			etk::Vector<etk::String> m_listImport; //!< native libraries imported by the "#import" directives
+			int64_t m_timeLex; //!< Duration of the lexing of the last parse (in us).
+			int64_t m_timeParse; //!< Duration of the parsing of the last parse (in us).
+		private:
+			etk::String m_data; //!< data currently parsed
+			mutable etk::Vector<int32_t> m_lineStart; //!< Offset of the start of each line of the data (computed on the first request of a line).
+			etk::Vector<etk::String> m_listClassName; //!< name of the classes already found (they can be used as a type)
+			etk::Vector<etk::String> m_listExternClassName; //!< name of the classes defined before the data (interactive mode)
 		public:
-			ParserCpp();
+			/**
+			 * @brief Constructor.
+			 * @param[in] _lexer Lexer created by @ref createLexer (null: create a new one).
+			 */
+			ParserCpp(const ememory::SharedPtr<eci::Lexer>& _lexer=null);
+			/**
+			 * @brief Create a lexer with all the C++ tokens.
+			 * @return The new lexer.
+			 */
+			static ememory::SharedPtr<eci::Lexer> createLexer();
 			~ParserCpp();
 			bool parse(const etk::String& _data);
+			/**
+			 * @brief Add the name of a class defined outside the parsed data (it can be used as a type).
+			 * @param[in] _name Name of the class.
+			 */
+			void addClassName(const etk::String& _name) {
+				m_listExternClassName.pushBack(_name);
+			}
+		private:
+			typedef etk::Vector<ememory::SharedPtr<eci::LexerNode>> NodeList;
+			etk::String getValue(const ememory::SharedPtr<eci::LexerNode>& _node) const;
+			int32_t getLine(const ememory::SharedPtr<eci::LexerNode>& _node) const;
+			bool parseImport(const ememory::SharedPtr<eci::LexerNode>& _node);
+			bool isToken(const NodeList& _nodes, size_t _pos, int32_t _tockenId, const etk::String& _value="") const;
+			NodeList getUsefullNode(const ememory::SharedPtr<eci::LexerNode>& _node) const;
+			bool isClassName(const etk::String& _name) const;
+			bool parseGlobal(const NodeList& _nodes);
+			bool parseClass(const NodeList& _nodes, size_t& _pos);
+			bool parseFunctionBody(const NodeList& _nodes, size_t& _pos, const ememory::SharedPtr<eci::Function>& _function);
+			etk::String parseTypeName(const NodeList& _nodes, size_t& _pos);
+			bool parseArguments(const ememory::SharedPtr<eci::LexerNode>& _node, const ememory::SharedPtr<eci::Function>& _function);
+			bool parseDeclaration(const NodeList& _nodes, size_t& _pos, const etk::String& _typeName, bool _const, const ememory::SharedPtr<eci::interpreter::Block>& _block, bool _global);
+			ememory::SharedPtr<eci::interpreter::Block> parseBlock(const ememory::SharedPtr<eci::LexerNode>& _node);
+			ememory::SharedPtr<eci::interpreter::Block> parseSubBlock(const NodeList& _nodes, size_t& _pos);
+			bool parseStatement(const NodeList& _nodes, size_t& _pos, const ememory::SharedPtr<eci::interpreter::Block>& _block);
+			ememory::SharedPtr<eci::interpreter::Element> parseCondition(const NodeList& _nodes, size_t& _pos);
+			ememory::SharedPtr<eci::interpreter::Element> parseFor(const NodeList& _nodes, size_t& _pos);
+			ememory::SharedPtr<eci::interpreter::Element> parseSwitch(const NodeList& _nodes, size_t& _pos);
+			ememory::SharedPtr<eci::interpreter::Element> parseExpression(const NodeList& _nodes, size_t& _pos, int32_t _minPriority=0);
+			ememory::SharedPtr<eci::interpreter::Element> parseUnary(const NodeList& _nodes, size_t& _pos);
+			ememory::SharedPtr<eci::interpreter::Element> parsePrimary(const NodeList& _nodes, size_t& _pos);
+			bool parseCallArguments(const ememory::SharedPtr<eci::LexerNode>& _node, const etk::String& _name, etk::Vector<ememory::SharedPtr<eci::interpreter::Element>>& _arguments);
 	};
 }
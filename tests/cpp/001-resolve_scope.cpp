@@ -0,0 +1,22 @@
+/* @copyright Edouard DUPIN */
+// Variable visibility (global, argument, local, shadowing)
+int value = 42;
+int add(int a, int b);
+int add(int a, int b) {
+	int value = a + b;
+	{
+		int value = 0;
+	}
+	return value;
+}
+int main() {
+	int out = add(value, 1);
+	for (int iii=0; iii<3; ++iii) {
+		int tmp = iii;
+		out += tmp;
+	}
+	if (out != 46) {
+		return 1;
+	}
+	return 0;
+}
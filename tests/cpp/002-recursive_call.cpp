@@ -0,0 +1,29 @@
+/* @copyright Edouard DUPIN */
+// Recursive call and call in argument
+int fib(int n) {
+	if (n < 2) {
+		return n;
+	}
+	return fib(n-1) + fib(n-2);
+}
+int sum(int a, int b, int c) {
+	return a + b + c;
+}
+int depth(int n) {
+	if (n == 0) {
+		return 0;
+	}
+	return 1 + depth(n-1);
+}
+int main() {
+	if (fib(15) != 610) {
+		return 1;
+	}
+	if (sum(fib(3), sum(1, 2, 3), fib(4)) != 11) {
+		return 2;
+	}
+	if (depth(1000) != 1000) {
+		return 3;
+	}
+	return 0;
+}
@@ -0,0 +1,38 @@
+/* @copyright Edouard DUPIN */
+// folded expressions must keep the C semantic of the types
+const int GLOBAL = 7 * 6;
+int main() {
+	int out = 0;
+	{
+		const int value = 3;
+		out = out + value;
+	}
+	{
+		// the slot of "value" is reused by a non const variable
+		int other = 10;
+		other = other + 1;
+		out = out + other;
+	}
+	if (GLOBAL != 42) {
+		return 1;
+	}
+	if ((unsigned char)300 != 44) {
+		return 2;
+	}
+	if (7 / 2 != 3 || 7.0 / 2 != 3.5) {
+		return 3;
+	}
+	if (false && out == 14) {
+		return 4;
+	}
+	for (int iii=0; false; ++iii) {
+		return 5;
+	}
+	if (-(2 - 5) * 2 % 4 != 2) {
+		return 6;
+	}
+	if (out != 14) {
+		return 7;
+	}
+	return 0;
+}
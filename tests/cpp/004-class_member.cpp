@@ -0,0 +1,67 @@
+/* @copyright Edouard DUPIN */
+// class layout, inherited fields and methods dispatched on the class of the object
+class Shape {
+	public:
+		int m_id;
+		int m_size;
+		int area() {
+			return 0;
+		}
+		int scaled(int _factor) {
+			return area() * _factor;
+		}
+};
+class Square : public Shape {
+	public:
+		int area() {
+			return m_size * m_size;
+		}
+};
+class Rectangle : public Shape {
+	public:
+		int m_height;
+		int area() {
+			return m_size * m_height;
+		}
+};
+struct Pair {
+	Square first;
+	int second;
+};
+int sumArea(Shape _shape, int _count) {
+	int out = 0;
+	for (int iii=0; iii<_count; ++iii) {
+		out += _shape.area();
+	}
+	return out;
+}
+int main() {
+	Square square;
+	square.m_size = 3;
+	Rectangle rectangle;
+	rectangle.m_size = 2;
+	rectangle.m_height = 5;
+	if (square.area() != 9) {
+		return 1;
+	}
+	if (rectangle.scaled(2) != 20) {
+		return 2;
+	}
+	// same call site with 2 classes (polymorphic)
+	if (sumArea(square, 10) + sumArea(rectangle, 10) != 190) {
+		return 3;
+	}
+	Pair pair;
+	pair.first.m_size = 4;
+	pair.second = pair.first.area() + 1;
+	if (pair.second != 17) {
+		return 4;
+	}
+	// reference on the same object
+	Shape other = square;
+	other.m_size = 5;
+	if (square.area() != 25) {
+		return 5;
+	}
+	return 0;
+}
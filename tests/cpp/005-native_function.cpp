@@ -0,0 +1,96 @@
+/* @copyright Edouard DUPIN */
+// Same result with the interpreter and the native code ("--jit"): the functions are called more than the threshold.
+int g_count = 0;
+int addWrap(int a, int b) {
+	return a + b;
+}
+int64_t addLong(int64_t a, int b) {
+	return a + b;
+}
+int divide(int a, int b) {
+	return a / b;
+}
+int modulo(int a, int b) {
+	return a % b;
+}
+bool lessDouble(double a, double b) {
+	return a < b;
+}
+int truncate(double value) {
+	return value;
+}
+double negate(double value) {
+	return -value;
+}
+int countGlobal() {
+	// use a global variable: stay in the interpreter
+	g_count++;
+	return g_count;
+}
+int loop(int count) {
+	int out = 0;
+	int iii = 0;
+	do {
+		iii++;
+		if (iii % 2 == 0) {
+			continue;
+		}
+		if (iii > count) {
+			break;
+		}
+		out += iii;
+	} while (iii < 100);
+	return out;
+}
+int callMix(int value) {
+	return countGlobal() + loop(value);
+}
+int fib(int value) {
+	if (value < 2) {
+		return value;
+	}
+	return fib(value-1) + fib(value-2);
+}
+bool logic(int a, int b) {
+	return !(a > 0 && b > 0) || a == b;
+}
+int main() {
+	int error = 0;
+	for (int iii=0; iii<20; ++iii) {
+		// the overflow wraps in both modes (unsigned arithmetic in the interpreter, add of the CPU in the native code)
+		if (addWrap(2147483647, 1) != -2147483647-1) {
+			error = 1;
+		}
+		if (addLong(4294967296, iii) != 4294967296 + iii) {
+			error = 2;
+		}
+		if (divide(7, -2) != -3 || modulo(-7, 2) != -1) {
+			error = 3;
+		}
+		if (divide(iii, 0) != 0 || modulo(iii, 0) != 0) {
+			error = 4;
+		}
+		if (divide(-2147483647-1, -1) != -2147483647-1 || modulo(-2147483647-1, -1) != 0) {
+			error = 4;
+		}
+		if (lessDouble(1.5, 2.5) != true || lessDouble(2.5, 1.5) != false) {
+			error = 5;
+		}
+		if (truncate(-3.75) != -3 || negate(1.5) != -1.5) {
+			error = 6;
+		}
+		if (loop(9) != 25) {
+			error = 7;
+		}
+		if (callMix(3) != iii + 1 + 4) {
+			error = 8;
+		}
+		if (logic(1, 2) != false || logic(0, 2) != true || logic(3, 3) != true) {
+			error = 9;
+		}
+	}
+	if (fib(20) != 6765) {
+		error = 10;
+	}
+	return error;
+}
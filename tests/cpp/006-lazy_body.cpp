@@ -0,0 +1,45 @@
+/* @copyright Edouard DUPIN */
+// The function bodies are parsed on the first call: the frame of the first call is extended with the locals.
+int later(int value);
+int sum(int count) {
+	int out = 0;
+	for (int iii=0; iii<count; ++iii) {
+		int tmp = iii * 2;
+		out += tmp;
+	}
+	return out;
+}
+int g_value = sum(10);
+class Counter {
+	public:
+		int m_count;
+		int add(int value) {
+			int previous = m_count;
+			m_count = previous + value;
+			return m_count;
+		}
+};
+int neverCalled(int value) {
+	int aaa = value * 3;
+	int bbb = aaa + 7;
+	return bbb / 2;
+}
+int main() {
+	if (g_value != 90) {
+		return 1;
+	}
+	if (later(4) != 24) {
+		return 2;
+	}
+	Counter counter;
+	counter.m_count = 1;
+	counter.add(2);
+	if (counter.add(3) != 6) {
+		return 3;
+	}
+	return 0;
+}
+int later(int value) {
+	int factor = 6;
+	return value * factor;
+}
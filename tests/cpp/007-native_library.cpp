@@ -0,0 +1,66 @@
+/* @copyright Edouard DUPIN */
+// C functions of the system libraries bound on declarations
+#import "libm.so.6"
+#import <libc.so.6>
+double cos(double value);
+double pow(double value, double exponent);
+float sqrtf(float value);
+double ldexp(double value, int exponent);
+int abs(int value);
+long labs(long value);
+int isalpha(int value);
+double frexp(double value, int exponent[]);
+double modf(double value, double integral[]);
+long strlen(char text[]);
+double scale(double value, int exponent) {
+	// called more than the JIT threshold: native code call the C function directly
+	return ldexp(value, exponent) + cos(0.0);
+}
+int main() {
+	int error = 0;
+	if (cos(0.0) != 1.0) {
+		error = 1;
+	}
+	if (pow(2.0, 10.0) != 1024.0) {
+		error = 2;
+	}
+	if (sqrtf(16.0) != 4.0) {
+		error = 3;
+	}
+	// integer and float arguments are mixed
+	if (ldexp(1.5, 4) != 24.0) {
+		error = 4;
+	}
+	if (abs(-5) != 5 || labs(-4294967296) != 4294967296) {
+		error = 5;
+	}
+	if (isalpha(65) == 0 || isalpha(48) != 0) {
+		error = 6;
+	}
+	int sum = 0;
+	for (int iii=-20; iii<20; ++iii) {
+		sum += abs(iii);
+	}
+	if (sum != 400) {
+		error = 7;
+	}
+	for (int iii=0; iii<20; ++iii) {
+		if (scale(0.5, iii) != 0.5 * pow(2.0, iii) + 1.0) {
+			error = 8;
+		}
+	}
+	// the arrays are given as pointers on their elements, written back after the call
+	int exponent[1];
+	double integral[] = new double[1];
+	if (frexp(24.0, exponent) != 0.75 || exponent[0] != 5 || modf(2.25, integral) != 0.25 || integral[0] != 2.0) {
+		error = 9;
+	}
+	char text[8];
+	text[0] = 'e';
+	text[1] = 'c';
+	text[2] = 'i';
+	if (strlen(text) != 3) {
+		error = 10;
+	}
+	return error;
+}
@@ -0,0 +1,55 @@
+/* @copyright Edouard DUPIN */
+// objects created with "new" and released with "delete" (the blocks are reused by the heap)
+class Node {
+	public:
+		int m_value;
+		Node* m_next;
+		int get() {
+			return m_value;
+		}
+};
+class Big {
+	public:
+		double m_a;
+		double m_b;
+		double m_c;
+		double m_d;
+		Node m_node;
+};
+Node* push(Node* _list, int _value) {
+	Node* node = new Node();
+	node->m_value = _value;
+	node->m_next = _list;
+	return node;
+}
+int main() {
+	int error = 0;
+	Node* list = new Node;
+	list->m_value = 0;
+	for (int iii=1; iii<10; ++iii) {
+		list = push(list, iii);
+	}
+	int sum = 0;
+	Node* it = list;
+	for (int iii=0; iii<10; ++iii) {
+		sum += it.get();
+		Node* next = it->m_next;
+		delete it;
+		it = next;
+	}
+	if (sum != 45) {
+		error = 1;
+	}
+	for (int iii=0; iii<100; ++iii) {
+		Big* big = new Big();
+		big->m_a = iii;
+		big->m_node.m_value = iii;
+		if (big->m_a != big->m_node.m_value) {
+			error = 2;
+		}
+		delete big;
+	}
+	Node* none = null;
+	delete none;
+	return error;
+}
@@ -0,0 +1,66 @@
+/* @copyright Edouard DUPIN */
+// unreachable objects and cycles released by the garbage collector ("--gc --stat"), reachable ones kept
+class Node {
+	public:
+		int m_value;
+		Node* m_next;
+		Node* m_other;
+};
+Node* global = null;
+Node* push(Node* _list, int _value) {
+	Node* node = new Node();
+	node->m_value = _value;
+	node->m_next = _list;
+	return node;
+}
+Node* makeCycle(int _value) {
+	Node* first = new Node();
+	Node* second = new Node();
+	first->m_value = _value;
+	second->m_value = _value + 1;
+	first->m_next = second;
+	second->m_next = first;
+	return first;
+}
+int check(Node* _list, int _count) {
+	int sum = 0;
+	Node* it = _list;
+	for (int iii=0; iii<_count; ++iii) {
+		sum += it->m_value;
+		if (it->m_other->m_value != it->m_value) {
+			return -1;
+		}
+		it = it->m_next;
+	}
+	return sum;
+}
+int main() {
+	Node* list = null;
+	for (int iii=0; iii<100; ++iii) {
+		list = push(list, iii);
+	}
+	global = push(null, 42);
+	int error = 0;
+	for (int iii=0; iii<20000; ++iii) {
+		Node* cycle = makeCycle(iii);
+		if (cycle->m_next->m_next->m_value != iii) {
+			error = 1;
+		}
+		// the reachable objects are modified while the collector mark them
+		Node* it = list;
+		for (int jjj=0; jjj<iii%100; ++jjj) {
+			it = it->m_next;
+		}
+		it->m_other = push(null, it->m_value);
+	}
+	if (check(list, 100) != 4950) {
+		error = 2;
+	}
+	if (global->m_value != 42) {
+		error = 3;
+	}
+	Node* deleted = new Node();
+	Node* alias = deleted;
+	delete deleted;
+	return error;
+}
@@ -0,0 +1,32 @@
+/* @copyright Edouard DUPIN */
+// global variables of a shared module ("--module --isolates=4"): each interpreter start with the initialized values of the module
+class Counter {
+	public:
+		int m_value;
+		Counter* m_self;
+};
+int square(int value) {
+	return value * value;
+}
+Counter counter;
+Counter* alias = null;
+int start = square(7);
+int main() {
+	// an other interpreter on the same module does not change the values
+	if (    start != 49
+	     || counter.m_value != 0) {
+		return 1;
+	}
+	alias = counter;
+	counter.m_self = alias;
+	for (int iii=0; iii<1000; ++iii) {
+		counter.m_value += 1;
+		start += 1;
+	}
+	if (    alias->m_value != 1000
+	     || counter.m_self->m_self->m_value != 1000
+	     || start != 1049) {
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,66 @@
+/* @copyright Edouard DUPIN */
+// quickened operators must keep the C semantic of the types (the sites are executed more than the stable count)
+int main() {
+	auto count = 0;
+	auto sum = 0;
+	long large = 0;
+	unsigned int wrap = 0;
+	double average = 0.0;
+	float ratio = 1.0f;
+	for (auto iii=0; iii<100; ++iii) {
+		sum += iii % 7;
+		count = count + 1;
+		large = large + 100000000;
+		wrap = wrap - 1;
+		average += iii / 4.0;
+		if (iii < 10) {
+			ratio = ratio * 0.5f;
+		}
+	}
+	if (count != 100 || sum != 295) {
+		return 1;
+	}
+	if (large != 10000000000) {
+		return 2;
+	}
+	if (wrap != 4294967196) {
+		return 3;
+	}
+	if (average != 1237.5) {
+		return 4;
+	}
+	if (ratio != 1.0f / 1024.0f) {
+		return 5;
+	}
+	// integer division by 0 on a quickened site: error and 0 (as the generic version)
+	auto divided = 0;
+	for (int iii=10; iii>=0; --iii) {
+		divided = divided + 100 / iii;
+	}
+	if (divided != 291) {
+		return 6;
+	}
+	// mixed types stay in the generic version (usual arithmetic conversions)
+	double mixed = 0.0;
+	for (int iii=0; iii<20; ++iii) {
+		mixed = mixed + iii * 0.5;
+	}
+	if (mixed != 95.0) {
+		return 7;
+	}
+	// signed overflow on a quickened site (after the stable count): the result wrap (as the generic version)
+	int grow = 2147483000;
+	int shrink = -2147483000;
+	int product = 1;
+	for (int iii=0; iii<100; ++iii) {
+		grow = grow + 10;
+		shrink = shrink - 10;
+		if (iii < 40) {
+			product = product * 3;
+		}
+	}
+	if (grow != -2147483296 || shrink != 2147483296 || product != 689956897) {
+		return 8;
+	}
+	return 0;
+}
@@ -0,0 +1,51 @@
+/* @copyright Edouard DUPIN */
+// fused operator sites must keep the result of the generic execution
+class Node {
+	public:
+		int m_value;
+};
+int main() {
+	int count = 0;
+	long large = 4294967295;
+	char small = 126;
+	double real = 0.5;
+	int before = count++;
+	int after = ++count;
+	if (before != 0 || after != 2 || count-- != 2 || --count != 0) {
+		return 1;
+	}
+	large++;
+	if (large != 4294967296) {
+		return 2;
+	}
+	++small;
+	++small;
+	if (small != -128) {
+		return 3;
+	}
+	if (real++ != 0.5 || --real != 0.5) {
+		return 4;
+	}
+	// "local op constant", "local op local" and "xxx op constant"
+	int left = 7;
+	int right = 3;
+	if (left - 2 != 5 || left / right != 2 || left % right != 1 || (left * right) - 1 != 20) {
+		return 5;
+	}
+	// compound assignment in the type of the slot
+	small = 10;
+	small += 300;
+	if (small != 54) {
+		return 6;
+	}
+	// object assigned in a local (barrier of the collector)
+	Node* node = null;
+	for (int iii=0; iii<100; ++iii) {
+		node = new Node();
+		node->m_value = iii;
+	}
+	if (node->m_value != 99) {
+		return 7;
+	}
+	return 0;
+}
@@ -0,0 +1,101 @@
+/* @copyright Edouard DUPIN */
+// switch on dense labels (table), sparse labels (search), fall through, default and break
+int dense(int value) {
+	switch (value) {
+		case 0:
+			return 10;
+		case 1:
+		case 2:
+			return 12;
+		case 3:
+			value = 30;
+		case 4:
+			return value + 1;
+		default:
+			return -1;
+	}
+	return -2;
+}
+int sparse(long value) {
+	int out = 0;
+	switch (value) {
+		case -1000:
+			out = 1;
+			break;
+		case 7:
+			out = 2;
+			break;
+		default:
+			out = 9;
+			break;
+		case 4096:
+			out = 3;
+		case 100000:
+			out += 4;
+			break;
+		case 4294967296:
+			out = 5;
+			break;
+		case 1024 * 1024:
+			out = 6;
+			break;
+	}
+	return out;
+}
+int letter(char value) {
+	switch (value) {
+		case 'a':
+		case 'e':
+		case 'i':
+		case 'o':
+		case 'u':
+			return 1;
+	}
+	return 0;
+}
+int main() {
+	if (dense(0) != 10 || dense(1) != 12 || dense(2) != 12 || dense(3) != 31 || dense(4) != 5 || dense(5) != -1 || dense(-1) != -1) {
+		return 1;
+	}
+	if (sparse(-1000) != 1 || sparse(7) != 2 || sparse(4096) != 7 || sparse(100000) != 4 || sparse(4294967296) != 5 || sparse(1048576) != 6 || sparse(8) != 9) {
+		return 2;
+	}
+	int vowel = letter('a') + letter('b') + letter('o') + letter('u') + letter('z');
+	if (vowel != 3) {
+		return 3;
+	}
+	// "break" leave the switch, "continue" the cycle
+	int sum = 0;
+	for (int iii=0; iii<10; ++iii) {
+		switch (iii % 3) {
+			case 0:
+				continue;
+			case 1:
+				sum += 1;
+				break;
+			default:
+				for (int jjj=0; jjj<5; ++jjj) {
+					if (jjj == 2) {
+						break;
+					}
+					sum += 10;
+				}
+				break;
+		}
+		sum += 100;
+	}
+	if (sum != 663) {
+		return 4;
+	}
+	// no label selected and no default: nothing is executed
+	int none = 3;
+	switch (none) {
+		case 1:
+			none = 0;
+			break;
+	}
+	if (none != 3) {
+		return 5;
+	}
+	return 0;
+}
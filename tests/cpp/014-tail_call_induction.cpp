@@ -0,0 +1,79 @@
+/* @copyright Edouard DUPIN */
+// recursive calls in tail position and counted loops must keep the result of the generic execution
+int sum(int count, int total) {
+	if (count == 0) {
+		return total;
+	}
+	return sum(count - 1, total + count);
+}
+int gcd(int left, int right) {
+	if (right == 0) {
+		return left;
+	}
+	// the new arguments use the current ones
+	return gcd(right, left % right);
+}
+int fresh(int count) {
+	int value;
+	value = value + 1;
+	if (count == 0) {
+		return value;
+	}
+	return fresh(count - 1);
+}
+int main() {
+	if (sum(5000, 0) != 12502500 || gcd(1071, 462) != 21 || fresh(10) != 1) {
+		return 1;
+	}
+	int total = 0;
+	int limit = 10;
+	for (int iii=0; iii<limit; ++iii) {
+		// the bound can change in the block
+		if (iii == 2) {
+			limit = 5;
+		}
+		total += iii;
+	}
+	if (total != 10) {
+		return 2;
+	}
+	int index = 0;
+	for (index=100; index>=0; index-=7) {
+		if (index < 50) {
+			break;
+		}
+	}
+	if (index != 44) {
+		return 3;
+	}
+	for (index=0; index!=12; index+=3) {
+		continue;
+	}
+	if (index != 12) {
+		return 4;
+	}
+	unsigned int count = 0;
+	for (unsigned int jjj=5; jjj<4294967295; --jjj) {
+		++count;
+	}
+	if (count != 6) {
+		return 5;
+	}
+	long large = 0;
+	for (long kkk=2147483640; kkk<2147483650; kkk++) {
+		large += kkk;
+	}
+	if (large != 21474836445) {
+		return 6;
+	}
+	// the block modify the variable: executed by the elements
+	total = 0;
+	for (int iii=0; iii<20; ++iii) {
+		iii += 1;
+		total += 1;
+	}
+	if (total != 10) {
+		return 7;
+	}
+	return 0;
+}
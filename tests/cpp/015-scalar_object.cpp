@@ -0,0 +1,92 @@
+/* @copyright Edouard DUPIN */
+// local objects that never leave the function are replaced by their fields: same result as the objects of the heap
+struct Point {
+	int x;
+	int y;
+	double weight;
+};
+class Node {
+	public:
+		int m_value;
+		Node* m_next;
+		int get() {
+			return m_value;
+		}
+};
+int length(Point _point) {
+	return _point.x + _point.y;
+}
+int local(int count) {
+	int total = 0;
+	for (int iii=0; iii<count; ++iii) {
+		// a new object at each cycle: the fields start at 0
+		Point point;
+		point.x += iii;
+		point.y = point.x * 2;
+		point.weight = 0.5;
+		total += point.x + point.y + point.weight * 2;
+	}
+	return total;
+}
+int pointer(int count) {
+	int total = 0;
+	for (int iii=0; iii<count; ++iii) {
+		Node* node = new Node();
+		node->m_value = iii;
+		node->m_next = null;
+		total += node->m_value;
+		delete node;
+	}
+	return total;
+}
+int escape(int count) {
+	int total = 0;
+	for (int iii=0; iii<count; ++iii) {
+		// given to a function, a method and an other variable: kept in the heap
+		Point point;
+		point.x = iii;
+		point.y = 1;
+		total += length(point);
+		Node node;
+		node.m_value = 2;
+		total += node.get();
+		Node* first = new Node();
+		Node* second = first;
+		second->m_value = 3;
+		total += first->m_value;
+		delete first;
+	}
+	return total;
+}
+int scope(int count) {
+	int total = 0;
+	if (count > 0) {
+		Point point;
+		point.x = count;
+		total += point.x;
+	} else {
+		int value = 3;
+		total += value;
+	}
+	{
+		Point other;
+		other.y = 4;
+		total += other.y + other.x;
+	}
+	return total;
+}
+int main() {
+	if (local(10) != 145) {
+		return 1;
+	}
+	if (pointer(10) != 45) {
+		return 2;
+	}
+	if (escape(10) != 105) {
+		return 3;
+	}
+	if (scope(5) != 9 || scope(0) != 7) {
+		return 4;
+	}
+	return 0;
+}
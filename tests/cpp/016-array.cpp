@@ -0,0 +1,74 @@
+/* @copyright Edouard DUPIN */
+// arrays of native values and of structures: the elements are stored inline in one block
+struct Point {
+	int x;
+	int y;
+	double weight;
+};
+int table[8];
+int native(int count) {
+	int values[count];
+	double halves[count];
+	for (int iii=0; iii<count; ++iii) {
+		values[iii] = iii * 3;
+		halves[iii] = iii * 0.5;
+	}
+	int total = 0;
+	for (int iii=0; iii<count; ++iii) {
+		++values[iii];
+		values[iii] += 2;
+		total += values[iii] + halves[iii] * 2;
+	}
+	return total;
+}
+int structure(int count) {
+	Point points[count];
+	for (int iii=0; iii<count; ++iii) {
+		points[iii].x = iii;
+		points[iii].y = iii * 2;
+		points[iii].weight = 0.5;
+	}
+	int total = 0;
+	for (int iii=0; iii<count; ++iii) {
+		points[iii].x += 1;
+		total += points[iii].x + points[iii].y + points[iii].weight * 2;
+	}
+	return total;
+}
+int sum(int values[], int count) {
+	int total = 0;
+	for (int iii=0; iii<count; ++iii) {
+		total += values[iii];
+	}
+	return total;
+}
+int dynamic(int count) {
+	int values[] = new int[count];
+	for (int iii=0; iii<count; ++iii) {
+		values[iii] = iii;
+	}
+	int total = sum(values, count);
+	delete values;
+	return total;
+}
+int global() {
+	for (int iii=0; iii<8; ++iii) {
+		table[iii] = iii + 1;
+	}
+	return sum(table, 8);
+}
+int main() {
+	if (native(10) != 210) {
+		return 1;
+	}
+	if (structure(10) != 155) {
+		return 2;
+	}
+	if (dynamic(10) != 45) {
+		return 3;
+	}
+	if (global() != 36) {
+		return 4;
+	}
+	return 0;
+}
@@ -0,0 +1,215 @@
+/* @copyright Edouard DUPIN */
+// kernels of the builtin library on the arrays: same result as the loops of the script (sizes with a remainder)
+#import <eci/kernel>
+double sumDouble(double values[]);
+double dotDouble(double left[], double right[]);
+double minDouble(double values[]);
+double maxDouble(double values[]);
+void addDouble(double out[], double left[], double right[]);
+void scaleDouble(double out[], double values[], double factor);
+int countLessDouble(double values[], double limit);
+void lessDouble(bool out[], double left[], double right[]);
+void sortDouble(double values[]);
+float sumFloat(float values[]);
+float maxFloat(float values[]);
+void mulFloat(float out[], float left[], float right[]);
+int sumInt(int values[]);
+int minInt(int values[]);
+int maxInt(int values[]);
+void subInt(int out[], int left[], int right[]);
+void mulInt(int out[], int left[], int right[]);
+int countLessInt(int values[], int limit);
+void sortInt(int values[]);
+long sumLong(long values[]);
+long minLong(long values[]);
+long dotLong(long left[], long right[]);
+int countLessLong(long values[], long limit);
+int checkDouble(int count) {
+	double left[count];
+	double right[count];
+	double out[count];
+	bool lower[count];
+	for (int iii=0; iii<count; ++iii) {
+		left[iii] = (iii * 7) % 11 - 4.5;
+		right[iii] = iii * 0.25;
+	}
+	double sum = 0.0;
+	double dot = 0.0;
+	double min = left[0];
+	double max = left[0];
+	int less = 0;
+	for (int iii=0; iii<count; ++iii) {
+		sum += left[iii];
+		dot += left[iii] * right[iii];
+		if (left[iii] < min) {
+			min = left[iii];
+		}
+		if (left[iii] > max) {
+			max = left[iii];
+		}
+		if (left[iii] < 1.0) {
+			less += 1;
+		}
+	}
+	if (sumDouble(left) != sum || dotDouble(left, right) != dot) {
+		return 1;
+	}
+	if (minDouble(left) != min || maxDouble(left) != max || countLessDouble(left, 1.0) != less) {
+		return 2;
+	}
+	addDouble(out, left, right);
+	lessDouble(lower, left, right);
+	for (int iii=0; iii<count; ++iii) {
+		if (out[iii] != left[iii] + right[iii] || lower[iii] != left[iii] < right[iii]) {
+			return 3;
+		}
+	}
+	// the output is an input
+	scaleDouble(out, out, 2.0);
+	for (int iii=0; iii<count; ++iii) {
+		if (out[iii] != (left[iii] + right[iii]) * 2.0) {
+			return 4;
+		}
+	}
+	sortDouble(left);
+	for (int iii=1; iii<count; ++iii) {
+		if (left[iii-1] > left[iii]) {
+			return 5;
+		}
+	}
+	return 0;
+}
+int checkFloat(int count) {
+	float left[count];
+	float right[count];
+	float out[count];
+	float max = -100.0;
+	for (int iii=0; iii<count; ++iii) {
+		left[iii] = iii * 0.5;
+		right[iii] = 3.0 - iii;
+		if (right[iii] > max) {
+			max = right[iii];
+		}
+	}
+	// the partial sums of 0.5 are exact
+	if (sumFloat(left) != count * (count - 1) * 0.25 || maxFloat(right) != max) {
+		return 1;
+	}
+	mulFloat(out, left, right);
+	for (int iii=0; iii<count; ++iii) {
+		if (out[iii] != left[iii] * right[iii]) {
+			return 2;
+		}
+	}
+	return 0;
+}
+int checkInt(int count) {
+	int left[count];
+	int right[count];
+	int out[count];
+	int sum = 0;
+	int min = 1000;
+	int max = -1000;
+	int less = 0;
+	for (int iii=0; iii<count; ++iii) {
+		left[iii] = (iii * 13) % 17 - 8;
+		right[iii] = iii - 3;
+		sum += left[iii];
+		if (left[iii] < min) {
+			min = left[iii];
+		}
+		if (left[iii] > max) {
+			max = left[iii];
+		}
+		if (left[iii] < 0) {
+			less += 1;
+		}
+	}
+	if (sumInt(left) != sum || minInt(left) != min || maxInt(left) != max || countLessInt(left, 0) != less) {
+		return 1;
+	}
+	subInt(out, left, right);
+	for (int iii=0; iii<count; ++iii) {
+		if (out[iii] != left[iii] - right[iii]) {
+			return 2;
+		}
+	}
+	mulInt(out, left, right);
+	for (int iii=0; iii<count; ++iii) {
+		if (out[iii] != left[iii] * right[iii]) {
+			return 3;
+		}
+	}
+	sortInt(left);
+	if (left[0] != min || left[count-1] != max) {
+		return 4;
+	}
+	return 0;
+}
+int checkLong(int count) {
+	long left[count];
+	long right[count];
+	long sum = 0;
+	long dot = 0;
+	long min = 0;
+	int less = 0;
+	for (int iii=0; iii<count; ++iii) {
+		left[iii] = (iii - 5) * 4294967296;
+		right[iii] = iii;
+		sum += left[iii];
+		dot += left[iii] * right[iii];
+		if (left[iii] < min) {
+			min = left[iii];
+		}
+		if (left[iii] < 4294967296) {
+			less += 1;
+		}
+	}
+	if (sumLong(left) != sum || dotLong(left, right) != dot) {
+		return 1;
+	}
+	if (minLong(left) != min || countLessLong(left, 4294967296) != less) {
+		return 2;
+	}
+	return 0;
+}
+int checkOverflow(int count) {
+	int left[count];
+	int out[count];
+	int sum = 0;
+	for (int iii=0; iii<count; ++iii) {
+		left[iii] = 2147483647 - iii;
+		sum += left[iii];
+	}
+	// the integers wrap as in the script
+	if (sumInt(left) != sum) {
+		return 1;
+	}
+	mulInt(out, left, left);
+	for (int iii=0; iii<count; ++iii) {
+		if (out[iii] != left[iii] * left[iii]) {
+			return 2;
+		}
+	}
+	return 0;
+}
+int main() {
+	for (int count=1; count<20; ++count) {
+		if (checkDouble(count) != 0) {
+			return 1;
+		}
+		if (checkFloat(count) != 0) {
+			return 2;
+		}
+		if (checkInt(count) != 0) {
+			return 3;
+		}
+		if (checkLong(count) != 0) {
+			return 4;
+		}
+		if (checkOverflow(count) != 0) {
+			return 5;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,156 @@
+/* @copyright Edouard DUPIN */
+// strings, builder and hash tables of the builtin library (growth of the tables, removal in the clusters, interned keys)
+#import <eci/container>
+int stringLength(string text);
+char stringAt(string text, int index);
+string stringConcat(string left, string right);
+string stringSub(string text, int start, int count);
+int stringFind(string text, string pattern, int start);
+bool stringEqual(string left, string right);
+int stringCompare(string left, string right);
+string stringFromInt(long value);
+long stringToInt(string text);
+string stringIntern(string text);
+void builderAppend(builder out, string text);
+void builderAppendChar(builder out, char value);
+void builderAppendInt(builder out, long value);
+int builderLength(builder out);
+string builderToString(builder out);
+void builderClear(builder out);
+void mapSet(map table, auto key, auto value);
+long mapGet(map table, auto key);
+long mapAdd(map table, auto key, long delta);
+bool mapHas(map table, auto key);
+bool mapRemove(map table, auto key);
+int mapSize(map table);
+int mapNext(map table, int position);
+long mapValue(map table, int position);
+bool setAdd(set table, auto key);
+bool setHas(set table, auto key);
+bool setRemove(set table, auto key);
+int setSize(set table);
+void setClear(set table);
+string name = "global";
+int strings() {
+	string text = "hello, world";
+	if (stringLength(text) != 12 || stringAt(text, 4) != 'o' || stringAt(text, 12) != 0) {
+		return 1;
+	}
+	// the parts are not aligned on the words of the string
+	string both = stringConcat(stringSub(text, 0, 5), stringSub(text, 5, 100));
+	if (stringEqual(both, text) == false || stringLength(stringSub(text, 3, 0)) != 0) {
+		return 2;
+	}
+	if (stringFind(text, "world", 0) != 7 || stringFind(text, "o", 5) != 8 || stringFind(text, "x", 0) != -1) {
+		return 3;
+	}
+	if (stringCompare("abc", "abd") >= 0 || stringCompare("abcdefghij", "abc") <= 0 || stringCompare("b", "abcdefghij") <= 0) {
+		return 4;
+	}
+	if (stringToInt(stringFromInt(-1234567890123)) != -1234567890123 || stringEqual(stringFromInt(0), "0") == false) {
+		return 5;
+	}
+	if (stringEqual("tab\there", stringConcat("tab", stringConcat("\t", "here"))) == false || stringLength("a\nb") != 3) {
+		return 6;
+	}
+	string empty;
+	if (stringLength(empty) != 0 || stringEqual(empty, "") == false || stringEqual(name, "global") == false) {
+		return 7;
+	}
+	return 0;
+}
+int builders() {
+	builder out;
+	for (int iii=0; iii<100; ++iii) {
+		builderAppendInt(out, iii);
+		builderAppendChar(out, ',');
+	}
+	builderAppend(out, "end");
+	string text = builderToString(out);
+	if (stringLength(text) != 293 || stringFind(text, "99,end", 0) != 287 || builderLength(out) != 293) {
+		return 1;
+	}
+	builderClear(out);
+	builderAppend(out, "x");
+	if (stringEqual(builderToString(out), "x") == false) {
+		return 2;
+	}
+	return 0;
+}
+int maps() {
+	map table;
+	for (int iii=0; iii<1000; ++iii) {
+		mapSet(table, iii * 7919, iii);
+	}
+	if (mapSize(table) != 1000 || mapGet(table, 7919 * 500) != 500 || mapHas(table, 3) == true) {
+		return 1;
+	}
+	// the removals move the next entries of the clusters: all the other keys are still found
+	for (int iii=0; iii<1000; iii+=2) {
+		if (mapRemove(table, iii * 7919) == false) {
+			return 2;
+		}
+	}
+	for (int iii=0; iii<1000; ++iii) {
+		if (mapHas(table, iii * 7919) != (iii % 2 == 1)) {
+			return 3;
+		}
+	}
+	long total = 0;
+	int count = 0;
+	for (int position=mapNext(table, 0); position>=0; position=mapNext(table, position+1)) {
+		total += mapValue(table, position);
+		count += 1;
+	}
+	if (count != 500 || total != 250000 || mapSize(table) != 500) {
+		return 4;
+	}
+	// the string keys are compared by their text
+	map words;
+	string text = "a b a c b a";
+	for (int iii=0; iii<stringLength(text); iii+=2) {
+		mapAdd(words, stringSub(text, iii, 1), 1);
+	}
+	if (mapGet(words, "a") != 3 || mapGet(words, "b") != 2 || mapGet(words, "c") != 1 || mapSize(words) != 3) {
+		return 5;
+	}
+	return 0;
+}
+int sets() {
+	set table;
+	if (setAdd(table, "key") == false || setAdd(table, stringConcat("k", "ey")) == true || setHas(table, 1) == true) {
+		return 1;
+	}
+	for (int iii=0; iii<100; ++iii) {
+		setAdd(table, iii);
+	}
+	if (setSize(table) != 101 || setRemove(table, 50) == false || setRemove(table, 50) == true || setHas(table, 51) == false) {
+		return 2;
+	}
+	setClear(table);
+	if (setSize(table) != 0 || setHas(table, "key") == true) {
+		return 3;
+	}
+	// the interned strings are the same object
+	set objects;
+	setAdd(objects, stringIntern(stringConcat("inter", "ned")));
+	if (setHas(objects, "interned") == false) {
+		return 4;
+	}
+	return 0;
+}
+int main() {
+	if (strings() != 0) {
+		return 1;
+	}
+	if (builders() != 0) {
+		return 2;
+	}
+	if (maps() != 0) {
+		return 3;
+	}
+	if (sets() != 0) {
+		return 4;
+	}
+	return 0;
+}
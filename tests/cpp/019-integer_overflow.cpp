@@ -0,0 +1,30 @@
+/* @copyright Edouard DUPIN */
+// the integer operators wrap (two's complement) and the minimum divided by -1 does not trap, at the execution and in the constant folding
+int divide(int left, int right) {
+	return left / right;
+}
+long modulo(long left, long right) {
+	return left % right;
+}
+int add(int left, int right) {
+	return left + right;
+}
+int main() {
+	int min = -2147483647 - 1;
+	long lmin = -9223372036854775807 - 1;
+	if (divide(min, -1) != min || modulo(lmin, -1) != 0 || modulo(7, -1) != 0 || divide(7, -1) != -7) {
+		return 1;
+	}
+	if ((-2147483647 - 1) / -1 != min || (-9223372036854775807 - 1) % -1 != 0) {
+		return 2;
+	}
+	if (add(2147483647, 1) != min || -min != min || 2147483647 * 2 != -2) {
+		return 3;
+	}
+	int value = 2147483647;
+	value++;
+	if (value != min) {
+		return 4;
+	}
+	return 0;
+}
@@ -0,0 +1,5 @@
+/* @copyright Edouard DUPIN */
+// a syntax error in the body of "main" is found on its first call: the execution fail
+int main() {
+	return 1 +* ;
+}
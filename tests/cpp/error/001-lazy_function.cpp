@@ -0,0 +1,16 @@
+/* @copyright Edouard DUPIN */
+// a syntax error in the body of a function is found on its first call: the callers do not continue with a void value
+int helper(int value) {
+	return value +* ;
+}
+int loop(int count) {
+	int out = 0;
+	for (int iii=0; iii<count; ++iii) {
+		out += helper(iii);
+	}
+	return out;
+}
+int main() {
+	int value = loop(10);
+	return 0;
+}
@@ -0,0 +1,7 @@
+/* @copyright Edouard DUPIN */
+// an array bigger than the heap accept is refused: the execution is aborted (no access out of the memory)
+int main() {
+	int values[2000000000];
+	values[0] = 1;
+	return 0;
+}
@@ -0,0 +1,15 @@
+/* @copyright Edouard DUPIN */
+// a local object deleted twice is not replaced by its fields (-O1): the second delete is reported
+class Point {
+	public:
+		int x;
+		int y;
+};
+int main() {
+	Point* point = new Point();
+	point->x = 1;
+	delete point;
+	delete point;
+	// the execution continue after the error: the test fail only if the error is reported
+	return 1;
+}
@@ -0,0 +1,16 @@
+/* @copyright Edouard DUPIN */
+// a local object deleted in a loop that does not declare it is not replaced by its fields (-O1): the second delete is reported
+class Point {
+	public:
+		int x;
+		int y;
+};
+int main() {
+	Point* point = new Point();
+	for (int iii=0; iii<2; ++iii) {
+		point->x = iii;
+		delete point;
+	}
+	// the execution continue after the error: the test fail only if the error is reported
+	return 1;
+}
@@ -0,0 +1,14 @@
+/* @copyright Edouard DUPIN */
+// a recursion deeper than the max call depth (or the native stack) abort the execution (interpreter and JIT)
+int depth(int n) {
+	if (n == 0) {
+		return 0;
+	}
+	return 1 + depth(n-1);
+}
+int main() {
+	if (depth(1000000) != 1000000) {
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,10 @@
+/* @copyright Edouard DUPIN */
+// a kernel called with arrays of different sizes abort the execution (no access out of the arrays)
+#import <eci/kernel>
+void addDouble(double out[], double left[], double right[]);
+int main() {
+	double values[4];
+	double other[5];
+	addDouble(values, values, other);
+	return 0;
+}
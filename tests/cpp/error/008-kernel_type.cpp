@@ -0,0 +1,9 @@
+/* @copyright Edouard DUPIN */
+// a kernel called with an array of an other type abort the execution
+#import <eci/kernel>
+double sumDouble(double values[]);
+int main() {
+	int values[4];
+	sumDouble(values);
+	return 0;
+}
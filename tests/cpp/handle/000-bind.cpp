@@ -0,0 +1,19 @@
+/* @copyright Edouard DUPIN */
+// functions called from the host application with typed handles
+int g_count = 0;
+int add(int _a, int _b) {
+	return _a + _b;
+}
+double scale(double _value, int _factor) {
+	return _value * _factor;
+}
+int count() {
+	++g_count;
+	return g_count;
+}
+void reset() {
+	g_count = 0;
+}
+int main() {
+	return add(1, -1);
+}
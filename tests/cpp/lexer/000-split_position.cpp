@@ -0,0 +1,47 @@
+/* @copyright Edouard DUPIN */
+// Tokens on both sides of the split positions of the parallel lexer: the tests of the "lexer" folder are lexed in
+// chunks of one line (the split positions are checked on every line) and compared with the sequential lexing.
+#import <eci/container>
+int stringLength(string text);
+bool stringEqual(string left, string right);
+/* a multiline comment
+int main() { return 1; }
+with a "string" and a // line comment */
+int value(int input) {
+	// a line comment with a "string"
+	return input
+	+ 1;
+}
+int strings() {
+	string text = "abc\
+def";
+	if (stringEqual(text, "abcdef") == false) {
+		return 1;
+	}
+	// the continuation in the middle of the lines of the string
+	string lines = "a\
+b\
+c";
+	if (stringLength(lines) != 3) {
+		return 2;
+	}
+	if (stringLength("tab\there") != 8) {
+		return 3;
+	}
+	char quote = '\'';
+	if (quote != 39) {
+		return 4;
+	}
+	return 0;
+}
+int main() {
+	int out = value(
+		41);
+	if (out != 42) {
+		return 1;
+	}
+	if (strings() != 0) {
+		return 2;
+	}
+	return 0;
+}
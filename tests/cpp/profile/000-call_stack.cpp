@@ -0,0 +1,26 @@
+/* @copyright Edouard DUPIN */
+// executed with the sampling profiler: the samples are recorded in the called functions and named by them
+long inner(long value) {
+	long out = 0;
+	for (long iii=0; iii<value; ++iii) {
+		out += iii % 7;
+	}
+	return out;
+}
+long work(int count) {
+	long out = 0;
+	for (int iii=0; iii<count; ++iii) {
+		out += inner(1000);
+	}
+	return out;
+}
+int main() {
+	long total = 0;
+	for (int iii=0; iii<20; ++iii) {
+		total += work(100);
+	}
+	if (total != 5994000) {
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,45 @@
+/* @copyright Edouard DUPIN */
+// requests executed in a region of the heap: the region is reset after each request, except when a request keep an object
+class Node {
+	public:
+		int m_value;
+		Node* m_next;
+};
+Node* g_kept = null;
+int request() {
+	Node* list = null;
+	for (int iii=0; iii<100; ++iii) {
+		Node* node = new Node();
+		node->m_value = iii;
+		node->m_next = list;
+		list = node;
+	}
+	int sum = 0;
+	for (int iii=0; iii<100; ++iii) {
+		sum += list->m_value;
+		Node* next = list->m_next;
+		delete list;
+		list = next;
+	}
+	if (sum != 4950) {
+		return 1;
+	}
+	return 0;
+}
+int keep() {
+	g_kept = new Node();
+	g_kept->m_value = 42;
+	return 0;
+}
+int check() {
+	int value = g_kept->m_value;
+	delete g_kept;
+	g_kept = null;
+	if (value != 42) {
+		return 2;
+	}
+	return 0;
+}
+int main() {
+	return request();
+}